@@ -3,7 +3,8 @@
 
 #include "HTTPServer.h"
 #include "utils/SHA256.h"
-#include <sstream>
+#include <charconv>
+#include <cstdint>
 
 using namespace std;
 
@@ -11,14 +12,17 @@ class AdminService {
 public:
     // POST /api/admin/addStudent
     static HTTPResponse addStudent(const HTTPRequest& req, DatabaseManager& db) {
-        auto data = JSONParser::parse(req.body);
+        JSONDocument data;
+        if (!data.parse(req.body)) {
+            return HTTPServer::jsonError("Invalid JSON: " + data.error());
+        }
         
         Student student;
-        student.studentID = JSONParser::getString(data, "studentID");
-        student.email = JSONParser::getString(data, "email");
-        student.name = JSONParser::getString(data, "name");
-        student.currentSemester = JSONParser::getInt(data, "semester", 1);
-        student.contactInfo = JSONParser::getString(data, "contact");
+        student.studentID = data.getString("studentID");
+        student.email = data.getString("email");
+        student.name = data.getString("name");
+        student.currentSemester = data.getInt("semester", 1);
+        student.contactInfo = data.getString("contact");
         student.dateOfAdmission = time(nullptr);
         
         if (student.studentID.empty() || student.email.empty() || student.name.empty()) {
@@ -36,23 +40,28 @@ public:
         user.email = student.email;
         user.name = student.name;
         user.role = UserRole::STUDENT;
-        string defaultPassword = JSONParser::getString(data, "password", "student123");
+        string defaultPassword = data.getString("password", "student123");
         user.passwordHash = SHA256::hash(defaultPassword);
         
         db.createUser(user);
         
-        map<string, string> response;
-        response["success"] = "true";
-        response["message"] = "Student added successfully";
-        response["studentID"] = student.studentID;
+        JsonWriter json;
+        json.beginObject()
+            .member("success", "true")
+            .member("message", "Student added successfully")
+            .member("studentID", student.studentID)
+            .endObject();
         
-        return HTTPServer::jsonSuccess(response);
+        return HTTPServer::jsonSuccess(json);
     }
     
     // POST /api/admin/removeStudent
     static HTTPResponse removeStudent(const HTTPRequest& req, DatabaseManager& db) {
-        auto data = JSONParser::parse(req.body);
-        string studentID = JSONParser::getString(data, "studentID");
+        JSONDocument data;
+        if (!data.parse(req.body)) {
+            return HTTPServer::jsonError("Invalid JSON: " + data.error());
+        }
+        string studentID = data.getString("studentID");
         
         if (studentID.empty()) {
             return HTTPServer::jsonError("Student ID required");
@@ -68,24 +77,29 @@ public:
         db.deleteStudent(studentID);
         db.deleteUser(email);
         
-        map<string, string> response;
-        response["success"] = "true";
-        response["message"] = "Student removed successfully";
+        JsonWriter json;
+        json.beginObject()
+            .member("success", "true")
+            .member("message", "Student removed successfully")
+            .endObject();
         
-        return HTTPServer::jsonSuccess(response);
+        return HTTPServer::jsonSuccess(json);
     }
     
     // POST /api/admin/addTeacher
     static HTTPResponse addTeacher(const HTTPRequest& req, DatabaseManager& db) {
-        auto data = JSONParser::parse(req.body);
+        JSONDocument data;
+        if (!data.parse(req.body)) {
+            return HTTPServer::jsonError("Invalid JSON: " + data.error());
+        }
         
         Teacher teacher;
-        teacher.teacherID = JSONParser::getString(data, "teacherID");
-        teacher.email = JSONParser::getString(data, "email");
-        teacher.name = JSONParser::getString(data, "name");
-        teacher.assignedCourseID = JSONParser::getString(data, "courseID");
-        teacher.department = JSONParser::getString(data, "department");
-        teacher.contactInfo = JSONParser::getString(data, "contact");
+        teacher.teacherID = data.getString("teacherID");
+        teacher.email = data.getString("email");
+        teacher.name = data.getString("name");
+        teacher.assignedCourseID = data.getString("courseID");
+        teacher.department = data.getString("department");
+        teacher.contactInfo = data.getString("contact");
         
         if (teacher.teacherID.empty() || teacher.email.empty() || teacher.name.empty()) {
             return HTTPServer::jsonError("Missing required fields");
@@ -101,23 +115,28 @@ public:
         user.email = teacher.email;
         user.name = teacher.name;
         user.role = UserRole::TEACHER;
-        string defaultPassword = JSONParser::getString(data, "password", "teacher123");
+        string defaultPassword = data.getString("password", "teacher123");
         user.passwordHash = SHA256::hash(defaultPassword);
         
         db.createUser(user);
         
-        map<string, string> response;
-        response["success"] = "true";
-        response["message"] = "Teacher added successfully";
-        response["teacherID"] = teacher.teacherID;
+        JsonWriter json;
+        json.beginObject()
+            .member("success", "true")
+            .member("message", "Teacher added successfully")
+            .member("teacherID", teacher.teacherID)
+            .endObject();
         
-        return HTTPServer::jsonSuccess(response);
+        return HTTPServer::jsonSuccess(json);
     }
     
     // POST /api/admin/removeTeacher
     static HTTPResponse removeTeacher(const HTTPRequest& req, DatabaseManager& db) {
-        auto data = JSONParser::parse(req.body);
-        string teacherID = JSONParser::getString(data, "teacherID");
+        JSONDocument data;
+        if (!data.parse(req.body)) {
+            return HTTPServer::jsonError("Invalid JSON: " + data.error());
+        }
+        string teacherID = data.getString("teacherID");
         
         if (teacherID.empty()) {
             return HTTPServer::jsonError("Teacher ID required");
@@ -133,116 +152,152 @@ public:
         db.deleteTeacher(teacherID);
         db.deleteUser(email);
         
-        map<string, string> response;
-        response["success"] = "true";
-        response["message"] = "Teacher removed successfully";
+        JsonWriter json;
+        json.beginObject()
+            .member("success", "true")
+            .member("message", "Teacher removed successfully")
+            .endObject();
         
-        return HTTPServer::jsonSuccess(response);
+        return HTTPServer::jsonSuccess(json);
     }
     
     // POST /api/admin/setRegistrationWindow
     static HTTPResponse setRegistrationWindow(const HTTPRequest& req, DatabaseManager& db) {
-        auto data = JSONParser::parse(req.body);
+        JSONDocument data;
+        if (!data.parse(req.body)) {
+            return HTTPServer::jsonError("Invalid JSON: " + data.error());
+        }
         
         SystemConfig config = db.getConfig();
-        config.registrationStartTime = JSONParser::getInt(data, "startTime", 0);
-        config.registrationEndTime = JSONParser::getInt(data, "endTime", 0);
-        config.isRegistrationOpen = JSONParser::getBool(data, "isOpen", true);
+        config.registrationStartTime = data.getInt64("startTime", 0);
+        config.registrationEndTime = data.getInt64("endTime", 0);
+        config.isRegistrationOpen = data.getBool("isOpen", true);
         
         // Auto-clear timetables when registration opens to prevent stale data
         if (config.isRegistrationOpen) {
-            cout << "[AdminService] Registration Opened. Clearing old timetables." << endl;
+            LOG_INFO("AdminService") << "Registration Opened. Clearing old timetables.";
             db.clearTimetables();
         }
 
         db.updateConfig(config);
         
-        map<string, string> response;
-        response["success"] = "true";
-        response["message"] = "Registration window updated";
+        JsonWriter json;
+        json.beginObject()
+            .member("success", "true")
+            .member("message", "Registration window updated")
+            .endObject();
         
-        return HTTPServer::jsonSuccess(response);
+        return HTTPServer::jsonSuccess(json);
     }
     
     // GET /api/admin/getRegistrationWindow
     static HTTPResponse getRegistrationWindow(const HTTPRequest& req, DatabaseManager& db) {
         SystemConfig config = db.getConfig();
         
-        map<string, string> response;
-        response["success"] = "true";
-        response["startTime"] = to_string(config.registrationStartTime);
-        response["endTime"] = to_string(config.registrationEndTime);
-        response["isOpen"] = config.isRegistrationOpen ? "true" : "false";
+        JsonWriter json;
+        json.beginObject()
+            .member("success", "true")
+            .key("startTime").quoted(config.registrationStartTime)
+            .key("endTime").quoted(config.registrationEndTime)
+            .member("isOpen", config.isRegistrationOpen ? "true" : "false")
+            .endObject();
         
-        HTTPResponse httpRes = HTTPServer::jsonSuccess(response);
+        HTTPResponse httpRes = HTTPServer::jsonSuccess(json);
         
-        // CRITICAL: Add cache-prevention headers to ensure all students see the same status
-        httpRes.headers["Cache-Control"] = "no-store, no-cache, must-revalidate, max-age=0";
-        httpRes.headers["Pragma"] = "no-cache";
-        httpRes.headers["Expires"] = "0";
+        // CRITICAL: a client may keep the status but must revalidate it (ETag)
+        // before every use, so all students see the same window
+        httpRes.headers["Cache-Control"] = "no-cache";
         
         return httpRes;
     }
     
     // GET /api/admin/viewAllStudents
+    // Optional paging: ?page=N (1-based) or ?after=<last studentID seen>,
+    // with ?pageSize=M (default 50); without either the full list is sent
     static HTTPResponse viewAllStudents(const HTTPRequest& req, DatabaseManager& db) {
-        vector<Student> students = db.getAllStudents();
-        
-        stringstream ss;
-        ss << "[";
-        for (size_t i = 0; i < students.size(); i++) {
-            if (i > 0) ss << ",";
-            ss << "{"
-               << "\"studentID\":\"" << students[i].studentID << "\","
-               << "\"name\":\"" << students[i].name << "\","
-               << "\"email\":\"" << students[i].email << "\","
-               << "\"semester\":" << students[i].currentSemester << ","
-               << "\"enrolledCourses\":" << JSONParser::stringifyArray(students[i].enrolledCourses)
-               << "}";
+        PageQuery query = parsePageQuery(req);
+        size_t total = 0;
+        vector<Student> students;
+        if (!query.paged) {
+            students = db.getAllStudents();
+        } else if (query.keyset) {
+            students = db.getStudentsAfter(query.after, query.pageSize, total);
+        } else {
+            students = db.getStudentsPage((query.page - 1) * query.pageSize, query.pageSize, total);
         }
-        ss << "]";
         
-        map<string, string> response;
-        response["success"] = "true";
-        response["students"] = ss.str();
+        JsonWriter json;
+        json.beginObject()
+            .member("success", "true")
+            .key("students").beginArray();
+        for (const auto& student : students) {
+            json.beginObject()
+                .member("studentID", student.studentID)
+                .member("name", student.name)
+                .member("email", student.email)
+                .member("semester", student.currentSemester)
+                .key("enrolledCourses").beginArray();
+            for (const auto& courseID : student.enrolledCourses) {
+                json.value(courseID);
+            }
+            json.endArray().endObject();
+        }
+        json.endArray();
+        if (query.paged) {
+            addPageInfo(json, query, total, students.empty() ? "" : students.back().studentID);
+        }
+        json.endObject();
         
-        return HTTPServer::jsonSuccess(response);
+        return HTTPServer::jsonSuccess(json);
     }
     
-    // GET /api/admin/viewAllTeachers
+    // GET /api/admin/viewAllTeachers (same paging parameters as viewAllStudents)
     static HTTPResponse viewAllTeachers(const HTTPRequest& req, DatabaseManager& db) {
-        vector<Teacher> teachers = db.getAllTeachers();
-        
-        stringstream ss;
-        ss << "[";
-        for (size_t i = 0; i < teachers.size(); i++) {
-            if (i > 0) ss << ",";
-            ss << "{"
-               << "\"teacherID\":\"" << teachers[i].teacherID << "\","
-               << "\"name\":\"" << teachers[i].name << "\","
-               << "\"email\":\"" << teachers[i].email << "\","
-               << "\"department\":\"" << teachers[i].department << "\","
-               << "\"assignedCourse\":\"" << teachers[i].assignedCourseID << "\""
-               << "}";
+        PageQuery query = parsePageQuery(req);
+        size_t total = 0;
+        vector<Teacher> teachers;
+        if (!query.paged) {
+            teachers = db.getAllTeachers();
+        } else if (query.keyset) {
+            teachers = db.getTeachersAfter(query.after, query.pageSize, total);
+        } else {
+            teachers = db.getTeachersPage((query.page - 1) * query.pageSize, query.pageSize, total);
         }
-        ss << "]";
         
-        map<string, string> response;
-        response["success"] = "true";
-        response["teachers"] = ss.str();
+        JsonWriter json;
+        json.beginObject()
+            .member("success", "true")
+            .key("teachers").beginArray();
+        for (const auto& teacher : teachers) {
+            json.beginObject()
+                .member("teacherID", teacher.teacherID)
+                .member("name", teacher.name)
+                .member("email", teacher.email)
+                .member("department", teacher.department)
+                .member("assignedCourse", teacher.assignedCourseID)
+                .endObject();
+        }
+        json.endArray();
+        if (query.paged) {
+            addPageInfo(json, query, total, teachers.empty() ? "" : teachers.back().teacherID);
+        }
+        json.endObject();
         
-        return HTTPServer::jsonSuccess(response);
+        return HTTPServer::jsonSuccess(json);
     }
     
     // POST /api/admin/addCourse
     static HTTPResponse addCourse(const HTTPRequest& req, DatabaseManager& db) {
-        auto data = JSONParser::parse(req.body);
+        JSONDocument data;
+        if (!data.parse(req.body)) {
+            return HTTPServer::jsonError("Invalid JSON: " + data.error());
+        }
         
         Course course;
-        course.courseID = JSONParser::getString(data, "courseID");
-        course.courseName = JSONParser::getString(data, "courseName");
-        course.semester = JSONParser::getInt(data, "semester");
-        course.teacherID = JSONParser::getString(data, "teacherID");
+        course.courseID = data.getString("courseID");
+        course.courseName = data.getString("courseName");
+        course.semester = data.getInt("semester");
+        course.teacherID = data.getString("teacherID");
         course.currentEnrollmentCount = 0;
         
         if (course.courseID.empty() || course.courseName.empty()) {
@@ -253,32 +308,30 @@ public:
             return HTTPServer::jsonError("Failed to add course");
         }
         
-        map<string, string> response;
-        response["success"] = "true";
-        response["message"] = "Course added successfully";
-        response["courseID"] = course.courseID;
+        JsonWriter json;
+        json.beginObject()
+            .member("success", "true")
+            .member("message", "Course added successfully")
+            .member("courseID", course.courseID)
+            .endObject();
         
-        return HTTPServer::jsonSuccess(response);
+        return HTTPServer::jsonSuccess(json);
     }
     
     // GET /api/admin/viewTimetable?semester=X
     static HTTPResponse viewTimetable(const HTTPRequest& req, DatabaseManager& db) {
-        // Extract semester from req.params
+        // Extract semester from the query string
         string semesterStr;
         
-        if (req.params.count("semester") > 0) {
-            semesterStr = req.params.at("semester");
+        if (req.hasParam("semester")) {
+            semesterStr = string(req.param("semester"));
         }
         
-        cout << "[AdminService] viewTimetable called" << endl;
-        cout << "[AdminService] Semester param: '" << semesterStr << "'" << endl;
-        cout << "[AdminService] All params:" << endl;
-        for (const auto& p : req.params) {
-            cout << "  " << p.first << " = " << p.second << endl;
-        }
+        LOG_DEBUG("AdminService") << "viewTimetable called";
+        LOG_DEBUG("AdminService") << "Semester param: '" << semesterStr << "'";
         
         if (semesterStr.empty()) {
-            cout << "[AdminService] ERROR: semester parameter is empty" << endl;
+            LOG_WARN("AdminService") << "semester parameter is empty";
             return HTTPServer::jsonError("Semester parameter required", 400);
         }
         
@@ -286,84 +339,123 @@ public:
         try {
             semester = stoi(semesterStr);
         } catch (const exception& e) {
-            cout << "[AdminService] ERROR: Failed to parse semester: " << e.what() << endl;
+            LOG_WARN("AdminService") << "Failed to parse semester: " << e.what();
             return HTTPServer::jsonError("Invalid semester parameter", 400);
         }
         
-        cout << "[AdminService] Parsed semester: " << semester << endl;
+        LOG_DEBUG("AdminService") << "Parsed semester: " << semester;
         
         // Get timetable for this semester
         Timetable timetable;
         bool found = db.getTimetable(semester, timetable);
         
-        cout << "[AdminService] getTimetable returned: " << (found ? "true" : "false") << endl;
+        LOG_DEBUG("AdminService") << "getTimetable returned: " << (found ? "true" : "false");
         
         if (!found) {
-            cout << "[AdminService] No timetable found for semester " << semester << endl;
+            LOG_DEBUG("AdminService") << "No timetable found for semester " << semester;
             return HTTPServer::jsonError("Timetable not found for semester " + semesterStr, 404);
         }
         
-        cout << "[AdminService] Found timetable with " << timetable.schedule.size() << " courses" << endl;
+        LOG_DEBUG("AdminService") << "Found timetable with " << timetable.schedule.size() << " courses";
         
         // Return ALL courses for admin (no filtering)
-        stringstream ss;
-        ss << "[";
+        JsonWriter json;
+        json.beginObject()
+            .member("success", "true")
+            .member("semester", semesterStr)
+            .key("timetable").beginArray();
         
         for (size_t i = 0; i < timetable.schedule.size(); i++) {
-            if (i > 0) ss << ",";
-            
             const auto& sc = timetable.schedule[i];
             
             // CRITICAL FIX: Get real-time enrollment count from Course object
             // The sc.studentIDs might be stale if students enrolled after timetable generation
             Course course;
-            int currentCount = 0;
+            size_t currentCount = 0;
             if (db.getCourse(sc.courseID, course)) {
                 currentCount = course.enrolledStudents.size();
             } else {
                 currentCount = sc.studentIDs.size(); // Fallback
             }
             
-            cout << "[AdminService] Serializing course " << (i+1) << "/" << timetable.schedule.size() 
-                 << ": " << sc.courseID << " with " << sc.slots.size() << " slots. Enrolled: " << currentCount << endl;
+            LOG_DEBUG("AdminService") << "Serializing course " << (i+1) << "/" << timetable.schedule.size() 
+                                      << ": " << sc.courseID << " with " << sc.slots.size() << " slots. Enrolled: " << currentCount;
             
-            ss << "{"
-               << "\"courseID\":\"" << sc.courseID << "\","
-               << "\"courseName\":\"" << sc.courseName << "\","
-               << "\"teacherName\":\"" << sc.teacherName << "\","
-               << "\"classroom\":" << sc.classroomID << ","
-               << "\"studentCount\":" << currentCount << ","
-               << "\"slots\":[";
+            json.beginObject()
+                .member("courseID", sc.courseID)
+                .member("courseName", sc.courseName)
+                .member("teacherName", sc.teacherName)
+                .member("classroom", sc.classroomID)
+                .member("studentCount", currentCount)
+                .key("slots").beginArray();
             
             // Serialize all slots
-            for (size_t j = 0; j < sc.slots.size(); j++) {
-                if (j > 0) ss << ",";
-                const auto& slot = sc.slots[j];
-                ss << "{"
-                   << "\"day\":" << slot.day << ","
-                   << "\"hour\":" << slot.hour << ","
-                   << "\"dayName\":\"" << slot.getDayName() << "\","
-                   << "\"time\":\"" << slot.getTimeString() << "\""
-                   << "}";
+            for (const auto& slot : sc.slots) {
+                json.beginObject()
+                    .member("day", slot.day)
+                    .member("hour", slot.hour)
+                    .member("dayName", slot.getDayName())
+                    .member("time", slot.getTimeString())
+                    .endObject();
             }
             
-            ss << "]}";
+            json.endArray().endObject();
         }
         
-        ss << "]";
+        json.endArray().endObject();
         
-        string timetableJson = ss.str();
-        cout << "[AdminService] Generated JSON length: " << timetableJson.length() << " bytes" << endl;
-        cout << "[AdminService] JSON preview: " << timetableJson.substr(0, 200) << "..." << endl;
+        LOG_DEBUG("AdminService") << "Generated JSON length: " << json.size() << " bytes";
+        LOG_DEBUG("AdminService") << "Returning success response";
         
-        map<string, string> response;
-        response["success"] = "true";
-        response["semester"] = semesterStr;
-        response["timetable"] = timetableJson;
-        
-        cout << "[AdminService] Returning success response" << endl;
-        
-        return HTTPServer::jsonSuccess(response);
+        return HTTPServer::jsonSuccess(json);
+    }
+
+private:
+    static constexpr size_t DEFAULT_PAGE_SIZE = 50;
+    static constexpr size_t MAX_PAGE_SIZE = 1000;
+    
+    struct PageQuery {
+        bool paged = false;
+        bool keyset = false;      // ?after= given: continue after that ID
+        size_t page = 1;
+        size_t pageSize = DEFAULT_PAGE_SIZE;
+        string after;
+    };
+    
+    // Positive integer query parameter, or fallback if missing/invalid
+    static size_t positiveParam(const HTTPRequest& req, string_view name, size_t fallback) {
+        string_view text = req.param(name);
+        size_t value = 0;
+        auto result = from_chars(text.data(), text.data() + text.size(), value);
+        if (text.empty() || result.ec != errc() || result.ptr != text.data() + text.size() || value == 0) {
+            return fallback;
+        }
+        return value;
+    }
+    
+    static PageQuery parsePageQuery(const HTTPRequest& req) {
+        PageQuery query;
+        query.keyset = req.hasParam("after");
+        query.paged = query.keyset || req.hasParam("page") || req.hasParam("pageSize");
+        if (query.keyset) {
+            query.after = string(req.param("after"));
+        }
+        query.page = min(positiveParam(req, "page", 1), SIZE_MAX / MAX_PAGE_SIZE);  // Offset can't overflow
+        query.pageSize = min(positiveParam(req, "pageSize", DEFAULT_PAGE_SIZE), MAX_PAGE_SIZE);
+        return query;
+    }
+    
+    // total/pages always; page for page-number queries; nextAfter (the last
+    // ID returned) for continuing with ?after=
+    static void addPageInfo(JsonWriter& json, const PageQuery& query,
+                            size_t total, const string& lastID) {
+        json.key("total").quoted(total)
+            .key("pageSize").quoted(query.pageSize)
+            .key("pages").quoted((total + query.pageSize - 1) / query.pageSize);
+        if (!query.keyset) {
+            json.key("page").quoted(query.page);
+        }
+        json.member("nextAfter", lastID);
     }
 };
 
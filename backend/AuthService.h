@@ -12,9 +12,12 @@ class AuthService {
 public:
     // Login endpoint: POST /api/login
     static HTTPResponse login(const HTTPRequest& req, DatabaseManager& db) {
-        auto data = JSONParser::parse(req.body);
-        string email = JSONParser::getString(data, "email");
-        string password = JSONParser::getString(data, "password");
+        JSONDocument data;
+        if (!data.parse(req.body)) {
+            return HTTPServer::jsonError("Invalid JSON: " + data.error());
+        }
+        string email = data.getString("email");
+        string password = data.getString("password");
         
         if (email.empty() || password.empty()) {
             return HTTPServer::jsonError("Email and password required");
@@ -30,14 +33,16 @@ public:
         string token = generateToken(user.userID);
         
         // Return success with token and role
-        map<string, string> response;
-        response["success"] = "true";
-        response["token"] = token;
-        response["role"] = roleToString(user.role);
-        response["userID"] = user.userID;
-        response["name"] = user.name;
+        JsonWriter json;
+        json.beginObject()
+            .member("success", "true")
+            .member("token", token)
+            .member("role", roleToString(user.role))
+            .member("userID", user.userID)
+            .member("name", user.name)
+            .endObject();
         
-        return HTTPServer::jsonSuccess(response);
+        return HTTPServer::jsonSuccess(json);
     }
     
     // Helper: Generate session token
@@ -12,125 +12,110 @@
 
 #include "../external/httplib.h"
 #include "../database/DatabaseManager.h"
+#include "../database/Logger.h"
+#include "../database/SeededHash.h"
 #include "utils/JSONParser.h"
+#include "utils/JSONDocument.h"
+#include "utils/JsonWriter.h"
+#include "utils/Router.h"
+#include "utils/WorkerPool.h"
+#include "utils/EventLoopServer.h"
+#include "utils/ResponseCache.h"
 #include <functional>
 #include <iostream>
-#include <sstream>
-#include <iomanip>
+#include <memory>
+#include <string_view>
+#include <cctype>
 
 using namespace std;
 using namespace httplib;
 
-// Helper function to URL decode a string
-inline string urlDecode(const string& str) {
-    string result;
-    for (size_t i = 0; i < str.length(); i++) {
-        if (str[i] == '+') {
-            result += ' ';
-        } else if (str[i] == '%' && i + 2 < str.length()) {
-            int value;
-            stringstream ss;
-            ss << hex << str.substr(i + 1, 2);
-            ss >> value;
-            result += static_cast<char>(value);
-            i += 2;
-        } else {
-            result += str[i];
-        }
+/**
+ * HTTPRequest - Read-only view of an httplib Request for the services
+ *
+ * Nothing is copied when it is built: method, path and body view httplib's
+ * strings, query parameters are looked up in the Request's already-decoded
+ * params, and headers are found with a case-insensitive scan of httplib's
+ * headers. Path parameters from the router (":name" segments) take
+ * precedence over query parameters of the same name. The request is only
+ * valid for the duration of the handler call.
+ */
+class HTTPRequest {
+public:
+    using PathParams = vector<pair<string_view, string_view>>;  // Same as Router::Params
+
+    string_view method;  // GET, POST
+    string_view path;    // Decoded path, no query string
+    string_view body;
+
+    explicit HTTPRequest(const Request& req, PathParams pathParams = {})
+        : method(req.method), path(req.path), body(req.body),
+          raw(req), pathParams(move(pathParams)) {}
+
+    // Path or query parameter; fallback if the request has none by that name
+    string_view param(string_view name, string_view fallback = string_view()) const {
+        string_view value;
+        return findParam(name, value) ? value : fallback;
     }
-    return result;
-}
 
-// Helper function to parse query string
-inline map<string, string> parseQueryString(const string& query) {
-    map<string, string> params;
-    
-    if (query.empty()) return params;
-    
-    stringstream ss(query);
-    string pair;
-    
-    while (getline(ss, pair, '&')) {
-        size_t pos = pair.find('=');
-        if (pos != string::npos) {
-            string key = urlDecode(pair.substr(0, pos));
-            string value = urlDecode(pair.substr(pos + 1));
-            params[key] = value;
-        } else {
-            // Handle parameters without values
-            string key = urlDecode(pair);
-            if (!key.empty()) {
-                params[key] = "";
+    bool hasParam(string_view name) const {
+        string_view value;
+        return findParam(name, value);
+    }
+
+    // Header value (name is case-insensitive); fallback if absent
+    string_view header(string_view name, string_view fallback = string_view()) const {
+        for (const auto& h : raw.headers) {
+            if (equalsIgnoreCase(h.first, name)) {
+                return h.second;
             }
         }
+        return fallback;
     }
-    
-    return params;
-}
 
-// HTTP Request/Response structures for compatibility
-struct HTTPRequest {
-    string method;  // GET, POST
-    string path;
-    string body;
-    map<string, string> headers;
-    map<string, string> params;  // Query parameters
-    
-    HTTPRequest(const Request& req) {
-        method = req.method;
-        path = req.path;
-        body = req.body;
-        
-        // Copy headers
-        for (const auto& header : req.headers) {
-            headers[header.first] = header.second;
+    // Debug-level dump of the request line, parameters and headers
+    void log() const {
+        LOG_DEBUG("HTTPRequest") << method << " " << raw.target;
+        for (const auto& p : pathParams) {
+            LOG_DEBUG("HTTPRequest") << "  path  [" << p.first << "] = [" << p.second << "]";
         }
-        
-        // DEBUGGING: Print all available request info
-        cout << "[HTTPRequest] ===================" << endl;
-        cout << "[HTTPRequest] Method: " << method << endl;
-        cout << "[HTTPRequest] Path: " << path << endl;
-        
-        // Check if path contains query string (it shouldn't, but let's verify)
-        if (path.find('?') != string::npos) {
-            cout << "[HTTPRequest] WARNING: Path contains '?' character!" << endl;
+        for (const auto& p : raw.params) {
+            LOG_DEBUG("HTTPRequest") << "  query [" << p.first << "] = [" << p.second << "]";
         }
-        
-        // Try to access target
-        string target = "";
-        try {
-            target = req.target;
-            cout << "[HTTPRequest] Target: " << target << endl;
-        } catch (...) {
-            cout << "[HTTPRequest] ERROR: Could not access req.target" << endl;
+        for (const auto& h : raw.headers) {
+            LOG_DEBUG("HTTPRequest") << "  header " << h.first << ": " << h.second;
         }
-        
-        // CRITICAL FIX: Parse query string from BOTH target AND path
-        // Some versions of cpp-httplib put params in path, others in target
-        string querySource = target;
-        size_t queryPos = querySource.find('?');
-        
-        if (queryPos == string::npos) {
-            // Try path instead
-            querySource = path;
-            queryPos = querySource.find('?');
-            cout << "[HTTPRequest] No '?' in target, trying path" << endl;
+    }
+
+private:
+    const Request& raw;
+    PathParams pathParams;
+
+    static bool equalsIgnoreCase(string_view a, string_view b) {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); i++) {
+            if (tolower(static_cast<unsigned char>(a[i])) != tolower(static_cast<unsigned char>(b[i]))) {
+                return false;
+            }
         }
-        
-        if (queryPos != string::npos) {
-            string queryString = querySource.substr(queryPos + 1);
-            params = parseQueryString(queryString);
-            
-            cout << "[HTTPRequest] Query string: '" << queryString << "'" << endl;
-            cout << "[HTTPRequest] Parsed " << params.size() << " parameters:" << endl;
-            for (const auto& p : params) {
-                cout << "  [" << p.first << "] = [" << p.second << "]" << endl;
+        return true;
+    }
+
+    bool findParam(string_view name, string_view& value) const {
+        for (const auto& p : pathParams) {
+            if (p.first == name) {
+                value = p.second;
+                return true;
             }
-        } else {
-            cout << "[HTTPRequest] No query string found in target or path" << endl;
         }
-        
-        cout << "[HTTPRequest] ===================" << endl;
+        // A handful of entries: a scan needs no key string, unlike multimap::find
+        for (const auto& p : raw.params) {
+            if (p.first == name) {
+                value = p.second;
+                return true;
+            }
+        }
+        return false;
     }
 };
 
@@ -139,125 +124,367 @@ struct HTTPResponse {
     string body;
     map<string, string> headers;
     
-    HTTPResponse(int code = 200, const string& content = "") 
-        : statusCode(code), body(content) {}
+    HTTPResponse(int code = 200, string content = "") 
+        : statusCode(code), body(move(content)) {}
+};
+
+/**
+ * ServerOptions - Connection handling for HTTPServer
+ *
+ * httplib serves one connection per worker thread for its whole keep-alive
+ * lifetime, so workerThreads bounds concurrent connections and the
+ * keep-alive limits decide how long an idle client can hold a worker.
+ * Connections beyond maxQueuedConnections are answered with 503 and
+ * Retry-After instead of waiting (see WorkerPool).
+ *
+ * Transport::EventLoop (Linux) replaces that with one epoll thread owning
+ * every socket (see EventLoopServer): workers are only busy while a request
+ * runs, maxQueuedConnections bounds queued requests, and idle keep-alive
+ * clients are held up to eventLoopIdleTimeoutSec at no thread cost.
+ *
+ * responseCacheBytes caps the cache of GET responses for routes registered
+ * with the stores they read (see HTTPServer::get); 0 turns it off.
+ */
+struct ServerOptions {
+    enum class Transport { Threaded, EventLoop };
+
+    Transport transport = Transport::Threaded;
+    size_t workerThreads = CPPHTTPLIB_THREAD_POOL_COUNT;  // max(8, cores - 1)
+    size_t maxQueuedConnections = 256;   // Waiting for a worker; 0 = unbounded
+    int retryAfterSeconds = 2;           // Sent with 503 responses
+    size_t keepAliveMaxRequests = 100;   // Requests per connection before it is closed
+    time_t keepAliveTimeoutSec = 2;      // Idle time before a keep-alive connection is closed
+    time_t readTimeoutSec = 5;
+    time_t writeTimeoutSec = 5;
+    bool tcpNoDelay = true;              // Small JSON responses: don't wait on Nagle
+    
+    // EventLoop transport only
+    time_t eventLoopIdleTimeoutSec = 60;
+    size_t maxConnections = 50000;       // Open sockets; further clients are closed on accept
+    size_t maxRequestBodyBytes = 1024 * 1024;
+    
+    size_t responseCacheBytes = 32 * 1024 * 1024;
+};
+
+// Route handler signature shared by all services
+using RouteHandler = function<HTTPResponse(const HTTPRequest&, DatabaseManager&)>;
+
+// A registered handler and the stores its responses are built from (none:
+// never cached)
+struct Route {
+    RouteHandler handler;
+    vector<Store> readsFrom;
 };
 
+// Runs before routing; returns true if it answered the request itself
+using RequestInterceptor = function<bool(const Request&, Response&)>;
+
 class HTTPServer {
 private:
     Server svr;
     DatabaseManager& db;
     int port;
+    ServerOptions options;
+    Router<Route> router;  // All GET/POST routes; httplib only sees the catch-alls
+    RequestInterceptor interceptor;
+    ResponseCache responseCache;
+#ifdef UMS_HAS_EPOLL
+    unique_ptr<EventLoopServer> eventLoop;
+#endif
     
     // CORS middleware
     void enableCORS(Response& res) {
         res.set_header("Access-Control-Allow-Origin", "*");
         res.set_header("Access-Control-Allow-Methods", "GET, POST, PUT, DELETE, OPTIONS");
-        res.set_header("Access-Control-Allow-Headers", "Content-Type, Authorization");
+        res.set_header("Access-Control-Allow-Headers", "Content-Type, Authorization, If-None-Match");
+        res.set_header("Access-Control-Expose-Headers", "ETag");
     }
     
+    // Strong validator for a GET body: a hash of its bytes with a fixed seed,
+    // so every process and restart gives unchanged data the same tag
+    static string etagFor(string_view body) {
+        static const char digits[] = "0123456789abcdef";
+        uint64_t h = wyhash_detail::hash(body.data(), body.size(), 0);
+        string tag(18, '"');
+        for (int i = 16; i >= 1; i--, h >>= 4) {
+            tag[i] = digits[h & 0xf];
+        }
+        return tag;
+    }
+    
+    // If-None-Match names this tag or "*" (weak comparison, RFC 9110 13.1.2)
+    static bool clientHasETag(const Request& req, string_view etag) {
+        auto header = req.headers.find("If-None-Match");
+        if (header == req.headers.end()) {
+            return false;
+        }
+        string_view list = header->second;
+        while (!list.empty()) {
+            size_t comma = list.find(',');
+            string_view candidate = list.substr(0, comma);
+            list = comma == string_view::npos ? string_view() : list.substr(comma + 1);
+            while (!candidate.empty() && (candidate.front() == ' ' || candidate.front() == '\t')) {
+                candidate.remove_prefix(1);
+            }
+            while (!candidate.empty() && (candidate.back() == ' ' || candidate.back() == '\t')) {
+                candidate.remove_suffix(1);
+            }
+            if (candidate.substr(0, 2) == "W/") {
+                candidate.remove_prefix(2);
+            }
+            if (candidate == etag || candidate == "*") {
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    // Tag a 200 GET response; true if the client already holds that body,
+    // which then becomes a 304 sent without it
+    static bool notModified(const Request& req, Response& res, const string& etag) {
+        res.set_header("ETag", etag);
+        if (!clientHasETag(req, etag)) {
+            return false;
+        }
+        res.status = 304;
+        return true;
+    }
+    
+    // On a WorkerPool shed thread: answer 503 without touching the database
+    bool shedLoad(Response& res) {
+        if (!WorkerPool::shedding()) {
+            return false;
+        }
+        HTTPResponse busy = jsonError("Server busy, retry later", 503);
+        res.status = busy.statusCode;
+        res.set_header("Retry-After", to_string(options.retryAfterSeconds));
+        res.set_content(move(busy.body), "application/json");
+        return true;
+    }
+    
+    // One lookup in the routing table, then the handler; ":name" path
+    // segments are added to the request's params
+    void dispatch(const Request& req, Response& res) {
+        enableCORS(res);
+        if (shedLoad(res)) {
+            return;
+        }
+        if (interceptor && interceptor(req, res)) {
+            return;
+        }
+        
+        // HEAD is answered by the GET route; the transport drops the body
+        string_view method = req.method == "HEAD" ? string_view("GET") : string_view(req.method);
+        Router<Route>::Params pathParams;
+        const Route* route = router.find(method, req.path, pathParams);
+        if (route == nullptr) {
+            HTTPResponse notFound = jsonError("No route for " + req.method + " " + req.path, 404);
+            res.status = notFound.statusCode;
+            res.set_content(move(notFound.body), "application/json");
+            return;
+        }
+        
+        // Generations first: a write racing with the handler makes the entry stale
+        bool cacheable = responseCache.enabled() && !route->readsFrom.empty();
+        vector<uint64_t> generations;
+        string cacheKey;
+        if (cacheable) {
+            for (Store store : route->readsFrom) {
+                generations.push_back(db.generation(store));
+            }
+            cacheKey = ResponseCache::key(req.path, req.params);
+            ResponseCache::Entry cached;
+            if (responseCache.lookup(cacheKey, generations, cached)) {
+                res.status = cached.status;
+                for (const auto& header : cached.headers) {
+                    res.set_header(header.first, header.second);
+                }
+                if (!notModified(req, res, cached.etag)) {
+                    res.set_content(*cached.body, "application/json");
+                }
+                return;
+            }
+        }
+        
+        try {
+            HTTPRequest httpReq(req, move(pathParams));
+            if (AsyncLogger::enabled(LogLevel::Debug)) {
+                httpReq.log();
+            }
+            HTTPResponse httpRes = route->handler(httpReq, db);
+            
+            res.status = httpRes.statusCode;
+            for (const auto& header : httpRes.headers) {
+                res.set_header(header.first, header.second);
+            }
+            if (cacheable && httpRes.statusCode == 200) {
+                ResponseCache::Entry entry;
+                entry.status = httpRes.statusCode;
+                entry.headers = move(httpRes.headers);
+                entry.body = make_shared<const string>(move(httpRes.body));
+                entry.etag = etagFor(*entry.body);
+                if (!notModified(req, res, entry.etag)) {
+                    res.set_content(*entry.body, "application/json");
+                }
+                responseCache.store(cacheKey, move(generations), move(entry));
+            } else if (req.method == "GET" && httpRes.statusCode == 200) {
+                if (!notModified(req, res, etagFor(httpRes.body))) {
+                    res.set_content(move(httpRes.body), "application/json");
+                }
+            } else {
+                res.set_content(move(httpRes.body), "application/json");
+            }
+        } catch (const exception& e) {
+            LOG_ERROR("HTTPServer") << req.method << " " << req.path << " failed: " << e.what();
+            HTTPResponse failure = jsonError(e.what(), 500);  // Escaped: messages may hold quotes
+            res.status = failure.statusCode;
+            res.set_content(move(failure.body), "application/json");
+        }
+    }
+    
+#ifdef UMS_HAS_EPOLL
+    // Built by the constructor so stop() never races with start()
+    void createEventLoop() {
+        EventLoopServer::Config config;
+        config.workerThreads = options.workerThreads;
+        config.maxQueuedRequests = options.maxQueuedConnections;
+        config.maxConnections = options.maxConnections;
+        config.idleTimeoutSec = options.eventLoopIdleTimeoutSec;
+        config.keepAliveMaxRequests = options.keepAliveMaxRequests;
+        config.maxBodyBytes = options.maxRequestBodyBytes;
+        config.tcpNoDelay = options.tcpNoDelay;
+        eventLoop = make_unique<EventLoopServer>(config, [this](const Request& req, Response& res) {
+            handle(req, res);
+        });
+    }
+    
+    void startEventLoop() {
+        LOG_INFO("HTTPServer") << "Event loop transport, " << options.workerThreads << " worker threads, up to "
+                               << options.maxConnections << " connections; press Ctrl+C to stop";
+        if (!eventLoop->listen("0.0.0.0", port)) {
+            LOG_ERROR("HTTPServer") << "Failed to start server on port " << port;
+            throw runtime_error("Failed to start HTTP server");
+        }
+    }
+#endif
+    
 public:
-    HTTPServer(int p, DatabaseManager& database) : port(p), db(database) {
+    HTTPServer(int p, DatabaseManager& database, const ServerOptions& opts = ServerOptions())
+        : db(database), port(p), options(opts), responseCache(opts.responseCacheBytes) {
+        svr.new_task_queue = [this] {
+            return new WorkerPool(options.workerThreads, options.maxQueuedConnections);
+        };
+        svr.set_keep_alive_max_count(options.keepAliveMaxRequests);
+        svr.set_keep_alive_timeout(options.keepAliveTimeoutSec);
+        svr.set_read_timeout(options.readTimeoutSec, 0);
+        svr.set_write_timeout(options.writeTimeoutSec, 0);
+        svr.set_tcp_nodelay(options.tcpNoDelay);
+        
         // Handle OPTIONS requests for CORS preflight
         svr.Options(".*", [this](const Request& req, Response& res) {
             enableCORS(res);
             res.set_content("", "text/plain");
         });
+        
+        // One catch-all per method: httplib runs a single trivial match and
+        // the router picks the handler
+        svr.Get(".*", [this](const Request& req, Response& res) { dispatch(req, res); });
+        svr.Post(".*", [this](const Request& req, Response& res) { dispatch(req, res); });
+        
+#ifdef UMS_HAS_EPOLL
+        if (options.transport == ServerOptions::Transport::EventLoop) {
+            createEventLoop();
+        }
+#endif
     }
     
-    // Register GET endpoint
-    void get(const string& path, function<HTTPResponse(const HTTPRequest&, DatabaseManager&)> handler) {
-        svr.Get(path, [this, handler](const Request& req, Response& res) {
-            enableCORS(res);
-            try {
-                HTTPRequest httpReq(req);
-                HTTPResponse httpRes = handler(httpReq, db);
-                
-                res.status = httpRes.statusCode;
-                for (const auto& header : httpRes.headers) {
-                    res.set_header(header.first, header.second);
-                }
-                res.set_content(httpRes.body, "application/json");
-            } catch (const exception& e) {
-                res.status = 500;
-                res.set_content("{\"error\":\"" + string(e.what()) + "\"}", "application/json");
-            }
-        });
+    // Register GET endpoint (literal path, or ":name" segments). With
+    // readsFrom, its 200 responses are cached until one of those stores is
+    // written; list every store the handler reads
+    void get(const string& path, RouteHandler handler, vector<Store> readsFrom = {}) {
+        router.add("GET", path, Route{move(handler), move(readsFrom)});
     }
     
-    // Register POST endpoint
-    void post(const string& path, function<HTTPResponse(const HTTPRequest&, DatabaseManager&)> handler) {
-        svr.Post(path, [this, handler](const Request& req, Response& res) {
+    // Register POST endpoint (literal path, or ":name" segments)
+    void post(const string& path, RouteHandler handler) {
+        router.add("POST", path, Route{move(handler), {}});
+    }
+    
+    // Number of registered routes
+    size_t routeCount() const { return router.size(); }
+    
+    // Hits, misses and size of the GET response cache
+    ResponseCache::Stats cacheStats() const { return responseCache.stats(); }
+    
+    // Hook in front of the router (e.g. ServerCluster forwarding writes)
+    void setInterceptor(RequestInterceptor hook) {
+        interceptor = move(hook);
+    }
+    
+    // Serve one request outside httplib's method table (the event loop
+    // transport, requests forwarded from another process): CORS preflight,
+    // then the same dispatch
+    void handle(const Request& req, Response& res) {
+        if (req.method == "OPTIONS") {
             enableCORS(res);
-            try {
-                HTTPRequest httpReq(req);
-                HTTPResponse httpRes = handler(httpReq, db);
-                
-                res.status = httpRes.statusCode;
-                for (const auto& header : httpRes.headers) {
-                    res.set_header(header.first, header.second);
-                }
-                res.set_content(httpRes.body, "application/json");
-            } catch (const exception& e) {
-                res.status = 500;
-                res.set_content("{\"error\":\"" + string(e.what()) + "\"}", "application/json");
-            }
-        });
+            res.set_content("", "text/plain");
+            return;
+        }
+        dispatch(req, res);
     }
     
     // Start server (blocking)
     void start() {
-        cout << "\n[Server] Starting HTTP server on port " << port << "..." << endl;
-        cout << "[Server] Press Ctrl+C to stop" << endl << endl;
+        LOG_INFO("HTTPServer") << "Starting HTTP server on port " << port;
+        if (options.transport == ServerOptions::Transport::EventLoop) {
+#ifdef UMS_HAS_EPOLL
+            startEventLoop();
+            return;
+#else
+            LOG_WARN("HTTPServer") << "Event loop transport needs epoll; using worker threads";
+#endif
+        }
+        LOG_INFO("HTTPServer") << options.workerThreads << " worker threads, up to "
+                               << options.maxQueuedConnections << " queued connections; press Ctrl+C to stop";
         
         if (!svr.listen("0.0.0.0", port)) {
-            cerr << "[ERROR] Failed to start server on port " << port << endl;
+            LOG_ERROR("HTTPServer") << "Failed to start server on port " << port;
             throw runtime_error("Failed to start HTTP server");
         }
     }
     
     // Stop server
     void stop() {
+#ifdef UMS_HAS_EPOLL
+        if (eventLoop) {
+            eventLoop->stop();
+        }
+#endif
         svr.stop();
-        cout << "[Server] Server stopped" << endl;
+        if (responseCache.enabled()) {
+            ResponseCache::Stats stats = responseCache.stats();
+            LOG_INFO("HTTPServer") << "Response cache: " << stats.hits << " hits, " << stats.misses
+                                   << " misses (" << stats.stale << " stale), " << stats.evictions
+                                   << " evictions, " << stats.entries << " entries in " << stats.bytes << " bytes";
+        }
+        LOG_INFO("HTTPServer") << "Server stopped";
     }
     
-    // Helper: Create JSON success response
-    static HTTPResponse jsonSuccess(const map<string, string>& data) {
-        HTTPResponse response;
-        response.statusCode = 200;
-        string json = "{";
-        bool first = true;
-        for (const auto& pair : data) {
-            if (!first) json += ",";
-            json += "\"" + pair.first + "\":";
-            
-            // Check if value is already JSON (array or object) - use it raw
-            if (!pair.second.empty() && (pair.second[0] == '[' || pair.second[0] == '{')) {
-                json += pair.second;
-            } else {
-                // String value - quote and escape it
-                json += "\"";
-                for (char c : pair.second) {
-                    if (c == '"') json += "\\\"";
-                    else if (c == '\\') json += "\\\\";
-                    else json += c;
-                }
-                json += "\"";
-            }
-            first = false;
-        }
-        json += "}";
-        response.body = json;
-        return response;
+    // Helper: Create JSON success response from a finished writer (the
+    // body is copied once out of the writer's buffer)
+    static HTTPResponse jsonSuccess(const JsonWriter& json, int statusCode = 200) {
+        return HTTPResponse(statusCode, json.str());
     }
     
     // Helper: Create JSON error response
     static HTTPResponse jsonError(const string& message, int statusCode = 400) {
-        HTTPResponse response;
-        response.statusCode = statusCode;
-        response.body = "{\"success\":\"false\",\"error\":\"" + message + "\"}";
-        return response;
+        string body;  // Not the thread buffer: a handler may still hold a writer
+        JsonWriter json(body);
+        json.beginObject()
+            .member("success", "false")
+            .member("error", message)
+            .endObject();
+        return HTTPResponse(statusCode, move(body));
     }
 };
 
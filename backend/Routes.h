@@ -0,0 +1,47 @@
+#ifndef ROUTES_H
+#define ROUTES_H
+
+#include "HTTPServer.h"
+#include "AuthService.h"
+#include "AdminService.h"
+#include "StudentService.h"
+#include "TeacherService.h"
+#include "TimetableGenerator.h"
+
+using namespace std;
+
+// Every API route of the server. GET routes list the stores their handler
+// reads, which makes their responses cacheable (see HTTPServer::get); a
+// store missing from a list serves stale data after writes to it.
+inline void registerRoutes(HTTPServer& server) {
+    // ========== Authentication Routes ==========
+    server.post("/api/login", AuthService::login);
+    
+    // ========== Admin Routes ==========
+    server.post("/api/admin/addStudent", AdminService::addStudent);
+    server.post("/api/admin/removeStudent", AdminService::removeStudent);
+    server.post("/api/admin/addTeacher", AdminService::addTeacher);
+    server.post("/api/admin/removeTeacher", AdminService::removeTeacher);
+    server.post("/api/admin/addCourse", AdminService::addCourse);
+    server.post("/api/admin/setRegistrationWindow", AdminService::setRegistrationWindow);
+    server.get("/api/admin/getRegistrationWindow", AdminService::getRegistrationWindow);
+    server.get("/api/admin/viewAllStudents", AdminService::viewAllStudents, {Store::STUDENTS});
+    server.get("/api/admin/viewAllTeachers", AdminService::viewAllTeachers, {Store::TEACHERS});
+    server.get("/api/admin/viewTimetable", AdminService::viewTimetable,
+               {Store::TIMETABLES, Store::COURSES});  // Live studentCount per course
+    server.post("/api/admin/generateTimetable", TimetableGenerator::generateTimetableAPI);
+    
+    // ========== Student Routes ==========
+    server.post("/api/student/enrollCourse", StudentService::enrollCourse);
+    server.post("/api/student/dropCourse", StudentService::dropCourse);
+    server.get("/api/student/viewCourses", StudentService::viewCourses, {Store::COURSES, Store::TEACHERS});
+    // Not cached: also depends on the clock (is the registration window open)
+    server.get("/api/student/viewTimetable", StudentService::viewTimetable);
+    server.get("/api/student/mydata", StudentService::getMyData);
+    // ========== Teacher Routes ==========
+    server.get("/api/teacher/viewStudents", TeacherService::viewStudents);
+    server.get("/api/teacher/viewTimetable", TeacherService::viewTimetable,
+               {Store::TEACHERS, Store::COURSES, Store::TIMETABLES});
+}
+
+#endif // ROUTES_H
@@ -0,0 +1,349 @@
+#ifndef SERVER_CLUSTER_H
+#define SERVER_CLUSTER_H
+
+#ifdef __linux__
+#define UMS_HAS_CLUSTER 1
+
+#include "HTTPServer.h"
+#include "../database/SharedSnapshot.h"
+#include <sys/prctl.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <signal.h>
+#include <strings.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+/**
+ * ServerCluster - One writer process and N worker processes sharing a port
+ *
+ * run() keeps a small single-threaded supervisor that forks:
+ *  - the writer, the only process that opens the real database. It serves
+ *    the write requests workers forward over a Unix socket
+ *    (<dataDir>/writer.sock) and publishes a SharedSnapshot after each.
+ *  - N workers, each with its own listening socket on the public port
+ *    (SO_REUSEPORT: the kernel spreads connections across them). GETs and
+ *    HEADs are served from a private replica DatabaseManager kept current
+ *    from the snapshot; POSTs are forwarded to the writer.
+ *
+ * Workers share no lock, so read-heavy endpoints scale with cores instead
+ * of queueing on one dbMutex. A crashed worker loses only the connections
+ * it held; the supervisor forks a replacement (for the writer too, while
+ * workers answer writes with 503 + Retry-After). SIGINT/SIGTERM stop
+ * every process cleanly.
+ */
+class ServerCluster {
+public:
+    // Registers the routes on a process's HTTPServer
+    using RouteSetup = function<void(HTTPServer&)>;
+
+    ServerCluster(int port, const string& dataDir, size_t workers,
+                  const ServerOptions& options = ServerOptions(), const string& logFile = "-")
+        : port(port), dataDir(dataDir), workerCount(max<size_t>(workers, 1)),
+          options(options), logFile(logFile) {}
+
+    // Fork the processes and supervise them until SIGINT/SIGTERM; returns
+    // the exit code for main()
+    int run(const RouteSetup& setup);
+
+private:
+    static constexpr int WRITER = -1;
+
+    struct Child {
+        pid_t pid = -1;
+        chrono::steady_clock::time_point started;
+    };
+
+    int port;
+    string dataDir;
+    size_t workerCount;
+    ServerOptions options;
+    string logFile;
+    Child writer;
+    vector<Child> workers;
+
+    string socketPath() const { return dataDir + "/writer.sock"; }
+
+    Child spawn(int role, const RouteSetup& setup);
+    int runWriter(const RouteSetup& setup);
+    int runWorker(size_t index, const RouteSetup& setup);
+    void forwardToWriter(const Request& req, Response& res);
+    void startLog(const string& process);
+
+    static bool isHopByHop(const string& name) {
+        static const char* const names[] = {
+            "Host", "Connection", "Keep-Alive", "Content-Length", "Transfer-Encoding",
+            "REMOTE_ADDR", "REMOTE_PORT", "LOCAL_ADDR", "LOCAL_PORT"  // Added by httplib
+        };
+        for (const char* n : names) {
+            if (strcasecmp(name.c_str(), n) == 0) return true;
+        }
+        return false;
+    }
+
+    /**
+     * Stops a process's server on SIGINT/SIGTERM. The signals stay blocked
+     * in every thread (the mask is inherited from the supervisor) and are
+     * taken here with sigtimedwait, so no handler runs in a random thread.
+     */
+    class SignalStop {
+    public:
+        explicit SignalStop(function<void()> stop) : waiter([this, stop]() {
+            sigset_t set;
+            sigemptyset(&set);
+            sigaddset(&set, SIGINT);
+            sigaddset(&set, SIGTERM);
+            timespec tick{0, 100 * 1000 * 1000};
+            while (!finished.load()) {
+                if (sigtimedwait(&set, nullptr, &tick) > 0) {
+                    requested.store(true);
+                    stop();
+                    return;
+                }
+            }
+        }) {}
+
+        ~SignalStop() {
+            finished.store(true);
+            waiter.join();
+        }
+
+        bool stopRequested() const { return requested.load(); }
+
+    private:
+        atomic<bool> finished{false};
+        atomic<bool> requested{false};
+        thread waiter;  // Last: starts once the flags exist
+    };
+};
+
+// ==================== Implementation ====================
+
+inline int ServerCluster::run(const RouteSetup& setup) {
+    // Before any thread exists: every child inherits the blocked mask
+    sigset_t set;
+    sigemptyset(&set);
+    sigaddset(&set, SIGINT);
+    sigaddset(&set, SIGTERM);
+    sigaddset(&set, SIGCHLD);
+    sigprocmask(SIG_BLOCK, &set, nullptr);
+
+    SharedSnapshot(dataDir).reset();  // Workers wait for this writer's first snapshot
+    cout << "[Cluster] Writer + " << workerCount << " worker processes on port " << port << endl;
+
+    writer = spawn(WRITER, setup);
+    workers.resize(workerCount);
+    for (size_t i = 0; i < workerCount; i++) {
+        workers[i] = spawn(static_cast<int>(i), setup);
+    }
+
+    auto alive = [this]() {
+        size_t n = writer.pid > 0 ? 1 : 0;
+        for (const Child& child : workers) {
+            if (child.pid > 0) n++;
+        }
+        return n;
+    };
+
+    bool stopping = false;
+    while (!stopping || alive() > 0) {
+        int sig = 0;
+        sigwait(&set, &sig);
+        if (sig != SIGCHLD) {
+            if (!stopping) {
+                cout << "[Cluster] Stopping..." << endl;
+                stopping = true;
+                if (writer.pid > 0) kill(writer.pid, SIGTERM);
+                for (const Child& child : workers) {
+                    if (child.pid > 0) kill(child.pid, SIGTERM);
+                }
+            }
+            continue;
+        }
+
+        int status = 0;
+        pid_t pid;
+        while ((pid = waitpid(-1, &status, WNOHANG)) > 0) {
+            Child* child = pid == writer.pid ? &writer : nullptr;
+            int role = WRITER;
+            for (size_t i = 0; child == nullptr && i < workers.size(); i++) {
+                if (workers[i].pid == pid) {
+                    child = &workers[i];
+                    role = static_cast<int>(i);
+                }
+            }
+            if (child == nullptr) continue;
+            if (stopping) {
+                child->pid = -1;
+                continue;
+            }
+
+            string name = role == WRITER ? string("writer") : "worker " + to_string(role + 1);
+            cerr << "[Cluster] " << name << " (pid " << pid << ") exited with "
+                 << (WIFSIGNALED(status) ? "signal " + to_string(WTERMSIG(status))
+                                         : "status " + to_string(WEXITSTATUS(status)))
+                 << ", restarting" << endl;
+            // Don't spin on a child that dies at startup
+            if (chrono::steady_clock::now() - child->started < chrono::seconds(1)) {
+                this_thread::sleep_for(chrono::seconds(1));
+            }
+            *child = spawn(role, setup);
+        }
+    }
+    cout << "[Cluster] All processes stopped" << endl;
+    return 0;
+}
+
+inline ServerCluster::Child ServerCluster::spawn(int role, const RouteSetup& setup) {
+    Child child;
+    child.started = chrono::steady_clock::now();
+    pid_t supervisor = getpid();
+    child.pid = fork();
+    if (child.pid == 0) {
+        // Stop (via SignalStop) rather than linger if the supervisor dies
+        prctl(PR_SET_PDEATHSIG, SIGTERM);
+        if (getppid() != supervisor) _exit(1);
+        int code = role == WRITER ? runWriter(setup) : runWorker(static_cast<size_t>(role), setup);
+        AsyncLogger::instance().stop();
+        fflush(stdout);
+        _exit(code);  // Nothing of the supervisor's to clean up
+    }
+    if (child.pid < 0) {
+        cerr << "[Cluster] fork failed: " << strerror(errno) << endl;
+    }
+    return child;
+}
+
+inline void ServerCluster::startLog(const string& process) {
+    // Each process appends to its own file: interleaved writes from several
+    // processes could split lines
+    string path = logFile.empty() || logFile == "-" ? "-" : logFile + "." + process;
+    if (!AsyncLogger::instance().start(path)) {
+        AsyncLogger::instance().start("-");
+    }
+}
+
+inline int ServerCluster::runWriter(const RouteSetup& setup) {
+    startLog("writer");
+    SharedSnapshot snapshot(dataDir);
+    DatabaseManager db(dataDir);
+    db.initialize();
+
+    HTTPServer routes(port, db, options);  // Only dispatches; never listens
+    setup(routes);
+    if (snapshot.publish(db) == 0) {
+        LOG_ERROR("ServerCluster") << "Cannot publish the database snapshot";
+        return 1;
+    }
+
+    Server server;
+    server.set_address_family(AF_UNIX);
+    server.Post(".*", [&routes, &snapshot, &db](const Request& req, Response& res) {
+        routes.handle(req, res);
+        // Before answering: the client's next read sees it. Requests that
+        // wrote nothing (logins, rejected input) leave every generation
+        // where it was, and publish() returns without exporting
+        snapshot.publish(db);
+    });
+    unlink(socketPath().c_str());
+
+    SignalStop signals([&server]() { server.stop(); });
+    LOG_INFO("ServerCluster") << "Writer serving " << socketPath();
+    bool ok = signals.stopRequested() || server.listen(socketPath(), 80);  // Port unused for AF_UNIX (0 would mean "pick one")
+    unlink(socketPath().c_str());
+    if (!ok) {
+        LOG_ERROR("ServerCluster") << "Cannot listen on " << socketPath();
+    }
+    return ok ? 0 : 1;
+}
+
+inline int ServerCluster::runWorker(size_t index, const RouteSetup& setup) {
+    string name = "worker" + to_string(index + 1);
+    startLog(name);
+    SharedSnapshot snapshot(dataDir);
+    DatabaseManager replica(dataDir + "/replica-" + to_string(index + 1));
+    for (Store store : {Store::USERS, Store::STUDENTS, Store::TEACHERS, Store::COURSES, Store::TIMETABLES}) {
+        replica.setDurability(store, DurabilityPolicy::none());  // Rebuilt from the snapshot anyway
+    }
+
+    HTTPServer server(port, replica, options);
+    setup(server);
+    server.setInterceptor([this, &snapshot, &replica](const Request& req, Response& res) {
+        if (req.method == "GET" || req.method == "HEAD") {
+            snapshot.refresh(replica);  // One atomic load unless something was written
+            return false;
+        }
+        forwardToWriter(req, res);
+        return true;
+    });
+
+    SignalStop signals([&server]() { server.stop(); });
+    while (snapshot.generation() == 0) {
+        if (signals.stopRequested()) return 0;
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+    snapshot.refresh(replica);
+
+    try {
+        if (!signals.stopRequested()) {
+            server.start();
+        }
+    } catch (const exception& e) {
+        LOG_ERROR("ServerCluster") << name << ": " << e.what();
+        return 1;
+    }
+    return 0;
+}
+
+// Send a write to the writer process and copy its answer into res
+inline void ServerCluster::forwardToWriter(const Request& req, Response& res) {
+    thread_local unique_ptr<Client> client;  // One keep-alive connection per worker thread
+    if (!client) {
+        client = make_unique<Client>(socketPath(), 80);
+        client->set_address_family(AF_UNIX);
+        client->set_keep_alive(true);
+        client->set_path_encode(false);  // req.target is still encoded
+        client->set_read_timeout(options.readTimeoutSec + 30, 0);
+    }
+
+    Request forwarded;
+    forwarded.method = req.method;
+    forwarded.path = req.target;
+    forwarded.body = req.body;
+    for (const auto& header : req.headers) {
+        if (!isHopByHop(header.first)) forwarded.headers.insert(header);
+    }
+
+    Result result = client->send(forwarded);
+    if (!result) {
+        LOG_WARN("ServerCluster") << "Writer unavailable (" << to_string(result.error()) << "), "
+                                  << req.method << " " << req.path << " refused";
+        client.reset();
+        HTTPResponse busy = HTTPServer::jsonError("Database writer unavailable, retry later", 503);
+        res.status = busy.statusCode;
+        res.set_header("Retry-After", to_string(options.retryAfterSeconds));
+        res.set_content(move(busy.body), "application/json");
+        return;
+    }
+
+    res.status = result->status;
+    for (const auto& header : result->headers) {
+        // CORS headers are already set by this process's dispatch
+        if (!isHopByHop(header.first) && header.first != "Content-Type" &&
+            header.first.compare(0, 15, "Access-Control-") != 0) {
+            res.set_header(header.first, header.second);
+        }
+    }
+    res.set_content(move(result->body), result->get_header_value("Content-Type"));
+}
+
+#endif // __linux__
+
+#endif // SERVER_CLUSTER_H
@@ -2,7 +2,6 @@
 #define STUDENT_SERVICE_H
 
 #include "HTTPServer.h"
-#include <sstream>
 
 using namespace std;
 
@@ -10,9 +9,12 @@ class StudentService {
 public:
     // POST /api/student/enrollCourse
     static HTTPResponse enrollCourse(const HTTPRequest& req, DatabaseManager& db) {
-        auto data = JSONParser::parse(req.body);
-        string studentID = JSONParser::getString(data, "studentID");
-        string courseID = JSONParser::getString(data, "courseID");
+        JSONDocument data;
+        if (!data.parse(req.body)) {
+            return HTTPServer::jsonError("Invalid JSON: " + data.error());
+        }
+        string studentID = data.getString("studentID");
+        string courseID = data.getString("courseID");
         
         if (studentID.empty() || courseID.empty()) {
             return HTTPServer::jsonError("Student ID and Course ID required");
@@ -27,18 +29,23 @@ public:
             return HTTPServer::jsonError("Enrollment failed");
         }
         
-        map<string, string> response;
-        response["success"] = "true";
-        response["message"] = "Enrolled successfully";
+        JsonWriter json;
+        json.beginObject()
+            .member("success", "true")
+            .member("message", "Enrolled successfully")
+            .endObject();
         
-        return HTTPServer::jsonSuccess(response);
+        return HTTPServer::jsonSuccess(json);
     }
     
     // POST /api/student/dropCourse
     static HTTPResponse dropCourse(const HTTPRequest& req, DatabaseManager& db) {
-        auto data = JSONParser::parse(req.body);
-        string studentID = JSONParser::getString(data, "studentID");
-        string courseID = JSONParser::getString(data, "courseID");
+        JSONDocument data;
+        if (!data.parse(req.body)) {
+            return HTTPServer::jsonError("Invalid JSON: " + data.error());
+        }
+        string studentID = data.getString("studentID");
+        string courseID = data.getString("courseID");
         
         if (studentID.empty() || courseID.empty()) {
             return HTTPServer::jsonError("Student ID and Course ID required");
@@ -48,11 +55,13 @@ public:
             return HTTPServer::jsonError("Drop course failed");
         }
         
-        map<string, string> response;
-        response["success"] = "true";
-        response["message"] = "Course dropped successfully";
+        JsonWriter json;
+        json.beginObject()
+            .member("success", "true")
+            .member("message", "Course dropped successfully")
+            .endObject();
         
-        return HTTPServer::jsonSuccess(response);
+        return HTTPServer::jsonSuccess(json);
     }
     
     // GET /api/student/viewCourses?semester=X
@@ -60,45 +69,42 @@ public:
         // Get semester from query parameters
         int semester = 1;  // Default
         
-        if (req.params.count("semester") > 0) {
-            semester = stoi(req.params.at("semester"));
+        if (req.hasParam("semester")) {
+            semester = stoi(string(req.param("semester")));
         }
         
-        cout << "[StudentService] Querying courses for semester: " << semester << endl;
+        LOG_DEBUG("StudentService") << "Querying courses for semester: " << semester;
         vector<Course> courses = db.getCoursesBySemester(semester);
-        cout << "[StudentService] Found " << courses.size() << " courses" << endl;
+        LOG_DEBUG("StudentService") << "Found " << courses.size() << " courses";
         if (!courses.empty()) {
-            cout << "[StudentService] First course: " << courses[0].courseID << " semester=" << courses[0].semester << endl;
+            LOG_DEBUG("StudentService") << "First course: " << courses[0].courseID << " semester=" << courses[0].semester;
         }
         
-        stringstream ss;
-        ss << "[";
-        for (size_t i = 0; i < courses.size(); i++) {
+        JsonWriter json;
+        json.beginObject()
+            .member("success", "true")
+            .key("courses").beginArray();
+        for (const auto& course : courses) {
             Teacher teacher;
             string teacherName = "TBA";
-            if (!courses[i].teacherID.empty() && db.getTeacher(courses[i].teacherID, teacher)) {
+            if (!course.teacherID.empty() && db.getTeacher(course.teacherID, teacher)) {
                 teacherName = teacher.name;
             }
 
-            if (i > 0) ss << ",";
-            ss << "{"
-               << "\"courseID\":\"" << courses[i].courseID << "\","
-               << "\"courseName\":\"" << courses[i].courseName << "\","
-               << "\"semester\":" << courses[i].semester << ","
-               << "\"teacherID\":\"" << courses[i].teacherID << "\","
-               << "\"teacherName\":\"" << teacherName << "\","
-               << "\"enrollmentCount\":" << courses[i].currentEnrollmentCount << ","
-               << "\"credits\":3,"
-               << "\"available\":" << (courses[i].currentEnrollmentCount < 50 ? "true" : "false")
-               << "}";
+            json.beginObject()
+                .member("courseID", course.courseID)
+                .member("courseName", course.courseName)
+                .member("semester", course.semester)
+                .member("teacherID", course.teacherID)
+                .member("teacherName", teacherName)
+                .member("enrollmentCount", course.currentEnrollmentCount)
+                .member("credits", 3)
+                .member("available", course.currentEnrollmentCount < 50)
+                .endObject();
         }
-        ss << "]";
-        
-        map<string, string> response;
-        response["success"] = "true";
-        response["courses"] = ss.str();
+        json.endArray().endObject();
         
-        return HTTPServer::jsonSuccess(response);
+        return HTTPServer::jsonSuccess(json);
     }
     
     // GET /api/student/getMyData?studentID=X or /api/student/mydata?studentID=X
@@ -106,61 +112,58 @@ public:
         string studentID;
         
         // CRITICAL FIX: Check both param formats
-        if (req.params.count("studentID") > 0) {
-            studentID = req.params.at("studentID");
+        if (req.hasParam("studentID")) {
+            studentID = string(req.param("studentID"));
         }
         
-        cout << "[StudentService] getMyData called for studentID: " << studentID << endl;
+        LOG_DEBUG("StudentService") << "getMyData called for studentID: " << studentID;
         
         if (studentID.empty()) {
-            cout << "[StudentService] ERROR: No studentID provided" << endl;
+            LOG_WARN("StudentService") << "No studentID provided";
             return HTTPServer::jsonError("Student ID required");
         }
         
         Student student;
         if (!db.getStudent(studentID, student)) {
-            cout << "[StudentService] ERROR: Student not found: " << studentID << endl;
+            LOG_WARN("StudentService") << "Student not found: " << studentID;
             return HTTPServer::jsonError("Student not found", 404);
         }
         
-        cout << "[StudentService] Found student: " << student.name << " (semester " << student.currentSemester << ")" << endl;
+        LOG_DEBUG("StudentService") << "Found student: " << student.name << " (semester " << student.currentSemester << ")";
         
-        // Get enrolled courses with details
-        stringstream coursesJson;
-        coursesJson << "[";
-        for (size_t i = 0; i < student.enrolledCourses.size(); i++) {
-            if (i > 0) coursesJson << ",";
-            
+        JsonWriter json;
+        json.beginObject()
+            .member("success", "true")
+            .member("studentID", student.studentID)
+            .member("name", student.name)
+            .member("email", student.email)
+            .key("currentSemester").quoted(student.currentSemester);
+        
+        // Enrolled courses with details
+        json.key("enrolledCourses").beginArray();
+        for (const auto& courseID : student.enrolledCourses) {
             Course course;
-            if (db.getCourse(student.enrolledCourses[i], course)) {
+            if (db.getCourse(courseID, course)) {
                 Teacher teacher;
                 string teacherName = "TBA";
                 if (!course.teacherID.empty() && db.getTeacher(course.teacherID, teacher)) {
                     teacherName = teacher.name;
                 }
 
-                coursesJson << "{"
-                           << "\"courseID\":\"" << course.courseID << "\","
-                           << "\"courseName\":\"" << course.courseName << "\","
-                           << "\"teacherID\":\"" << course.teacherID << "\","
-                           << "\"teacherName\":\"" << teacherName << "\","
-                           << "\"semester\":" << course.semester << ","
-                           << "\"enrollmentCount\":" << course.currentEnrollmentCount << ","
-                           << "\"credits\":3"
-                           << "}";
+                json.beginObject()
+                    .member("courseID", course.courseID)
+                    .member("courseName", course.courseName)
+                    .member("teacherID", course.teacherID)
+                    .member("teacherName", teacherName)
+                    .member("semester", course.semester)
+                    .member("enrollmentCount", course.currentEnrollmentCount)
+                    .member("credits", 3)
+                    .endObject();
             }
         }
-        coursesJson << "]";
+        json.endArray().endObject();
         
-        map<string, string> response;
-        response["success"] = "true";
-        response["studentID"] = student.studentID;
-        response["name"] = student.name;
-        response["email"] = student.email;
-        response["currentSemester"] = to_string(student.currentSemester);
-        response["enrolledCourses"] = coursesJson.str();
-        
-        return HTTPServer::jsonSuccess(response);
+        return HTTPServer::jsonSuccess(json);
     }
     
     // GET /api/student/viewTimetable?studentID=X
@@ -173,39 +176,40 @@ public:
         // CRITICAL FIX: Extract student ID from query params
         string studentID;
         
-        if (req.params.count("studentID") > 0) {
-            studentID = req.params.at("studentID");
+        if (req.hasParam("studentID")) {
+            studentID = string(req.param("studentID"));
         }
         
-        cout << "[StudentService] viewTimetable called for student: " << studentID << endl;
+        LOG_DEBUG("StudentService") << "viewTimetable called for student: " << studentID;
         
         if (studentID.empty()) {
-            cout << "[StudentService] viewTimetable: No studentID provided" << endl;
+            LOG_WARN("StudentService") << "viewTimetable: No studentID provided";
             return HTTPServer::jsonError("Student ID required");
         }
         
         Student student;
         if (!db.getStudent(studentID, student)) {
-            cout << "[StudentService] Student not found: " << studentID << endl;
+            LOG_WARN("StudentService") << "Student not found: " << studentID;
             return HTTPServer::jsonError("Student not found", 404);
         }
         
-        cout << "[StudentService] Student found. Semester: " << student.currentSemester << endl;
-        cout << "[StudentService] Enrolled courses: " << student.enrolledCourses.size() << endl;
+        LOG_DEBUG("StudentService") << "Student found. Semester: " << student.currentSemester;
+        LOG_DEBUG("StudentService") << "Enrolled courses: " << student.enrolledCourses.size();
         
         // Get student's timetable
         Timetable timetable;
         if (!db.getTimetable(student.currentSemester, timetable)) {
-            cout << "[StudentService] No timetable for semester " << student.currentSemester << endl;
+            LOG_DEBUG("StudentService") << "No timetable for semester " << student.currentSemester;
             return HTTPServer::jsonError("Timetable not generated yet", 400);
         }
         
-        cout << "[StudentService] Timetable found with " << timetable.schedule.size() << " total courses" << endl;
+        LOG_DEBUG("StudentService") << "Timetable found with " << timetable.schedule.size() << " total courses";
         
         // CRITICAL FIX: Filter for student's enrolled courses
-        stringstream ss;
-        ss << "[";
-        bool first = true;
+        JsonWriter json;
+        json.beginObject()
+            .member("success", "true")
+            .key("timetable").beginArray();
         int matchedCourses = 0;
         
         for (const auto& sc : timetable.schedule) {
@@ -220,45 +224,36 @@ public:
             
             if (isEnrolled) {
                 matchedCourses++;
-                cout << "[StudentService] Including course: " << sc.courseID << " with " << sc.slots.size() << " slots" << endl;
-                
-                if (!first) ss << ",";
-                first = false;
+                LOG_DEBUG("StudentService") << "Including course: " << sc.courseID << " with " << sc.slots.size() << " slots";
                 
-                ss << "{"
-                   << "\"courseID\":\"" << sc.courseID << "\","
-                   << "\"courseName\":\"" << sc.courseName << "\","
-                   << "\"teacherName\":\"" << sc.teacherName << "\","
-                   << "\"classroom\":" << sc.classroomID << ","
-                   << "\"slots\":[";
+                json.beginObject()
+                    .member("courseID", sc.courseID)
+                    .member("courseName", sc.courseName)
+                    .member("teacherName", sc.teacherName)
+                    .member("classroom", sc.classroomID)
+                    .key("slots").beginArray();
                 
                 // Serialize all slots for this course
-                for (size_t i = 0; i < sc.slots.size(); i++) {
-                    if (i > 0) ss << ",";
-                    const auto& slot = sc.slots[i];
-                    
-                    cout << "[StudentService]   Slot: day=" << slot.day << " hour=" << slot.hour << endl;
+                for (const auto& slot : sc.slots) {
+                    LOG_DEBUG("StudentService") << "  Slot: day=" << slot.day << " hour=" << slot.hour;
                     
-                    ss << "{\"day\":" << slot.day << ",\"hour\":" << slot.hour
-                       << ",\"dayName\":\"" << slot.getDayName() << "\""
-                       << ",\"time\":\"" << slot.getTimeString() << "\"}";
+                    json.beginObject()
+                        .member("day", slot.day)
+                        .member("hour", slot.hour)
+                        .member("dayName", slot.getDayName())
+                        .member("time", slot.getTimeString())
+                        .endObject();
                 }
                 
-                ss << "]}";
+                json.endArray().endObject();
             }
         }
-        ss << "]";
-        
-        cout << "[StudentService] Matched " << matchedCourses << " enrolled courses in timetable" << endl;
-        
-        string timetableJson = ss.str();
-        cout << "[StudentService] Timetable JSON length: " << timetableJson.length() << endl;
+        json.endArray().endObject();
         
-        map<string, string> response;
-        response["success"] = "true";
-        response["timetable"] = timetableJson;
+        LOG_DEBUG("StudentService") << "Matched " << matchedCourses << " enrolled courses in timetable";
+        LOG_DEBUG("StudentService") << "Timetable JSON length: " << json.size();
         
-        return HTTPServer::jsonSuccess(response);
+        return HTTPServer::jsonSuccess(json);
     }
 };
 
@@ -2,7 +2,6 @@
 #define TEACHER_SERVICE_H
 
 #include "HTTPServer.h"
-#include <sstream>
 
 using namespace std;
 
@@ -11,13 +10,7 @@ public:
     // GET /api/teacher/viewStudents?teacherID=X
     static HTTPResponse viewStudents(const HTTPRequest& req, DatabaseManager& db) {
         // Extract teacher ID from query
-        string teacherID;
-        size_t pos = req.path.find("teacherID=");
-        if (pos != string::npos) {
-            size_t endPos = req.path.find("&", pos);
-            if (endPos == string::npos) endPos = req.path.length();
-            teacherID = req.path.substr(pos + 10, endPos - pos - 10);
-        }
+        string teacherID(req.param("teacherID"));
         
         if (teacherID.empty()) {
             return HTTPServer::jsonError("Teacher ID required");
@@ -34,43 +27,34 @@ public:
             return HTTPServer::jsonError("No course assigned");
         }
         
-        // Get enrolled students
-        stringstream ss;
-        ss << "[";
-        for (size_t i = 0; i < course.enrolledStudents.size(); i++) {
-            if (i > 0) ss << ",";
-            
+        JsonWriter json;
+        json.beginObject()
+            .member("success", "true")
+            .member("courseID", course.courseID)
+            .member("courseName", course.courseName);
+        
+        // Enrolled students
+        json.key("students").beginArray();
+        for (const auto& studentID : course.enrolledStudents) {
             Student student;
-            if (db.getStudent(course.enrolledStudents[i], student)) {
-                ss << "{"
-                   << "\"studentID\":\"" << student.studentID << "\","
-                   << "\"name\":\"" << student.name << "\","
-                   << "\"email\":\"" << student.email << "\","
-                   << "\"semester\":" << student.currentSemester
-                   << "}";
+            if (db.getStudent(studentID, student)) {
+                json.beginObject()
+                    .member("studentID", student.studentID)
+                    .member("name", student.name)
+                    .member("email", student.email)
+                    .member("semester", student.currentSemester)
+                    .endObject();
             }
         }
-        ss << "]";
+        json.endArray().endObject();
         
-        map<string, string> response;
-        response["success"] = "true";
-        response["courseID"] = course.courseID;
-        response["courseName"] = course.courseName;
-        response["students"] = ss.str();
-        
-        return HTTPServer::jsonSuccess(response);
+        return HTTPServer::jsonSuccess(json);
     }
     
     // GET /api/teacher/viewTimetable?teacherID=X
     static HTTPResponse viewTimetable(const HTTPRequest& req, DatabaseManager& db) {
         // Extract teacher ID from query
-        string teacherID;
-        size_t pos = req.path.find("teacherID=");
-        if (pos != string::npos) {
-            size_t endPos = req.path.find("&", pos);
-            if (endPos == string::npos) endPos = req.path.length();
-            teacherID = req.path.substr(pos + 10, endPos - pos - 10);
-        }
+        string teacherID(req.param("teacherID"));
         
         if (teacherID.empty()) {
             return HTTPServer::jsonError("Teacher ID required");
@@ -94,42 +78,40 @@ public:
         }
         
         // Find course in timetable
-        stringstream ss;
-        ss << "{";
-        bool found = false;
+        const ScheduledCourse* scheduled = nullptr;
         for (const auto& sc : timetable.schedule) {
             if (sc.courseID == teacher.assignedCourseID) {
-                found = true;
-                ss << "\"courseID\":\"" << sc.courseID << "\","
-                   << "\"courseName\":\"" << sc.courseName << "\","
-                   << "\"classroom\":" << sc.classroomID << ","
-                   << "\"slots\":[";
-                
-                // Serialize all session slots
-                for (size_t i = 0; i < sc.slots.size(); i++) {
-                    if (i > 0) ss << ",";
-                    const auto& slot = sc.slots[i];
-                    ss << "{\"day\":" << slot.day
-                       << ",\"hour\":" << slot.hour
-                       << ",\"dayName\":\"" << slot.getDayName() << "\""
-                       << ",\"time\":\"" << slot.getTimeString() << "\"}";
-                }
-                
-                ss << "]";
+                scheduled = &sc;
                 break;
             }
         }
-        ss << "}";
         
-        if (!found) {
+        if (scheduled == nullptr) {
             return HTTPServer::jsonError("Course not scheduled yet");
         }
         
-        map<string, string> response;
-        response["success"] = "true";
-        response["timetable"] = ss.str();
+        JsonWriter json;
+        json.beginObject()
+            .member("success", "true")
+            .key("timetable").beginObject()
+                .member("courseID", scheduled->courseID)
+                .member("courseName", scheduled->courseName)
+                .member("classroom", scheduled->classroomID)
+                .key("slots").beginArray();
+        
+        // Serialize all session slots
+        for (const auto& slot : scheduled->slots) {
+            json.beginObject()
+                .member("day", slot.day)
+                .member("hour", slot.hour)
+                .member("dayName", slot.getDayName())
+                .member("time", slot.getTimeString())
+                .endObject();
+        }
+        
+        json.endArray().endObject().endObject();
         
-        return HTTPServer::jsonSuccess(response);
+        return HTTPServer::jsonSuccess(json);
     }
 };
 
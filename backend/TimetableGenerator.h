@@ -3,10 +3,10 @@
 
 #include "../database/DatabaseManager.h"
 #include "../database/DataModels.h"
+#include "../database/Logger.h"
 #include <vector>
 #include <set>
 #include <map>
-#include <iostream>
 
 using namespace std;
 
@@ -126,19 +126,19 @@ private:
                    map<int, Timetable>& timetables) {
         // Base case: all courses scheduled
         if (courseIndex >= courses.size()) {
-            cout << "[Backtrack] SUCCESS - All " << courses.size() << " courses scheduled!" << endl;
+            LOG_DEBUG("Backtrack") << "SUCCESS - All " << courses.size() << " courses scheduled!";
             return true;
         }
         
         Course& course = courses[courseIndex];
         int requiredSessions = course.getRequiredSessions();
         
-        cout << "[Backtrack] Course " << (courseIndex+1) << "/" << courses.size() 
-             << ": " << course.courseID << " (needs " << requiredSessions << " sessions)" << endl;
+        LOG_DEBUG("Backtrack") << "Course " << (courseIndex+1) << "/" << courses.size() 
+                               << ": " << course.courseID << " (needs " << requiredSessions << " sessions)";
         
         // Skip courses with no enrollments
         if (course.enrolledStudents.empty()) {
-            cout << "[Backtrack] Skipping " << course.courseID << " - no students" << endl;
+            LOG_DEBUG("Backtrack") << "Skipping " << course.courseID << " - no students";
             return backtrack(courses, courseIndex + 1, timetables);
         }
         
@@ -189,7 +189,7 @@ private:
         }
         
         // No valid configuration found
-        cout << "[Backtrack] FAILED - Could not schedule " << course.courseID << endl;
+        LOG_DEBUG("Backtrack") << "FAILED - Could not schedule " << course.courseID;
         return false;
     }
     
@@ -198,7 +198,7 @@ public:
     
     // Generate timetables for all semesters
     bool generateAll() {
-        cout << "[TimetableGenerator] Starting timetable generation..." << endl;
+        LOG_INFO("TimetableGenerator") << "Starting timetable generation...";
         
         // Clear existing schedules
         teacherSchedule.clear();
@@ -209,11 +209,11 @@ public:
         vector<Course> courses = db.getAllCourses();
         
         if (courses.empty()) {
-            cout << "[TimetableGenerator] No courses found" << endl;
+            LOG_INFO("TimetableGenerator") << "No courses found";
             return false;
         }
         
-        cout << "[TimetableGenerator] Found " << courses.size() << " courses" << endl;
+        LOG_INFO("TimetableGenerator") << "Found " << courses.size() << " courses";
         
         // Sort courses by enrollment count (descending) - schedule fuller courses first
         sort(courses.begin(), courses.end(), 
@@ -229,7 +229,7 @@ public:
         
         // Run backtracking algorithm
         if (!backtrack(courses, 0, timetables)) {
-            cout << "[TimetableGenerator] Failed to generate conflict-free timetable" << endl;
+            LOG_WARN("TimetableGenerator") << "Failed to generate conflict-free timetable";
             return false;
         }
         
@@ -237,9 +237,9 @@ public:
         for (auto& pair : timetables) {
             if (!pair.second.schedule.empty()) {
                 db.saveTimetable(pair.second);
-                cout << "[TimetableGenerator] Saved timetable for semester " 
-                     << pair.first << " (" << pair.second.schedule.size() 
-                     << " courses)" << endl;
+                LOG_INFO("TimetableGenerator") << "Saved timetable for semester " 
+                                               << pair.first << " (" << pair.second.schedule.size() 
+                                               << " courses)";
             }
         }
         
@@ -248,7 +248,7 @@ public:
         config.isTimetableGenerated = true;
         db.updateConfig(config);
         
-        cout << "[TimetableGenerator] Timetable generation completed successfully!" << endl;
+        LOG_INFO("TimetableGenerator") << "Timetable generation completed successfully!";
         return true;
     }
     
@@ -262,10 +262,12 @@ public:
         TimetableGenerator generator(db);
         
         if (generator.generateAll()) {
-            map<string, string> response;
-            response["success"] = "true";
-            response["message"] = "Timetable generated successfully";
-            return HTTPServer::jsonSuccess(response);
+            JsonWriter json;
+            json.beginObject()
+                .member("success", "true")
+                .member("message", "Timetable generated successfully")
+                .endObject();
+            return HTTPServer::jsonSuccess(json);
         } else {
             return HTTPServer::jsonError("Failed to generate timetable");
         }
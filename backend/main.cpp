@@ -1,61 +1,77 @@
 #include <iostream>
+#include <cstring>
+#include <cstdlib>
 #include "../database/DatabaseManager.h"
 #include "HTTPServer.h"
-#include "AuthService.h"
-#include "AdminService.h"
-#include "StudentService.h"
-#include "TeacherService.h"
-#include "TimetableGenerator.h"
+#include "Routes.h"
+#include "ServerCluster.h"
 
 using namespace std;
 
-int main() {
+int main(int argc, char* argv[]) {
     cout << "========================================" << endl;
     cout << "  University Management System Server" << endl;
     cout << "========================================" << endl;
     cout << endl;
     
+    // --verbose: debug-level logging, including every request's parameters
+    // and headers; --log-file PATH: where the log goes ("-" for stdout);
+    // --threads N / --max-queue N: worker pool size and connection backlog;
+    // --event-loop: serve all sockets from one epoll thread (Linux);
+    // --processes N: N worker processes plus a writer (Linux, see ServerCluster);
+    // --cache-mb N: GET response cache size (0 disables)
+    string logFile = "server.log";
+    ServerOptions options;
+    int processes = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--verbose") == 0) {
+            AsyncLogger::instance().setLevel(LogLevel::Debug);
+        } else if (strcmp(argv[i], "--log-file") == 0 && i + 1 < argc) {
+            logFile = argv[++i];
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            options.workerThreads = max(1, atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--max-queue") == 0 && i + 1 < argc) {
+            options.maxQueuedConnections = max(0, atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--event-loop") == 0) {
+            options.transport = ServerOptions::Transport::EventLoop;
+        } else if (strcmp(argv[i], "--processes") == 0 && i + 1 < argc) {
+            processes = max(0, atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--cache-mb") == 0 && i + 1 < argc) {
+            options.responseCacheBytes = static_cast<size_t>(max(0, atoi(argv[++i]))) * 1024 * 1024;
+        }
+    }
+    if (processes > 0) {
+#ifdef UMS_HAS_CLUSTER
+        // Forks before any thread or file is opened; each process starts its own log
+        ServerCluster cluster(8080, "data", processes, options, logFile);
+        return cluster.run(registerRoutes);
+#else
+        cerr << "[WARN] --processes needs Linux; running a single process" << endl;
+#endif
+    }
+    if (!AsyncLogger::instance().start(logFile)) {
+        cerr << "[ERROR] Cannot open log file " << logFile << ", logging to stdout" << endl;
+        AsyncLogger::instance().start("-");
+    }
+    
     // Initialize database
     DatabaseManager db("data");
     db.initialize();
     
     // Create HTTP server
-    HTTPServer server(8080, db);
-    
-    // ========== Authentication Routes ==========
-    server.post("/api/login", AuthService::login);
-    
-    // ========== Admin Routes ==========
-    server.post("/api/admin/addStudent", AdminService::addStudent);
-    server.post("/api/admin/removeStudent", AdminService::removeStudent);
-    server.post("/api/admin/addTeacher", AdminService::addTeacher);
-    server.post("/api/admin/removeTeacher", AdminService::removeTeacher);
-    server.post("/api/admin/addCourse", AdminService::addCourse);
-    server.post("/api/admin/setRegistrationWindow", AdminService::setRegistrationWindow);
-    server.get("/api/admin/getRegistrationWindow", AdminService::getRegistrationWindow);
-    server.get("/api/admin/viewAllStudents", AdminService::viewAllStudents);
-    server.get("/api/admin/viewAllTeachers", AdminService::viewAllTeachers);
-    server.get("/api/admin/viewTimetable", AdminService::viewTimetable);
-    server.post("/api/admin/generateTimetable", TimetableGenerator::generateTimetableAPI);
+    HTTPServer server(8080, db, options);
     
-    // ========== Student Routes ==========
-    server.post("/api/student/enrollCourse", StudentService::enrollCourse);
-    server.post("/api/student/dropCourse", StudentService::dropCourse);
-    server.get("/api/student/viewCourses", StudentService::viewCourses);
-    server.get("/api/student/viewTimetable", StudentService::viewTimetable);
-    server.get("/api/student/mydata", StudentService::getMyData);
-    // ========== Teacher Routes ==========
-    server.get("/api/teacher/viewStudents", TeacherService::viewStudents);
-    server.get("/api/teacher/viewTimetable", TeacherService::viewTimetable);
+    registerRoutes(server);
     
     cout << "\n[Server] All routes registered successfully!" << endl;
-    cout << "[Server] Total endpoints: 18" << endl;
+    cout << "[Server] Total endpoints: " << server.routeCount() << endl;
     cout << "\n========================================" << endl;
     cout << "  Server Configuration" << endl;
     cout << "========================================" << endl;
     cout << "Port: 8080" << endl;
     cout << "Database: Custom B-Tree + Hash Table" << endl;
     cout << "Data Directory: ./data/" << endl;
+    cout << "Log File: " << logFile << endl;
     cout << "========================================" << endl;
     
     // In production, this would call server.start() which uses cpp-httplib
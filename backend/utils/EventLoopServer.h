@@ -0,0 +1,494 @@
+#ifndef EVENT_LOOP_SERVER_H
+#define EVENT_LOOP_SERVER_H
+
+#ifdef __linux__
+#define UMS_HAS_EPOLL 1
+
+#include "../../external/httplib.h"
+#include "HttpRequestParser.h"
+#include "WorkerPool.h"
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <cerrno>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * EventLoopServer - HTTP/1.1 transport on one edge-triggered epoll loop
+ *
+ * A single thread owns every socket: it accepts, reads until EAGAIN, feeds
+ * the bytes to each connection's HttpRequestParser and writes responses
+ * until EAGAIN. An idle keep-alive connection costs a file descriptor and
+ * a small Connection record, not a thread, so tens of thousands can stay
+ * open. Complete requests go to a WorkerPool, one in flight per connection
+ * (pipelined requests are answered in order); workers run the handler,
+ * serialize the response and post it back through an eventfd.
+ *
+ * The handler sees the same httplib Request/Response types as the
+ * threaded transport. A request the pool has to shed runs on its shed
+ * lane, where WorkerPool::shedding() is true.
+ */
+class EventLoopServer {
+public:
+    using Handler = function<void(const httplib::Request&, httplib::Response&)>;
+
+    struct Config {
+        size_t workerThreads = 8;
+        size_t maxQueuedRequests = 256;    // Backlog before requests are shed
+        size_t maxConnections = 50000;     // Further connections are closed on accept
+        time_t idleTimeoutSec = 60;        // Idle keep-alive connections are closed after this
+        size_t keepAliveMaxRequests = 1000;
+        size_t maxBodyBytes = 1024 * 1024;
+        bool tcpNoDelay = true;
+    };
+
+    EventLoopServer(const Config& config, Handler handler)
+        : config(config), handler(move(handler)),
+          wakeFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {}
+
+    EventLoopServer(const EventLoopServer&) = delete;
+    EventLoopServer& operator=(const EventLoopServer&) = delete;
+
+    ~EventLoopServer() {
+        closeAll();
+        if (wakeFd >= 0) ::close(wakeFd);
+    }
+
+    // Bind and serve until stop(); false if the socket can't be set up
+    bool listen(const string& host, int port);
+
+    // Thread-safe; listen() returns once the loop has wound down
+    void stop() {
+        stopping.store(true, memory_order_release);
+        wake();
+    }
+
+    bool isRunning() const { return running.load(memory_order_acquire); }
+    size_t connectionCount() const { return openConnections.load(memory_order_relaxed); }
+
+    // Bytes of a complete HTTP/1.1 response; the answer to a HEAD request
+    // keeps its Content-Length but sends no body
+    static string serialize(const httplib::Response& res, bool keepAlive, const Config& config,
+                            bool head = false);
+
+private:
+    struct Connection {
+        int fd = -1;
+        uint32_t generation = 0;
+        string in;                          // Received, not yet consumed
+        string out;                         // Response bytes not yet written
+        size_t outSent = 0;
+        HttpRequestParser parser;
+        unique_ptr<httplib::Request> pending;  // Request being parsed
+        bool busy = false;                  // A worker owns this connection's request
+        bool closeAfterWrite = false;
+        bool peerClosed = false;
+        size_t served = 0;
+        chrono::steady_clock::time_point lastActive;
+
+        explicit Connection(size_t maxBody) : parser(maxBody) {}
+    };
+
+    struct Completion {
+        int fd;
+        uint32_t generation;
+        string bytes;
+        bool keepAlive;
+    };
+
+    Config config;
+    Handler handler;
+    atomic<bool> running{false};
+    atomic<bool> stopping{false};
+    atomic<size_t> openConnections{0};
+
+    int wakeFd;  // Workers and stop() signal the loop; lives as long as the server
+    int listenFd = -1;
+    int epollFd = -1;
+    vector<unique_ptr<Connection>> connections;  // Indexed by fd
+    uint32_t nextGeneration = 1;
+    unique_ptr<WorkerPool> pool;
+
+    mutex completionMutex;
+    vector<Completion> completions;
+
+    static uint64_t token(int fd, uint32_t generation) {
+        return (static_cast<uint64_t>(generation) << 32) | static_cast<uint32_t>(fd);
+    }
+
+    void wake() {
+        if (wakeFd >= 0) {
+            uint64_t one = 1;
+            ssize_t ignored = ::write(wakeFd, &one, sizeof(one));
+            (void)ignored;
+        }
+    }
+
+    Connection* lookup(int fd, uint32_t generation) {
+        if (fd < 0 || static_cast<size_t>(fd) >= connections.size()) return nullptr;
+        Connection* conn = connections[fd].get();
+        return conn != nullptr && conn->generation == generation ? conn : nullptr;
+    }
+
+    void acceptAll();
+    void onReadable(Connection* conn);
+    void nextRequest(Connection* conn);
+    void respondNow(Connection* conn, int status);
+    bool flush(Connection* conn);
+    void afterWrite(Connection* conn);
+    void drainCompletions();
+    void sweepIdle();
+    void closeConnection(Connection* conn);
+    void closeAll();
+};
+
+// ==================== Implementation ====================
+
+inline bool EventLoopServer::listen(const string& host, int port) {
+    listenFd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) return false;
+    int yes = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+    // As httplib does: ServerCluster workers each bind the same port
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEPORT, &yes, sizeof(yes));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+    if (inet_pton(AF_INET, host.c_str(), &addr.sin_addr) != 1 ||
+        ::bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        ::listen(listenFd, SOMAXCONN) != 0) {
+        closeAll();
+        return false;
+    }
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0 || wakeFd < 0) {
+        closeAll();
+        return false;
+    }
+    epoll_event ev{};
+    ev.events = EPOLLIN | EPOLLET;
+    ev.data.u64 = token(listenFd, 0);
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &ev);
+    ev.data.u64 = token(wakeFd, 0);
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &ev);
+
+    pool = make_unique<WorkerPool>(config.workerThreads, config.maxQueuedRequests);
+    running.store(true, memory_order_release);
+
+    vector<epoll_event> events(512);
+    auto lastSweep = chrono::steady_clock::now();
+    while (!stopping.load(memory_order_acquire)) {
+        int n = epoll_wait(epollFd, events.data(), static_cast<int>(events.size()), 1000);
+        if (n < 0 && errno != EINTR) break;
+
+        for (int i = 0; i < n; i++) {
+            int fd = static_cast<int>(events[i].data.u64 & 0xffffffffu);
+            uint32_t generation = static_cast<uint32_t>(events[i].data.u64 >> 32);
+            if (fd == listenFd) {
+                acceptAll();
+            } else if (fd == wakeFd) {
+                uint64_t count;
+                while (::read(wakeFd, &count, sizeof(count)) > 0) {}
+                drainCompletions();
+            } else if (Connection* conn = lookup(fd, generation)) {
+                uint32_t flags = events[i].events;
+                if (flags & (EPOLLERR | EPOLLHUP)) {
+                    closeConnection(conn);
+                    continue;
+                }
+                if ((flags & EPOLLOUT) && !flush(conn)) {
+                    continue;
+                }
+                if (flags & (EPOLLIN | EPOLLRDHUP)) {
+                    onReadable(conn);
+                }
+            }
+        }
+
+        auto now = chrono::steady_clock::now();
+        if (now - lastSweep >= chrono::seconds(1)) {
+            sweepIdle();
+            lastSweep = now;
+        }
+    }
+
+    // Let running handlers finish before their connections go away
+    pool->shutdown();
+    closeAll();
+    running.store(false, memory_order_release);
+    return true;
+}
+
+inline void EventLoopServer::acceptAll() {
+    while (true) {
+        int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            return;  // EAGAIN: backlog empty (or EMFILE: retried on the next event)
+        }
+        if (openConnections.load(memory_order_relaxed) >= config.maxConnections) {
+            ::close(fd);
+            continue;
+        }
+        if (config.tcpNoDelay) {
+            int yes = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+        }
+        if (static_cast<size_t>(fd) >= connections.size()) {
+            connections.resize(max<size_t>(fd + 1, connections.size() * 2));
+        }
+        auto conn = make_unique<Connection>(config.maxBodyBytes);
+        conn->fd = fd;
+        conn->generation = nextGeneration++;
+        conn->lastActive = chrono::steady_clock::now();
+
+        // Registered once for both directions: edge-triggered, so no
+        // re-arming as the connection alternates between reading and writing
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+        ev.data.u64 = token(fd, conn->generation);
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            ::close(fd);
+            continue;
+        }
+        connections[fd] = move(conn);
+        openConnections.fetch_add(1, memory_order_relaxed);
+    }
+}
+
+inline void EventLoopServer::onReadable(Connection* conn) {
+    char buffer[64 * 1024];
+    while (true) {
+        ssize_t n = ::recv(conn->fd, buffer, sizeof(buffer), 0);
+        if (n > 0) {
+            conn->in.append(buffer, static_cast<size_t>(n));
+            if (conn->in.size() > HttpRequestParser::MAX_HEAD_BYTES + config.maxBodyBytes + 64 * 1024) {
+                closeConnection(conn);  // Flooding past any valid request
+                return;
+            }
+            continue;
+        }
+        if (n == 0) {
+            conn->peerClosed = true;
+        } else if (errno == EINTR) {
+            continue;
+        } else if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            closeConnection(conn);
+            return;
+        }
+        break;
+    }
+    conn->lastActive = chrono::steady_clock::now();
+    nextRequest(conn);
+}
+
+// Parse the next buffered request and hand it to a worker
+inline void EventLoopServer::nextRequest(Connection* conn) {
+    if (conn->busy || conn->outSent < conn->out.size() || conn->closeAfterWrite) {
+        return;  // One request at a time; pipelined bytes wait in `in`
+    }
+    if (conn->in.empty()) {
+        if (conn->peerClosed) closeConnection(conn);
+        return;
+    }
+
+    if (!conn->pending) {
+        conn->pending = make_unique<httplib::Request>();
+    }
+    auto status = conn->parser.parse(conn->in, *conn->pending);
+    if (status == HttpRequestParser::Status::NeedMore) {
+        if (conn->peerClosed) closeConnection(conn);
+        return;
+    }
+    if (status == HttpRequestParser::Status::Error) {
+        respondNow(conn, conn->parser.errorStatus());
+        return;
+    }
+
+    conn->in.erase(0, conn->parser.consumed());
+    if (conn->in.empty() && conn->in.capacity() > 64 * 1024) {
+        string().swap(conn->in);  // Idle connections keep no large buffers
+    }
+    conn->served++;
+    bool keepAlive = conn->parser.keepAlive() && !conn->peerClosed &&
+                     conn->served < config.keepAliveMaxRequests;
+    conn->parser.reset();
+
+    shared_ptr<httplib::Request> req(move(conn->pending));
+    int fd = conn->fd;
+    uint32_t generation = conn->generation;
+    conn->busy = true;
+    bool queued = pool->enqueue([this, req, fd, generation, keepAlive]() {
+        httplib::Response res;
+        try {
+            handler(*req, res);
+        } catch (...) {
+            res = httplib::Response();
+            res.status = 500;
+            res.set_content("{\"error\":\"Internal server error\"}", "application/json");
+        }
+        bool keep = keepAlive && res.status < 500 && !stopping.load(memory_order_relaxed);
+        Completion done{fd, generation, serialize(res, keep, config, req->method == "HEAD"), keep};
+        {
+            lock_guard<mutex> lock(completionMutex);
+            completions.push_back(move(done));
+        }
+        wake();
+    });
+    if (!queued) {
+        conn->busy = false;
+        respondNow(conn, 503);
+    }
+}
+
+// Answer from the loop thread (parse errors, pool refusal) and close
+inline void EventLoopServer::respondNow(Connection* conn, int status) {
+    httplib::Response res;
+    res.status = status;
+    if (status == 503) res.set_header("Retry-After", "2");
+    res.set_content(string("{\"success\":\"false\",\"error\":\"") + httplib::status_message(status) + "\"}",
+                    "application/json");
+    conn->out += serialize(res, false, config);
+    conn->closeAfterWrite = true;
+    conn->in.clear();
+    flush(conn);
+}
+
+// Write pending output until done or EAGAIN; false if the connection closed
+inline bool EventLoopServer::flush(Connection* conn) {
+    while (conn->outSent < conn->out.size()) {
+        ssize_t n = ::send(conn->fd, conn->out.data() + conn->outSent,
+                           conn->out.size() - conn->outSent, MSG_NOSIGNAL);
+        if (n > 0) {
+            conn->outSent += static_cast<size_t>(n);
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return true;  // EPOLLOUT resumes
+        } else {
+            closeConnection(conn);
+            return false;
+        }
+    }
+    if (!conn->out.empty()) {
+        conn->out.clear();
+        conn->outSent = 0;
+        int fd = conn->fd;
+        uint32_t generation = conn->generation;
+        afterWrite(conn);
+        return lookup(fd, generation) != nullptr;
+    }
+    return true;
+}
+
+// Response fully written: close, or start on the next buffered request
+inline void EventLoopServer::afterWrite(Connection* conn) {
+    if (conn->closeAfterWrite) {
+        closeConnection(conn);
+        return;
+    }
+    conn->lastActive = chrono::steady_clock::now();
+    nextRequest(conn);  // Pipelined request already buffered
+}
+
+inline void EventLoopServer::drainCompletions() {
+    vector<Completion> done;
+    {
+        lock_guard<mutex> lock(completionMutex);
+        done.swap(completions);
+    }
+    for (auto& completion : done) {
+        Connection* conn = lookup(completion.fd, completion.generation);
+        if (conn == nullptr) continue;  // Client went away meanwhile
+        conn->busy = false;
+        conn->closeAfterWrite = !completion.keepAlive;
+        conn->out += completion.bytes;
+        flush(conn);
+    }
+}
+
+inline void EventLoopServer::sweepIdle() {
+    auto cutoff = chrono::steady_clock::now() - chrono::seconds(config.idleTimeoutSec);
+    for (auto& slot : connections) {
+        Connection* conn = slot.get();
+        if (conn != nullptr && !conn->busy && conn->out.empty() && conn->lastActive < cutoff) {
+            closeConnection(conn);
+        }
+    }
+}
+
+inline void EventLoopServer::closeConnection(Connection* conn) {
+    int fd = conn->fd;
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    connections[fd].reset();
+    openConnections.fetch_sub(1, memory_order_relaxed);
+}
+
+inline void EventLoopServer::closeAll() {
+    for (auto& slot : connections) {
+        if (slot) closeConnection(slot.get());
+    }
+    for (int* fd : {&listenFd, &epollFd}) {
+        if (*fd >= 0) {
+            ::close(*fd);
+            *fd = -1;
+        }
+    }
+}
+
+inline string EventLoopServer::serialize(const httplib::Response& res, bool keepAlive, const Config& config,
+                                         bool head) {
+    int status = res.status == -1 ? 200 : res.status;  // httplib's "not set"
+    string out;
+    out.reserve(160 + res.body.size());
+    out += "HTTP/1.1 ";
+    out += to_string(status);
+    out += ' ';
+    out += httplib::status_message(status);
+    out += "\r\n";
+    for (const auto& header : res.headers) {
+        if (header.first == "Content-Length" || header.first == "Connection") continue;
+        out += header.first;
+        out += ": ";
+        out += header.second;
+        out += "\r\n";
+    }
+    if (status != 304 && status != 204) {
+        // A 304's length would have to be that of the body it stands for
+        out += "Content-Length: ";
+        out += to_string(res.body.size());
+        out += "\r\n";
+    }
+    if (keepAlive) {
+        out += "Connection: keep-alive\r\nKeep-Alive: timeout=";
+        out += to_string(config.idleTimeoutSec);
+        out += ", max=";
+        out += to_string(config.keepAliveMaxRequests);
+    } else {
+        out += "Connection: close";
+    }
+    out += "\r\n\r\n";
+    if (!head) {
+        out += res.body;  // Else the client would read it as the next response
+    }
+    return out;
+}
+
+#endif // __linux__
+
+#endif // EVENT_LOOP_SERVER_H
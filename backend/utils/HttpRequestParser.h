@@ -0,0 +1,271 @@
+#ifndef HTTP_REQUEST_PARSER_H
+#define HTTP_REQUEST_PARSER_H
+
+#include "../../external/httplib.h"
+#include <string>
+#include <string_view>
+#include <charconv>
+#include <cctype>
+
+using namespace std;
+
+/**
+ * HttpRequestParser - Incremental HTTP/1.1 request parser
+ *
+ * Fed the bytes received so far on a connection, parse() resumes where the
+ * previous call stopped: the head is scanned for its terminating blank line
+ * only over new bytes, a Content-Length body completes once enough bytes
+ * are buffered, and a chunked body is decoded chunk by chunk as it
+ * arrives. On Complete the request has been filled into an httplib
+ * Request (path decoded, query split into params) and consumed() bytes of
+ * the buffer belong to it; call reset() before parsing the next request
+ * (pipelined bytes after it stay in the buffer).
+ *
+ * Malformed or oversized requests end in Error with the HTTP status to
+ * answer: 400, 413 (body), 431 (head), 501 (transfer coding), 505 (version).
+ */
+class HttpRequestParser {
+public:
+    enum class Status { NeedMore, Complete, Error };
+
+    static constexpr size_t MAX_HEAD_BYTES = 16 * 1024;
+
+    explicit HttpRequestParser(size_t maxBodyBytes = 1024 * 1024) : maxBody(maxBodyBytes) {}
+
+    Status parse(string_view buffer, httplib::Request& req);
+
+    // Bytes of the buffer that made up the completed request
+    size_t consumed() const { return cursor; }
+
+    // HTTP status for an Error result
+    int errorStatus() const { return error; }
+
+    // Whether the completed request allows the connection to stay open
+    bool keepAlive() const { return persistent; }
+
+    void reset() {
+        state = State::Head;
+        scanned = 0;
+        cursor = 0;
+        contentLength = 0;
+        chunkRemaining = 0;
+        error = 0;
+        persistent = false;
+    }
+
+private:
+    enum class State { Head, Body, ChunkSize, ChunkData, Trailers, Done, Failed };
+
+    State state = State::Head;
+    size_t maxBody;
+    size_t scanned = 0;         // Head bytes already searched for the blank line
+    size_t cursor = 0;          // Start of the unparsed part (body/chunks)
+    size_t contentLength = 0;
+    size_t chunkRemaining = 0;  // Bytes of the current chunk (+ CRLF) still expected
+    int error = 0;
+    bool persistent = false;
+
+    Status fail(int status) {
+        state = State::Failed;
+        error = status;
+        return Status::Error;
+    }
+
+    bool reject(int status) {
+        fail(status);
+        return false;
+    }
+
+    static bool equalsIgnoreCase(string_view a, string_view b) {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); i++) {
+            if (tolower(static_cast<unsigned char>(a[i])) != tolower(static_cast<unsigned char>(b[i]))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static string_view trim(string_view s) {
+        while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+        while (!s.empty() && (s.back() == ' ' || s.back() == '\t')) s.remove_suffix(1);
+        return s;
+    }
+
+    static bool isTokenChar(char c) {
+        return isalnum(static_cast<unsigned char>(c)) || string_view("!#$%&'*+-.^_`|~").find(c) != string_view::npos;
+    }
+
+    bool parseHead(string_view head, httplib::Request& req);
+    Status parseChunks(string_view buffer, httplib::Request& req);
+};
+
+// ==================== Implementation ====================
+
+inline HttpRequestParser::Status HttpRequestParser::parse(string_view buffer, httplib::Request& req) {
+    if (state == State::Failed) return Status::Error;
+    if (state == State::Done) return Status::Complete;
+
+    if (state == State::Head) {
+        // Tolerate blank lines before the request line (RFC 9112 2.2)
+        size_t start = 0;
+        while (start + 1 < buffer.size() && buffer[start] == '\r' && buffer[start + 1] == '\n') {
+            start += 2;
+        }
+        size_t end = buffer.find("\r\n\r\n", max(start, scanned >= 3 ? scanned - 3 : 0));
+        if (end == string_view::npos) {
+            scanned = buffer.size();
+            if (buffer.size() - start > MAX_HEAD_BYTES) return fail(431);
+            return Status::NeedMore;
+        }
+        if (end - start > MAX_HEAD_BYTES) return fail(431);
+
+        if (!parseHead(buffer.substr(start, end - start), req)) return Status::Error;
+        cursor = end + 4;
+    }
+
+    if (state == State::Body) {
+        if (buffer.size() - cursor < contentLength) return Status::NeedMore;
+        req.body.assign(buffer.data() + cursor, contentLength);
+        cursor += contentLength;
+        state = State::Done;
+        return Status::Complete;
+    }
+
+    if (state == State::ChunkSize || state == State::ChunkData || state == State::Trailers) {
+        return parseChunks(buffer, req);
+    }
+
+    state = State::Done;  // No body
+    return Status::Complete;
+}
+
+inline bool HttpRequestParser::parseHead(string_view head, httplib::Request& req) {
+    size_t lineEnd = head.find("\r\n");
+    string_view requestLine = head.substr(0, lineEnd);
+    head = lineEnd == string_view::npos ? string_view() : head.substr(lineEnd + 2);
+
+    // METHOD SP request-target SP HTTP-version
+    size_t sp1 = requestLine.find(' ');
+    size_t sp2 = sp1 == string_view::npos ? sp1 : requestLine.find(' ', sp1 + 1);
+    if (sp1 == 0 || sp2 == string_view::npos || sp2 == sp1 + 1 ||
+        requestLine.find(' ', sp2 + 1) != string_view::npos) {
+        return reject(400);
+    }
+    string_view method = requestLine.substr(0, sp1);
+    string_view target = requestLine.substr(sp1 + 1, sp2 - sp1 - 1);
+    string_view version = requestLine.substr(sp2 + 1);
+    for (char c : method) {
+        if (!isTokenChar(c)) return reject(400);
+    }
+    if (target[0] != '/' && target != "*") return reject(400);
+    if (version != "HTTP/1.1" && version != "HTTP/1.0") {
+        return reject(version.substr(0, 5) == "HTTP/" ? 505 : 400);
+    }
+
+    req.method.assign(method);
+    req.target.assign(target);
+    req.version.assign(version);
+    size_t query = target.find('?');
+    req.path = httplib::decode_path_component(string(target.substr(0, query)));
+    if (query != string_view::npos) {
+        httplib::detail::parse_query_text(target.data() + query + 1, target.size() - query - 1, req.params);
+    }
+
+    bool http10 = version == "HTTP/1.0";
+    bool hasLength = false, chunked = false;
+    persistent = !http10;
+
+    while (!head.empty()) {
+        lineEnd = head.find("\r\n");
+        string_view line = head.substr(0, lineEnd);
+        head = lineEnd == string_view::npos ? string_view() : head.substr(lineEnd + 2);
+
+        size_t colon = line.find(':');
+        if (colon == 0 || colon == string_view::npos) return reject(400);
+        string_view name = line.substr(0, colon);
+        for (char c : name) {
+            if (!isTokenChar(c)) return reject(400);  // Also rejects obs-fold continuations
+        }
+        string_view value = trim(line.substr(colon + 1));
+
+        if (equalsIgnoreCase(name, "Content-Length")) {
+            size_t length = 0;
+            auto result = from_chars(value.data(), value.data() + value.size(), length);
+            if (value.empty() || result.ec != errc() || result.ptr != value.data() + value.size() ||
+                (hasLength && length != contentLength)) {
+                return reject(400);
+            }
+            hasLength = true;
+            contentLength = length;
+        } else if (equalsIgnoreCase(name, "Transfer-Encoding")) {
+            if (!equalsIgnoreCase(value, "chunked")) return reject(501);
+            chunked = true;
+        } else if (equalsIgnoreCase(name, "Connection")) {
+            if (equalsIgnoreCase(value, "close")) persistent = false;
+            else if (equalsIgnoreCase(value, "keep-alive")) persistent = true;
+        }
+        req.headers.emplace(string(name), string(value));
+    }
+
+    if (hasLength && chunked) return reject(400);  // Request smuggling vector
+    if (chunked) {
+        state = State::ChunkSize;
+    } else if (contentLength > 0) {
+        if (contentLength > maxBody) return reject(413);
+        state = State::Body;
+    } else {
+        state = State::Done;
+    }
+    return true;
+}
+
+inline HttpRequestParser::Status HttpRequestParser::parseChunks(string_view buffer, httplib::Request& req) {
+    while (true) {
+        if (state == State::ChunkSize) {
+            size_t lineEnd = buffer.find("\r\n", cursor);
+            if (lineEnd == string_view::npos) {
+                if (buffer.size() - cursor > 1024) return fail(400);
+                return Status::NeedMore;
+            }
+            string_view line = buffer.substr(cursor, lineEnd - cursor);
+            line = line.substr(0, line.find(';'));  // Chunk extensions are ignored
+            line = trim(line);
+            size_t size = 0;
+            auto result = from_chars(line.data(), line.data() + line.size(), size, 16);
+            if (line.empty() || result.ec != errc() || result.ptr != line.data() + line.size()) {
+                return fail(400);
+            }
+            cursor = lineEnd + 2;
+            if (size == 0) {
+                state = State::Trailers;
+                continue;
+            }
+            if (size > maxBody || req.body.size() + size > maxBody) return fail(413);
+            chunkRemaining = size + 2;
+            state = State::ChunkData;
+        } else if (state == State::ChunkData) {
+            if (buffer.size() - cursor < chunkRemaining) return Status::NeedMore;
+            if (buffer.compare(cursor + chunkRemaining - 2, 2, "\r\n") != 0) return fail(400);
+            req.body.append(buffer.data() + cursor, chunkRemaining - 2);
+            cursor += chunkRemaining;
+            chunkRemaining = 0;
+            state = State::ChunkSize;
+        } else {
+            // Trailer fields (ignored) up to the final blank line
+            size_t lineEnd = buffer.find("\r\n", cursor);
+            if (lineEnd == string_view::npos) {
+                if (buffer.size() - cursor > MAX_HEAD_BYTES) return fail(431);
+                return Status::NeedMore;
+            }
+            bool last = lineEnd == cursor;
+            cursor = lineEnd + 2;
+            if (last) {
+                state = State::Done;
+                return Status::Complete;
+            }
+        }
+    }
+}
+
+#endif // HTTP_REQUEST_PARSER_H
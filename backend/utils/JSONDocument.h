@@ -0,0 +1,547 @@
+#ifndef JSON_DOCUMENT_H
+#define JSON_DOCUMENT_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <charconv>
+#include <limits>
+
+using namespace std;
+
+/**
+ * JSONDocument - Single-pass JSON parser into a flat, zero-copy DOM
+ *
+ * parse() reads the input once, left to right, and appends one node per
+ * value to a flat vector in document order. A container records the index
+ * just past its subtree, so siblings are reached by skipping rather than
+ * through child pointers, and nesting costs nothing extra.
+ *
+ * Nothing is copied out of the input: numbers, literals and strings
+ * without escapes are string_views into it. Strings with escapes are
+ * decoded into an arena reserved to the input length before parsing (a
+ * decoded string is never longer than its source), so views into the
+ * arena never move. The input must outlive the document; parse() can be
+ * called again on the same document to reuse its capacity.
+ *
+ * Accessors are typed and never throw: a missing key or a value of another
+ * type yields the caller's default. As with the old map-based parser,
+ * getInt also reads numeric strings ("3") and getBool reads "true"/"1".
+ */
+class JSONDocument {
+public:
+    enum class Type : uint8_t { MISSING, NUL, BOOL, NUMBER, STRING, ARRAY, OBJECT };
+
+private:
+    struct Node {
+        Type type;
+        uint32_t end;      // Index one past this node's subtree
+        uint32_t count;    // Elements of an array, members of an object
+        string_view text;  // Decoded string, number/literal token, or container source
+    };
+
+    static constexpr int MAX_DEPTH = 64;
+
+    vector<Node> nodes;    // Objects hold key, value, key, value, ...
+    string arena;          // Decoded escaped strings
+    string_view input;
+    size_t pos = 0;
+    int depth = 0;
+    string errorMessage;
+
+    bool fail(const char* message);
+    void skipSpace();
+    uint32_t addNode(Type type);
+    bool parseValue();
+    bool parseObject();
+    bool parseArray();
+    bool parseString();
+    bool parseNumber();
+    bool parseLiteral(string_view literal, Type type);
+    bool decodeEscapes(size_t start);
+    bool readHex4(uint32_t& code);
+    void appendUTF8(uint32_t code);
+
+    static bool toInt64(string_view text, int64_t& out);
+
+public:
+    // A read-only handle to one node; cheap to copy
+    class Value {
+    private:
+        const JSONDocument* doc = nullptr;
+        uint32_t index = 0;
+
+        const Node& node() const { return doc->nodes[index]; }
+
+    public:
+        Value() = default;
+        Value(const JSONDocument* d, uint32_t i) : doc(d), index(i) {}
+
+        // Iterates array elements, or object member values (key() gives the name)
+        class Iterator {
+        private:
+            const JSONDocument* doc;
+            uint32_t index;   // Element, or member key in an object
+            bool object;
+
+        public:
+            Iterator(const JSONDocument* d, uint32_t i, bool isObject) : doc(d), index(i), object(isObject) {}
+
+            Value operator*() const { return Value(doc, object ? index + 1 : index); }
+            string_view key() const { return object ? doc->nodes[index].text : string_view(); }
+
+            Iterator& operator++() {
+                index = doc->nodes[object ? index + 1 : index].end;
+                return *this;
+            }
+
+            bool operator==(const Iterator& other) const { return index == other.index; }
+            bool operator!=(const Iterator& other) const { return index != other.index; }
+        };
+
+        Type type() const { return doc ? node().type : Type::MISSING; }
+        bool exists() const { return doc != nullptr; }
+        bool isNull() const { return type() == Type::NUL; }
+        bool isBool() const { return type() == Type::BOOL; }
+        bool isNumber() const { return type() == Type::NUMBER; }
+        bool isString() const { return type() == Type::STRING; }
+        bool isArray() const { return type() == Type::ARRAY; }
+        bool isObject() const { return type() == Type::OBJECT; }
+
+        // Elements of an array or members of an object; 0 for scalars
+        size_t size() const { return isArray() || isObject() ? node().count : 0; }
+
+        // Decoded string, number/literal token, or container source text
+        string_view text() const { return doc ? node().text : string_view(); }
+
+        // Object member by name (first match), or a missing value
+        Value operator[](string_view key) const;
+
+        // Array element by position, or a missing value
+        Value at(size_t i) const;
+
+        Iterator begin() const;
+        Iterator end() const;
+
+        // Typed reads; numbers and booleans read as strings give their token
+        string_view asString(string_view defaultValue = "") const;
+        int64_t asInt64(int64_t defaultValue = 0) const;
+        int asInt(int defaultValue = 0) const;
+        bool asBool(bool defaultValue = false) const;
+    };
+
+    // Parse a complete document; false (with error()) on malformed input
+    bool parse(string_view json);
+
+    const string& error() const { return errorMessage; }
+
+    // Top-level value, missing if the last parse failed
+    Value root() const { return nodes.empty() ? Value() : Value(this, 0); }
+    Value operator[](string_view key) const { return root()[key]; }
+
+    // Shortcuts for members of a top-level object (request bodies)
+    string getString(string_view key, string_view defaultValue = "") const {
+        return string(root()[key].asString(defaultValue));
+    }
+    int getInt(string_view key, int defaultValue = 0) const { return root()[key].asInt(defaultValue); }
+    int64_t getInt64(string_view key, int64_t defaultValue = 0) const { return root()[key].asInt64(defaultValue); }
+    bool getBool(string_view key, bool defaultValue = false) const { return root()[key].asBool(defaultValue); }
+
+    // String elements of an array member; other elements are skipped
+    vector<string> getStringArray(string_view key) const;
+};
+
+// ==================== Implementation ====================
+
+inline bool JSONDocument::parse(string_view json) {
+    nodes.clear();
+    arena.clear();
+    arena.reserve(json.size());  // Decoded strings fit: no reallocation, views stay valid
+    errorMessage.clear();
+    input = json;
+    pos = 0;
+    depth = 0;
+
+    if (!parseValue()) {
+        nodes.clear();
+        return false;
+    }
+    skipSpace();
+    if (pos != input.size()) {
+        nodes.clear();
+        return fail("Unexpected data after the document");
+    }
+    return true;
+}
+
+inline bool JSONDocument::fail(const char* message) {
+    if (errorMessage.empty()) {
+        errorMessage = string(message) + " at offset " + to_string(pos);
+    }
+    return false;
+}
+
+inline void JSONDocument::skipSpace() {
+    while (pos < input.size()) {
+        char c = input[pos];
+        if (c != ' ' && c != '\n' && c != '\r' && c != '\t') break;
+        pos++;
+    }
+}
+
+inline uint32_t JSONDocument::addNode(Type type) {
+    nodes.push_back({type, static_cast<uint32_t>(nodes.size() + 1), 0, string_view()});
+    return static_cast<uint32_t>(nodes.size() - 1);
+}
+
+inline bool JSONDocument::parseValue() {
+    skipSpace();
+    if (pos >= input.size()) {
+        return fail("Unexpected end of input");
+    }
+    switch (input[pos]) {
+        case '{': return parseObject();
+        case '[': return parseArray();
+        case '"': return parseString();
+        case 't': return parseLiteral("true", Type::BOOL);
+        case 'f': return parseLiteral("false", Type::BOOL);
+        case 'n': return parseLiteral("null", Type::NUL);
+        default:
+            if (input[pos] == '-' || (input[pos] >= '0' && input[pos] <= '9')) {
+                return parseNumber();
+            }
+            return fail("Unexpected character");
+    }
+}
+
+inline bool JSONDocument::parseObject() {
+    if (++depth > MAX_DEPTH) {
+        return fail("Nesting too deep");
+    }
+    size_t start = pos++;
+    uint32_t self = addNode(Type::OBJECT);
+    uint32_t count = 0;
+
+    skipSpace();
+    if (pos < input.size() && input[pos] == '}') {
+        pos++;
+    } else {
+        while (true) {
+            skipSpace();
+            if (pos >= input.size() || input[pos] != '"') {
+                return fail("Expected a member name");
+            }
+            if (!parseString()) return false;
+            skipSpace();
+            if (pos >= input.size() || input[pos] != ':') {
+                return fail("Expected ':'");
+            }
+            pos++;
+            if (!parseValue()) return false;
+            count++;
+
+            skipSpace();
+            if (pos < input.size() && input[pos] == ',') {
+                pos++;
+            } else if (pos < input.size() && input[pos] == '}') {
+                pos++;
+                break;
+            } else {
+                return fail("Expected ',' or '}'");
+            }
+        }
+    }
+
+    Node& node = nodes[self];
+    node.end = static_cast<uint32_t>(nodes.size());
+    node.count = count;
+    node.text = input.substr(start, pos - start);
+    depth--;
+    return true;
+}
+
+inline bool JSONDocument::parseArray() {
+    if (++depth > MAX_DEPTH) {
+        return fail("Nesting too deep");
+    }
+    size_t start = pos++;
+    uint32_t self = addNode(Type::ARRAY);
+    uint32_t count = 0;
+
+    skipSpace();
+    if (pos < input.size() && input[pos] == ']') {
+        pos++;
+    } else {
+        while (true) {
+            if (!parseValue()) return false;
+            count++;
+
+            skipSpace();
+            if (pos < input.size() && input[pos] == ',') {
+                pos++;
+            } else if (pos < input.size() && input[pos] == ']') {
+                pos++;
+                break;
+            } else {
+                return fail("Expected ',' or ']'");
+            }
+        }
+    }
+
+    Node& node = nodes[self];
+    node.end = static_cast<uint32_t>(nodes.size());
+    node.count = count;
+    node.text = input.substr(start, pos - start);
+    depth--;
+    return true;
+}
+
+inline bool JSONDocument::parseString() {
+    uint32_t self = addNode(Type::STRING);
+    size_t start = ++pos;  // Past the opening quote
+
+    // Common case: no escapes, the value is a view into the input
+    while (pos < input.size()) {
+        char c = input[pos];
+        if (c == '"') {
+            nodes[self].text = input.substr(start, pos - start);
+            pos++;
+            return true;
+        }
+        if (c == '\\') {
+            size_t arenaStart = arena.size();
+            if (!decodeEscapes(start)) return false;
+            nodes[self].text = string_view(arena.data() + arenaStart, arena.size() - arenaStart);
+            return true;
+        }
+        pos++;
+    }
+    return fail("Unterminated string");
+}
+
+// Copy the string from start into the arena, decoding escapes, up to and
+// past the closing quote. pos is at the first backslash.
+inline bool JSONDocument::decodeEscapes(size_t start) {
+    arena.append(input.data() + start, pos - start);
+
+    while (pos < input.size()) {
+        char c = input[pos++];
+        if (c == '"') {
+            return true;
+        }
+        if (c != '\\') {
+            arena.push_back(c);
+            continue;
+        }
+        if (pos >= input.size()) break;
+
+        char escape = input[pos++];
+        switch (escape) {
+            case '"':  arena.push_back('"'); break;
+            case '\\': arena.push_back('\\'); break;
+            case '/':  arena.push_back('/'); break;
+            case 'b':  arena.push_back('\b'); break;
+            case 'f':  arena.push_back('\f'); break;
+            case 'n':  arena.push_back('\n'); break;
+            case 'r':  arena.push_back('\r'); break;
+            case 't':  arena.push_back('\t'); break;
+            case 'u': {
+                uint32_t code = 0;
+                if (!readHex4(code)) return false;
+                if (code >= 0xD800 && code <= 0xDBFF) {
+                    // High surrogate: must pair with a following \uDC00-\uDFFF
+                    uint32_t low = 0;
+                    if (input.substr(pos, 2) != "\\u") return fail("Unpaired surrogate");
+                    pos += 2;
+                    if (!readHex4(low)) return false;
+                    if (low < 0xDC00 || low > 0xDFFF) return fail("Unpaired surrogate");
+                    code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                } else if (code >= 0xDC00 && code <= 0xDFFF) {
+                    return fail("Unpaired surrogate");
+                }
+                appendUTF8(code);
+                break;
+            }
+            default:
+                pos--;
+                return fail("Invalid escape");
+        }
+    }
+    return fail("Unterminated string");
+}
+
+inline bool JSONDocument::readHex4(uint32_t& code) {
+    if (pos + 4 > input.size()) {
+        return fail("Truncated unicode escape");
+    }
+    code = 0;
+    for (int i = 0; i < 4; i++) {
+        char c = input[pos++];
+        code <<= 4;
+        if (c >= '0' && c <= '9') code |= c - '0';
+        else if (c >= 'a' && c <= 'f') code |= c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') code |= c - 'A' + 10;
+        else return fail("Invalid unicode escape");
+    }
+    return true;
+}
+
+inline void JSONDocument::appendUTF8(uint32_t code) {
+    if (code < 0x80) {
+        arena.push_back(static_cast<char>(code));
+    } else if (code < 0x800) {
+        arena.push_back(static_cast<char>(0xC0 | (code >> 6)));
+        arena.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    } else if (code < 0x10000) {
+        arena.push_back(static_cast<char>(0xE0 | (code >> 12)));
+        arena.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        arena.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    } else {
+        arena.push_back(static_cast<char>(0xF0 | (code >> 18)));
+        arena.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+        arena.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        arena.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    }
+}
+
+inline bool JSONDocument::parseNumber() {
+    size_t start = pos;
+    auto digits = [this]() {
+        size_t first = pos;
+        while (pos < input.size() && input[pos] >= '0' && input[pos] <= '9') pos++;
+        return pos > first;
+    };
+
+    if (input[pos] == '-') pos++;
+    if (pos < input.size() && input[pos] == '0') {
+        pos++;  // No leading zeros
+    } else if (!digits()) {
+        return fail("Invalid number");
+    }
+    if (pos < input.size() && input[pos] == '.') {
+        pos++;
+        if (!digits()) return fail("Invalid number");
+    }
+    if (pos < input.size() && (input[pos] == 'e' || input[pos] == 'E')) {
+        pos++;
+        if (pos < input.size() && (input[pos] == '+' || input[pos] == '-')) pos++;
+        if (!digits()) return fail("Invalid number");
+    }
+
+    uint32_t self = addNode(Type::NUMBER);
+    nodes[self].text = input.substr(start, pos - start);
+    return true;
+}
+
+inline bool JSONDocument::parseLiteral(string_view literal, Type type) {
+    if (input.substr(pos, literal.size()) != literal) {
+        return fail("Invalid literal");
+    }
+    uint32_t self = addNode(type);
+    nodes[self].text = input.substr(pos, literal.size());
+    pos += literal.size();
+    return true;
+}
+
+inline bool JSONDocument::toInt64(string_view text, int64_t& out) {
+    const char* first = text.data();
+    const char* last = first + text.size();
+    auto result = from_chars(first, last, out);
+    if (result.ec == errc() && result.ptr == last) {
+        return true;
+    }
+
+    // Fraction or exponent: truncate toward zero if it fits
+    double value;
+    auto real = from_chars(first, last, value);
+    if (real.ec != errc() || real.ptr != last || !(value > -9.2e18 && value < 9.2e18)) {
+        return false;
+    }
+    out = static_cast<int64_t>(value);
+    return true;
+}
+
+inline JSONDocument::Value JSONDocument::Value::operator[](string_view key) const {
+    if (!isObject()) {
+        return Value();
+    }
+    for (auto it = begin(); it != end(); ++it) {
+        if (it.key() == key) {
+            return *it;
+        }
+    }
+    return Value();
+}
+
+inline JSONDocument::Value JSONDocument::Value::at(size_t i) const {
+    if (!isArray() || i >= node().count) {
+        return Value();
+    }
+    auto it = begin();
+    while (i-- > 0) ++it;
+    return *it;
+}
+
+inline JSONDocument::Value::Iterator JSONDocument::Value::begin() const {
+    if (!isArray() && !isObject()) {
+        return end();
+    }
+    return Iterator(doc, index + 1, isObject());
+}
+
+inline JSONDocument::Value::Iterator JSONDocument::Value::end() const {
+    return Iterator(doc, doc ? node().end : 0, isObject());
+}
+
+inline string_view JSONDocument::Value::asString(string_view defaultValue) const {
+    Type t = type();
+    if (t == Type::STRING || t == Type::NUMBER || t == Type::BOOL) {
+        return node().text;
+    }
+    return defaultValue;
+}
+
+inline int64_t JSONDocument::Value::asInt64(int64_t defaultValue) const {
+    int64_t value;
+    if ((isNumber() || isString()) && toInt64(node().text, value)) {
+        return value;
+    }
+    return defaultValue;
+}
+
+inline int JSONDocument::Value::asInt(int defaultValue) const {
+    int64_t value;
+    if ((isNumber() || isString()) && toInt64(node().text, value) &&
+        value >= numeric_limits<int>::min() && value <= numeric_limits<int>::max()) {
+        return static_cast<int>(value);
+    }
+    return defaultValue;
+}
+
+inline bool JSONDocument::Value::asBool(bool defaultValue) const {
+    switch (type()) {
+        case Type::BOOL:
+            return node().text == "true";
+        case Type::STRING:
+            return node().text == "true" || node().text == "1";
+        case Type::NUMBER:
+            return asInt64(0) != 0;
+        default:
+            return defaultValue;
+    }
+}
+
+inline vector<string> JSONDocument::getStringArray(string_view key) const {
+    vector<string> result;
+    Value array = root()[key];
+    result.reserve(array.size());
+    for (Value element : array) {
+        if (element.isString()) {
+            result.emplace_back(element.asString());
+        }
+    }
+    return result;
+}
+
+#endif // JSON_DOCUMENT_H
@@ -5,14 +5,16 @@
 #include <map>
 #include <vector>
 #include <sstream>
+#include "JSONDocument.h"
 
 using namespace std;
 
-// Simple JSON parser for basic request/response handling
+// Simple JSON helpers for basic request/response handling
 // Supports: strings, numbers, booleans, arrays (strings only)
+// Request handlers parse with JSONDocument; parse() remains for the CLI client
 class JSONParser {
 public:
-    // Parse JSON string to key-value map
+    // Parse a JSON object to a key-value map of its top-level members
     static map<string, string> parse(const string& json);
     
     // Create JSON string from map
@@ -54,48 +56,25 @@ inline string JSONParser::unquote(const string& str) {
 
 inline map<string, string> JSONParser::parse(const string& json) {
     map<string, string> result;
-    
-    // Find opening and closing braces
-    size_t start = json.find('{');
-    size_t end = json.rfind('}');
-    if (start == string::npos || end == string::npos) {
+
+    JSONDocument doc;
+    if (!doc.parse(json)) {
         return result;
     }
-    
-    string content = json.substr(start + 1, end - start - 1);
-    
-    // Simple tokenizer - split by comma (not inside quotes)
-    vector<string> pairs;
-    string current;
-    bool inQuotes = false;
-    
-    for (char c : content) {
-        if (c == '"') {
-            inQuotes = !inQuotes;
-            current += c;
-        } else if (c == ',' && !inQuotes) {
-            if (!current.empty()) {
-                pairs.push_back(current);
-                current.clear();
-            }
+
+    // Strings are kept quoted (getString unquotes them); other values,
+    // including nested arrays and objects, as their source text
+    JSONDocument::Value root = doc.root();
+    for (auto it = root.begin(); it != root.end(); ++it) {
+        JSONDocument::Value value = *it;
+        string& entry = result[string(it.key())];
+        if (value.isString()) {
+            entry = "\"" + string(value.asString()) + "\"";
         } else {
-            current += c;
+            entry = string(value.text());
         }
     }
-    if (!current.empty()) {
-        pairs.push_back(current);
-    }
-    
-    // Parse each key-value pair
-    for (const string& pair : pairs) {
-        size_t colonPos = pair.find(':');
-        if (colonPos != string::npos) {
-            string key = unquote(pair.substr(0, colonPos));
-            string value = trim(pair.substr(colonPos + 1));
-            result[key] = value;
-        }
-    }
-    
+
     return result;
 }
 
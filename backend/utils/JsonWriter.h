@@ -0,0 +1,148 @@
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <string>
+#include <string_view>
+#include <charconv>
+#include <type_traits>
+
+using namespace std;
+
+/**
+ * JsonWriter - Streaming JSON output into one reusable buffer
+ *
+ * Values are appended to the buffer as they are produced: there is no
+ * intermediate stringstream, map or second escaping pass. Commas are
+ * inserted automatically, names and strings are escaped (quotes,
+ * backslashes, control characters), and integers are formatted with
+ * to_chars.
+ *
+ * The default constructor writes into a buffer owned by the calling
+ * thread, so after the first few responses building one allocates
+ * nothing; use at most one such writer per thread at a time. The buffer
+ * is cleared, not freed, when the next writer starts.
+ *
+ * Usage:
+ *   JsonWriter json;
+ *   json.beginObject()
+ *       .member("success", "true")
+ *       .key("courses").beginArray();
+ *   for (...) json.beginObject().member("courseID", id).endObject();
+ *   json.endArray().endObject();
+ *   return HTTPServer::jsonSuccess(json);
+ */
+class JsonWriter {
+private:
+    string& out;
+    bool needComma = false;  // A value was just completed at this level
+
+    static string& threadBuffer() {
+        thread_local string buffer;
+        return buffer;
+    }
+
+    void separate() {
+        if (needComma) out.push_back(',');
+    }
+
+    template<typename Int>
+    void appendInteger(Int n) {
+        char digits[24];
+        auto result = to_chars(digits, digits + sizeof(digits), n);
+        out.append(digits, result.ptr - digits);
+    }
+
+    void appendEscaped(string_view s);
+
+public:
+    template<typename Int>
+    using IfInteger = enable_if_t<is_integral_v<Int> && !is_same_v<Int, bool>, JsonWriter&>;
+
+    // Write into this thread's buffer
+    JsonWriter() : out(threadBuffer()) { out.clear(); }
+
+    // Write into a caller-owned buffer (cleared first)
+    explicit JsonWriter(string& buffer) : out(buffer) { out.clear(); }
+
+    JsonWriter(const JsonWriter&) = delete;
+    JsonWriter& operator=(const JsonWriter&) = delete;
+
+    JsonWriter& beginObject() { separate(); out.push_back('{'); needComma = false; return *this; }
+    JsonWriter& endObject() { out.push_back('}'); needComma = true; return *this; }
+    JsonWriter& beginArray() { separate(); out.push_back('['); needComma = false; return *this; }
+    JsonWriter& endArray() { out.push_back(']'); needComma = true; return *this; }
+
+    // Member name inside an object; the next call writes its value
+    JsonWriter& key(string_view name) {
+        separate();
+        appendEscaped(name);
+        out.push_back(':');
+        needComma = false;
+        return *this;
+    }
+
+    JsonWriter& value(string_view s) { separate(); appendEscaped(s); needComma = true; return *this; }
+    JsonWriter& value(const char* s) { return value(string_view(s)); }
+    JsonWriter& value(const string& s) { return value(string_view(s)); }
+    JsonWriter& value(bool b) { separate(); out += b ? "true" : "false"; needComma = true; return *this; }
+    JsonWriter& null() { separate(); out += "null"; needComma = true; return *this; }
+
+    template<typename Int>
+    IfInteger<Int> value(Int n) { separate(); appendInteger(n); needComma = true; return *this; }
+
+    // Integer as a JSON string ("42"), for fields clients read as strings
+    template<typename Int>
+    IfInteger<Int> quoted(Int n) {
+        separate();
+        out.push_back('"');
+        appendInteger(n);
+        out.push_back('"');
+        needComma = true;
+        return *this;
+    }
+
+    // Already-serialized JSON, written as is
+    JsonWriter& raw(string_view json) { separate(); out.append(json); needComma = true; return *this; }
+
+    template<typename T>
+    JsonWriter& member(string_view name, const T& v) { return key(name).value(v); }
+
+    JsonWriter& member(string_view name, const char* v) { return key(name).value(string_view(v)); }
+
+    const string& str() const { return out; }
+    size_t size() const { return out.size(); }
+};
+
+// ==================== Implementation ====================
+
+inline void JsonWriter::appendEscaped(string_view s) {
+    static const char HEX[] = "0123456789abcdef";
+
+    out.push_back('"');
+    size_t run = 0;  // Start of the pending run of plain characters
+    for (size_t i = 0; i < s.size(); i++) {
+        unsigned char c = static_cast<unsigned char>(s[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        out.append(s.data() + run, i - run);
+        run = i + 1;
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            default:
+                out += "\\u00";
+                out.push_back(HEX[c >> 4]);
+                out.push_back(HEX[c & 0xF]);
+        }
+    }
+    out.append(s.data() + run, s.size() - run);
+    out.push_back('"');
+}
+
+#endif // JSON_WRITER_H
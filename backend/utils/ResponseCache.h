@@ -0,0 +1,170 @@
+#ifndef RESPONSE_CACHE_H
+#define RESPONSE_CACHE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+/**
+ * ResponseCache - Bounded LRU cache of rendered GET responses
+ *
+ * An entry is keyed by route path plus its query parameters (sorted by
+ * name, see key()) and tagged with the write generations of the stores the
+ * response was built from (DatabaseManager::generation). A lookup hits only
+ * if the caller's current generations equal the tags, so an entry goes stale
+ * exactly when a write changes one of those stores - writers never have to
+ * know the cache exists. Callers read the generations BEFORE building a
+ * response: a write racing with the build then leaves the new entry already
+ * stale instead of caching data older than its tags.
+ *
+ * Entries beyond maxBytes (key, headers and body) are evicted least
+ * recently used first. Bodies are shared, so a hit copies them outside the
+ * lock.
+ */
+class ResponseCache {
+public:
+    struct Entry {
+        int status = 200;
+        map<string, string> headers;
+        shared_ptr<const string> body;
+        string etag;  // Of body, so a conditional hit needs no rehash
+    };
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;      // Including stale entries
+        uint64_t stale = 0;       // Found, but a store had been written since
+        uint64_t evictions = 0;
+        size_t entries = 0;
+        size_t bytes = 0;
+    };
+
+    explicit ResponseCache(size_t maxBytes) : maxBytes(maxBytes) {}
+
+    ResponseCache(const ResponseCache&) = delete;
+    ResponseCache& operator=(const ResponseCache&) = delete;
+
+    bool enabled() const { return maxBytes > 0; }
+
+    // Cache key for a path and its decoded query parameters: the same
+    // parameters in any order give the same key
+    template<typename Params>
+    static string key(string_view path, const Params& params) {
+        vector<pair<string_view, string_view>> sorted;
+        sorted.reserve(params.size());
+        size_t length = path.size();
+        for (const auto& p : params) {
+            sorted.emplace_back(p.first, p.second);
+            length += p.first.size() + p.second.size() + 2;
+        }
+        // Stable: repeated names keep their order, which the handler may rely on
+        stable_sort(sorted.begin(), sorted.end(),
+                    [](const auto& a, const auto& b) { return a.first < b.first; });
+        string key;
+        key.reserve(length);
+        key.append(path);
+        for (const auto& p : sorted) {
+            // NUL can't appear in a decoded path, so keys never collide
+            key.push_back('\0');
+            key.append(p.first);
+            key.push_back('\0');
+            key.append(p.second);
+        }
+        return key;
+    }
+
+    // Copy out the entry for key if it was stored with these generations;
+    // a stale entry is dropped
+    bool lookup(const string& key, const vector<uint64_t>& generations, Entry& out) {
+        lock_guard<mutex> lock(m);
+        auto it = index.find(key);
+        if (it == index.end()) {
+            counters.misses++;
+            return false;
+        }
+        if (it->second->generations != generations) {
+            counters.stale++;
+            counters.misses++;
+            erase(it->second);
+            return false;
+        }
+        lru.splice(lru.begin(), lru, it->second);  // Most recently used first
+        counters.hits++;
+        out = it->second->entry;
+        return true;
+    }
+
+    // Remember a response built from data at these generations
+    void store(const string& key, vector<uint64_t> generations, Entry entry) {
+        size_t bytes = NODE_OVERHEAD + 2 * key.size() + entry.etag.size() +
+                       (entry.body ? entry.body->size() : 0);
+        for (const auto& header : entry.headers) {
+            bytes += header.first.size() + header.second.size();
+        }
+        if (bytes > maxBytes) return;  // Would evict everything else
+
+        lock_guard<mutex> lock(m);
+        auto it = index.find(key);
+        if (it != index.end()) {
+            erase(it->second);  // Replaced by a newer response
+        }
+        while (!lru.empty() && usedBytes + bytes > maxBytes) {
+            erase(prev(lru.end()));
+            counters.evictions++;
+        }
+        lru.push_front(Node{key, move(generations), move(entry), bytes});
+        index.emplace(lru.front().key, lru.begin());
+        usedBytes += bytes;
+    }
+
+    Stats stats() const {
+        lock_guard<mutex> lock(m);
+        Stats s = counters;
+        s.entries = lru.size();
+        s.bytes = usedBytes;
+        return s;
+    }
+
+    void clear() {
+        lock_guard<mutex> lock(m);
+        index.clear();
+        lru.clear();
+        usedBytes = 0;
+    }
+
+private:
+    struct Node {
+        string key;
+        vector<uint64_t> generations;
+        Entry entry;
+        size_t bytes;
+    };
+
+    // List node, index slot and small allocations of an entry
+    static constexpr size_t NODE_OVERHEAD = 160;
+
+    size_t maxBytes;
+    mutable mutex m;
+    list<Node> lru;                                          // Most recently used first
+    unordered_map<string_view, list<Node>::iterator> index;  // Views Node::key
+    size_t usedBytes = 0;
+    Stats counters;
+
+    void erase(list<Node>::iterator node) {
+        usedBytes -= node->bytes;
+        index.erase(node->key);
+        lru.erase(node);
+    }
+};
+
+#endif // RESPONSE_CACHE_H
@@ -0,0 +1,235 @@
+#ifndef ROUTER_H
+#define ROUTER_H
+
+#include "../../database/FlatHashTable.h"
+#include "../../database/SeededHash.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <stdexcept>
+
+using namespace std;
+
+/**
+ * Router - Request routing table: exact paths in a hash table, patterns in
+ * a radix trie
+ *
+ * Patterns are literal paths ("/api/login") or contain ":name" segments
+ * that match one non-empty path segment ("/api/student/:studentID/timetable").
+ * Each method has its own table:
+ *
+ * - Literal paths go into a FlatHashTable, so the common case is one hash
+ *   and one probe, whatever the number of routes
+ * - Parameterized patterns go into a radix trie whose edges are runs of
+ *   literal characters (shared prefixes such as "/api/admin/" are stored
+ *   once) plus at most one ":name" child per node. Literal edges are
+ *   tried before the parameter, so "/users/me" beats "/users/:id"
+ *
+ * find() fills params with views into the pattern names and the path; they
+ * are valid while the router and the path string are.
+ */
+template<typename Handler>
+class Router {
+public:
+    using Params = vector<pair<string_view, string_view>>;
+
+private:
+    struct Node {
+        string label;                       // Literal characters on the edge into this node
+        vector<unique_ptr<Node>> children;  // Literal edges, distinct first characters
+        unique_ptr<Node> param;             // ":name" edge
+        string paramName;                   // Name of the param child's segment
+        size_t route = NO_ROUTE;            // Index into routes
+    };
+
+    struct MethodTable {
+        string method;
+        FlatHashTable<string, size_t, SeededHash<string>> exact;
+        Node trie;
+    };
+
+    static constexpr size_t NO_ROUTE = static_cast<size_t>(-1);
+
+    vector<unique_ptr<MethodTable>> tables;  // A handful of methods: linear scan
+    vector<Handler> routes;
+
+    MethodTable* tableFor(string_view method) const;
+    void insert(Node* node, string_view pattern, size_t route);
+    const Node* match(const Node* node, string_view path, Params& params) const;
+
+public:
+    Router() = default;
+    Router(const Router&) = delete;
+    Router& operator=(const Router&) = delete;
+
+    // Register a handler; throws invalid_argument for a malformed pattern or
+    // one that is already registered for this method
+    void add(string_view method, string_view pattern, Handler handler);
+
+    // Handler for method and path (nullptr if none); params gets the
+    // ":name" segments of a parameterized match
+    const Handler* find(string_view method, string_view path, Params& params) const;
+
+    size_t size() const { return routes.size(); }
+};
+
+// ==================== Implementation ====================
+
+template<typename Handler>
+typename Router<Handler>::MethodTable* Router<Handler>::tableFor(string_view method) const {
+    for (const auto& table : tables) {
+        if (table->method == method) {
+            return table.get();
+        }
+    }
+    return nullptr;
+}
+
+template<typename Handler>
+void Router<Handler>::add(string_view method, string_view pattern, Handler handler) {
+    if (pattern.empty() || pattern[0] != '/') {
+        throw invalid_argument("Route pattern must start with '/': " + string(pattern));
+    }
+
+    MethodTable* table = tableFor(method);
+    if (table == nullptr) {
+        tables.push_back(make_unique<MethodTable>());
+        table = tables.back().get();
+        table->method = string(method);
+    }
+
+    size_t route = routes.size();
+    if (pattern.find(':') == string_view::npos) {
+        if (table->exact.contains(pattern)) {
+            throw invalid_argument("Duplicate route: " + string(method) + " " + string(pattern));
+        }
+        table->exact.insert(string(pattern), route);
+    } else {
+        insert(&table->trie, pattern, route);
+    }
+    routes.push_back(move(handler));
+}
+
+template<typename Handler>
+void Router<Handler>::insert(Node* node, string_view pattern, size_t route) {
+    while (!pattern.empty()) {
+        if (pattern[0] == ':') {
+            size_t end = pattern.find('/');
+            string_view name = pattern.substr(1, end == string_view::npos ? string_view::npos : end - 1);
+            if (name.empty() || name.find(':') != string_view::npos) {
+                throw invalid_argument("Invalid parameter in route pattern");
+            }
+            if (node->param == nullptr) {
+                node->param = make_unique<Node>();
+                node->paramName = string(name);
+            } else if (node->paramName != name) {
+                throw invalid_argument("Conflicting parameter names :" + node->paramName +
+                                       " and :" + string(name));
+            }
+            node = node->param.get();
+            pattern = end == string_view::npos ? string_view() : pattern.substr(end);
+            continue;
+        }
+
+        // Literal run up to the next parameter
+        string_view literal = pattern.substr(0, pattern.find(':'));
+        Node* child = nullptr;
+        for (auto& candidate : node->children) {
+            if (candidate->label[0] == literal[0]) {
+                child = candidate.get();
+                break;
+            }
+        }
+
+        if (child == nullptr) {
+            node->children.push_back(make_unique<Node>());
+            child = node->children.back().get();
+            child->label = string(literal);
+            node = child;
+            pattern.remove_prefix(literal.size());
+            continue;
+        }
+
+        size_t common = 0;
+        while (common < literal.size() && common < child->label.size() &&
+               literal[common] == child->label[common]) {
+            common++;
+        }
+
+        if (common < child->label.size()) {
+            // Split the edge: child keeps the tail under a new shared prefix
+            auto split = make_unique<Node>();
+            split->label = child->label.substr(0, common);
+            child->label.erase(0, common);
+            for (auto& slot : node->children) {
+                if (slot.get() == child) {
+                    split->children.push_back(move(slot));
+                    slot = move(split);
+                    child = slot.get();
+                    break;
+                }
+            }
+        }
+        node = child;
+        pattern.remove_prefix(common);
+    }
+
+    if (node->route != NO_ROUTE) {
+        throw invalid_argument("Duplicate route pattern");
+    }
+    node->route = route;
+}
+
+template<typename Handler>
+const typename Router<Handler>::Node* Router<Handler>::match(const Node* node, string_view path,
+                                                             Params& params) const {
+    if (path.empty()) {
+        return node->route != NO_ROUTE ? node : nullptr;
+    }
+
+    // Literal edges first; at most one can start with path[0]
+    for (const auto& child : node->children) {
+        if (child->label[0] == path[0]) {
+            if (path.compare(0, child->label.size(), child->label) == 0) {
+                const Node* found = match(child.get(), path.substr(child->label.size()), params);
+                if (found != nullptr) {
+                    return found;
+                }
+            }
+            break;
+        }
+    }
+
+    // Then the parameter: one non-empty segment
+    if (node->param != nullptr) {
+        size_t end = min(path.find('/'), path.size());
+        if (end > 0) {
+            params.emplace_back(node->paramName, path.substr(0, end));
+            const Node* found = match(node->param.get(), path.substr(end), params);
+            if (found != nullptr) {
+                return found;
+            }
+            params.pop_back();
+        }
+    }
+    return nullptr;
+}
+
+template<typename Handler>
+const Handler* Router<Handler>::find(string_view method, string_view path, Params& params) const {
+    const MethodTable* table = tableFor(method);
+    if (table == nullptr) {
+        return nullptr;
+    }
+
+    const size_t* exact = table->exact.get(path);
+    if (exact != nullptr) {
+        return &routes[*exact];
+    }
+
+    const Node* node = match(&table->trie, path, params);
+    return node != nullptr ? &routes[node->route] : nullptr;
+}
+
+#endif // ROUTER_H
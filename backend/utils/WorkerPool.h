@@ -0,0 +1,143 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include "../../external/httplib.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+/**
+ * WorkerPool - httplib task queue with a bounded backlog and a shed lane
+ *
+ * httplib hands the queue one task per accepted connection. Up to
+ * `workers` connections are served at once and up to `maxQueued` wait for
+ * a worker. When the backlog is full the connection is not dropped: it
+ * goes to a small shed lane whose threads only answer "503 Service
+ * Unavailable" (HTTPServer checks shedding() before routing), so clients
+ * see a clean, retryable rejection instead of a reset. Only when the shed
+ * lane is full too does enqueue() refuse and httplib close the socket.
+ *
+ * maxQueued == 0 means an unbounded backlog (httplib's default behaviour).
+ */
+class WorkerPool : public httplib::TaskQueue {
+public:
+    static constexpr size_t SHED_THREADS = 1;
+
+    WorkerPool(size_t workers, size_t maxQueued)
+        : main(maxQueued), shed(maxQueued == 0 ? 0 : max<size_t>(maxQueued, 16)) {
+        for (size_t i = 0; i < max<size_t>(workers, 1); i++) {
+            main.threads.emplace_back(&WorkerPool::run, this, ref(main), false);
+        }
+        if (maxQueued > 0) {
+            for (size_t i = 0; i < SHED_THREADS; i++) {
+                shed.threads.emplace_back(&WorkerPool::run, this, ref(shed), true);
+            }
+        }
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    ~WorkerPool() override { shutdown(); }
+
+    bool enqueue(function<void()> fn) override {
+        if (main.push(fn)) {
+            return true;
+        }
+        if (!shed.threads.empty() && shed.push(fn)) {
+            shedCount.fetch_add(1, memory_order_relaxed);
+            return true;
+        }
+        refusedCount.fetch_add(1, memory_order_relaxed);
+        return false;
+    }
+
+    // Finish queued connections, then join every thread
+    void shutdown() override {
+        main.close();
+        shed.close();
+    }
+
+    // True on a shed-lane thread: the request should get a 503
+    static bool shedding() { return sheddingThread(); }
+
+    size_t queued() const { return main.size(); }
+    size_t shedConnections() const { return shedCount.load(memory_order_relaxed); }
+    size_t refusedConnections() const { return refusedCount.load(memory_order_relaxed); }
+
+private:
+    struct Lane {
+        explicit Lane(size_t limit) : limit(limit) {}
+
+        // Queue a task unless the lane is at its limit (0 = no limit)
+        bool push(function<void()>& fn) {
+            {
+                lock_guard<mutex> lock(m);
+                if (stopping || (limit > 0 && jobs.size() >= limit)) {
+                    return false;
+                }
+                jobs.push_back(move(fn));
+            }
+            ready.notify_one();
+            return true;
+        }
+
+        void close() {
+            {
+                lock_guard<mutex> lock(m);
+                if (stopping && threads.empty()) return;
+                stopping = true;
+            }
+            ready.notify_all();
+            for (auto& t : threads) {
+                if (t.joinable()) t.join();
+            }
+            threads.clear();
+        }
+
+        size_t size() const {
+            lock_guard<mutex> lock(m);
+            return jobs.size();
+        }
+
+        const size_t limit;
+        mutable mutex m;
+        condition_variable ready;
+        deque<function<void()>> jobs;
+        vector<thread> threads;
+        bool stopping = false;
+    };
+
+    Lane main;
+    Lane shed;
+    atomic<size_t> shedCount{0};
+    atomic<size_t> refusedCount{0};
+
+    static bool& sheddingThread() {
+        thread_local bool flag = false;
+        return flag;
+    }
+
+    void run(Lane& lane, bool isShedLane) {
+        sheddingThread() = isShedLane;
+        while (true) {
+            function<void()> fn;
+            {
+                unique_lock<mutex> lock(lane.m);
+                lane.ready.wait(lock, [&] { return !lane.jobs.empty() || lane.stopping; });
+                if (lane.jobs.empty()) break;  // Stopping and drained
+                fn = move(lane.jobs.front());
+                lane.jobs.pop_front();
+            }
+            fn();
+        }
+    }
+};
+
+#endif // WORKER_POOL_H
@@ -0,0 +1,145 @@
+#include "../database/BTree.h"
+#include "../database/BPlusTree.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <algorithm>
+
+using namespace std;
+
+// BTree<string, size_t, ORDER> at ORDER 5/16/64/128 and the cache-line
+// derived defaults: random-order insert, random search, full iteration.
+// BPlusTree rows iterate by walking the leaf chain instead of getAllPairs.
+// The second table times clear() + rebuild in key order (what
+// IndexedStorage::remove does) with NodePool vs one new/delete per node,
+// and with bulkLoad instead of one insert per key.
+// Usage: bench_btree_order [keys]
+
+vector<string> makeKeys(size_t n) {
+    vector<string> keys;
+    for (size_t i = 0; i < n; i++) {
+        string roll = to_string(i % 1000);
+        keys.push_back("BSCS" + to_string(10 + i / 1000) + string(3 - roll.size(), '0') + roll);
+    }
+    return keys;
+}
+
+template<typename Tree>
+size_t iterate(Tree& tree) {
+    return tree.getAllPairs().size();
+}
+
+template<int ORDER>
+size_t iterate(BPlusTree<string, size_t, ORDER>& tree) {
+    size_t sum = 0;
+    for (auto [id, offset] : tree) {
+        sum += offset;
+    }
+    return sum;
+}
+
+template<typename Tree, int ORDER>
+void runTree(const string& label, const vector<string>& inserts, const vector<string>& probes) {
+    Tree tree;
+    
+    auto t0 = chrono::steady_clock::now();
+    for (size_t i = 0; i < inserts.size(); i++) {
+        tree.insert(inserts[i], i);
+    }
+    auto t1 = chrono::steady_clock::now();
+    
+    size_t sink = 0;
+    for (const auto& key : probes) {
+        size_t* value = tree.search(key);
+        if (value != nullptr) sink += *value;
+    }
+    auto t2 = chrono::steady_clock::now();
+    
+    sink += iterate(tree);
+    auto t3 = chrono::steady_clock::now();
+    
+    cout << left << setw(20) << label << right << setw(6) << ORDER << fixed << setprecision(1)
+         << setw(14) << chrono::duration<double, nano>(t1 - t0).count() / inserts.size()
+         << setw(14) << chrono::duration<double, nano>(t2 - t1).count() / probes.size()
+         << setw(14) << chrono::duration<double, milli>(t3 - t2).count()
+         << "   (checksum " << sink << ")" << endl;
+}
+
+template<int ORDER>
+void runOrder(const string& label, const vector<string>& inserts, const vector<string>& probes) {
+    runTree<BTree<string, size_t, ORDER>, ORDER>(label, inserts, probes);
+}
+
+template<int ORDER>
+void runPlus(const string& label, const vector<string>& inserts, const vector<string>& probes) {
+    runTree<BPlusTree<string, size_t, ORDER>, ORDER>(label, inserts, probes);
+}
+
+template<typename Tree>
+void runRebuild(const string& label, const vector<string>& sorted, bool bulk = false) {
+    const int ROUNDS = 5;
+    Tree tree;
+    vector<pair<string, size_t>> pairs;
+    for (size_t i = 0; i < sorted.size(); i++) {
+        tree.insert(sorted[i], i);
+        pairs.emplace_back(sorted[i], i);
+    }
+    
+    auto t0 = chrono::steady_clock::now();
+    for (int round = 0; round < ROUNDS; round++) {
+        if (bulk) {
+            tree.bulkLoad(pairs);
+            continue;
+        }
+        tree.clear();
+        for (size_t i = 0; i < sorted.size(); i++) {
+            tree.insert(sorted[i], i);
+        }
+    }
+    auto t1 = chrono::steady_clock::now();
+    
+    cout << left << setw(34) << label << right << fixed << setprecision(2)
+         << setw(14) << chrono::duration<double, milli>(t1 - t0).count() / ROUNDS << endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? stoul(argv[1]) : 100000;
+    
+    mt19937 rng(7);
+    vector<string> inserts = makeKeys(n);
+    shuffle(inserts.begin(), inserts.end(), rng);
+    vector<string> probes = inserts;
+    shuffle(probes.begin(), probes.end(), rng);
+    
+    cout << "========================================" << endl;
+    cout << "  B-Tree Order Benchmark (" << n << " keys)" << endl;
+    cout << "========================================" << endl;
+    cout << left << setw(20) << "config" << right << setw(6) << "order"
+         << setw(14) << "insert ns/op" << setw(14) << "search ns/op" << setw(14) << "iterate ms" << endl;
+    
+    runOrder<5>("BTree", inserts, probes);
+    runOrder<16>("BTree", inserts, probes);
+    runOrder<64>("BTree", inserts, probes);
+    runOrder<128>("BTree", inserts, probes);
+    runOrder<BTreeCacheOrder<string, size_t, 4>::value>("BTree 4 lines", inserts, probes);
+    runOrder<BTreeCacheOrder<string, size_t, 8>::value>("BTree 8 lines", inserts, probes);
+    runOrder<BTreeCacheOrder<string, size_t, 16>::value>("BTree 16 lines", inserts, probes);
+    runPlus<5>("BPlusTree", inserts, probes);
+    runPlus<16>("BPlusTree", inserts, probes);
+    runPlus<64>("BPlusTree", inserts, probes);
+    runPlus<BTreeCacheOrder<string, size_t>::value>("BPlusTree default", inserts, probes);
+    
+    vector<string> sorted = inserts;
+    sort(sorted.begin(), sorted.end());
+    
+    cout << endl << left << setw(34) << "clear + rebuild" << right << setw(14) << "ms/rebuild" << endl;
+    runRebuild<BTree<string, size_t, 22, HeapNodeAllocator>>("BTree heap nodes", sorted);
+    runRebuild<BTree<string, size_t, 22, NodePool>>("BTree NodePool", sorted);
+    runRebuild<BPlusTree<string, size_t, 22, HeapNodeAllocator>>("BPlusTree heap nodes", sorted);
+    runRebuild<BPlusTree<string, size_t, 22, NodePool>>("BPlusTree NodePool", sorted);
+    runRebuild<BTree<string, size_t, 22, NodePool>>("BTree NodePool bulkLoad", sorted, true);
+    runRebuild<BPlusTree<string, size_t, 22, NodePool>>("BPlusTree NodePool bulkLoad", sorted, true);
+    
+    return 0;
+}
@@ -0,0 +1,139 @@
+#include "../database/BPlusTree.h"
+#include "../database/ConcurrentBTree.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <shared_mutex>
+#include <random>
+#include <atomic>
+#include <cstring>
+
+using namespace std;
+
+// Multi-threaded ordered-index throughput: a BPlusTree behind one
+// shared_mutex (readers share, writers exclusive) vs the optimistic
+// lock-coupling ConcurrentBTree. Each thread mixes point lookups, short
+// range scans (20 keys, a page of IDs) and 5% inserts of existing keys.
+// Usage: bench_concurrent_btree [keys] [opsPerThread] [maxThreads]
+
+using ID = FixedKey<16>;
+
+vector<string> makeKeys(size_t n) {
+    vector<string> keys;
+    keys.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+        keys.push_back("BSCS22" + to_string(100000 + i));
+    }
+    return keys;
+}
+
+// Adapter giving the locked B+Tree the same call shape
+struct SharedLockTree {
+    shared_mutex lock;
+    BPlusTree<string, size_t> tree;
+
+    void insert(const string& key, size_t value) {
+        unique_lock<shared_mutex> guard(lock);
+        tree.insert(key, value);
+    }
+    bool get(const string& key, size_t& out) {
+        shared_lock<shared_mutex> guard(lock);
+        const size_t* found = tree.search(key);
+        if (found == nullptr) return false;
+        out = *found;
+        return true;
+    }
+    size_t scan(const string& lo, size_t limit) {
+        shared_lock<shared_mutex> guard(lock);
+        size_t sum = 0, n = 0;
+        for (auto it = tree.lowerBound(lo); it != tree.end() && n < limit; ++it, ++n) {
+            sum += it.value();
+        }
+        return sum;
+    }
+};
+
+struct OptimisticTree {
+    ConcurrentBTree<ID, size_t> tree;
+    ID highest;  // Above every ID: scans stop on the limit
+
+    OptimisticTree() { memset(highest.bytes, 0xff, sizeof(highest.bytes)); }
+
+    void insert(const string& key, size_t value) { tree.insert(key, value); }
+    bool get(const string& key, size_t& out) const { return tree.get(key, out); }
+    size_t scan(const string& lo, size_t limit) const {
+        vector<pair<ID, size_t>> page;
+        page.reserve(limit);
+        tree.scan(lo, highest, page, limit);
+        size_t sum = 0;
+        for (const auto& entry : page) sum += entry.second;
+        return sum;
+    }
+};
+
+template<typename Tree>
+double run(Tree& tree, const vector<string>& keys, int threads, size_t opsPerThread) {
+    atomic<size_t> sink(0);
+    vector<thread> workers;
+
+    auto start = chrono::steady_clock::now();
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            mt19937 rng(t + 1);
+            uniform_int_distribution<size_t> pick(0, keys.size() - 1);
+            size_t local = 0;
+            for (size_t i = 0; i < opsPerThread; i++) {
+                const string& key = keys[pick(rng)];
+                if (i % 20 == 0) {
+                    tree.insert(key, i);
+                } else if (i % 20 == 1) {
+                    local += tree.scan(key, 20);
+                } else {
+                    size_t value;
+                    if (tree.get(key, value)) local += value;
+                }
+            }
+            sink += local;
+        });
+    }
+    for (auto& w : workers) w.join();
+    auto end = chrono::steady_clock::now();
+
+    double seconds = chrono::duration<double>(end - start).count();
+    return (threads * opsPerThread) / seconds / 1e6;
+}
+
+int main(int argc, char* argv[]) {
+    size_t numKeys = argc > 1 ? stoul(argv[1]) : 100000;
+    size_t opsPerThread = argc > 2 ? stoul(argv[2]) : 1000000;
+    int maxThreads = argc > 3 ? stoi(argv[3]) : static_cast<int>(thread::hardware_concurrency());
+    if (maxThreads < 1) maxThreads = 1;
+
+    vector<string> keys = makeKeys(numKeys);
+
+    SharedLockTree locked;
+    OptimisticTree optimistic;
+    for (size_t i = 0; i < keys.size(); i++) {
+        locked.insert(keys[i], i);
+        optimistic.insert(keys[i], i);
+    }
+
+    cout << "========================================" << endl;
+    cout << "  Concurrent B-Tree Benchmark" << endl;
+    cout << "========================================" << endl;
+    cout << "Keys: " << numKeys << ", ops/thread: " << opsPerThread
+         << " (90% get, 5% 20-key scan, 5% insert)" << endl;
+    cout << left << setw(10) << "threads" << right << setw(20) << "shared_mutex Mops/s"
+         << setw(20) << "optimistic Mops/s" << endl;
+
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        double lockedOps = run(locked, keys, threads, opsPerThread);
+        double optimisticOps = run(optimistic, keys, threads, opsPerThread);
+        cout << left << setw(10) << threads << right << fixed << setprecision(2)
+             << setw(20) << lockedOps << setw(20) << optimisticOps << endl;
+    }
+
+    return 0;
+}
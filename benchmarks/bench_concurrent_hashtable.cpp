@@ -0,0 +1,112 @@
+#include "../database/HashTable.h"
+#include "../database/ConcurrentHashTable.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <random>
+#include <atomic>
+
+using namespace std;
+
+// Multi-threaded lookup throughput: one HashTable behind a single mutex
+// (today's dbMutex model) vs the 16-shard ConcurrentHashTable.
+// Each thread performs get() on random existing keys; 5% of operations
+// are writes (update) to show reader/writer interaction.
+// Usage: bench_concurrent_hashtable [keys] [opsPerThread] [maxThreads]
+
+vector<string> makeKeys(size_t n) {
+    vector<string> keys;
+    keys.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+        keys.push_back("BSCS22" + to_string(100000 + i));
+    }
+    return keys;
+}
+
+// Adapter giving the single-lock table the same call shape
+struct GlobalLockTable {
+    mutex lock;
+    HashTable<string, size_t> table;
+    
+    void insert(const string& key, size_t value) {
+        lock_guard<mutex> guard(lock);
+        table.insert(key, value);
+    }
+    bool get(const string& key, size_t& out) {
+        lock_guard<mutex> guard(lock);
+        size_t* found = table.get(key);
+        if (found == nullptr) return false;
+        out = *found;
+        return true;
+    }
+    bool update(const string& key, size_t value) {
+        lock_guard<mutex> guard(lock);
+        return table.update(key, value);
+    }
+};
+
+template<typename Table>
+double run(Table& table, const vector<string>& keys, int threads, size_t opsPerThread) {
+    atomic<size_t> sink(0);
+    vector<thread> workers;
+    
+    auto start = chrono::steady_clock::now();
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            mt19937 rng(t + 1);
+            uniform_int_distribution<size_t> pick(0, keys.size() - 1);
+            size_t local = 0;
+            for (size_t i = 0; i < opsPerThread; i++) {
+                const string& key = keys[pick(rng)];
+                if (i % 20 == 0) {
+                    table.update(key, i);
+                } else {
+                    size_t value;
+                    if (table.get(key, value)) local += value;
+                }
+            }
+            sink += local;
+        });
+    }
+    for (auto& w : workers) w.join();
+    auto end = chrono::steady_clock::now();
+    
+    double seconds = chrono::duration<double>(end - start).count();
+    return (threads * opsPerThread) / seconds / 1e6;
+}
+
+int main(int argc, char* argv[]) {
+    size_t numKeys = argc > 1 ? stoul(argv[1]) : 100000;
+    size_t opsPerThread = argc > 2 ? stoul(argv[2]) : 1000000;
+    int maxThreads = argc > 3 ? stoi(argv[3]) : static_cast<int>(thread::hardware_concurrency());
+    if (maxThreads < 1) maxThreads = 1;
+    
+    vector<string> keys = makeKeys(numKeys);
+    
+    GlobalLockTable global;
+    ConcurrentHashTable<string, size_t> sharded;
+    sharded.reserve(numKeys);
+    global.table.reserve(numKeys);
+    for (size_t i = 0; i < keys.size(); i++) {
+        global.insert(keys[i], i);
+        sharded.insert(keys[i], i);
+    }
+    
+    cout << "========================================" << endl;
+    cout << "  Concurrent HashTable Benchmark" << endl;
+    cout << "========================================" << endl;
+    cout << "Keys: " << numKeys << ", ops/thread: " << opsPerThread << " (95% get, 5% update)" << endl;
+    cout << left << setw(10) << "threads" << right << setw(18) << "global Mops/s"
+         << setw(18) << "sharded Mops/s" << endl;
+    
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        double globalOps = run(global, keys, threads, opsPerThread);
+        double shardedOps = run(sharded, keys, threads, opsPerThread);
+        cout << left << setw(10) << threads << right << fixed << setprecision(2)
+             << setw(18) << globalOps << setw(18) << shardedOps << endl;
+    }
+    
+    return 0;
+}
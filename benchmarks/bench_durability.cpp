@@ -0,0 +1,79 @@
+#include "../database/IndexedStorage.h"
+#include "../database/Durability.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <filesystem>
+
+using namespace std;
+namespace fs = std::filesystem;
+
+// Throughput of IndexedStorage writes under each DurabilityMode.
+//
+// Every write rewrites the whole .dat file, so the store is kept small
+// (STORE_SIZE records) to isolate the cost of the fsync policy itself.
+// Usage: bench_durability [writes] [storeSize]
+
+Student makeStudent(int i) {
+    Student s;
+    s.studentID = "BSCS22" + to_string(100 + i);
+    s.email = "bscs22" + to_string(100 + i) + "@itu.edu.pk";
+    s.name = "Student " + to_string(i);
+    s.currentSemester = 1 + i % 8;
+    return s;
+}
+
+double runMode(const string& dir, const DurabilityPolicy& policy, int writes, int storeSize) {
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    
+    IndexedStorage<Student> storage(dir + "/students");
+    for (int i = 0; i < storeSize; i++) {
+        storage.add(makeStudent(i));
+    }
+    storage.setDurability(policy);
+    
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < writes; i++) {
+        Student s = makeStudent(i % storeSize);
+        s.currentSemester = 1 + (i + 1) % 8;
+        storage.update(s);  // One commit per update
+    }
+    storage.save();  // Flush pending batch
+    auto end = chrono::steady_clock::now();
+    
+    double seconds = chrono::duration<double>(end - start).count();
+    return writes / seconds;
+}
+
+int main(int argc, char* argv[]) {
+    int writes = argc > 1 ? stoi(argv[1]) : 500;
+    int storeSize = argc > 2 ? stoi(argv[2]) : 100;
+    string dir = "bench_durability_data";
+    
+    cout << "========================================" << endl;
+    cout << "  Durability Mode Benchmark" << endl;
+    cout << "========================================" << endl;
+    cout << "Writes: " << writes << ", store size: " << storeSize << endl << endl;
+    
+    struct Case { string label; DurabilityPolicy policy; };
+    vector<Case> cases = {
+        {"none", DurabilityPolicy::none()},
+        {"batch (100ms / 32)", DurabilityPolicy::batch(100, 32)},
+        {"batch (10ms / 8)", DurabilityPolicy::batch(10, 8)},
+        {"strict", DurabilityPolicy::strict()},
+    };
+    
+    // Silence the per-entity load logging of IndexedStorage
+    streambuf* oldBuf = cout.rdbuf();
+    
+    for (const auto& c : cases) {
+        cout.rdbuf(nullptr);
+        double opsPerSec = runMode(dir, c.policy, writes, storeSize);
+        cout.rdbuf(oldBuf);
+        cout << left << setw(22) << c.label << fixed << setprecision(1) << opsPerSec << " writes/sec" << endl;
+    }
+    
+    fs::remove_all(dir);
+    return 0;
+}
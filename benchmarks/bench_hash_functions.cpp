@@ -0,0 +1,112 @@
+#include "../database/HashTable.h"
+#include "../database/SeededHash.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <algorithm>
+
+using namespace std;
+
+// Hash policy benchmark on the system's real ID shapes:
+// raw hashing cost, and HashTable lookups with std::hash + prime modulus
+// (KeyHash) vs seeded wyhash + power-of-two mask (SeededHash).
+// Usage: bench_hash_functions [keysPerShape]
+
+vector<string> studentIDs(size_t n) {
+    vector<string> ids;
+    for (size_t i = 0; i < n; i++) {
+        string roll = to_string(i % 1000);
+        ids.push_back("BSCS" + to_string(10 + i / 1000) + string(3 - roll.size(), '0') + roll);
+    }
+    return ids;
+}
+
+vector<string> courseIDs(size_t n) {
+    vector<string> ids;
+    const string prefixes[] = {"CS", "MATH", "MGT", "ENG", "PHY", "ELEC"};
+    for (size_t i = 0; ids.size() < n; i++) {
+        ids.push_back(prefixes[i % 6] + to_string(101 + i / 6));
+    }
+    return ids;
+}
+
+vector<string> emails(size_t n) {
+    vector<string> ids;
+    for (size_t i = 0; i < n; i++) {
+        ids.push_back("bscs" + to_string(22000 + i) + "@itu.edu.pk");
+    }
+    return ids;
+}
+
+template<typename Hasher>
+double hashNs(const vector<string>& keys, const Hasher& hasher, size_t rounds) {
+    size_t sink = 0;
+    auto start = chrono::steady_clock::now();
+    for (size_t r = 0; r < rounds; r++) {
+        for (const auto& key : keys) {
+            sink += hasher(key);
+        }
+    }
+    auto end = chrono::steady_clock::now();
+    if (sink == 42) cout << "";  // Keep the loop alive
+    return chrono::duration<double, nano>(end - start).count() / (keys.size() * rounds);
+}
+
+template<typename Table>
+double lookupNs(Table& table, const vector<string>& probes) {
+    size_t sink = 0;
+    auto start = chrono::steady_clock::now();
+    for (const auto& key : probes) {
+        const size_t* value = table.get(key);
+        if (value != nullptr) sink += *value;
+    }
+    auto end = chrono::steady_clock::now();
+    if (sink == 42) cout << "";
+    return chrono::duration<double, nano>(end - start).count() / probes.size();
+}
+
+void runShape(const string& name, const vector<string>& keys) {
+    mt19937 rng(1);
+    vector<string> probes;
+    while (probes.size() < 1000000) {
+        probes.insert(probes.end(), keys.begin(), keys.end());
+    }
+    shuffle(probes.begin(), probes.end(), rng);
+    
+    size_t rounds = 1000000 / keys.size() + 1;
+    double stdNs = hashNs(keys, hash<string>(), rounds);
+    double seededNs = hashNs(keys, SeededHash<string>(), rounds);
+    
+    HashTable<string, size_t> primeTable;
+    HashTable<string, size_t, SeededHash<string>> maskTable;
+    for (size_t i = 0; i < keys.size(); i++) {
+        primeTable.insert(keys[i], i);
+        maskTable.insert(keys[i], i);
+    }
+    const HashTable<string, size_t>& primeRef = primeTable;
+    const HashTable<string, size_t, SeededHash<string>>& maskRef = maskTable;
+    double primeLookup = lookupNs(primeRef, probes);
+    double maskLookup = lookupNs(maskRef, probes);
+    
+    cout << left << setw(14) << name << right << setw(8) << keys.size() << fixed << setprecision(1)
+         << setw(12) << stdNs << setw(12) << seededNs
+         << setw(14) << primeLookup << setw(14) << maskLookup << endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? stoul(argv[1]) : 10000;
+    
+    cout << "========================================" << endl;
+    cout << "  Hash Function Benchmark" << endl;
+    cout << "========================================" << endl;
+    cout << left << setw(14) << "shape" << right << setw(8) << "keys"
+         << setw(12) << "std ns" << setw(12) << "seeded ns"
+         << setw(14) << "prime get ns" << setw(14) << "mask get ns" << endl;
+    
+    runShape("BSCS22201", studentIDs(n));
+    runShape("CS701", courseIDs(min<size_t>(n, 500)));
+    runShape("email", emails(n));
+    
+    return 0;
+}
@@ -0,0 +1,77 @@
+#include "../database/HashTable.h"
+#include "../database/FlatHashTable.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <algorithm>
+
+using namespace std;
+
+// Insert and lookup latency: chained HashTable vs open-addressing FlatHashTable.
+// Keys look like real student IDs (BSCS22xxxxxxx); lookups hit in random order.
+// Usage: bench_hashtable [maxKeys]
+
+vector<string> makeKeys(size_t n) {
+    vector<string> keys;
+    keys.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+        string num = to_string(i);
+        keys.push_back("BSCS22" + string(7 - min<size_t>(7, num.size()), '0') + num);
+    }
+    return keys;
+}
+
+template<typename Table>
+void runCase(const string& label, const vector<string>& keys, const vector<string>& probes) {
+    size_t sink = 0;
+    
+    Table table;
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < keys.size(); i++) {
+        table.insert(keys[i], i);
+    }
+    auto mid = chrono::steady_clock::now();
+    for (const auto& key : probes) {
+        size_t* value = table.get(key);
+        if (value != nullptr) sink += *value;
+    }
+    auto end = chrono::steady_clock::now();
+    
+    double insertNs = chrono::duration<double, nano>(mid - start).count() / keys.size();
+    double lookupNs = chrono::duration<double, nano>(end - mid).count() / probes.size();
+    
+    cout << left << setw(16) << label << right << setw(10) << keys.size()
+         << fixed << setprecision(1)
+         << setw(14) << insertNs << setw(14) << lookupNs
+         << "   (checksum " << sink << ")" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t maxKeys = argc > 1 ? stoul(argv[1]) : 1000000;
+    
+    cout << "========================================" << endl;
+    cout << "  HashTable Benchmark" << endl;
+    cout << "========================================" << endl;
+    cout << left << setw(16) << "table" << right << setw(10) << "keys"
+         << setw(14) << "insert ns/op" << setw(14) << "lookup ns/op" << endl;
+    
+    mt19937 rng(42);
+    for (size_t n : {size_t(1000), size_t(100000), size_t(1000000)}) {
+        if (n > maxKeys) break;
+        
+        vector<string> keys = makeKeys(n);
+        vector<string> probes = keys;
+        shuffle(probes.begin(), probes.end(), rng);
+        if (probes.size() < 1000000) {
+            // Repeat small sets so timings aren't dominated by clock overhead
+            size_t base = probes.size();
+            while (probes.size() < 1000000) probes.push_back(probes[probes.size() % base]);
+        }
+        
+        runCase<HashTable<string, size_t>>("chained", keys, probes);
+        runCase<FlatHashTable<string, size_t>>("flat (swiss)", keys, probes);
+    }
+    
+    return 0;
+}
@@ -0,0 +1,149 @@
+#include "../backend/utils/JSONDocument.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <map>
+
+using namespace std;
+
+// Request-body parsing throughput: the previous JSONParser::parse (substr,
+// per-character token copies, comma split, std::map<string,string>) vs
+// JSONDocument, each followed by the field reads the handler does.
+// Bodies are the ones web/js and frontend/APIClient.h send.
+// Usage: bench_json_parse [rounds]
+
+namespace legacy {
+
+string trim(const string& str) {
+    size_t start = str.find_first_not_of(" \t\n\r");
+    size_t end = str.find_last_not_of(" \t\n\r");
+    if (start == string::npos) return "";
+    return str.substr(start, end - start + 1);
+}
+
+string unquote(const string& str) {
+    string s = trim(str);
+    if (s.length() >= 2 && s[0] == '"' && s[s.length() - 1] == '"') {
+        return s.substr(1, s.length() - 2);
+    }
+    return s;
+}
+
+map<string, string> parse(const string& json) {
+    map<string, string> result;
+    size_t start = json.find('{');
+    size_t end = json.rfind('}');
+    if (start == string::npos || end == string::npos) {
+        return result;
+    }
+    string content = json.substr(start + 1, end - start - 1);
+
+    vector<string> pairs;
+    string current;
+    bool inQuotes = false;
+    for (char c : content) {
+        if (c == '"') {
+            inQuotes = !inQuotes;
+            current += c;
+        } else if (c == ',' && !inQuotes) {
+            if (!current.empty()) {
+                pairs.push_back(current);
+                current.clear();
+            }
+        } else {
+            current += c;
+        }
+    }
+    if (!current.empty()) {
+        pairs.push_back(current);
+    }
+
+    for (const string& pair : pairs) {
+        size_t colonPos = pair.find(':');
+        if (colonPos != string::npos) {
+            result[unquote(pair.substr(0, colonPos))] = trim(pair.substr(colonPos + 1));
+        }
+    }
+    return result;
+}
+
+string getString(const map<string, string>& data, const string& key) {
+    auto it = data.find(key);
+    return it != data.end() ? unquote(it->second) : "";
+}
+
+}  // namespace legacy
+
+struct Body {
+    string endpoint;
+    string json;
+    vector<string> fields;  // Read by the handler
+};
+
+vector<Body> requestBodies() {
+    return {
+        {"login", R"({"email":"bscs22001@itu.edu.pk","password":"2001"})", {"email", "password"}},
+        {"enrollCourse", R"({"studentID":"BSCS22001","courseID":"CS301"})", {"studentID", "courseID"}},
+        {"addStudent",
+         R"({"studentID":"BSCS22114","name":"Ayesha Siddiqui","email":"bscs22114@itu.edu.pk",)"
+         R"("password":"2114","semester":3})",
+         {"studentID", "email", "name", "semester", "contact", "password"}},
+        {"addTeacher",
+         R"({"teacherID":"T1142","name":"Dr. Imran Qureshi","email":"t1142@itu.edu.pk",)"
+         R"("password":"teacher123","department":"Computer Science"})",
+         {"teacherID", "email", "name", "courseID", "department", "contact", "password"}},
+        {"addCourse",
+         R"({"courseID":"CS301","courseName":"Data Structures and Algorithms","semester":3,)"
+         R"("teacherID":"T1142"})",
+         {"courseID", "courseName", "semester", "teacherID"}},
+        {"setRegistration", R"({"startTime":1735689600,"endTime":1736899200,"isOpen":true})",
+         {"startTime", "endTime", "isOpen"}},
+    };
+}
+
+template<typename Parse>
+double nsPerBody(const Body& body, size_t rounds, Parse parse) {
+    size_t sink = 0;
+    auto start = chrono::steady_clock::now();
+    for (size_t r = 0; r < rounds; r++) {
+        sink += parse(body);
+    }
+    auto end = chrono::steady_clock::now();
+    if (sink == 42) cout << "";  // Keep the loop alive
+    return chrono::duration<double, nano>(end - start).count() / rounds;
+}
+
+int main(int argc, char* argv[]) {
+    size_t rounds = argc > 1 ? stoul(argv[1]) : 500000;
+
+    cout << "========================================" << endl;
+    cout << "  JSON Request Parsing Benchmark" << endl;
+    cout << "========================================" << endl;
+    cout << left << setw(18) << "body" << right << setw(7) << "bytes"
+         << setw(14) << "legacy ns" << setw(14) << "document ns" << setw(10) << "speedup"
+         << setw(14) << "legacy MB/s" << setw(16) << "document MB/s" << endl;
+
+    JSONDocument doc;  // Reused across requests, as a handler's would be per thread
+    for (const Body& body : requestBodies()) {
+        double legacyNs = nsPerBody(body, rounds, [](const Body& b) {
+            auto data = legacy::parse(b.json);
+            size_t length = 0;
+            for (const auto& field : b.fields) length += legacy::getString(data, field).size();
+            return length;
+        });
+        double documentNs = nsPerBody(body, rounds, [&doc](const Body& b) {
+            doc.parse(b.json);
+            size_t length = 0;
+            for (const auto& field : b.fields) length += doc.getString(field).size();
+            return length;
+        });
+
+        double bytes = static_cast<double>(body.json.size());
+        cout << left << setw(18) << body.endpoint << right << setw(7) << body.json.size()
+             << fixed << setprecision(1)
+             << setw(14) << legacyNs << setw(14) << documentNs
+             << setw(9) << legacyNs / documentNs << "x"
+             << setw(14) << bytes * 1000.0 / legacyNs << setw(16) << bytes * 1000.0 / documentNs << endl;
+    }
+    return 0;
+}
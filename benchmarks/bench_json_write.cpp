@@ -0,0 +1,156 @@
+#include "../backend/utils/JsonWriter.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <sstream>
+#include <map>
+#include <vector>
+
+using namespace std;
+
+// Response building for viewAllStudents: the previous path (stringstream
+// list, map<string,string>, then jsonSuccess copying and re-escaping
+// every value) vs JsonWriter into the thread's reused buffer. Both end
+// with the response body in its own string, as HTTPResponse needs.
+// Usage: bench_json_write [rounds]
+
+struct StudentRow {
+    string studentID;
+    string name;
+    string email;
+    int semester;
+    vector<string> enrolledCourses;
+};
+
+vector<StudentRow> makeStudents(size_t n) {
+    vector<StudentRow> students;
+    const string courses[] = {"CS101", "CS201", "MATH201", "PHY101", "ENG102"};
+    for (size_t i = 0; i < n; i++) {
+        string roll = to_string(i % 1000);
+        string id = "BSCS" + to_string(18 + i / 1000) + string(3 - roll.size(), '0') + roll;
+        StudentRow s{id, "Student Name " + to_string(i), "bscs" + to_string(22000 + i) + "@itu.edu.pk",
+                     static_cast<int>(1 + i % 8), {}};
+        for (size_t c = 0; c < 1 + i % 5; c++) s.enrolledCourses.push_back(courses[c]);
+        students.push_back(s);
+    }
+    return students;
+}
+
+namespace legacy {
+
+string stringifyArray(const vector<string>& arr) {
+    if (arr.empty()) return "[]";
+    stringstream ss;
+    ss << "[";
+    for (size_t i = 0; i < arr.size(); i++) {
+        if (i > 0) ss << ",";
+        ss << "\"" << arr[i] << "\"";
+    }
+    ss << "]";
+    return ss.str();
+}
+
+string jsonSuccess(const map<string, string>& data) {
+    string json = "{";
+    bool first = true;
+    for (const auto& pair : data) {
+        if (!first) json += ",";
+        json += "\"" + pair.first + "\":";
+        if (!pair.second.empty() && (pair.second[0] == '[' || pair.second[0] == '{')) {
+            json += pair.second;
+        } else {
+            json += "\"";
+            for (char c : pair.second) {
+                if (c == '"') json += "\\\"";
+                else if (c == '\\') json += "\\\\";
+                else json += c;
+            }
+            json += "\"";
+        }
+        first = false;
+    }
+    json += "}";
+    return json;
+}
+
+string studentList(const vector<StudentRow>& students) {
+    stringstream ss;
+    ss << "[";
+    for (size_t i = 0; i < students.size(); i++) {
+        if (i > 0) ss << ",";
+        ss << "{"
+           << "\"studentID\":\"" << students[i].studentID << "\","
+           << "\"name\":\"" << students[i].name << "\","
+           << "\"email\":\"" << students[i].email << "\","
+           << "\"semester\":" << students[i].semester << ","
+           << "\"enrolledCourses\":" << stringifyArray(students[i].enrolledCourses)
+           << "}";
+    }
+    ss << "]";
+
+    map<string, string> response;
+    response["success"] = "true";
+    response["students"] = ss.str();
+    response["total"] = to_string(students.size());
+    return jsonSuccess(response);
+}
+
+}  // namespace legacy
+
+string writerStudentList(const vector<StudentRow>& students) {
+    JsonWriter json;
+    json.beginObject()
+        .member("success", "true")
+        .key("students").beginArray();
+    for (const auto& student : students) {
+        json.beginObject()
+            .member("studentID", student.studentID)
+            .member("name", student.name)
+            .member("email", student.email)
+            .member("semester", student.semester)
+            .key("enrolledCourses").beginArray();
+        for (const auto& courseID : student.enrolledCourses) {
+            json.value(courseID);
+        }
+        json.endArray().endObject();
+    }
+    json.endArray()
+        .key("total").quoted(students.size())
+        .endObject();
+    return json.str();
+}
+
+template<typename Build>
+double usPerResponse(const vector<StudentRow>& students, size_t rounds, Build build, size_t& bytes) {
+    size_t sink = 0;
+    auto start = chrono::steady_clock::now();
+    for (size_t r = 0; r < rounds; r++) {
+        string body = build(students);
+        sink += body.size();
+    }
+    auto end = chrono::steady_clock::now();
+    bytes = sink / rounds;
+    return chrono::duration<double, micro>(end - start).count() / rounds;
+}
+
+int main(int argc, char* argv[]) {
+    size_t rounds = argc > 1 ? stoul(argv[1]) : 2000;
+
+    cout << "========================================" << endl;
+    cout << "  JSON Response Writing Benchmark" << endl;
+    cout << "========================================" << endl;
+    cout << right << setw(10) << "students" << setw(10) << "bytes"
+         << setw(14) << "legacy us" << setw(14) << "writer us" << setw(10) << "speedup" << endl;
+
+    for (size_t n : {1, 50, 1000}) {
+        vector<StudentRow> students = makeStudents(n);
+        size_t scaled = max<size_t>(1, rounds * 50 / max<size_t>(n, 50));
+        size_t legacyBytes, writerBytes;
+        double legacyUs = usPerResponse(students, scaled, legacy::studentList, legacyBytes);
+        double writerUs = usPerResponse(students, scaled, writerStudentList, writerBytes);
+        cout << setw(10) << n << setw(10) << writerBytes << fixed << setprecision(2)
+             << setw(14) << legacyUs << setw(14) << writerUs
+             << setw(9) << legacyUs / writerUs << "x" << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,118 @@
+#include "../database/BPlusTree.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <algorithm>
+
+using namespace std;
+
+// Memory and lookup time of each store's ID index (BPlusTree<string,
+// size_t>) with prefix-compressed key slots vs plain std::string slots.
+// Keys follow utils/students_data.txt and utils/teachers_data.txt: student
+// IDs BSCS22201, emails bscs22201@itu.edu.pk, teacher IDs T1100, course
+// codes CS701, scaled to a campus-sized store over several intake years.
+// Usage: bench_key_compression [studentsPerYear]
+
+// Same key, but a distinct type: NodeKeys falls back to its generic
+// layout, one std::string per slot
+struct PlainKey : string {
+    PlainKey() = default;
+    PlainKey(const string& s) : string(s) {}
+};
+
+constexpr int ORDER = BTreeCacheOrder<string, size_t>::value;
+
+struct Store {
+    string name;
+    vector<string> keys;
+};
+
+vector<Store> makeStores(size_t perYear) {
+    vector<string> programs = {"BSCS", "BSEE", "BSSE", "BSDS"};
+    Store students{"students", {}};
+    Store users{"users", {}};
+    for (const auto& program : programs) {
+        for (int year = 18; year <= 24; year++) {
+            for (size_t roll = 1; roll <= perYear; roll++) {
+                string digits = to_string(roll);
+                string id = program + to_string(year) + string(3 - digits.size(), '0') + digits;
+                string email = id;
+                transform(email.begin(), email.end(), email.begin(), ::tolower);
+                students.keys.push_back(id);
+                users.keys.push_back(email + "@itu.edu.pk");
+            }
+        }
+    }
+
+    Store teachers{"teachers", {}};
+    for (int i = 0; i < 400; i++) {
+        string id = "T" + to_string(1100 + i);
+        teachers.keys.push_back(id);
+        users.keys.push_back(id + "@itu.edu.pk");
+    }
+    users.keys.push_back("admin@itu.edu.pk");
+
+    Store courses{"courses", {}};
+    for (string dept : {"CS", "EE", "SE", "DS", "MATH", "PHY", "HUM"}) {
+        for (int level = 1; level <= 8; level++) {
+            for (int n = 1; n <= 9; n++) {
+                courses.keys.push_back(dept + to_string(level) + "0" + to_string(n));
+            }
+        }
+    }
+    return {users, students, teachers, courses};
+}
+
+template<typename Key>
+void measure(const vector<string>& keys, const vector<string>& probes, size_t& bytes, double& nsPerLookup) {
+    BPlusTree<Key, size_t, ORDER> tree;
+    for (size_t i = 0; i < keys.size(); i++) {
+        tree.insert(Key(keys[i]), i);
+    }
+    bytes = tree.memoryUsage();
+
+    size_t sink = 0;
+    auto start = chrono::steady_clock::now();
+    for (const auto& key : probes) {
+        size_t* value = tree.search(key);
+        if (value != nullptr) sink += *value;
+    }
+    auto end = chrono::steady_clock::now();
+    nsPerLookup = chrono::duration<double, nano>(end - start).count() / probes.size();
+    if (sink == 42) cout << "";
+}
+
+int main(int argc, char* argv[]) {
+    size_t perYear = argc > 1 ? stoul(argv[1]) : 400;
+    vector<Store> stores = makeStores(perYear);
+
+    cout << "========================================" << endl;
+    cout << "  Key Compression Benchmark (order " << ORDER << ")" << endl;
+    cout << "========================================" << endl;
+    cout << left << setw(10) << "store" << right << setw(8) << "keys"
+         << setw(14) << "plain B/key" << setw(16) << "prefixed B/key" << setw(9) << "saved"
+         << setw(14) << "plain ns" << setw(16) << "prefixed ns" << endl;
+
+    for (auto& store : stores) {
+        mt19937 rng(7);
+        shuffle(store.keys.begin(), store.keys.end(), rng);  // Random insert order
+        vector<string> probes;
+        for (size_t i = 0; i < 1000000; i++) {
+            probes.push_back(store.keys[rng() % store.keys.size()]);
+        }
+
+        size_t plainBytes, prefixedBytes;
+        double plainNs, prefixedNs;
+        measure<PlainKey>(store.keys, probes, plainBytes, plainNs);
+        measure<string>(store.keys, probes, prefixedBytes, prefixedNs);
+
+        double n = static_cast<double>(store.keys.size());
+        cout << left << setw(10) << store.name << right << setw(8) << store.keys.size()
+             << fixed << setprecision(1)
+             << setw(14) << plainBytes / n << setw(16) << prefixedBytes / n
+             << setw(8) << 100.0 * (1.0 - static_cast<double>(prefixedBytes) / plainBytes) << "%"
+             << setw(14) << plainNs << setw(16) << prefixedNs << endl;
+    }
+    return 0;
+}
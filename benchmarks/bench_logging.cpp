@@ -0,0 +1,71 @@
+#include "../database/Logger.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Cost per log line on the calling thread: the previous cout << ... << endl
+// (stdout redirected to a file, flushed every line under the stream lock)
+// vs LOG_INFO into the thread's ring with the sink writing the same file,
+// plus a LOG_DEBUG call site with debug disabled.
+// Usage: bench_logging [lines per thread]
+
+template<typename Body>
+double nsPerLine(int threads, size_t lines, Body body) {
+    auto start = chrono::steady_clock::now();
+    vector<thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&body, t, lines]() {
+            for (size_t i = 0; i < lines; i++) body(t, i);
+        });
+    }
+    for (auto& w : workers) w.join();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, nano>(end - start).count() / (threads * lines);
+}
+
+int main(int argc, char* argv[]) {
+    size_t lines = argc > 1 ? stoul(argv[1]) : 100000;
+    string path = (filesystem::temp_directory_path() / "ums_bench_logging.log").string();
+    string courseID = "CS101";
+
+    cout << "========================================" << endl;
+    cout << "  Logging Benchmark" << endl;
+    cout << "========================================" << endl;
+    cout << right << setw(8) << "threads" << setw(14) << "cout ns" << setw(14) << "async ns"
+         << setw(10) << "speedup" << setw(16) << "disabled ns" << setw(10) << "dropped" << endl;
+
+    AsyncLogger& logger = AsyncLogger::instance();
+    for (int threads : {1, 4}) {
+        // Previous logging: every line flushed through cout
+        ofstream file(path, ios::trunc);
+        streambuf* saved = cout.rdbuf(file.rdbuf());
+        double coutNs = nsPerLine(threads, lines, [&courseID](int t, size_t i) {
+            cout << "[DB] Checking course " << courseID << " (semester=" << t << ") #" << i << endl;
+        });
+        cout.rdbuf(saved);
+        file.close();
+
+        filesystem::remove(path);
+        logger.start(path);
+        logger.setLevel(LogLevel::Info);
+        size_t droppedBefore = logger.droppedCount();
+        double asyncNs = nsPerLine(threads, lines, [&courseID](int t, size_t i) {
+            LOG_INFO("DB") << "Checking course " << courseID << " (semester=" << t << ") #" << i;
+        });
+        double disabledNs = nsPerLine(threads, lines, [&courseID](int t, size_t i) {
+            LOG_DEBUG("DB") << "Checking course " << courseID << " (semester=" << t << ") #" << i;
+        });
+        logger.stop();
+
+        cout << setw(8) << threads << fixed << setprecision(1) << setw(14) << coutNs
+             << setw(14) << asyncNs << setw(9) << coutNs / asyncNs << "x"
+             << setw(16) << disabledNs << setw(10) << logger.droppedCount() - droppedBefore << endl;
+    }
+    filesystem::remove(path);
+    return 0;
+}
@@ -0,0 +1,146 @@
+#include "../backend/utils/Router.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <regex>
+#include <random>
+
+using namespace std;
+
+// Per-request dispatch cost for the server's routes: httplib's previous
+// scheme (one std::regex per route, regex_match in registration order
+// until one matches) vs Router (hash lookup for literal paths, radix trie
+// for ":name" patterns).
+// Usage: bench_router [requests]
+
+const vector<pair<string, string>> ROUTES = {
+    {"POST", "/api/login"},
+    {"POST", "/api/admin/addStudent"},
+    {"POST", "/api/admin/removeStudent"},
+    {"POST", "/api/admin/addTeacher"},
+    {"POST", "/api/admin/removeTeacher"},
+    {"POST", "/api/admin/addCourse"},
+    {"POST", "/api/admin/setRegistrationWindow"},
+    {"GET", "/api/admin/getRegistrationWindow"},
+    {"GET", "/api/admin/viewAllStudents"},
+    {"GET", "/api/admin/viewAllTeachers"},
+    {"GET", "/api/admin/viewTimetable"},
+    {"POST", "/api/admin/generateTimetable"},
+    {"POST", "/api/student/enrollCourse"},
+    {"POST", "/api/student/dropCourse"},
+    {"GET", "/api/student/viewCourses"},
+    {"GET", "/api/student/viewTimetable"},
+    {"GET", "/api/student/mydata"},
+    {"GET", "/api/teacher/viewStudents"},
+    {"GET", "/api/teacher/viewTimetable"},
+};
+
+// The same endpoints keyed by ID in the path
+const vector<pair<string, string>> PARAM_ROUTES = {
+    {"GET", "/api/student/:studentID"},
+    {"GET", "/api/student/:studentID/courses"},
+    {"GET", "/api/student/:studentID/timetable"},
+    {"POST", "/api/student/:studentID/courses/:courseID"},
+    {"GET", "/api/teacher/:teacherID/students"},
+    {"GET", "/api/teacher/:teacherID/timetable"},
+    {"GET", "/api/admin/timetable/:semester"},
+};
+
+struct RegexRoutes {
+    vector<pair<string, regex>> routes;
+
+    explicit RegexRoutes(const vector<pair<string, string>>& patterns) {
+        for (const auto& p : patterns) {
+            // ":name" becomes a segment group, as a regex route would be written
+            string re = regex_replace(p.second, regex(":[A-Za-z]+"), "([^/]+)");
+            routes.emplace_back(p.first, regex(re));
+        }
+    }
+
+    int find(const string& method, const string& path) const {
+        smatch m;
+        for (size_t i = 0; i < routes.size(); i++) {
+            if (routes[i].first == method && regex_match(path, m, routes[i].second)) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+};
+
+vector<pair<string, string>> requestMix(const vector<pair<string, string>>& patterns, size_t n) {
+    mt19937 rng(11);
+    vector<pair<string, string>> requests;
+    for (size_t i = 0; i < n; i++) {
+        auto route = patterns[rng() % patterns.size()];
+        string path;
+        for (size_t pos = 0; pos < route.second.size();) {
+            if (route.second[pos] == ':') {
+                path += "BSCS22" + to_string(100 + rng() % 900);
+                pos = route.second.find('/', pos);
+                if (pos == string::npos) break;
+            } else {
+                path += route.second[pos++];
+            }
+        }
+        requests.emplace_back(route.first, path);
+    }
+    return requests;
+}
+
+template<typename Find>
+double nsPerRequest(const vector<pair<string, string>>& requests, Find find) {
+    long long sink = 0;
+    auto start = chrono::steady_clock::now();
+    for (const auto& request : requests) {
+        sink += find(request.first, request.second);
+    }
+    auto end = chrono::steady_clock::now();
+    if (sink == 42) cout << "";  // Keep the loop alive
+    return chrono::duration<double, nano>(end - start).count() / requests.size();
+}
+
+void run(const string& name, const vector<pair<string, string>>& patterns, size_t n) {
+    RegexRoutes regexRoutes(patterns);
+    Router<int> router;
+    for (size_t i = 0; i < patterns.size(); i++) {
+        router.add(patterns[i].first, patterns[i].second, static_cast<int>(i));
+    }
+
+    vector<pair<string, string>> requests = requestMix(patterns, n);
+    for (const auto& request : requests) {
+        Router<int>::Params params;
+        const int* handler = router.find(request.first, request.second, params);
+        if (handler == nullptr || *handler != regexRoutes.find(request.first, request.second)) {
+            cerr << "Mismatch for " << request.first << " " << request.second << endl;
+            exit(1);
+        }
+    }
+
+    double regexNs = nsPerRequest(requests, [&regexRoutes](const string& method, const string& path) {
+        return regexRoutes.find(method, path);
+    });
+    double routerNs = nsPerRequest(requests, [&router](const string& method, const string& path) {
+        Router<int>::Params params;
+        const int* handler = router.find(method, path, params);
+        return handler != nullptr ? *handler : -1;
+    });
+
+    cout << left << setw(16) << name << right << setw(8) << patterns.size()
+         << fixed << setprecision(1) << setw(12) << regexNs << setw(12) << routerNs
+         << setw(9) << regexNs / routerNs << "x" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? stoul(argv[1]) : 200000;
+
+    cout << "========================================" << endl;
+    cout << "  Route Dispatch Benchmark" << endl;
+    cout << "========================================" << endl;
+    cout << left << setw(16) << "routes" << right << setw(8) << "count"
+         << setw(12) << "regex ns" << setw(12) << "router ns" << setw(10) << "speedup" << endl;
+
+    run("server (exact)", ROUTES, n);
+    run("parameterized", PARAM_ROUTES, n);
+    return 0;
+}
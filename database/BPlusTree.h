@@ -0,0 +1,831 @@
+#ifndef BPLUSTREE_H
+#define BPLUSTREE_H
+
+#include "BTree.h"  // BTreeCacheOrder
+#include "NodePool.h"
+#include "NodeKeys.h"
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+using namespace std;
+
+/**
+ * BPlusTree - B+Tree with all values in linked leaves
+ *
+ * Internal nodes hold only separator keys; every key/value pair lives in a
+ * leaf, and leaves are chained left to right. Full and range scans are a
+ * sequential walk along the leaf chain through BPlusTree::iterator, with no
+ * recursion and no copying:
+ *
+ *   for (auto [id, offset] : tree) { ... }
+ *   for (auto it = tree.lowerBound(lo); it != tree.upperBound(hi); ++it) { ... }
+ *
+ * search/insert/update/remove/getAllPairs/clear match BTree, so it can back
+ * IndexedStorage. ORDER is the maximum number of children of an internal
+ * node; leaves hold up to ORDER-1 pairs. Allocator supplies nodes as in
+ * BTree (one pool for leaves, one for internal nodes).
+ *
+ * Internal nodes also count the entries under each child, which makes
+ * positional queries O(log n): rank(key) is the number of keys below key,
+ * select(k) the iterator at position k, countRange(lo, hi) the number of
+ * keys in [lo, hi]. Pagination by page number or by last-seen key needs no
+ * scan of the earlier pages.
+ */
+template<typename K, typename V, int ORDER = BTreeCacheOrder<K, V>::value,
+         template<typename> class Allocator = NodePool>
+class BPlusTree {
+private:
+    static_assert(ORDER >= 4, "B+Tree order must be at least 4");
+
+    static constexpr int MAX_KEYS = ORDER - 1;
+    static constexpr int MIN_KEYS = MAX_KEYS / 2;  // Non-root nodes never drop below this
+
+    // Arrays carry one spare slot: a node briefly holds MAX_KEYS+1 keys
+    // between an insert and the split that follows it
+    struct Node {
+        bool isLeaf;
+        int numKeys;
+        NodeKeys<K, MAX_KEYS + 1> keys;  // Write with keys.set
+
+        explicit Node(bool leaf) : isLeaf(leaf), numKeys(0) {}
+    };
+
+    struct Leaf : Node {
+        V values[MAX_KEYS + 1];
+        Leaf* next;                       // Right sibling in key order
+
+        Leaf() : Node(true), next(nullptr) {}
+    };
+
+    // children[i] holds keys < keys[i] <= children[i+1]
+    struct Internal : Node {
+        Node* children[ORDER + 1];
+        size_t counts[ORDER + 1];         // Entries under children[i]
+
+        Internal() : Node(false) {}
+    };
+
+    Node* root;
+    size_t count;
+    Allocator<Leaf> leaves;
+    Allocator<Internal> internals;
+
+    static constexpr bool BULK_RESET = Allocator<Leaf>::BULK_RESET;
+
+    Leaf* newLeaf() {
+        Leaf* leaf = leaves.allocate();
+        leaf->numKeys = 0;
+        leaf->next = nullptr;
+        return leaf;
+    }
+
+    Internal* newInternal() {
+        Internal* node = internals.allocate();
+        node->numKeys = 0;
+        return node;
+    }
+
+    void destroyTree(Node* node);
+
+    static size_t memoryUsage(const Node* node) {
+        size_t bytes = node->keys.heapBytes(node->numKeys);
+        if (node->isLeaf) {
+            return bytes + sizeof(Leaf);
+        }
+        const Internal* internal = static_cast<const Internal*>(node);
+        bytes += sizeof(Internal);
+        for (int i = 0; i <= internal->numKeys; i++) {
+            bytes += memoryUsage(internal->children[i]);
+        }
+        return bytes;
+    }
+
+    // Entries stored under a node
+    static size_t subtreeSize(const Node* node) {
+        if (node->isLeaf) return node->numKeys;
+        const Internal* internal = static_cast<const Internal*>(node);
+        size_t total = 0;
+        for (int i = 0; i <= internal->numKeys; i++) {
+            total += internal->counts[i];
+        }
+        return total;
+    }
+
+    // Child subtree of an internal node that may contain key
+    template<typename Q>
+    static int childIndex(const Node* node, const Q& key) {
+        return node->keys.upperBound(node->numKeys, key);
+    }
+
+    // First position in a node whose key is >= key
+    template<typename Q>
+    static int lowerIndex(const Node* node, const Q& key) {
+        return node->keys.lowerBound(node->numKeys, key);
+    }
+
+    template<typename Q>
+    Leaf* findLeaf(const Q& key) const {
+        Node* node = root;
+        while (!node->isLeaf) {
+            node = static_cast<Internal*>(node)->children[childIndex(node, key)];
+        }
+        return static_cast<Leaf*>(node);
+    }
+
+    // Number of keys < key, or <= key when INCLUSIVE
+    template<bool INCLUSIVE, typename Q>
+    size_t countBelow(const Q& key) const;
+
+    // Leaf holding position k; k becomes the position within that leaf
+    Leaf* leafAt(size_t& k) const;
+
+    Leaf* firstLeaf() const {
+        if (root == nullptr) return nullptr;
+        Node* node = root;
+        while (!node->isLeaf) {
+            node = static_cast<Internal*>(node)->children[0];
+        }
+        return static_cast<Leaf*>(node);
+    }
+
+    // Insert into a subtree. If the node overflows it is split, upKey is set
+    // to the separator and the new right sibling is returned.
+    Node* insertInto(Node* node, const K& key, const V& value, K& upKey);
+    Node* splitLeaf(Leaf* leaf, K& upKey);
+    Node* splitInternal(Internal* node, K& upKey);
+
+    // Remove from a subtree, fixing any child left below MIN_KEYS
+    bool removeFrom(Node* node, const K& key);
+    void rebalance(Internal* parent, int idx);
+    void borrowFromPrev(Internal* parent, int idx);
+    void borrowFromNext(Internal* parent, int idx);
+    void merge(Internal* parent, int idx);  // Merge children[idx+1] into children[idx]
+
+public:
+    /**
+     * Iterator over leaf entries in key order
+     *
+     * Dereferences to pair<const K&, V&> (structured bindings work); key()
+     * and value() give direct access. Prefix-compressed string keys are
+     * rebuilt into a buffer the iterator owns and reuses, so a walk costs
+     * no allocation per entry; that reference lasts until the iterator
+     * moves or is dereferenced again. Invalidated by insert/remove.
+     */
+    template<bool IS_CONST>
+    class Iterator {
+    private:
+        using LeafPtr = conditional_t<IS_CONST, const Leaf*, Leaf*>;
+        using ValueRef = conditional_t<IS_CONST, const V&, V&>;
+
+        // NodeKeys that rebuild keys (KeyRef by value) are read into keyBuffer
+        static constexpr bool REBUILT_KEYS = !is_reference_v<typename NodeKeys<K, MAX_KEYS + 1>::KeyRef>;
+
+        LeafPtr leaf;
+        int pos;
+        mutable conditional_t<REBUILT_KEYS, K, char> keyBuffer{};
+
+        Iterator(LeafPtr l, int p) : leaf(l), pos(p) {
+            // Step past the end of a leaf onto the next one
+            if (leaf != nullptr && pos >= leaf->numKeys) {
+                leaf = leaf->next;
+                pos = 0;
+            }
+        }
+
+        friend class BPlusTree;
+
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type = pair<K, V>;
+        using difference_type = ptrdiff_t;
+        using reference = pair<const K&, ValueRef>;
+        using pointer = void;
+
+        Iterator() : leaf(nullptr), pos(0) {}
+
+        const K& key() const {
+            if constexpr (REBUILT_KEYS) {
+                leaf->keys.keyInto(pos, keyBuffer);
+                return keyBuffer;
+            } else {
+                return leaf->keys[pos];
+            }
+        }
+        ValueRef value() const { return leaf->values[pos]; }
+        reference operator*() const { return reference(key(), leaf->values[pos]); }
+
+        Iterator& operator++() {
+            if (++pos >= leaf->numKeys) {
+                leaf = leaf->next;
+                pos = 0;
+            }
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator old = *this;
+            ++(*this);
+            return old;
+        }
+
+        bool operator==(const Iterator& other) const { return leaf == other.leaf && pos == other.pos; }
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    BPlusTree() : root(nullptr), count(0) {}
+    ~BPlusTree() {
+        if constexpr (!BULK_RESET) {
+            destroyTree(root);
+        }
+    }
+
+    BPlusTree(const BPlusTree&) = delete;
+    BPlusTree& operator=(const BPlusTree&) = delete;
+
+    // Search for a key (accepts string_view etc. for string keys, no temporary K)
+    template<typename Q>
+    V* search(const Q& key);
+
+    // Insert a key-value pair (updates the value if the key exists)
+    void insert(const K& key, const V& value);
+
+    // Update existing key's value
+    bool update(const K& key, const V& value);
+
+    // Remove a key
+    void remove(const K& key);
+
+    // Copy all key-value pairs in key order (prefer iterating the tree)
+    vector<pair<K, V>> getAllPairs() const;
+
+    // Ordered iteration along the leaf chain
+    iterator begin() { return iterator(firstLeaf(), 0); }
+    iterator end() { return iterator(); }
+    const_iterator begin() const { return const_iterator(firstLeaf(), 0); }
+    const_iterator end() const { return const_iterator(); }
+
+    // First entry with key >= key / key > key, for range scans
+    template<typename Q>
+    iterator lowerBound(const Q& key);
+    template<typename Q>
+    iterator upperBound(const Q& key);
+
+    // Entry at position k in key order (0-based); end() if k >= size()
+    iterator select(size_t k) {
+        if (k >= count) return end();
+        Leaf* leaf = leafAt(k);
+        return iterator(leaf, static_cast<int>(k));
+    }
+
+    const_iterator select(size_t k) const {
+        if (k >= count) return end();
+        const Leaf* leaf = leafAt(k);
+        return const_iterator(leaf, static_cast<int>(k));
+    }
+
+    // Position key has or would take in key order (number of smaller keys)
+    template<typename Q>
+    size_t rank(const Q& key) const { return countBelow<false>(key); }
+
+    // Number of keys in [lo, hi]
+    template<typename Lo, typename Hi>
+    size_t countRange(const Lo& lo, const Hi& hi) const {
+        size_t upper = countBelow<true>(hi);
+        size_t lower = countBelow<false>(lo);
+        return upper > lower ? upper - lower : 0;
+    }
+
+    size_t size() const { return count; }
+
+    // Check if tree is empty
+    bool isEmpty() const { return count == 0; }
+
+    // Bytes held by the tree's nodes plus the key bytes they keep on the
+    // heap (pool slack not counted)
+    size_t memoryUsage() const { return root == nullptr ? 0 : memoryUsage(root); }
+
+    // Clear all data
+    void clear();
+
+    // Replace the contents with pairs from [first, last), which must be
+    // sorted by strictly increasing key (random-access iterators over
+    // pair<K, V>). Fills leaves left to right and builds each internal
+    // level on top in O(n); fillFactor (0.5 - 1.0) sets how full nodes are.
+    // Unsorted input falls back to insert().
+    template<typename It>
+    void bulkLoad(It first, It last, double fillFactor = 1.0);
+
+    template<typename Range>
+    void bulkLoad(const Range& sorted, double fillFactor = 1.0) {
+        bulkLoad(std::begin(sorted), std::end(sorted), fillFactor);
+    }
+};
+
+// ==================== BPlusTree Implementation ====================
+
+template<typename K, typename V, int ORDER, template<typename> class Allocator>
+void BPlusTree<K, V, ORDER, Allocator>::destroyTree(Node* node) {
+    if (node == nullptr) return;
+
+    if (node->isLeaf) {
+        leaves.release(static_cast<Leaf*>(node));
+        return;
+    }
+
+    Internal* internal = static_cast<Internal*>(node);
+    for (int i = 0; i <= internal->numKeys; i++) {
+        destroyTree(internal->children[i]);
+    }
+    internals.release(internal);
+}
+
+template<typename K, typename V, int ORDER, template<typename> class Allocator>
+template<typename Q>
+V* BPlusTree<K, V, ORDER, Allocator>::search(const Q& key) {
+    if (root == nullptr) return nullptr;
+
+    Leaf* leaf = findLeaf(key);
+    int i = lowerIndex(leaf, key);
+    if (i < leaf->numKeys && leaf->keys.matches(i, key)) {
+        return &leaf->values[i];
+    }
+    return nullptr;
+}
+
+template<typename K, typename V, int ORDER, template<typename> class Allocator>
+void BPlusTree<K, V, ORDER, Allocator>::insert(const K& key, const V& value) {
+    if (root == nullptr) {
+        root = newLeaf();
+    }
+
+    K upKey;
+    Node* sibling = insertInto(root, key, value, upKey);
+
+    // Root split: grow the tree by one level
+    if (sibling != nullptr) {
+        Internal* newRoot = newInternal();
+        newRoot->keys.set(0, move(upKey));
+        newRoot->children[0] = root;
+        newRoot->children[1] = sibling;
+        newRoot->counts[0] = subtreeSize(root);
+        newRoot->counts[1] = subtreeSize(sibling);
+        newRoot->numKeys = 1;
+        root = newRoot;
+    }
+}
+
+template<typename K, typename V, int ORDER, template<typename> class Allocator>
+typename BPlusTree<K, V, ORDER, Allocator>::Node*
+BPlusTree<K, V, ORDER, Allocator>::insertInto(Node* node, const K& key, const V& value, K& upKey) {
+    if (node->isLeaf) {
+        Leaf* leaf = static_cast<Leaf*>(node);
+        int i = lowerIndex(leaf, key);
+
+        if (i < leaf->numKeys && leaf->keys.matches(i, key)) {
+            leaf->values[i] = value;  // Existing key: update in place
+            return nullptr;
+        }
+
+        for (int j = leaf->numKeys; j > i; j--) {
+            leaf->keys.moveFrom(j, leaf->keys, j - 1);
+            leaf->values[j] = move(leaf->values[j - 1]);
+        }
+        leaf->keys.set(i, key);
+        leaf->values[i] = value;
+        leaf->numKeys++;
+        count++;
+
+        return leaf->numKeys > MAX_KEYS ? splitLeaf(leaf, upKey) : nullptr;
+    }
+
+    Internal* internal = static_cast<Internal*>(node);
+    int i = childIndex(internal, key);
+    size_t before = count;
+    Node* sibling = insertInto(internal->children[i], key, value, upKey);
+    internal->counts[i] += count - before;  // 0 when an existing key was updated
+    if (sibling == nullptr) {
+        return nullptr;
+    }
+
+    // Child split: add its separator and new sibling after position i
+    for (int j = internal->numKeys; j > i; j--) {
+        internal->keys.moveFrom(j, internal->keys, j - 1);
+        internal->children[j + 1] = internal->children[j];
+        internal->counts[j + 1] = internal->counts[j];
+    }
+    internal->keys.set(i, move(upKey));
+    internal->children[i + 1] = sibling;
+    internal->counts[i + 1] = subtreeSize(sibling);
+    internal->counts[i] -= internal->counts[i + 1];
+    internal->numKeys++;
+
+    return internal->numKeys > MAX_KEYS ? splitInternal(internal, upKey) : nullptr;
+}
+
+template<typename K, typename V, int ORDER, template<typename> class Allocator>
+typename BPlusTree<K, V, ORDER, Allocator>::Node*
+BPlusTree<K, V, ORDER, Allocator>::splitLeaf(Leaf* leaf, K& upKey) {
+    Leaf* right = newLeaf();
+    int keep = leaf->numKeys / 2;
+
+    for (int j = keep; j < leaf->numKeys; j++) {
+        right->keys.moveFrom(j - keep, leaf->keys, j);
+        right->values[j - keep] = move(leaf->values[j]);
+    }
+    right->numKeys = leaf->numKeys - keep;
+    leaf->numKeys = keep;
+
+    right->next = leaf->next;
+    leaf->next = right;
+
+    // Each half spans a narrower key range: re-pick the shared prefixes
+    leaf->keys.repack(keep);
+    right->keys.repack(right->numKeys);
+
+    upKey = right->keys[0];  // Copied up: the pair itself stays in the leaf
+    return right;
+}
+
+template<typename K, typename V, int ORDER, template<typename> class Allocator>
+typename BPlusTree<K, V, ORDER, Allocator>::Node*
+BPlusTree<K, V, ORDER, Allocator>::splitInternal(Internal* node, K& upKey) {
+    Internal* right = newInternal();
+    int keep = node->numKeys / 2;
+
+    // keys[keep] moves up; keys after it go to the new sibling
+    for (int j = keep + 1; j < node->numKeys; j++) {
+        right->keys.moveFrom(j - keep - 1, node->keys, j);
+    }
+    for (int j = keep + 1; j <= node->numKeys; j++) {
+        right->children[j - keep - 1] = node->children[j];
+        right->counts[j - keep - 1] = node->counts[j];
+    }
+    right->numKeys = node->numKeys - keep - 1;
+
+    upKey = node->keys.take(keep);
+    node->numKeys = keep;
+    node->keys.repack(keep);
+    right->keys.repack(right->numKeys);
+    return right;
+}
+
+template<typename K, typename V, int ORDER, template<typename> class Allocator>
+bool BPlusTree<K, V, ORDER, Allocator>::update(const K& key, const V& value) {
+    V* found = search(key);
+    if (found != nullptr) {
+        *found = value;
+        return true;
+    }
+    return false;
+}
+
+template<typename K, typename V, int ORDER, template<typename> class Allocator>
+void BPlusTree<K, V, ORDER, Allocator>::remove(const K& key) {
+    if (root == nullptr) return;
+
+    removeFrom(root, key);
+
+    // Shrink the tree when the root runs out of keys
+    if (root->numKeys == 0) {
+        Node* oldRoot = root;
+        if (root->isLeaf) {
+            root = nullptr;
+            leaves.release(static_cast<Leaf*>(oldRoot));
+        } else {
+            root = static_cast<Internal*>(oldRoot)->children[0];
+            internals.release(static_cast<Internal*>(oldRoot));
+        }
+    }
+}
+
+template<typename K, typename V, int ORDER, template<typename> class Allocator>
+bool BPlusTree<K, V, ORDER, Allocator>::removeFrom(Node* node, const K& key) {
+    if (node->isLeaf) {
+        Leaf* leaf = static_cast<Leaf*>(node);
+        int i = lowerIndex(leaf, key);
+        if (i == leaf->numKeys || !leaf->keys.matches(i, key)) {
+            return false;  // Key not found
+        }
+
+        for (int j = i + 1; j < leaf->numKeys; j++) {
+            leaf->keys.moveFrom(j - 1, leaf->keys, j);
+            leaf->values[j - 1] = move(leaf->values[j]);
+        }
+        leaf->numKeys--;
+        count--;
+        return true;
+    }
+
+    // Separators equal to a removed key stay valid as routing keys
+    Internal* internal = static_cast<Internal*>(node);
+    int i = childIndex(internal, key);
+    if (!removeFrom(internal->children[i], key)) {
+        return false;
+    }
+    internal->counts[i]--;
+
+    if (internal->children[i]->numKeys < MIN_KEYS) {
+        rebalance(internal, i);
+    }
+    return true;
+}
+
+template<typename K, typename V, int ORDER, template<typename> class Allocator>
+void BPlusTree<K, V, ORDER, Allocator>::rebalance(Internal* parent, int idx) {
+    if (idx > 0 && parent->children[idx - 1]->numKeys > MIN_KEYS) {
+        borrowFromPrev(parent, idx);
+    } else if (idx < parent->numKeys && parent->children[idx + 1]->numKeys > MIN_KEYS) {
+        borrowFromNext(parent, idx);
+    } else if (idx > 0) {
+        merge(parent, idx - 1);
+    } else {
+        merge(parent, idx);
+    }
+}
+
+template<typename K, typename V, int ORDER, template<typename> class Allocator>
+void BPlusTree<K, V, ORDER, Allocator>::borrowFromPrev(Internal* parent, int idx) {
+    Node* child = parent->children[idx];
+    Node* sibling = parent->children[idx - 1];
+    size_t moved = 1;  // Entries that change subtree
+
+    for (int i = child->numKeys; i > 0; i--) {
+        child->keys.moveFrom(i, child->keys, i - 1);
+    }
+
+    if (child->isLeaf) {
+        Leaf* leaf = static_cast<Leaf*>(child);
+        Leaf* prev = static_cast<Leaf*>(sibling);
+        for (int i = leaf->numKeys; i > 0; i--) {
+            leaf->values[i] = move(leaf->values[i - 1]);
+        }
+        leaf->keys.moveFrom(0, prev->keys, prev->numKeys - 1);
+        leaf->values[0] = move(prev->values[prev->numKeys - 1]);
+        parent->keys.set(idx - 1, leaf->keys[0]);
+    } else {
+        Internal* node = static_cast<Internal*>(child);
+        Internal* prev = static_cast<Internal*>(sibling);
+        for (int i = node->numKeys + 1; i > 0; i--) {
+            node->children[i] = node->children[i - 1];
+            node->counts[i] = node->counts[i - 1];
+        }
+        // Rotate through the parent separator
+        node->keys.moveFrom(0, parent->keys, idx - 1);
+        node->children[0] = prev->children[prev->numKeys];
+        node->counts[0] = moved = prev->counts[prev->numKeys];
+        parent->keys.moveFrom(idx - 1, prev->keys, prev->numKeys - 1);
+    }
+
+    child->numKeys++;
+    sibling->numKeys--;
+    parent->counts[idx] += moved;
+    parent->counts[idx - 1] -= moved;
+}
+
+template<typename K, typename V, int ORDER, template<typename> class Allocator>
+void BPlusTree<K, V, ORDER, Allocator>::borrowFromNext(Internal* parent, int idx) {
+    Node* child = parent->children[idx];
+    Node* sibling = parent->children[idx + 1];
+    size_t moved = 1;
+
+    if (child->isLeaf) {
+        Leaf* leaf = static_cast<Leaf*>(child);
+        Leaf* next = static_cast<Leaf*>(sibling);
+        leaf->keys.moveFrom(leaf->numKeys, next->keys, 0);
+        leaf->values[leaf->numKeys] = move(next->values[0]);
+        for (int i = 1; i < next->numKeys; i++) {
+            next->keys.moveFrom(i - 1, next->keys, i);
+            next->values[i - 1] = move(next->values[i]);
+        }
+        parent->keys.set(idx, next->keys[0]);
+    } else {
+        Internal* node = static_cast<Internal*>(child);
+        Internal* next = static_cast<Internal*>(sibling);
+        // Rotate through the parent separator
+        node->keys.moveFrom(node->numKeys, parent->keys, idx);
+        node->children[node->numKeys + 1] = next->children[0];
+        node->counts[node->numKeys + 1] = moved = next->counts[0];
+        parent->keys.moveFrom(idx, next->keys, 0);
+        for (int i = 1; i < next->numKeys; i++) {
+            next->keys.moveFrom(i - 1, next->keys, i);
+        }
+        for (int i = 1; i <= next->numKeys; i++) {
+            next->children[i - 1] = next->children[i];
+            next->counts[i - 1] = next->counts[i];
+        }
+    }
+
+    child->numKeys++;
+    sibling->numKeys--;
+    parent->counts[idx] += moved;
+    parent->counts[idx + 1] -= moved;
+}
+
+template<typename K, typename V, int ORDER, template<typename> class Allocator>
+void BPlusTree<K, V, ORDER, Allocator>::merge(Internal* parent, int idx) {
+    Node* child = parent->children[idx];
+    Node* sibling = parent->children[idx + 1];
+
+    if (child->isLeaf) {
+        Leaf* leaf = static_cast<Leaf*>(child);
+        Leaf* next = static_cast<Leaf*>(sibling);
+        for (int i = 0; i < next->numKeys; i++) {
+            leaf->keys.moveFrom(leaf->numKeys + i, next->keys, i);
+            leaf->values[leaf->numKeys + i] = move(next->values[i]);
+        }
+        leaf->numKeys += next->numKeys;
+        leaf->next = next->next;
+        leaves.release(next);
+    } else {
+        Internal* node = static_cast<Internal*>(child);
+        Internal* next = static_cast<Internal*>(sibling);
+        // The parent separator comes down between the two halves
+        node->keys.moveFrom(node->numKeys, parent->keys, idx);
+        for (int i = 0; i < next->numKeys; i++) {
+            node->keys.moveFrom(node->numKeys + 1 + i, next->keys, i);
+        }
+        for (int i = 0; i <= next->numKeys; i++) {
+            node->children[node->numKeys + 1 + i] = next->children[i];
+            node->counts[node->numKeys + 1 + i] = next->counts[i];
+        }
+        node->numKeys += next->numKeys + 1;
+        internals.release(next);
+    }
+
+    parent->counts[idx] += parent->counts[idx + 1];
+    for (int i = idx + 1; i < parent->numKeys; i++) {
+        parent->keys.moveFrom(i - 1, parent->keys, i);
+    }
+    for (int i = idx + 2; i <= parent->numKeys; i++) {
+        parent->children[i - 1] = parent->children[i];
+        parent->counts[i - 1] = parent->counts[i];
+    }
+    parent->numKeys--;
+}
+
+template<typename K, typename V, int ORDER, template<typename> class Allocator>
+vector<pair<K, V>> BPlusTree<K, V, ORDER, Allocator>::getAllPairs() const {
+    vector<pair<K, V>> pairs;
+    pairs.reserve(count);
+    for (Leaf* leaf = firstLeaf(); leaf != nullptr; leaf = leaf->next) {
+        for (int i = 0; i < leaf->numKeys; i++) {
+            pairs.emplace_back(leaf->keys[i], leaf->values[i]);
+        }
+    }
+    return pairs;
+}
+
+template<typename K, typename V, int ORDER, template<typename> class Allocator>
+template<typename Q>
+typename BPlusTree<K, V, ORDER, Allocator>::iterator BPlusTree<K, V, ORDER, Allocator>::lowerBound(const Q& key) {
+    if (root == nullptr) return end();
+
+    // Keys equal to a separator live in the right subtree, so the leaf found
+    // by childIndex holds the first key >= key or ends just before it
+    Leaf* leaf = findLeaf(key);
+    return iterator(leaf, lowerIndex(leaf, key));
+}
+
+template<typename K, typename V, int ORDER, template<typename> class Allocator>
+template<typename Q>
+typename BPlusTree<K, V, ORDER, Allocator>::iterator BPlusTree<K, V, ORDER, Allocator>::upperBound(const Q& key) {
+    if (root == nullptr) return end();
+
+    Leaf* leaf = findLeaf(key);
+    return iterator(leaf, childIndex(leaf, key));
+}
+
+template<typename K, typename V, int ORDER, template<typename> class Allocator>
+template<bool INCLUSIVE, typename Q>
+size_t BPlusTree<K, V, ORDER, Allocator>::countBelow(const Q& key) const {
+    if (root == nullptr) return 0;
+
+    // Every child left of the one searched holds only smaller keys
+    size_t below = 0;
+    const Node* node = root;
+    while (!node->isLeaf) {
+        const Internal* internal = static_cast<const Internal*>(node);
+        int i = childIndex(node, key);
+        for (int j = 0; j < i; j++) {
+            below += internal->counts[j];
+        }
+        node = internal->children[i];
+    }
+    return below + (INCLUSIVE ? childIndex(node, key) : lowerIndex(node, key));
+}
+
+template<typename K, typename V, int ORDER, template<typename> class Allocator>
+typename BPlusTree<K, V, ORDER, Allocator>::Leaf* BPlusTree<K, V, ORDER, Allocator>::leafAt(size_t& k) const {
+    Node* node = root;
+    while (!node->isLeaf) {
+        Internal* internal = static_cast<Internal*>(node);
+        int i = 0;
+        while (i < internal->numKeys && k >= internal->counts[i]) {
+            k -= internal->counts[i];
+            i++;
+        }
+        node = internal->children[i];
+    }
+    return static_cast<Leaf*>(node);
+}
+
+template<typename K, typename V, int ORDER, template<typename> class Allocator>
+void BPlusTree<K, V, ORDER, Allocator>::clear() {
+    if constexpr (BULK_RESET) {
+        leaves.reset();  // O(1): every node goes back to its pool
+        internals.reset();
+    } else {
+        destroyTree(root);
+    }
+    root = nullptr;
+    count = 0;
+}
+
+template<typename K, typename V, int ORDER, template<typename> class Allocator>
+template<typename It>
+void BPlusTree<K, V, ORDER, Allocator>::bulkLoad(It first, It last, double fillFactor) {
+    clear();
+
+    size_t n = static_cast<size_t>(last - first);
+    if (n == 0) return;
+
+    for (size_t i = 1; i < n; i++) {
+        if (!(first[i - 1].first < first[i].first)) {
+            for (It it = first; it != last; ++it) {
+                insert(it->first, it->second);
+            }
+            return;
+        }
+    }
+
+    // Keys per node; at least 2*MIN_KEYS so evenly spread nodes never underflow
+    size_t perNode = static_cast<size_t>(fillFactor * MAX_KEYS + 0.5);
+    perNode = max<size_t>(2 * MIN_KEYS, min<size_t>(MAX_KEYS, perNode));
+
+    // Leaf level, chained left to right
+    size_t leafCount = (n + perNode - 1) / perNode;
+    vector<Node*> level;
+    vector<K> lowKeys;  // Smallest key under each node of the current level
+    level.reserve(leafCount);
+    lowKeys.reserve(leafCount);
+
+    size_t pos = 0;
+    Leaf* prev = nullptr;
+    for (size_t i = 0; i < leafCount; i++) {
+        size_t take = n / leafCount + (i < n % leafCount ? 1 : 0);
+        Leaf* leaf = newLeaf();
+        for (size_t j = 0; j < take; j++) {
+            leaf->keys.set(j, first[pos + j].first);
+            leaf->values[j] = first[pos + j].second;
+        }
+        leaf->numKeys = static_cast<int>(take);
+        leaf->keys.repack(leaf->numKeys);
+        pos += take;
+
+        if (prev != nullptr) prev->next = leaf;
+        prev = leaf;
+        level.push_back(leaf);
+        lowKeys.push_back(leaf->keys[0]);
+    }
+    count = n;
+
+    // Internal levels: group perNode+1 children under each parent
+    while (level.size() > 1) {
+        size_t parents = (level.size() + perNode) / (perNode + 1);
+        vector<Node*> parentLevel;
+        vector<K> parentLowKeys;
+        parentLevel.reserve(parents);
+        parentLowKeys.reserve(parents);
+
+        size_t idx = 0;
+        for (size_t p = 0; p < parents; p++) {
+            size_t take = level.size() / parents + (p < level.size() % parents ? 1 : 0);
+            Internal* node = newInternal();
+            for (size_t j = 0; j < take; j++) {
+                node->children[j] = level[idx + j];
+                node->counts[j] = subtreeSize(level[idx + j]);
+                if (j > 0) {
+                    node->keys.set(j - 1, move(lowKeys[idx + j]));
+                }
+            }
+            node->numKeys = static_cast<int>(take - 1);
+            node->keys.repack(node->numKeys);
+            parentLevel.push_back(node);
+            parentLowKeys.push_back(move(lowKeys[idx]));
+            idx += take;
+        }
+
+        level.swap(parentLevel);
+        lowKeys.swap(parentLowKeys);
+    }
+
+    root = level[0];
+}
+
+#endif // BPLUSTREE_H
@@ -5,15 +5,42 @@
 #include <fstream>
 #include <vector>
 #include <algorithm>
+#include <iterator>
+#include "NodePool.h"
+#include "NodeKeys.h"
 
 using namespace std;
 
-#define ORDER 5  // B-Tree order (max 4 keys per node)
+// Cache line size assumed when sizing nodes
+static const size_t BTREE_CACHE_LINE = 64;
+
+/**
+ * BTreeCacheOrder - Compile-time B-Tree order for a key/value pair
+ *
+ * Picks the largest order whose node arrays (ORDER-1 keys, ORDER-1 values,
+ * ORDER children) fit in LINES cache lines, never below the minimum order 4.
+ * Keys are counted as NodeKeys stores them: SLOT_BYTES per key plus what
+ * the node keeps once whatever its order. With prefix-compressed std::string
+ * keys (24-byte slots, 72 bytes of shared prefix and tails) and size_t
+ * values, 8 lines give order 11 and 16 lines (the default) order 24, which
+ * benchmarks/bench_btree_order measures as the fastest for ID lookups.
+ */
+template<typename K, typename V, size_t LINES = 16>
+struct BTreeCacheOrder {
+    static constexpr size_t BYTES = LINES * BTREE_CACHE_LINE;
+    static constexpr size_t KEY_SLOT = NodeKeys<K, 1>::SLOT_BYTES;
+    static constexpr size_t KEYS_FIXED = sizeof(NodeKeys<K, 1>) - KEY_SLOT;
+    static constexpr size_t PER_SLOT = KEY_SLOT + sizeof(V) + sizeof(void*);
+    // ORDER slots, one fewer key/value
+    static constexpr size_t FIT = BYTES > KEYS_FIXED ? (BYTES - KEYS_FIXED + KEY_SLOT + sizeof(V)) / PER_SLOT : 0;
+    static constexpr int value = FIT < 4 ? 4 : static_cast<int>(FIT);
+};
 
-template<typename K, typename V>
+// ORDER = max children per node (max ORDER-1 keys); must be at least 4
+template<typename K, typename V, int ORDER>
 class BTreeNode {
 public:
-    K keys[ORDER - 1];           // Maximum ORDER-1 keys
+    NodeKeys<K, ORDER - 1> keys; // Maximum ORDER-1 keys (write with keys.set)
     V values[ORDER - 1];         // Corresponding values
     BTreeNode* children[ORDER];  // Child pointers
     int numKeys;                 // Current number of keys
@@ -22,26 +49,34 @@ public:
     BTreeNode(bool leaf = true);
     ~BTreeNode();
     
-    // Search for a key in this node
-    V* search(const K& key);
+    // Reinitialize as an empty node (pooled nodes are reused)
+    void reset(bool leaf);
+    
+    // Search for a key in this node (Q: K or a type comparable with K, e.g. string_view)
+    template<typename Q>
+    V* search(const Q& key);
     
     // Insert a key-value pair (assumes node is not full)
-    void insertNonFull(const K& key, const V& value);
+    // Alloc is the owning tree's node allocator, used for splits and merges
+    template<typename Alloc>
+    void insertNonFull(const K& key, const V& value, Alloc& alloc);
     
     // Split child at index i
-    void splitChild(int i, BTreeNode* child);
+    template<typename Alloc>
+    void splitChild(int i, BTreeNode* child, Alloc& alloc);
     
     // Find index of first key >= given key
     int findKey(const K& key);
     
     // Remove key from this node
-    void remove(const K& key);
+    template<typename Alloc>
+    void remove(const K& key, Alloc& alloc);
     
-    // Get predecessor key from subtree
-    K getPredecessor(int idx);
+    // Get predecessor key/value from subtree
+    pair<K, V> getPredecessor(int idx);
     
-    // Get successor key from subtree
-    K getSuccessor(int idx);
+    // Get successor key/value from subtree
+    pair<K, V> getSuccessor(int idx);
     
     // Borrow from previous sibling
     void borrowFromPrev(int idx);
@@ -50,10 +85,12 @@ public:
     void borrowFromNext(int idx);
     
     // Merge with sibling
-    void merge(int idx);
+    template<typename Alloc>
+    void merge(int idx, Alloc& alloc);
     
     // Fill child at idx if it has fewer than ORDER/2 keys
-    void fill(int idx);
+    template<typename Alloc>
+    void fill(int idx, Alloc& alloc);
     
     // Serialize node to file
     void serialize(ofstream& out);
@@ -61,24 +98,58 @@ public:
     // Deserialize node from file
     void deserialize(ifstream& in);
     
-    template<typename K2, typename V2>
+    template<typename K2, typename V2, int ORDER2, template<typename> class Alloc2>
     friend class BTree;
+    
+private:
+    static_assert(ORDER >= 4, "B-Tree order must be at least 4");
+    
+    // Split layout of a full node (ORDER-1 keys): MID keys stay left,
+    // keys[MID] moves up, RIGHT keys go to the new sibling
+    static constexpr int MID = ORDER / 2 - 1;
+    static constexpr int RIGHT = ORDER - 2 - MID;
 };
 
-template<typename K, typename V>
+/**
+ * BTree - B-Tree map with compile-time ORDER
+ *
+ * Allocator supplies the nodes: the default NodePool keeps them in
+ * contiguous slabs and lets clear() drop the whole tree in O(1);
+ * HeapNodeAllocator gives one new/delete per node.
+ */
+template<typename K, typename V, int ORDER = BTreeCacheOrder<K, V>::value,
+         template<typename> class Allocator = NodePool>
 class BTree {
 private:
-    BTreeNode<K, V>* root;
+    using Node = BTreeNode<K, V, ORDER>;
     
-    void destroyTree(BTreeNode<K, V>* node);
-    void getAllPairs(BTreeNode<K, V>* node, vector<pair<K, V>>& pairs);
+    BTreeNode<K, V, ORDER>* root;
+    Allocator<Node> nodes;
+    
+    Node* newNode(bool leaf) {
+        Node* node = nodes.allocate();
+        node->reset(leaf);
+        return node;
+    }
+    
+    // Build a subtree of the given height from count sorted pairs;
+    // capacities[h] = pairs held by a subtree of height h at the fill target
+    template<typename It>
+    Node* buildSubtree(It first, size_t count, int height, const vector<size_t>& capacities);
+    
+    void destroyTree(BTreeNode<K, V, ORDER>* node);
+    void getAllPairs(BTreeNode<K, V, ORDER>* node, vector<pair<K, V>>& pairs);
     
 public:
     BTree();
     ~BTree();
     
-    // Search for a key
-    V* search(const K& key);
+    BTree(const BTree&) = delete;
+    BTree& operator=(const BTree&) = delete;
+    
+    // Search for a key (accepts string_view etc. for string keys, no temporary K)
+    template<typename Q>
+    V* search(const Q& key);
     
     // Insert a key-value pair
     void insert(const K& key, const V& value);
@@ -103,30 +174,47 @@ public:
     
     // Clear all data
     void clear();
+    
+    // Replace the contents with pairs from [first, last), which must be
+    // sorted by strictly increasing key (random-access iterators over
+    // pair<K, V>). Builds the tree bottom-up in O(n) with nodes filled to
+    // fillFactor (0.5 - 1.0); unsorted input falls back to insert().
+    template<typename It>
+    void bulkLoad(It first, It last, double fillFactor = 1.0);
+    
+    template<typename Range>
+    void bulkLoad(const Range& sorted, double fillFactor = 1.0) {
+        bulkLoad(std::begin(sorted), std::end(sorted), fillFactor);
+    }
 };
 
 // ==================== BTreeNode Implementation ====================
 
-template<typename K, typename V>
-BTreeNode<K, V>::BTreeNode(bool leaf) : numKeys(0), isLeaf(leaf) {
-    for (int i = 0; i < ORDER; i++) {
-        children[i] = nullptr;
-    }
+template<typename K, typename V, int ORDER>
+BTreeNode<K, V, ORDER>::BTreeNode(bool leaf) {
+    reset(leaf);
 }
 
-template<typename K, typename V>
-BTreeNode<K, V>::~BTreeNode() {
-    // Children are deleted by BTree destructor
+template<typename K, typename V, int ORDER>
+BTreeNode<K, V, ORDER>::~BTreeNode() {
+    // Children are released by the owning BTree
 }
 
-template<typename K, typename V>
-V* BTreeNode<K, V>::search(const K& key) {
-    int i = 0;
-    while (i < numKeys && key > keys[i]) {
-        i++;
+template<typename K, typename V, int ORDER>
+void BTreeNode<K, V, ORDER>::reset(bool leaf) {
+    numKeys = 0;
+    isLeaf = leaf;
+    for (int i = 0; i < ORDER; i++) {
+        children[i] = nullptr;
     }
+}
+
+template<typename K, typename V, int ORDER>
+template<typename Q>
+V* BTreeNode<K, V, ORDER>::search(const Q& key) {
+    int i = keys.lowerBound(numKeys, key);
     
-    if (i < numKeys && key == keys[i]) {
+    if (i < numKeys && keys.matches(i, key)) {
         return &values[i];
     }
     
@@ -137,68 +225,60 @@ V* BTreeNode<K, V>::search(const K& key) {
     return children[i]->search(key);
 }
 
-template<typename K, typename V>
-int BTreeNode<K, V>::findKey(const K& key) {
-    int idx = 0;
-    while (idx < numKeys && keys[idx] < key) {
-        idx++;
-    }
-    return idx;
+template<typename K, typename V, int ORDER>
+int BTreeNode<K, V, ORDER>::findKey(const K& key) {
+    return keys.lowerBound(numKeys, key);
 }
 
-template<typename K, typename V>
-void BTreeNode<K, V>::insertNonFull(const K& key, const V& value) {
-    int i = numKeys - 1;
+template<typename K, typename V, int ORDER>
+template<typename Alloc>
+void BTreeNode<K, V, ORDER>::insertNonFull(const K& key, const V& value, Alloc& alloc) {
+    int i = keys.upperBound(numKeys, key);
     
     if (isLeaf) {
-        // Find position and shift keys
-        while (i >= 0 && keys[i] > key) {
-            keys[i + 1] = keys[i];
-            values[i + 1] = values[i];
-            i--;
+        // Shift larger keys right and insert at i
+        for (int j = numKeys; j > i; j--) {
+            keys.moveFrom(j, keys, j - 1);
+            values[j] = values[j - 1];
         }
         
-        keys[i + 1] = key;
-        values[i + 1] = value;
+        keys.set(i, key);
+        values[i] = value;
         numKeys++;
     } else {
-        // Find child to insert
-        while (i >= 0 && keys[i] > key) {
-            i--;
-        }
-        i++;
-        
-        // Check if child is full
+        // Child i takes the key; split it first if it is full
         if (children[i]->numKeys == ORDER - 1) {
-            splitChild(i, children[i]);
+            splitChild(i, children[i], alloc);
             
             if (keys[i] < key) {
                 i++;
             }
         }
-        children[i]->insertNonFull(key, value);
+        children[i]->insertNonFull(key, value, alloc);
     }
 }
 
-template<typename K, typename V>
-void BTreeNode<K, V>::splitChild(int i, BTreeNode* child) {
-    BTreeNode* newNode = new BTreeNode<K, V>(child->isLeaf);
-    newNode->numKeys = ORDER / 2;
+template<typename K, typename V, int ORDER>
+template<typename Alloc>
+void BTreeNode<K, V, ORDER>::splitChild(int i, BTreeNode* child, Alloc& alloc) {
+    BTreeNode* newNode = alloc.allocate();
+    newNode->reset(child->isLeaf);
+    newNode->numKeys = RIGHT;
     
     // Copy second half of keys to new node
-    for (int j = 0; j < ORDER / 2; j++) {
-        newNode->keys[j] = child->keys[j + ORDER / 2];
-        newNode->values[j] = child->values[j + ORDER / 2];
+    for (int j = 0; j < RIGHT; j++) {
+        newNode->keys.moveFrom(j, child->keys, j + MID + 1);
+        newNode->values[j] = child->values[j + MID + 1];
     }
     
     // Copy children if not leaf
     if (!child->isLeaf) {
-        for (int j = 0; j <= ORDER / 2; j++) {
-            newNode->children[j] = child->children[j + ORDER / 2];
+        for (int j = 0; j <= RIGHT; j++) {
+            newNode->children[j] = child->children[j + MID + 1];
         }
     }
     
-    child->numKeys = ORDER / 2 - 1;
+    child->numKeys = MID;
     
     // Shift children of this node
     for (int j = numKeys; j >= i + 1; j--) {
@@ -208,41 +288,48 @@ void BTreeNode<K, V>::splitChild(int i, BTreeNode* child) {
     
     // Shift keys of this node
     for (int j = numKeys - 1; j >= i; j--) {
-        keys[j + 1] = keys[j];
+        keys.moveFrom(j + 1, keys, j);
         values[j + 1] = values[j];
     }
     
     // Copy middle key up
-    keys[i] = child->keys[ORDER / 2 - 1];
-    values[i] = child->values[ORDER / 2 - 1];
+    keys.moveFrom(i, child->keys, MID);
+    values[i] = child->values[MID];
     numKeys++;
+
+    // Each half spans a narrower key range: re-pick the shared prefixes
+    child->keys.repack(MID);
+    newNode->keys.repack(RIGHT);
 }
 
-template<typename K, typename V>
-void BTreeNode<K, V>::remove(const K& key) {
+template<typename K, typename V, int ORDER>
+template<typename Alloc>
+void BTreeNode<K, V, ORDER>::remove(const K& key, Alloc& alloc) {
     int idx = findKey(key);
     
-    if (idx < numKeys && keys[idx] == key) {
+    if (idx < numKeys && keys.matches(idx, key)) {
         if (isLeaf) {
             // Remove from leaf
             for (int i = idx + 1; i < numKeys; i++) {
-                keys[i - 1] = keys[i];
+                keys.moveFrom(i - 1, keys, i);
                 values[i - 1] = values[i];
             }
             numKeys--;
         } else {
             // Remove from internal node
             if (children[idx]->numKeys >= ORDER / 2) {
-                K pred = getPredecessor(idx);
-                keys[idx] = pred;
-                children[idx]->remove(pred);
+                pair<K, V> pred = getPredecessor(idx);
+                keys.set(idx, pred.first);
+                values[idx] = pred.second;
+                children[idx]->remove(pred.first, alloc);
             } else if (children[idx + 1]->numKeys >= ORDER / 2) {
-                K succ = getSuccessor(idx);
-                keys[idx] = succ;
-                children[idx + 1]->remove(succ);
+                pair<K, V> succ = getSuccessor(idx);
+                keys.set(idx, succ.first);
+                values[idx] = succ.second;
+                children[idx + 1]->remove(succ.first, alloc);
             } else {
-                merge(idx);
-                children[idx]->remove(key);
+                merge(idx, alloc);
+                children[idx]->remove(key, alloc);
             }
         }
     } else {
@@ -253,58 +340,59 @@ void BTreeNode<K, V>::remove(const K& key) {
         bool isInSubtree = (idx == numKeys);
         
         if (children[idx]->numKeys < ORDER / 2) {
-            fill(idx);
+            fill(idx, alloc);
         }
         
         if (isInSubtree && idx > numKeys) {
-            children[idx - 1]->remove(key);
+            children[idx - 1]->remove(key, alloc);
         } else {
-            children[idx]->remove(key);
+            children[idx]->remove(key, alloc);
         }
     }
 }
 
-template<typename K, typename V>
-K BTreeNode<K, V>::getPredecessor(int idx) {
+template<typename K, typename V, int ORDER>
+pair<K, V> BTreeNode<K, V, ORDER>::getPredecessor(int idx) {
     BTreeNode* cur = children[idx];
     while (!cur->isLeaf) {
         cur = cur->children[cur->numKeys];
     }
-    return cur->keys[cur->numKeys - 1];
+    return {cur->keys[cur->numKeys - 1], cur->values[cur->numKeys - 1]};
 }
 
-template<typename K, typename V>
-K BTreeNode<K, V>::getSuccessor(int idx) {
+template<typename K, typename V, int ORDER>
+pair<K, V> BTreeNode<K, V, ORDER>::getSuccessor(int idx) {
     BTreeNode* cur = children[idx + 1];
     while (!cur->isLeaf) {
         cur = cur->children[0];
     }
-    return cur->keys[0];
+    return {cur->keys[0], cur->values[0]};
 }
 
-template<typename K, typename V>
-void BTreeNode<K, V>::fill(int idx) {
+template<typename K, typename V, int ORDER>
+template<typename Alloc>
+void BTreeNode<K, V, ORDER>::fill(int idx, Alloc& alloc) {
     if (idx != 0 && children[idx - 1]->numKeys >= ORDER / 2) {
         borrowFromPrev(idx);
     } else if (idx != numKeys && children[idx + 1]->numKeys >= ORDER / 2) {
         borrowFromNext(idx);
     } else {
         if (idx != numKeys) {
-            merge(idx);
+            merge(idx, alloc);
         } else {
-            merge(idx - 1);
+            merge(idx - 1, alloc);
         }
     }
 }
 
-template<typename K, typename V>
-void BTreeNode<K, V>::borrowFromPrev(int idx) {
+template<typename K, typename V, int ORDER>
+void BTreeNode<K, V, ORDER>::borrowFromPrev(int idx) {
     BTreeNode* child = children[idx];
     BTreeNode* sibling = children[idx - 1];
     
     // Move keys in child
     for (int i = child->numKeys - 1; i >= 0; i--) {
-        child->keys[i + 1] = child->keys[i];
+        child->keys.moveFrom(i + 1, child->keys, i);
         child->values[i + 1] = child->values[i];
     }
     
@@ -315,37 +403,37 @@ void BTreeNode<K, V>::borrowFromPrev(int idx) {
         }
     }
     
-    child->keys[0] = keys[idx - 1];
+    child->keys.moveFrom(0, keys, idx - 1);
     child->values[0] = values[idx - 1];
     
     if (!child->isLeaf) {
         child->children[0] = sibling->children[sibling->numKeys];
     }
     
-    keys[idx - 1] = sibling->keys[sibling->numKeys - 1];
+    keys.moveFrom(idx - 1, sibling->keys, sibling->numKeys - 1);
     values[idx - 1] = sibling->values[sibling->numKeys - 1];
     
     child->numKeys++;
     sibling->numKeys--;
 }
 
-template<typename K, typename V>
-void BTreeNode<K, V>::borrowFromNext(int idx) {
+template<typename K, typename V, int ORDER>
+void BTreeNode<K, V, ORDER>::borrowFromNext(int idx) {
     BTreeNode* child = children[idx];
     BTreeNode* sibling = children[idx + 1];
     
-    child->keys[child->numKeys] = keys[idx];
+    child->keys.moveFrom(child->numKeys, keys, idx);
     child->values[child->numKeys] = values[idx];
     
     if (!child->isLeaf) {
         child->children[child->numKeys + 1] = sibling->children[0];
     }
     
-    keys[idx] = sibling->keys[0];
+    keys.moveFrom(idx, sibling->keys, 0);
     values[idx] = sibling->values[0];
     
     for (int i = 1; i < sibling->numKeys; i++) {
-        sibling->keys[i - 1] = sibling->keys[i];
+        sibling->keys.moveFrom(i - 1, sibling->keys, i);
         sibling->values[i - 1] = sibling->values[i];
     }
     
@@ -359,16 +447,17 @@ void BTreeNode<K, V>::borrowFromNext(int idx) {
     sibling->numKeys--;
 }
 
-template<typename K, typename V>
-void BTreeNode<K, V>::merge(int idx) {
+template<typename K, typename V, int ORDER>
+template<typename Alloc>
+void BTreeNode<K, V, ORDER>::merge(int idx, Alloc& alloc) {
     BTreeNode* child = children[idx];
     BTreeNode* sibling = children[idx + 1];
     
-    child->keys[child->numKeys] = keys[idx];
+    child->keys.moveFrom(child->numKeys, keys, idx);
     child->values[child->numKeys] = values[idx];
     
     for (int i = 0; i < sibling->numKeys; i++) {
-        child->keys[i + child->numKeys + 1] = sibling->keys[i];
+        child->keys.moveFrom(i + child->numKeys + 1, sibling->keys, i);
         child->values[i + child->numKeys + 1] = sibling->values[i];
     }
     
@@ -379,7 +468,7 @@ void BTreeNode<K, V>::merge(int idx) {
     }
     
     for (int i = idx + 1; i < numKeys; i++) {
-        keys[i - 1] = keys[i];
+        keys.moveFrom(i - 1, keys, i);
         values[i - 1] = values[i];
     }
     
@@ -390,21 +479,24 @@ void BTreeNode<K, V>::merge(int idx) {
     child->numKeys += sibling->numKeys + 1;
     numKeys--;
     
-    delete sibling;
+    alloc.release(sibling);
 }
 
 // ==================== BTree Implementation ====================
 
-template<typename K, typename V>
-BTree<K, V>::BTree() : root(nullptr) {}
+template<typename K, typename V, int ORDER, template<typename> class Allocator>
+BTree<K, V, ORDER, Allocator>::BTree() : root(nullptr) {}
 
-template<typename K, typename V>
-BTree<K, V>::~BTree() {
-    destroyTree(root);
+template<typename K, typename V, int ORDER, template<typename> class Allocator>
+BTree<K, V, ORDER, Allocator>::~BTree() {
+    // A bulk-reset allocator frees its nodes when it is destroyed
+    if constexpr (!Allocator<Node>::BULK_RESET) {
+        destroyTree(root);
+    }
 }
 
-template<typename K, typename V>
-void BTree<K, V>::destroyTree(BTreeNode<K, V>* node) {
+template<typename K, typename V, int ORDER, template<typename> class Allocator>
+void BTree<K, V, ORDER, Allocator>::destroyTree(BTreeNode<K, V, ORDER>* node) {
     if (node == nullptr) return;
     
     if (!node->isLeaf) {
@@ -412,20 +504,21 @@ void BTree<K, V>::destroyTree(BTreeNode<K, V>* node) {
             destroyTree(node->children[i]);
         }
     }
-    delete node;
+    nodes.release(node);
 }
 
-template<typename K, typename V>
-V* BTree<K, V>::search(const K& key) {
+template<typename K, typename V, int ORDER, template<typename> class Allocator>
+template<typename Q>
+V* BTree<K, V, ORDER, Allocator>::search(const Q& key) {
     if (root == nullptr) return nullptr;
     return root->search(key);
 }
 
-template<typename K, typename V>
-void BTree<K, V>::insert(const K& key, const V& value) {
+template<typename K, typename V, int ORDER, template<typename> class Allocator>
+void BTree<K, V, ORDER, Allocator>::insert(const K& key, const V& value) {
     if (root == nullptr) {
-        root = new BTreeNode<K, V>(true);
-        root->keys[0] = key;
+        root = newNode(true);
+        root->keys.set(0, key);
         root->values[0] = value;
         root->numKeys = 1;
         return;
@@ -437,24 +530,24 @@ void BTree<K, V>::insert(const K& key, const V& value) {
     }
     
     if (root->numKeys == ORDER - 1) {
-        BTreeNode<K, V>* newRoot = new BTreeNode<K, V>(false);
+        BTreeNode<K, V, ORDER>* newRoot = newNode(false);
         newRoot->children[0] = root;
-        newRoot->splitChild(0, root);
+        newRoot->splitChild(0, root, nodes);
         
         int i = 0;
         if (newRoot->keys[0] < key) {
             i++;
         }
-        newRoot->children[i]->insertNonFull(key, value);
+        newRoot->children[i]->insertNonFull(key, value, nodes);
         
         root = newRoot;
     } else {
-        root->insertNonFull(key, value);
+        root->insertNonFull(key, value, nodes);
     }
 }
 
-template<typename K, typename V>
-bool BTree<K, V>::update(const K& key, const V& value) {
+template<typename K, typename V, int ORDER, template<typename> class Allocator>
+bool BTree<K, V, ORDER, Allocator>::update(const K& key, const V& value) {
     V* found = search(key);
     if (found != nullptr) {
         *found = value;
@@ -463,67 +556,61 @@ bool BTree<K, V>::update(const K& key, const V& value) {
     return false;
 }
 
-template<typename K, typename V>
-void BTree<K, V>::remove(const K& key) {
+template<typename K, typename V, int ORDER, template<typename> class Allocator>
+void BTree<K, V, ORDER, Allocator>::remove(const K& key) {
     if (root == nullptr) return;
     
-    root->remove(key);
+    root->remove(key, nodes);
     
     if (root->numKeys == 0) {
-        BTreeNode<K, V>* oldRoot = root;
+        BTreeNode<K, V, ORDER>* oldRoot = root;
         if (root->isLeaf) {
             root = nullptr;
         } else {
             root = root->children[0];
         }
-        delete oldRoot;
+        nodes.release(oldRoot);
     }
 }
 
-template<typename K, typename V>
-void BTree<K, V>::getAllPairs(BTreeNode<K, V>* node, vector<pair<K, V>>& pairs) {
+template<typename K, typename V, int ORDER, template<typename> class Allocator>
+void BTree<K, V, ORDER, Allocator>::getAllPairs(BTreeNode<K, V, ORDER>* node, vector<pair<K, V>>& pairs) {
     if (node == nullptr) {
-        cout << "[BTree] getAllPairs: node is nullptr" << endl;
         return;
     }
     
-    cout << "[BTree] Visiting node with " << node->numKeys << " keys, isLeaf=" << node->isLeaf << endl;
-    
     int i;
     for (i = 0; i < node->numKeys; i++) {
         if (!node->isLeaf) {
-            cout << "[BTree]   Traversing left child " << i << endl;
             getAllPairs(node->children[i], pairs);
         }
-        cout << "[BTree]   Adding key[" << i << "]: " << node->keys[i] << endl;
         pairs.push_back({node->keys[i], node->values[i]});
     }
     
     if (!node->isLeaf) {
-        cout << "[BTree]   Traversing right child " << i << endl;
         getAllPairs(node->children[i], pairs);
     }
-    
-    cout << "[BTree] Node done. Total pairs so far: " << pairs.size() << endl;
 }
 
-template<typename K, typename V>
-vector<pair<K, V>> BTree<K, V>::getAllPairs() {
+template<typename K, typename V, int ORDER, template<typename> class Allocator>
+vector<pair<K, V>> BTree<K, V, ORDER, Allocator>::getAllPairs() {
     vector<pair<K, V>> pairs;
-    cout << "[BTree] getAllPairs() called. Root is " << (root ? "NOT null" : "null") << endl;
     getAllPairs(root, pairs);
-    cout << "[BTree] getAllPairs() returning " << pairs.size() << " total pairs" << endl;
     return pairs;
 }
 
-template<typename K, typename V>
-void BTree<K, V>::clear() {
-    destroyTree(root);
+template<typename K, typename V, int ORDER, template<typename> class Allocator>
+void BTree<K, V, ORDER, Allocator>::clear() {
+    if constexpr (Allocator<Node>::BULK_RESET) {
+        nodes.reset();  // O(1): every node goes back to the pool
+    } else {
+        destroyTree(root);
+    }
     root = nullptr;
 }
 
-template<typename K, typename V>
-bool BTree<K, V>::saveToFile(const string& filename) {
+template<typename K, typename V, int ORDER, template<typename> class Allocator>
+bool BTree<K, V, ORDER, Allocator>::saveToFile(const string& filename) {
     // Note: Simplified serialization - in production, implement proper node serialization
     ofstream out(filename, ios::binary);
     if (!out.is_open()) return false;
@@ -541,8 +628,8 @@ bool BTree<K, V>::saveToFile(const string& filename) {
     return true;
 }
 
-template<typename K, typename V>
-bool BTree<K, V>::loadFromFile(const string& filename) {
+template<typename K, typename V, int ORDER, template<typename> class Allocator>
+bool BTree<K, V, ORDER, Allocator>::loadFromFile(const string& filename) {
     ifstream in(filename, ios::binary);
     if (!in.is_open()) return false;
     
@@ -563,4 +650,73 @@ bool BTree<K, V>::loadFromFile(const string& filename) {
     return true;
 }
 
+template<typename K, typename V, int ORDER, template<typename> class Allocator>
+template<typename It>
+void BTree<K, V, ORDER, Allocator>::bulkLoad(It first, It last, double fillFactor) {
+    clear();
+    
+    size_t n = static_cast<size_t>(last - first);
+    if (n == 0) return;
+    
+    for (size_t i = 1; i < n; i++) {
+        if (!(first[i - 1].first < first[i].first)) {
+            for (It it = first; it != last; ++it) {
+                insert(it->first, it->second);
+            }
+            return;
+        }
+    }
+    
+    // Keys per node; at least 2 so every split below leaves each child non-empty
+    size_t perNode = static_cast<size_t>(fillFactor * (ORDER - 1) + 0.5);
+    perNode = max<size_t>(2, min<size_t>(ORDER - 1, perNode));
+    
+    // Lowest tree that holds n pairs at the fill target
+    vector<size_t> capacities = {perNode};
+    while (capacities.back() < n) {
+        capacities.push_back((perNode + 1) * capacities.back() + perNode);
+    }
+    
+    root = buildSubtree(first, n, static_cast<int>(capacities.size()) - 1, capacities);
+}
+
+template<typename K, typename V, int ORDER, template<typename> class Allocator>
+template<typename It>
+BTreeNode<K, V, ORDER>* BTree<K, V, ORDER, Allocator>::buildSubtree(It first, size_t count, int height,
+                                                                    const vector<size_t>& capacities) {
+    Node* node = newNode(height == 0);
+    
+    if (height == 0) {
+        for (size_t i = 0; i < count; i++) {
+            node->keys.set(i, first[i].first);
+            node->values[i] = first[i].second;
+        }
+        node->numKeys = static_cast<int>(count);
+        node->keys.repack(node->numKeys);
+        return node;
+    }
+    
+    // Fewest children that fit count pairs, then spread pairs evenly
+    size_t childCapacity = capacities[height - 1];
+    size_t children = max<size_t>(2, (count + childCapacity + 1) / (childCapacity + 1));
+    size_t childPairs = count - (children - 1);
+    
+    size_t pos = 0;
+    for (size_t i = 0; i < children; i++) {
+        size_t take = childPairs / children + (i < childPairs % children ? 1 : 0);
+        node->children[i] = buildSubtree(first + pos, take, height - 1, capacities);
+        pos += take;
+        
+        // The pair between two children becomes this node's key
+        if (i + 1 < children) {
+            node->keys.set(i, first[pos].first);
+            node->values[i] = first[pos].second;
+            pos++;
+        }
+    }
+    node->numKeys = static_cast<int>(children - 1);
+    node->keys.repack(node->numKeys);
+    return node;
+}
+
 #endif // BTREE_H
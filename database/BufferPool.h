@@ -0,0 +1,265 @@
+#ifndef BUFFER_POOL_H
+#define BUFFER_POOL_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <unordered_map>
+#include <stdexcept>
+#include <cstdint>
+#include <cstring>
+
+using namespace std;
+
+using PageID = uint32_t;
+static const PageID INVALID_PAGE = 0xFFFFFFFFu;
+
+/**
+ * PageFile - A binary file of fixed-size pages (page i at byte i * pageSize)
+ *
+ * Pages past the end of the file read as zeros; allocate() hands out the
+ * next page number and the file grows when that page is first written.
+ */
+class PageFile {
+private:
+    string path;
+    size_t pageSize;
+    fstream file;
+    PageID pageCount;
+
+public:
+    PageFile(const string& filePath, size_t size) : path(filePath), pageSize(size), pageCount(0) {
+        file.open(path, ios::in | ios::out | ios::binary);
+        if (!file.is_open()) {
+            ofstream create(path, ios::binary);  // Create, then reopen read/write
+            create.close();
+            file.open(path, ios::in | ios::out | ios::binary);
+        }
+        if (!file.is_open()) {
+            throw runtime_error("PageFile: cannot open " + path);
+        }
+        file.seekg(0, ios::end);
+        pageCount = static_cast<PageID>(static_cast<size_t>(file.tellg()) / pageSize);
+    }
+
+    PageFile(const PageFile&) = delete;
+    PageFile& operator=(const PageFile&) = delete;
+
+    // Read page id into buffer (zeros where the file ends)
+    void read(PageID id, char* buffer) {
+        memset(buffer, 0, pageSize);
+        if (id >= pageCount) return;
+        file.clear();
+        file.seekg(static_cast<streamoff>(id) * static_cast<streamoff>(pageSize));
+        file.read(buffer, static_cast<streamsize>(pageSize));
+    }
+
+    bool write(PageID id, const char* buffer) {
+        file.clear();
+        file.seekp(static_cast<streamoff>(id) * static_cast<streamoff>(pageSize));
+        file.write(buffer, static_cast<streamsize>(pageSize));
+        if (id >= pageCount) pageCount = id + 1;
+        return file.good();
+    }
+
+    PageID allocate() { return pageCount++; }
+    PageID numPages() const { return pageCount; }
+
+    // Push written pages to the OS (fsync is the caller's business)
+    void flush() { file.flush(); }
+
+    // Drop every page
+    void truncate() {
+        file.close();
+        file.open(path, ios::in | ios::out | ios::binary | ios::trunc);
+        pageCount = 0;
+    }
+
+    const string& getPath() const { return path; }
+    size_t getPageSize() const { return pageSize; }
+};
+
+class BufferPool;
+
+/**
+ * PageGuard - A pinned page; unpins when destroyed
+ *
+ * Call markDirty() after changing data() so the page is written back
+ * before its frame is reused.
+ */
+class PageGuard {
+private:
+    BufferPool* pool;
+    size_t frame;
+    PageID id;
+    char* bytes;
+    bool dirty;
+
+    friend class BufferPool;
+    PageGuard(BufferPool* p, size_t f, PageID page, char* data)
+        : pool(p), frame(f), id(page), bytes(data), dirty(false) {}
+
+public:
+    PageGuard() : pool(nullptr), frame(0), id(INVALID_PAGE), bytes(nullptr), dirty(false) {}
+
+    PageGuard(PageGuard&& other) noexcept
+        : pool(other.pool), frame(other.frame), id(other.id), bytes(other.bytes), dirty(other.dirty) {
+        other.pool = nullptr;
+    }
+
+    PageGuard& operator=(PageGuard&& other) noexcept {
+        if (this != &other) {
+            release();
+            pool = other.pool;
+            frame = other.frame;
+            id = other.id;
+            bytes = other.bytes;
+            dirty = other.dirty;
+            other.pool = nullptr;
+        }
+        return *this;
+    }
+
+    PageGuard(const PageGuard&) = delete;
+    PageGuard& operator=(const PageGuard&) = delete;
+
+    ~PageGuard() { release(); }
+
+    char* data() { return bytes; }
+    const char* data() const { return bytes; }
+    PageID page() const { return id; }
+    bool valid() const { return pool != nullptr; }
+    void markDirty() { dirty = true; }
+
+    inline void release();
+};
+
+/**
+ * BufferPool - Caches the pages of a PageFile in a fixed number of frames
+ *
+ * fetch() pins a page, reading it on a miss. When every frame is taken the
+ * CLOCK hand sweeps the frames: a pinned frame is skipped, a recently used
+ * one loses its reference bit (a second chance), and the first frame with
+ * neither is evicted, written back first if dirty. Memory use is fixed at
+ * frames * pageSize however large the file grows.
+ */
+class BufferPool {
+private:
+    struct Frame {
+        PageID page = INVALID_PAGE;
+        int pins = 0;
+        bool dirty = false;
+        bool referenced = false;
+    };
+
+    PageFile& file;
+    size_t pageSize;
+    vector<char> memory;
+    vector<Frame> frames;
+    unordered_map<PageID, size_t> pageTable;  // Cached page -> frame
+    size_t hand;                              // CLOCK position
+    size_t hits;
+    size_t misses;
+
+    char* frameData(size_t f) { return memory.data() + f * pageSize; }
+
+    size_t victim() {
+        for (size_t step = 0; step < 2 * frames.size(); step++) {
+            size_t f = hand;
+            hand = (hand + 1) % frames.size();
+            Frame& frame = frames[f];
+            if (frame.pins > 0) continue;
+            if (frame.referenced) {
+                frame.referenced = false;
+                continue;
+            }
+            return f;
+        }
+        throw runtime_error("BufferPool: every frame is pinned");
+    }
+
+    friend class PageGuard;
+    void unpin(size_t f, bool dirty) {
+        frames[f].pins--;
+        frames[f].dirty = frames[f].dirty || dirty;
+    }
+
+public:
+    BufferPool(PageFile& pageFile, size_t frameCount)
+        : file(pageFile), pageSize(pageFile.getPageSize()),
+          memory(frameCount * pageFile.getPageSize()), frames(frameCount),
+          hand(0), hits(0), misses(0) {
+        if (frameCount < 8) {
+            throw invalid_argument("BufferPool: need at least 8 frames");
+        }
+        pageTable.reserve(frameCount);
+    }
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    ~BufferPool() { flushAll(); }
+
+    // Pin page id, reading it from the file if it isn't cached
+    PageGuard fetch(PageID id) {
+        auto it = pageTable.find(id);
+        if (it != pageTable.end()) {
+            hits++;
+            Frame& frame = frames[it->second];
+            frame.pins++;
+            frame.referenced = true;
+            return PageGuard(this, it->second, id, frameData(it->second));
+        }
+
+        misses++;
+        size_t f = victim();
+        Frame& frame = frames[f];
+        if (frame.page != INVALID_PAGE) {
+            if (frame.dirty) {
+                file.write(frame.page, frameData(f));
+            }
+            pageTable.erase(frame.page);
+        }
+
+        file.read(id, frameData(f));
+        frame.page = id;
+        frame.pins = 1;
+        frame.dirty = false;
+        frame.referenced = true;
+        pageTable[id] = f;
+        return PageGuard(this, f, id, frameData(f));
+    }
+
+    // Write every dirty page back to the file
+    void flushAll() {
+        for (size_t f = 0; f < frames.size(); f++) {
+            if (frames[f].page != INVALID_PAGE && frames[f].dirty) {
+                file.write(frames[f].page, frameData(f));
+                frames[f].dirty = false;
+            }
+        }
+        file.flush();
+    }
+
+    // Forget every cached page without writing it (after PageFile::truncate)
+    void discardAll() {
+        for (auto& frame : frames) {
+            frame = Frame();
+        }
+        pageTable.clear();
+        hand = 0;
+    }
+
+    size_t frameCount() const { return frames.size(); }
+    size_t hitCount() const { return hits; }
+    size_t missCount() const { return misses; }
+};
+
+inline void PageGuard::release() {
+    if (pool != nullptr) {
+        pool->unpin(frame, dirty);
+        pool = nullptr;
+    }
+}
+
+#endif // BUFFER_POOL_H
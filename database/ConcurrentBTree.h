@@ -0,0 +1,550 @@
+#ifndef CONCURRENT_BTREE_H
+#define CONCURRENT_BTREE_H
+
+#include "BTree.h"  // BTreeCacheOrder
+#include "NodePool.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+using namespace std;
+
+/**
+ * FixedKey - String key of up to N bytes stored inline
+ *
+ * ConcurrentBTree readers copy keys while a writer may be changing them,
+ * which is only safe for plain bytes, so string IDs go in as FixedKey.
+ * Shorter strings are zero-padded, which makes memcmp order equal string
+ * order for strings without NUL bytes; fits() checks a string first.
+ */
+template<size_t N>
+struct FixedKey {
+    char bytes[N];
+
+    FixedKey() { memset(bytes, 0, N); }
+    FixedKey(string_view s) { assign(s); }
+    FixedKey(const string& s) { assign(s); }
+    FixedKey(const char* s) { assign(s); }
+
+    static bool fits(string_view s) { return s.size() <= N && s.find('\0') == string_view::npos; }
+
+    string str() const {
+        const void* end = memchr(bytes, 0, N);
+        return string(bytes, end == nullptr ? N : static_cast<const char*>(end) - bytes);
+    }
+
+    bool operator<(const FixedKey& other) const { return memcmp(bytes, other.bytes, N) < 0; }
+    bool operator==(const FixedKey& other) const { return memcmp(bytes, other.bytes, N) == 0; }
+    bool operator!=(const FixedKey& other) const { return !(*this == other); }
+
+private:
+    void assign(string_view s) {  // Input longer than N is cut; check fits()
+        size_t len = min(s.size(), N);
+        memcpy(bytes, s.data(), len);
+        memset(bytes + len, 0, N - len);
+    }
+};
+
+/**
+ * ConcurrentBTree - B+Tree for many threads using optimistic lock coupling
+ *
+ * Every node carries a version word; a writer makes it odd while it holds
+ * the node and even again (two higher) when it lets go.
+ * - get()/contains()/scan() take no locks: they read a node, then check
+ *   its version is unchanged, and restart from the root (or re-read the
+ *   leaf, for scans) if a writer got in. Readers never block writers or
+ *   each other.
+ * - insert()/update()/remove() descend the same way and lock only the
+ *   leaf they change; a full node met on the way down is split first,
+ *   locking just that node and its parent.
+ *
+ * Nodes are never freed while the tree is in use (remove() leaves
+ * underfull leaves in place), so a reader holding a stale pointer still
+ * reads valid memory and the version check rejects what it saw. clear()
+ * and destruction need exclusive access.
+ *
+ * K and V must be trivially copyable, since readers copy them out of
+ * nodes that may be mid-write: use FixedKey<N> for string IDs. Values are
+ * returned by copy, as in ConcurrentHashTable. ORDER is the maximum number
+ * of children of an internal node; leaves hold up to ORDER-1 pairs.
+ */
+template<typename K, typename V, int ORDER = BTreeCacheOrder<K, V>::value>
+class ConcurrentBTree {
+private:
+    static_assert(ORDER >= 4, "B-Tree order must be at least 4");
+    static_assert(is_trivially_copyable_v<K> && is_trivially_copyable_v<V>,
+                  "ConcurrentBTree keys and values must be trivially copyable (use FixedKey for strings)");
+
+    static constexpr int MAX_KEYS = ORDER - 1;
+
+    // Version lock: odd while a writer holds it, +2 per completed write
+    class VersionLock {
+    private:
+        atomic<uint64_t> version{0};
+
+    public:
+        // Start an optimistic read; false while a writer holds the node
+        bool readLock(uint64_t& v) const {
+            v = version.load(memory_order_acquire);
+            return (v & 1) == 0;
+        }
+
+        // Was the node left alone since readLock returned v?
+        bool validate(uint64_t v) const {
+            atomic_thread_fence(memory_order_acquire);
+            return version.load(memory_order_relaxed) == v;
+        }
+
+        // Turn a read at v into the write lock, unless a writer got in first
+        bool upgrade(uint64_t v) {
+            return version.compare_exchange_strong(v, v + 1, memory_order_acquire);
+        }
+
+        void unlock() { version.fetch_add(1, memory_order_release); }
+    };
+
+    struct Node {
+        VersionLock lock;
+        bool isLeaf = true;
+        int numKeys = 0;
+        K keys[MAX_KEYS];
+    };
+
+    struct Leaf : Node {
+        V values[MAX_KEYS];
+        Leaf* next = nullptr;             // Right sibling in key order
+    };
+
+    // children[i] holds keys < keys[i] <= children[i+1]
+    struct Inner : Node {
+        Node* children[ORDER];
+    };
+
+    atomic<Node*> root;
+    atomic<size_t> count;
+    mutex poolLock;                       // Splits in different subtrees allocate concurrently
+    NodePool<Leaf> leaves;
+    NodePool<Inner> inners;
+
+    Leaf* newLeaf() {
+        lock_guard<mutex> guard(poolLock);
+        Leaf* leaf = leaves.allocate();
+        leaf->isLeaf = true;
+        leaf->numKeys = 0;
+        leaf->next = nullptr;
+        return leaf;
+    }
+
+    Inner* newInner() {
+        lock_guard<mutex> guard(poolLock);
+        Inner* node = inners.allocate();
+        node->isLeaf = false;
+        node->numKeys = 0;
+        return node;
+    }
+
+    // numKeys as seen by a reader that may race a writer: kept in bounds
+    // so a torn read can't index past the arrays (the version check then
+    // discards the result)
+    static int keyCount(const Node* node) {
+        int n = node->numKeys;
+        return n < 0 ? 0 : (n > MAX_KEYS ? MAX_KEYS : n);
+    }
+
+    // Child subtree that may contain key (keys equal to a separator go right)
+    static int childIndex(const Node* node, int n, const K& key) {
+        return static_cast<int>(upper_bound(node->keys, node->keys + n, key) - node->keys);
+    }
+
+    static int lowerIndex(const Node* node, int n, const K& key) {
+        return static_cast<int>(lower_bound(node->keys, node->keys + n, key) - node->keys);
+    }
+
+    static void backoff() { this_thread::yield(); }
+
+    // Optimistically descend to the leaf for key (the leftmost leaf when
+    // key is null). Returns the leaf with its version, or nullptr if a
+    // writer interfered and the caller must restart.
+    Leaf* findLeaf(const K* key, uint64_t& version) const;
+
+    // One insert attempt; false means restart from the root
+    bool tryInsert(const K& key, const V& value);
+
+    // Split a full node (locked by the caller); sets sep to the key that
+    // goes up and returns the new right sibling
+    Node* split(Node* node, K& sep);
+
+    // Lock the leaf for key and apply change(leaf, position, found);
+    // returns whatever change returns
+    template<typename Change>
+    bool modifyLeaf(const K& key, Change change);
+
+    size_t scanFrom(const K* lo, const K* hi, vector<pair<K, V>>& out, size_t limit) const;
+
+public:
+    ConcurrentBTree() : root(nullptr), count(0) {
+        root.store(newLeaf(), memory_order_release);
+    }
+
+    ConcurrentBTree(const ConcurrentBTree&) = delete;
+    ConcurrentBTree& operator=(const ConcurrentBTree&) = delete;
+
+    // Insert or update key-value pair
+    void insert(const K& key, const V& value) {
+        while (!tryInsert(key, value)) {
+            backoff();
+        }
+    }
+
+    // Copy value into outValue (returns false if not found)
+    bool get(const K& key, V& outValue) const;
+
+    bool contains(const K& key) const {
+        V ignored;
+        return get(key, ignored);
+    }
+
+    // Update existing key's value
+    bool update(const K& key, const V& value) {
+        return modifyLeaf(key, [&](Leaf* leaf, int i, bool found) {
+            if (found) leaf->values[i] = value;
+            return found;
+        });
+    }
+
+    // Remove key-value pair (the leaf is not merged, see class comment)
+    bool remove(const K& key);
+
+    // Append entries with lo <= key <= hi to out in key order, at most
+    // limit of them; returns how many were added. Each leaf is copied
+    // consistently, but the scan as a whole is not a snapshot: writes that
+    // land behind it are missed.
+    size_t scan(const K& lo, const K& hi, vector<pair<K, V>>& out, size_t limit = SIZE_MAX) const {
+        if (hi < lo) return 0;
+        return scanFrom(&lo, &hi, out, limit);
+    }
+
+    // Get all key-value pairs in key order (same caveat as scan)
+    vector<pair<K, V>> getAllPairs() const {
+        vector<pair<K, V>> pairs;
+        pairs.reserve(size());
+        scanFrom(nullptr, nullptr, pairs, SIZE_MAX);
+        return pairs;
+    }
+
+    // Get number of elements (not a snapshot while writers are active)
+    size_t size() const { return count.load(memory_order_relaxed); }
+
+    bool isEmpty() const { return size() == 0; }
+
+    // Clear all data; no other thread may use the tree meanwhile
+    void clear() {
+        {
+            lock_guard<mutex> guard(poolLock);
+            leaves.reset();
+            inners.reset();
+        }
+        root.store(newLeaf(), memory_order_release);
+        count.store(0, memory_order_relaxed);
+    }
+};
+
+// ==================== ConcurrentBTree Implementation ====================
+
+template<typename K, typename V, int ORDER>
+typename ConcurrentBTree<K, V, ORDER>::Leaf* ConcurrentBTree<K, V, ORDER>::findLeaf(const K* key, uint64_t& version) const {
+    Node* node = root.load(memory_order_acquire);
+    uint64_t v;
+    if (!node->lock.readLock(v) || node != root.load(memory_order_acquire)) {
+        return nullptr;  // Root locked or replaced by a root split
+    }
+
+    while (!node->isLeaf) {
+        const Inner* inner = static_cast<const Inner*>(node);
+        Node* child = inner->children[key == nullptr ? 0 : childIndex(inner, keyCount(inner), *key)];
+        if (!inner->lock.validate(v)) {
+            return nullptr;  // child may be garbage: don't touch it
+        }
+
+        uint64_t childVersion;
+        if (!child->lock.readLock(childVersion)) {
+            return nullptr;
+        }
+        // A split of child after we read the pointer shows up in the
+        // parent, so checking the parent again pins child's key range
+        if (!inner->lock.validate(v)) {
+            return nullptr;
+        }
+        node = child;
+        v = childVersion;
+    }
+
+    version = v;
+    return static_cast<Leaf*>(node);
+}
+
+template<typename K, typename V, int ORDER>
+bool ConcurrentBTree<K, V, ORDER>::get(const K& key, V& outValue) const {
+    while (true) {
+        uint64_t v;
+        const Leaf* leaf = findLeaf(&key, v);
+        if (leaf == nullptr) {
+            backoff();
+            continue;
+        }
+
+        int n = keyCount(leaf);
+        int i = lowerIndex(leaf, n, key);
+        bool found = i < n && leaf->keys[i] == key;
+        V value = found ? leaf->values[i] : V();
+        if (!leaf->lock.validate(v)) {
+            continue;
+        }
+
+        if (found) {
+            outValue = value;
+        }
+        return found;
+    }
+}
+
+template<typename K, typename V, int ORDER>
+bool ConcurrentBTree<K, V, ORDER>::tryInsert(const K& key, const V& value) {
+    Node* node = root.load(memory_order_acquire);
+    uint64_t v;
+    if (!node->lock.readLock(v) || node != root.load(memory_order_acquire)) {
+        return false;
+    }
+
+    Inner* parent = nullptr;
+    uint64_t parentVersion = 0;
+    while (true) {
+        if (parent != nullptr && !parent->lock.validate(parentVersion)) {
+            return false;
+        }
+
+        // Split full nodes on the way down so a parent always has room for
+        // the separator of a child split
+        if (node->numKeys == MAX_KEYS) {
+            if (parent != nullptr && !parent->lock.upgrade(parentVersion)) {
+                return false;
+            }
+            if (!node->lock.upgrade(v)) {
+                if (parent != nullptr) parent->lock.unlock();
+                return false;
+            }
+            if (parent == nullptr && node != root.load(memory_order_acquire)) {
+                node->lock.unlock();  // Someone grew the tree above us
+                return false;
+            }
+
+            K sep;
+            Node* right = split(node, sep);
+            if (parent != nullptr) {
+                int i = childIndex(parent, parent->numKeys, sep);
+                for (int j = parent->numKeys; j > i; j--) {
+                    parent->keys[j] = parent->keys[j - 1];
+                    parent->children[j + 1] = parent->children[j];
+                }
+                parent->keys[i] = sep;
+                parent->children[i + 1] = right;
+                parent->numKeys++;
+            } else {
+                Inner* newRoot = newInner();
+                newRoot->keys[0] = sep;
+                newRoot->children[0] = node;
+                newRoot->children[1] = right;
+                newRoot->numKeys = 1;
+                root.store(newRoot, memory_order_release);
+            }
+
+            node->lock.unlock();
+            if (parent != nullptr) parent->lock.unlock();
+            return false;  // Restart: key may now belong to the new sibling
+        }
+
+        if (node->isLeaf) {
+            break;
+        }
+
+        Inner* inner = static_cast<Inner*>(node);
+        Node* child = inner->children[childIndex(inner, keyCount(inner), key)];
+        if (!inner->lock.validate(v)) {
+            return false;
+        }
+        uint64_t childVersion;
+        if (!child->lock.readLock(childVersion)) {
+            return false;
+        }
+        parent = inner;
+        parentVersion = v;
+        node = child;
+        v = childVersion;
+    }
+
+    // Only the leaf is locked; its parent was validated after its version
+    // was read, so the leaf still covers key
+    Leaf* leaf = static_cast<Leaf*>(node);
+    if (!leaf->lock.upgrade(v)) {
+        return false;
+    }
+
+    int n = leaf->numKeys;
+    int i = lowerIndex(leaf, n, key);
+    if (i < n && leaf->keys[i] == key) {
+        leaf->values[i] = value;  // Existing key: update in place
+    } else {
+        for (int j = n; j > i; j--) {
+            leaf->keys[j] = leaf->keys[j - 1];
+            leaf->values[j] = leaf->values[j - 1];
+        }
+        leaf->keys[i] = key;
+        leaf->values[i] = value;
+        leaf->numKeys = n + 1;
+        count.fetch_add(1, memory_order_relaxed);
+    }
+    leaf->lock.unlock();
+    return true;
+}
+
+template<typename K, typename V, int ORDER>
+typename ConcurrentBTree<K, V, ORDER>::Node* ConcurrentBTree<K, V, ORDER>::split(Node* node, K& sep) {
+    int keep = node->numKeys / 2;
+
+    if (node->isLeaf) {
+        Leaf* leaf = static_cast<Leaf*>(node);
+        Leaf* right = newLeaf();
+        for (int j = keep; j < leaf->numKeys; j++) {
+            right->keys[j - keep] = leaf->keys[j];
+            right->values[j - keep] = leaf->values[j];
+        }
+        right->numKeys = leaf->numKeys - keep;
+        right->next = leaf->next;
+
+        // right is complete before a reader can reach it through next
+        leaf->next = right;
+        leaf->numKeys = keep;
+        sep = right->keys[0];  // Copied up: the pair stays in the leaf
+        return right;
+    }
+
+    // keys[keep] moves up; keys after it go to the new sibling
+    Inner* inner = static_cast<Inner*>(node);
+    Inner* right = newInner();
+    for (int j = keep + 1; j < inner->numKeys; j++) {
+        right->keys[j - keep - 1] = inner->keys[j];
+    }
+    for (int j = keep + 1; j <= inner->numKeys; j++) {
+        right->children[j - keep - 1] = inner->children[j];
+    }
+    right->numKeys = inner->numKeys - keep - 1;
+
+    sep = inner->keys[keep];
+    inner->numKeys = keep;
+    return right;
+}
+
+template<typename K, typename V, int ORDER>
+template<typename Change>
+bool ConcurrentBTree<K, V, ORDER>::modifyLeaf(const K& key, Change change) {
+    while (true) {
+        uint64_t v;
+        Leaf* leaf = findLeaf(&key, v);
+        if (leaf == nullptr || !leaf->lock.upgrade(v)) {
+            backoff();
+            continue;
+        }
+
+        int n = leaf->numKeys;
+        int i = lowerIndex(leaf, n, key);
+        bool result = change(leaf, i, i < n && leaf->keys[i] == key);
+        leaf->lock.unlock();
+        return result;
+    }
+}
+
+template<typename K, typename V, int ORDER>
+bool ConcurrentBTree<K, V, ORDER>::remove(const K& key) {
+    return modifyLeaf(key, [&](Leaf* leaf, int i, bool found) {
+        if (!found) return false;
+        for (int j = i + 1; j < leaf->numKeys; j++) {
+            leaf->keys[j - 1] = leaf->keys[j];
+            leaf->values[j - 1] = leaf->values[j];
+        }
+        leaf->numKeys--;
+        count.fetch_sub(1, memory_order_relaxed);
+        return true;
+    });
+}
+
+template<typename K, typename V, int ORDER>
+size_t ConcurrentBTree<K, V, ORDER>::scanFrom(const K* lo, const K* hi, vector<pair<K, V>>& out, size_t limit) const {
+    size_t added = 0;
+    if (limit == 0) return 0;
+
+    uint64_t v;
+    const Leaf* leaf;
+    while ((leaf = findLeaf(lo, v)) == nullptr) {
+        backoff();
+    }
+
+    // Copy a leaf, then keep it only if its version held. A leaf's range
+    // only shrinks (a split moves its upper half to a new next leaf), so a
+    // failed copy re-reads the same leaf instead of descending again.
+    K keys[MAX_KEYS];
+    V values[MAX_KEYS];
+    bool haveLast = false;
+    K last{};
+    while (leaf != nullptr) {
+        int n = keyCount(leaf);
+        int m = 0;
+        bool pastHi = false;
+        for (int i = 0; i < n; i++) {
+            K key = leaf->keys[i];
+            if (haveLast ? !(last < key) : (lo != nullptr && key < *lo)) continue;
+            if (hi != nullptr && *hi < key) {
+                pastHi = true;
+                break;
+            }
+            keys[m] = key;
+            values[m] = leaf->values[i];
+            m++;
+        }
+        const Leaf* next = leaf->next;
+
+        if (!leaf->lock.validate(v)) {
+            while (!leaf->lock.readLock(v)) {
+                backoff();
+            }
+            continue;
+        }
+
+        for (int j = 0; j < m && added < limit; j++) {
+            out.emplace_back(keys[j], values[j]);
+            added++;
+        }
+        if (m > 0) {
+            last = keys[m - 1];
+            haveLast = true;
+        }
+        if (pastHi || added == limit) {
+            break;
+        }
+
+        leaf = next;
+        while (leaf != nullptr && !leaf->lock.readLock(v)) {
+            backoff();
+        }
+    }
+    return added;
+}
+
+#endif // CONCURRENT_BTREE_H
@@ -0,0 +1,149 @@
+#ifndef CONCURRENT_HASHTABLE_H
+#define CONCURRENT_HASHTABLE_H
+
+#include "HashTable.h"
+#include "KeyHash.h"
+#include <shared_mutex>
+#include <mutex>
+#include <vector>
+#include <array>
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * ConcurrentHashTable - Lock-striped HashTable for many reader threads
+ *
+ * The key space is split across SHARDS independent HashTable<K, V> shards,
+ * each guarded by its own shared_mutex:
+ * - get()/contains() take a shared lock on one shard, so readers never
+ *   block each other and only contend with writers to the same shard
+ * - insert()/remove()/update() take an exclusive lock on one shard
+ * - Whole-table operations (size, getAllPairs, clear) visit shards in order
+ *
+ * Values are returned by copy: a pointer into a shard would outlive the lock.
+ * SHARDS must be a power of two. Hash is the hash policy shared by the
+ * shard selector and the shards (see HashTable).
+ */
+template<typename K, typename V, size_t SHARDS = 16, typename Hash = KeyHash<K>>
+class ConcurrentHashTable {
+private:
+    static_assert(SHARDS > 0 && (SHARDS & (SHARDS - 1)) == 0, "SHARDS must be a power of two");
+
+    // Padded to a cache line so neighbouring shard locks don't false-share
+    struct alignas(64) Shard {
+        mutable shared_mutex lock;
+        HashTable<K, V, Hash> table;
+    };
+
+    array<Shard, SHARDS> shards;
+    Hash hashFunction;
+
+    // Shard index from the high bits of a mixed hash; the shard's own
+    // HashTable buckets by hash % size, so the two choices stay independent
+    template<typename Q>
+    Shard& shardFor(const Q& key) {
+        return shards[shardIndex(hashFunction(key))];
+    }
+
+    template<typename Q>
+    const Shard& shardFor(const Q& key) const {
+        return shards[shardIndex(hashFunction(key))];
+    }
+
+    static size_t shardIndex(size_t hash) {
+        uint64_t mixed = static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ULL;
+        return static_cast<size_t>(mixed >> 32) & (SHARDS - 1);
+    }
+
+public:
+    ConcurrentHashTable() {}
+
+    ConcurrentHashTable(const ConcurrentHashTable&) = delete;
+    ConcurrentHashTable& operator=(const ConcurrentHashTable&) = delete;
+
+    // Insert or update key-value pair
+    void insert(const K& key, const V& value) {
+        Shard& shard = shardFor(key);
+        unique_lock<shared_mutex> guard(shard.lock);
+        shard.table.insert(key, value);
+    }
+
+    // Copy value into outValue (returns false if not found)
+    template<typename Q>
+    bool get(const Q& key, V& outValue) const {
+        const Shard& shard = shardFor(key);
+        shared_lock<shared_mutex> guard(shard.lock);
+        const V* found = shard.table.get(key);
+        if (found == nullptr) {
+            return false;
+        }
+        outValue = *found;
+        return true;
+    }
+
+    // Check if key exists
+    template<typename Q>
+    bool contains(const Q& key) const {
+        const Shard& shard = shardFor(key);
+        shared_lock<shared_mutex> guard(shard.lock);
+        return shard.table.contains(key);
+    }
+
+    // Remove key-value pair
+    bool remove(const K& key) {
+        Shard& shard = shardFor(key);
+        unique_lock<shared_mutex> guard(shard.lock);
+        return shard.table.remove(key);
+    }
+
+    // Update existing key's value
+    bool update(const K& key, const V& value) {
+        Shard& shard = shardFor(key);
+        unique_lock<shared_mutex> guard(shard.lock);
+        return shard.table.update(key, value);
+    }
+
+    // Get number of elements (not a snapshot while writers are active)
+    size_t size() const {
+        size_t total = 0;
+        for (const auto& shard : shards) {
+            shared_lock<shared_mutex> guard(shard.lock);
+            total += shard.table.size();
+        }
+        return total;
+    }
+
+    bool isEmpty() const { return size() == 0; }
+
+    // Get all key-value pairs, shard by shard
+    vector<pair<K, V>> getAllPairs() const {
+        vector<pair<K, V>> pairs;
+        for (const auto& shard : shards) {
+            shared_lock<shared_mutex> guard(shard.lock);
+            auto shardPairs = shard.table.getAllPairs();
+            pairs.insert(pairs.end(), shardPairs.begin(), shardPairs.end());
+        }
+        return pairs;
+    }
+
+    // Clear all data
+    void clear() {
+        for (auto& shard : shards) {
+            unique_lock<shared_mutex> guard(shard.lock);
+            shard.table.clear();
+        }
+    }
+
+    // Size every shard for its share of n elements
+    void reserve(size_t n) {
+        for (auto& shard : shards) {
+            unique_lock<shared_mutex> guard(shard.lock);
+            shard.table.reserve(n / SHARDS + 1);
+        }
+    }
+
+    static constexpr size_t shardCount() { return SHARDS; }
+};
+
+#endif // CONCURRENT_HASHTABLE_H
@@ -1,33 +1,42 @@
 #include "DatabaseManager.h"
 #include "Serialization.h"
+#include "Logger.h"
 #include "../backend/utils/SHA256.h"
-#include <iostream>
 #include <fstream>
 #include <ctime>
 #include <algorithm>
+#include <charconv>
 #include <filesystem>
+#include <unordered_set>
 
 using namespace std;
 
 DatabaseManager::DatabaseManager(const string& dataDirectory) 
-    : dataDir(dataDirectory),
+    : dataDir(ensureDataDirectory(dataDirectory)),  // PagedStorage can't create files in a missing directory
       configFile(dataDirectory + "/config.dat"),
       users(dataDirectory + "/users"),
       students(dataDirectory + "/students"),
       teachers(dataDirectory + "/teachers"),
       courses(dataDirectory + "/courses"),
       timetables(dataDirectory + "/timetables") {
-    ensureDataDirectory();
+    // Enrollment state lives in student and course records, so those run strict;
+    // accounts, teachers and generated timetables can tolerate a short batch window
+    students.setDurability(DurabilityPolicy::strict());
+    courses.setDurability(DurabilityPolicy::strict());
+    users.setDurability(DurabilityPolicy::batch(100, 32));
+    teachers.setDurability(DurabilityPolicy::batch(100, 32));
+    timetables.setDurability(DurabilityPolicy::batch(100, 32));
 }
 
 DatabaseManager::~DatabaseManager() {
     saveAll();
 }
 
-void DatabaseManager::ensureDataDirectory() {
-    if (!fs::exists(dataDir)) {
-        fs::create_directories(dataDir);
+string DatabaseManager::ensureDataDirectory(const string& dir) {
+    if (!fs::exists(dir)) {
+        fs::create_directories(dir);
     }
+    return dir;
 }
 
 string DatabaseManager::generateID(const string& prefix) {
@@ -49,11 +58,10 @@ bool DatabaseManager::initialize() {
         admin.role = UserRole::ADMIN;
         admin.name = "System Administrator";
         
-        users.add(admin);  // No serialization needed!
+        markChanged(Store::USERS, users.add(admin));  // No serialization needed!
         
-        cout << "[DatabaseManager] Created default admin account" << endl;
-        cout << "  Email: admin@university.com" << endl;
-        cout << "  Password: admin123" << endl;
+        LOG_INFO("DatabaseManager") << "Created default admin account (email: admin@university.com, "
+                                    << "password: admin123)";
         
         // IMPORTANT: Save immediately so indexes are persisted
         saveAll();
@@ -81,27 +89,58 @@ bool DatabaseManager::loadAll() {
         
         return true;
     } catch (const exception& e) {
-        cerr << "[DatabaseManager] Error loading config: " << e.what() << endl;
+        LOG_ERROR("DatabaseManager") << "Error loading config: " << e.what();
         return false;
     }
 }
 
 bool DatabaseManager::saveAll() {
     // IndexedStorage saves automatically in destructor and on modifications
-    // We only need to save the config file manually
+    // We only need to flush pending batch fsyncs and save the config file manually
     
     try {
+        users.save();
+        students.save();
+        teachers.save();
+        courses.save();
+        timetables.save();
+        
         ofstream configOut(configFile);
         configOut << Serializer::serializeConfig(config) << "\n";
         configOut.close();
         
         return true;
     } catch (const exception& e) {
-        cerr << "[DatabaseManager] Error saving config: " << e.what() << endl;
+        LOG_ERROR("DatabaseManager") << "Error saving config: " << e.what();
         return false;
     }
 }
 
+// ========== Durability ==========
+
+void DatabaseManager::setDurability(Store store, const DurabilityPolicy& policy) {
+    lock_guard<mutex> lock(dbMutex);
+    switch (store) {
+        case Store::USERS: users.setDurability(policy); break;
+        case Store::STUDENTS: students.setDurability(policy); break;
+        case Store::TEACHERS: teachers.setDurability(policy); break;
+        case Store::COURSES: courses.setDurability(policy); break;
+        case Store::TIMETABLES: timetables.setDurability(policy); break;
+    }
+}
+
+DurabilityPolicy DatabaseManager::getDurability(Store store) {
+    lock_guard<mutex> lock(dbMutex);
+    switch (store) {
+        case Store::USERS: return users.getDurability();
+        case Store::STUDENTS: return students.getDurability();
+        case Store::TEACHERS: return teachers.getDurability();
+        case Store::COURSES: return courses.getDurability();
+        case Store::TIMETABLES: return timetables.getDurability();
+    }
+    return DurabilityPolicy();
+}
+
 // ========== User Operations ==========
 
 bool DatabaseManager::authenticateUser(const string& email, const string& password, User& outUser) {
@@ -118,19 +157,26 @@ bool DatabaseManager::authenticateUser(const string& email, const string& passwo
 bool DatabaseManager::createUser(const User& user) {
     lock_guard<mutex> lock(dbMutex);
     
-    cout << "[DB] createUser called for: " << user.email << " (role: " << static_cast<int>(user.role) << ")" << endl;
+    LOG_DEBUG("DB") << "createUser called for: " << user.email << " (role: " << static_cast<int>(user.role) << ")";
     
     if (users.exists(user.email)) {
-        cout << "[DB] User already exists!" << endl;
+        LOG_DEBUG("DB") << "User already exists!";
         return false;  // User already exists
     }
     
-    cout << "[DB] Adding user to IndexedStorage..." << endl;
-    bool result = users.add(user);
-    cout << "[DB] User added successfully!" << endl;
+    LOG_DEBUG("DB") << "Adding user to IndexedStorage...";
+    bool result = markChanged(Store::USERS, users.add(user));
+    LOG_DEBUG("DB") << "User added successfully!";
     return result;
 }
 
+size_t DatabaseManager::createUsers(const vector<User>& newUsers) {
+    lock_guard<mutex> lock(dbMutex);
+    size_t added = users.addAll(newUsers);
+    markChanged(Store::USERS, added > 0);
+    return added;
+}
+
 User* DatabaseManager::getUserByEmail(const string& email) {
     lock_guard<mutex> lock(dbMutex);
     static User cachedUser;
@@ -142,12 +188,12 @@ User* DatabaseManager::getUserByEmail(const string& email) {
 
 bool DatabaseManager::updateUser(const User& user) {
     lock_guard<mutex> lock(dbMutex);
-    return users.update(user);
+    return markChanged(Store::USERS, users.update(user));
 }
 
 bool DatabaseManager::deleteUser(const string& email) {
     lock_guard<mutex> lock(dbMutex);
-    return users.remove(email);
+    return markChanged(Store::USERS, users.remove(email));
 }
 
 vector<User> DatabaseManager::getAllUsers() {
@@ -159,7 +205,14 @@ vector<User> DatabaseManager::getAllUsers() {
 
 bool DatabaseManager::addStudent(const Student& student) {
     lock_guard<mutex> lock(dbMutex);
-    return students.add(student);  // O(1) + B-Tree insert
+    return markChanged(Store::STUDENTS, students.add(student));  // O(1) + B-Tree insert
+}
+
+size_t DatabaseManager::addStudents(const vector<Student>& newStudents) {
+    lock_guard<mutex> lock(dbMutex);
+    size_t added = students.addAll(newStudents);  // One file write + bulk-loaded B+Tree
+    markChanged(Store::STUDENTS, added > 0);
+    return added;
 }
 
 // Internal unlocked version for use when lock is already held
@@ -174,7 +227,7 @@ bool DatabaseManager::getStudent(const string& studentID, Student& outStudent) {
 
 // Internal unlocked version
 bool DatabaseManager::updateStudentInternal(const Student& student) {
-    return students.update(student);  // O(1) update
+    return markChanged(Store::STUDENTS, students.update(student));  // O(1) update
 }
 
 bool DatabaseManager::updateStudent(const Student& student) {
@@ -207,11 +260,11 @@ bool DatabaseManager::deleteStudent(const string& studentID) {
     
     // Delete the user account associated with this student
     if (!student.email.empty()) {
-        users.remove(student.email);
+        markChanged(Store::USERS, users.remove(student.email));
     }
     
     // Finally delete the student record
-    return students.remove(studentID);
+    return markChanged(Store::STUDENTS, students.remove(studentID));
 }
 
 vector<Student> DatabaseManager::getAllStudents() {
@@ -219,6 +272,18 @@ vector<Student> DatabaseManager::getAllStudents() {
     return students.getAll();  // Sorted by B-Tree!
 }
 
+vector<Student> DatabaseManager::getStudentsPage(size_t offset, size_t limit, size_t& total) {
+    lock_guard<mutex> lock(dbMutex);
+    total = students.size();
+    return students.getPage(offset, limit);
+}
+
+vector<Student> DatabaseManager::getStudentsAfter(const string& afterID, size_t limit, size_t& total) {
+    lock_guard<mutex> lock(dbMutex);
+    total = students.size();
+    return students.getPageAfter(afterID, limit);
+}
+
 vector<Student> DatabaseManager::getStudentsBySemester(int semester) {
     vector<Student> all = getAllStudents();
     vector<Student> result;
@@ -236,7 +301,7 @@ vector<Student> DatabaseManager::getStudentsBySemester(int semester) {
 
 bool DatabaseManager::addTeacher(const Teacher& teacher) {
     lock_guard<mutex> lock(dbMutex);
-    return teachers.add(teacher);
+    return markChanged(Store::TEACHERS, teachers.add(teacher));
 }
 
 bool DatabaseManager::getTeacher(const string& teacherID, Teacher& outTeacher) {
@@ -246,7 +311,7 @@ bool DatabaseManager::getTeacher(const string& teacherID, Teacher& outTeacher) {
 
 bool DatabaseManager::updateTeacher(const Teacher& teacher) {
     lock_guard<mutex> lock(dbMutex);
-    return teachers.update(teacher);
+    return markChanged(Store::TEACHERS, teachers.update(teacher));
 }
 
 bool DatabaseManager::deleteTeacher(const string& teacherID) {
@@ -260,11 +325,11 @@ bool DatabaseManager::deleteTeacher(const string& teacherID) {
     
     // Delete the user account associated with this teacher
     if (!teacher.email.empty()) {
-        users.remove(teacher.email);
+        markChanged(Store::USERS, users.remove(teacher.email));
     }
     
     // Delete the teacher record
-    return teachers.remove(teacherID);
+    return markChanged(Store::TEACHERS, teachers.remove(teacherID));
 }
 
 vector<Teacher> DatabaseManager::getAllTeachers() {
@@ -272,11 +337,23 @@ vector<Teacher> DatabaseManager::getAllTeachers() {
     return teachers.getAll();
 }
 
+vector<Teacher> DatabaseManager::getTeachersPage(size_t offset, size_t limit, size_t& total) {
+    lock_guard<mutex> lock(dbMutex);
+    total = teachers.size();
+    return teachers.getPage(offset, limit);
+}
+
+vector<Teacher> DatabaseManager::getTeachersAfter(const string& afterID, size_t limit, size_t& total) {
+    lock_guard<mutex> lock(dbMutex);
+    total = teachers.size();
+    return teachers.getPageAfter(afterID, limit);
+}
+
 // ========== Course Operations ==========
 
 bool DatabaseManager::addCourse(const Course& course) {
     lock_guard<mutex> lock(dbMutex);
-    return courses.add(course);
+    return markChanged(Store::COURSES, courses.add(course));
 }
 
 // Internal unlocked version for use when lock is already held
@@ -291,7 +368,7 @@ bool DatabaseManager::getCourse(const string& courseID, Course& outCourse) {
 
 // Internal unlocked version  
 bool DatabaseManager::updateCourseInternal(const Course& course) {
-    return courses.update(course);
+    return markChanged(Store::COURSES, courses.update(course));
 }
 
 bool DatabaseManager::updateCourse(const Course& course) {
@@ -301,16 +378,16 @@ bool DatabaseManager::updateCourse(const Course& course) {
 
 bool DatabaseManager::deleteCourse(const string& courseID) {
     lock_guard<mutex> lock(dbMutex);
-    return courses.remove(courseID);
+    return markChanged(Store::COURSES, courses.remove(courseID));
 }
 
 vector<Course> DatabaseManager::getAllCourses() {
     lock_guard<mutex> lock(dbMutex);
     vector<Course> result = courses.getAll();
-    cout << "[DB] getAllCourses() returning " << result.size() << " courses" << endl;
+    LOG_DEBUG("DB") << "getAllCourses() returning " << result.size() << " courses";
     if (!result.empty()) {
-        cout << "[DB] First course: " << result[0].courseID << " (semester " << result[0].semester << ")" << endl;
-        cout << "[DB] Last course: " << result[result.size()-1].courseID << " (semester " << result[result.size()-1].semester << ")" << endl;
+        LOG_DEBUG("DB") << "First course: " << result[0].courseID << " (semester " << result[0].semester << ")";
+        LOG_DEBUG("DB") << "Last course: " << result[result.size()-1].courseID << " (semester " << result[result.size()-1].semester << ")";
     }
     return result;
 }
@@ -319,17 +396,17 @@ vector<Course> DatabaseManager::getCoursesBySemester(int semester) {
     vector<Course> all = getAllCourses();
     vector<Course> result;
     
-    cout << "[DB] getCoursesBySemester called with semester=" << semester << endl;
-    cout << "[DB] Total courses in database: " << all.size() << endl;
+    LOG_DEBUG("DB") << "getCoursesBySemester called with semester=" << semester;
+    LOG_DEBUG("DB") << "Total courses in database: " << all.size();
     
     for (const auto& course : all) {
-        cout << "[DB] Checking course " << course.courseID << " (semester=" << course.semester << ")" << endl;
+        LOG_DEBUG("DB") << "Checking course " << course.courseID << " (semester=" << course.semester << ")";
         if (course.semester == semester) {
             result.push_back(course);
         }
     }
     
-    cout << "[DB] Found " << result.size() << " courses for semester " << semester << endl;
+    LOG_DEBUG("DB") << "Found " << result.size() << " courses for semester " << semester;
     return result;
 }
 
@@ -395,7 +472,7 @@ bool DatabaseManager::enrollStudent(const string& studentID, const string& cours
     
     string errorMsg;
     if (!canEnroll(studentID, courseID, errorMsg)) {
-        cerr << "[DatabaseManager] Enrollment failed: " << errorMsg << endl;
+        LOG_WARN("DatabaseManager") << "Enrollment failed: " << errorMsg;
         return false;
     }
     
@@ -428,13 +505,13 @@ bool DatabaseManager::dropCourse(const string& studentID, const string& courseID
     
     // Check if registration window is open (same check as enrollment)
     if (!config.isRegistrationOpen) {
-        cerr << "[DatabaseManager] Cannot drop course - registration window is closed" << endl;
+        LOG_WARN("DatabaseManager") << "Cannot drop course - registration window is closed";
         return false;
     }
     
     time_t now = time(nullptr);
     if (!(now >= config.registrationStartTime && now <= config.registrationEndTime)) {
-        cerr << "[DatabaseManager] Cannot drop course - outside registration window" << endl;
+        LOG_WARN("DatabaseManager") << "Cannot drop course - outside registration window";
         return false;
     }
     
@@ -475,15 +552,19 @@ bool DatabaseManager::saveTimetable(const Timetable& timetable) {
     lock_guard<mutex> lock(dbMutex);
     string id = to_string(timetable.semesterNumber);
     if (timetables.exists(id)) {
-        cout << "[DatabaseManager] Updating existing timetable for semester " << id << endl;
-        return timetables.update(timetable);
+        LOG_INFO("DatabaseManager") << "Updating existing timetable for semester " << id;
+        return markChanged(Store::TIMETABLES, timetables.update(timetable));
     }
-    return timetables.add(timetable);
+    return markChanged(Store::TIMETABLES, timetables.add(timetable));
 }
 
 bool DatabaseManager::getTimetable(int semester, Timetable& outTimetable) {
     lock_guard<mutex> lock(dbMutex);
-    return timetables.get(to_string(semester), outTimetable);
+    
+    // Format the key on the stack; the index lookup takes a string_view
+    char key[16];
+    auto result = to_chars(key, key + sizeof(key), semester);
+    return timetables.get(string_view(key, result.ptr - key), outTimetable);
 }
 
 vector<Timetable> DatabaseManager::getAllTimetables() {
@@ -494,6 +575,7 @@ vector<Timetable> DatabaseManager::getAllTimetables() {
 void DatabaseManager::clearTimetables() {
     lock_guard<mutex> lock(dbMutex);
     timetables.clear();
+    markChanged(Store::TIMETABLES, true);
 }
 
 // ========== System Config Operations ==========
@@ -507,9 +589,150 @@ void DatabaseManager::updateConfig(const SystemConfig& newConfig) {
     lock_guard<mutex> lock(dbMutex);
     
     config = newConfig;
+    generations[SNAPSHOT_CONFIG].fetch_add(1, memory_order_release);
     saveAll();
 }
 
+// ========== Snapshots ==========
+
+vector<pair<size_t, string>> DatabaseManager::exportSnapshot(array<uint64_t, SNAPSHOT_SECTIONS>& seen) {
+    lock_guard<mutex> lock(dbMutex);
+    vector<pair<size_t, string>> sections;
+    for (size_t i = 0; i < SNAPSHOT_SECTIONS; i++) {
+        uint64_t current = generations[i].load(memory_order_acquire);
+        if (current == seen[i]) continue;
+        seen[i] = current;
+        string lines;
+        switch (i) {
+            case static_cast<size_t>(Store::USERS): lines = users.exportLines(); break;
+            case static_cast<size_t>(Store::STUDENTS): lines = students.exportLines(); break;
+            case static_cast<size_t>(Store::TEACHERS): lines = teachers.exportLines(); break;
+            case static_cast<size_t>(Store::COURSES): lines = courses.exportLines(); break;
+            case static_cast<size_t>(Store::TIMETABLES): lines = timetables.exportLines(); break;
+            case SNAPSHOT_CONFIG: lines = Serializer::serializeConfig(config) + "\n"; break;
+        }
+        sections.emplace_back(i, move(lines));
+    }
+    return sections;
+}
+
+// Non-empty lines of a snapshot section
+static vector<string_view> splitLines(string_view lines) {
+    vector<string_view> result;
+    size_t start = 0;
+    while (start < lines.size()) {
+        size_t end = lines.find('\n', start);
+        if (end == string_view::npos) end = lines.size();
+        if (end > start) {
+            result.push_back(lines.substr(start, end - start));
+        }
+        start = end + 1;
+    }
+    return result;
+}
+
+template<typename T>
+static bool parseRecord(string_view line, T& entity) {
+    try {
+        entity = EntityCodec::deserialize<T>(string(line));
+        return true;
+    } catch (const exception& e) {
+        LOG_ERROR("DatabaseManager") << "Skipping bad snapshot record: " << e.what();
+        return false;
+    }
+}
+
+// Clear a store and bulk-load the records of one snapshot section
+template<typename T>
+static void replaceRecords(EntityStore<T>& store, string_view lines) {
+    vector<T> entities;
+    for (string_view line : splitLines(lines)) {
+        T entity;
+        if (parseRecord(line, entity)) {
+            entities.push_back(move(entity));
+        }
+    }
+    store.clear();
+    store.addAll(entities);
+}
+
+// Move a store from the records of previous to those of lines. Unchanged
+// lines are only hashed: just the added and removed ones are parsed, and a
+// removed line whose ID comes back changed is an update, not a remove
+template<typename T>
+static void applyRecords(EntityStore<T>& store, string_view lines, string_view previous) {
+    vector<string_view> before = splitLines(previous);
+    vector<string_view> after = splitLines(lines);
+    unordered_set<string_view> beforeSet(before.begin(), before.end());
+    unordered_set<string_view> afterSet(after.begin(), after.end());
+
+    vector<T> upserts;
+    unordered_set<string> upserted;
+    for (string_view line : after) {
+        T entity;
+        if (beforeSet.count(line) == 0 && parseRecord(line, entity)) {
+            upserted.insert(string(EntityCodec::id(entity)));
+            upserts.push_back(move(entity));
+        }
+    }
+    vector<string> removed;
+    for (string_view line : before) {
+        T entity;
+        if (afterSet.count(line) == 0 && parseRecord(line, entity)) {
+            string id(EntityCodec::id(entity));
+            if (upserted.count(id) == 0) {
+                removed.push_back(move(id));
+            }
+        }
+    }
+
+    // A remove rewrites the whole data file (IndexedStorage): with several
+    // of them, or most records changed, reloading the section is cheaper
+    if (removed.size() > 1 || upserts.size() > after.size() / 2) {
+        replaceRecords(store, lines);
+        return;
+    }
+    for (const T& entity : upserts) {
+        store.add(entity);  // Updates an existing ID
+    }
+    for (const string& id : removed) {
+        store.remove(id);
+    }
+}
+
+template<typename T>
+static void importRecords(EntityStore<T>& store, const SnapshotSection& section) {
+    if (section.previous) {
+        applyRecords(store, section.lines, *section.previous);
+    } else {
+        replaceRecords(store, section.lines);
+    }
+}
+
+void DatabaseManager::importSnapshot(const vector<SnapshotSection>& sections) {
+    lock_guard<mutex> lock(dbMutex);
+    for (const SnapshotSection& section : sections) {
+        switch (section.index) {
+            case static_cast<size_t>(Store::USERS): importRecords(users, section); break;
+            case static_cast<size_t>(Store::STUDENTS): importRecords(students, section); break;
+            case static_cast<size_t>(Store::TEACHERS): importRecords(teachers, section); break;
+            case static_cast<size_t>(Store::COURSES): importRecords(courses, section); break;
+            case static_cast<size_t>(Store::TIMETABLES): importRecords(timetables, section); break;
+            case SNAPSHOT_CONFIG: {
+                string_view line = section.lines.substr(0, section.lines.find('\n'));
+                if (!line.empty()) {
+                    config = Serializer::deserializeConfig(string(line));
+                }
+                break;
+            }
+        }
+        if (section.index < generations.size()) {
+            // Replica reads invalidate like local writes
+            generations[section.index].fetch_add(1, memory_order_release);
+        }
+    }
+}
+
 bool DatabaseManager::isRegistrationOpen() {
     lock_guard<mutex> lock(dbMutex);
     
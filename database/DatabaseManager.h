@@ -4,35 +4,85 @@
 #include <string>
 #include <vector>
 #include <mutex>
+#include <array>
+#include <atomic>
 #include <filesystem>
+#include <optional>
+#include <string_view>
 #include "IndexedStorage.h"
+#include "PagedStorage.h"
 #include "DataModels.h"
 #include "Serialization.h"
 
 using namespace std;
 namespace fs = std::filesystem;
 
+// Storage backend for every store: in-memory indexes over a text data file,
+// or (built with UMS_PAGED_STORAGE) on-disk paged B+Trees that need no
+// rebuild on startup and hold data sets larger than RAM
+#ifdef UMS_PAGED_STORAGE
+template<typename T> using EntityStore = PagedStorage<T>;
+#else
+template<typename T> using EntityStore = IndexedStorage<T>;
+#endif
+
+// Identifies one of the stores owned by DatabaseManager
+enum class Store {
+    USERS,
+    STUDENTS,
+    TEACHERS,
+    COURSES,
+    TIMETABLES
+};
+
+// A snapshot has one section per Store (indexed by its value), then the config
+constexpr size_t SNAPSHOT_SECTIONS = 6;
+constexpr size_t SNAPSHOT_CONFIG = 5;
+
+// One section handed to DatabaseManager::importSnapshot
+struct SnapshotSection {
+    size_t index;
+    string_view lines;
+    // The section's lines when the replica last imported it; without them
+    // the store is cleared and reloaded
+    optional<string_view> previous;
+};
+
 class DatabaseManager {
 private:
-    // Data structures - using IndexedStorage for O(1) lookups + sorted iteration
-    IndexedStorage<User> users;
-    IndexedStorage<Student> students;
-    IndexedStorage<Teacher> teachers;
-    IndexedStorage<Course> courses;
-    IndexedStorage<Timetable> timetables;
-    SystemConfig config;
-    
-    // File paths
+    // File paths (first: the directory exists before any store opens its files)
     string dataDir;
     string configFile;
     
+    // Data structures - one EntityStore per entity type
+    EntityStore<User> users;
+    EntityStore<Student> students;
+    EntityStore<Teacher> teachers;
+    EntityStore<Course> courses;
+    EntityStore<Timetable> timetables;
+    SystemConfig config;
+    
     // Thread safety
     mutex dbMutex;
     
+    // Write generation of each snapshot section: the stores, indexed by
+    // Store, then the config at SNAPSHOT_CONFIG
+    array<atomic<uint64_t>, SNAPSHOT_SECTIONS> generations{};
+    
     // Helper methods
-    void ensureDataDirectory();
+    // Creates dir if missing; returns it
+    static string ensureDataDirectory(const string& dir);
     string generateID(const string& prefix);
     
+    // Called under dbMutex after a write: bumps the store's generation if
+    // the write changed it, and passes the result through
+    bool markChanged(Store store, bool changed) {
+        if (changed) {
+            generations[static_cast<size_t>(store)].fetch_add(1, memory_order_release);
+        }
+        return changed;
+    }
+    
 public:
     DatabaseManager(const string& dataDirectory = "data");
     ~DatabaseManager();
@@ -46,9 +96,28 @@ public:
     // Save all data to disk
     bool saveAll();
     
+    // ========== Durability ==========
+    // Defaults: students and courses (enrollments) STRICT, everything else BATCH
+    void setDurability(Store store, const DurabilityPolicy& policy);
+    DurabilityPolicy getDurability(Store store);
+    
+    // ========== Write Generations ==========
+    // Counts the writes that changed a store. A value read before a read
+    // operation still equals the current one afterwards only if no write
+    // touched the store in between (see ResponseCache)
+    uint64_t generation(Store store) const {
+        return generations[static_cast<size_t>(store)].load(memory_order_acquire);
+    }
+    
+    // Same for any snapshot section, including SNAPSHOT_CONFIG
+    uint64_t sectionGeneration(size_t section) const {
+        return generations[section].load(memory_order_acquire);
+    }
+    
     // ========== User Operations ==========
     bool authenticateUser(const string& email, const string& password, User& outUser);
     bool createUser(const User& user);
+    size_t createUsers(const vector<User>& newUsers);  // Bulk import; skips existing emails
     User* getUserByEmail(const string& email);
     bool updateUser(const User& user);
     bool deleteUser(const string& email);
@@ -56,10 +125,15 @@ public:
     
     // ========== Student Operations ==========
     bool addStudent(const Student& student);
+    size_t addStudents(const vector<Student>& newStudents);  // Bulk import; skips existing IDs
     bool getStudent(const string& studentID, Student& outStudent);  // Changed: returns bool, uses output param
     bool updateStudent(const Student& student);
     bool deleteStudent(const string& studentID);
     vector<Student> getAllStudents();
+    // One page in ID order, by position or after the last ID seen; total
+    // is set to the number of students
+    vector<Student> getStudentsPage(size_t offset, size_t limit, size_t& total);
+    vector<Student> getStudentsAfter(const string& afterID, size_t limit, size_t& total);
     vector<Student> getStudentsBySemester(int semester);
     
     // ========== Teacher Operations ==========
@@ -68,6 +142,8 @@ public:
     bool updateTeacher(const Teacher& teacher);
     bool deleteTeacher(const string& teacherID);
     vector<Teacher> getAllTeachers();
+    vector<Teacher> getTeachersPage(size_t offset, size_t limit, size_t& total);
+    vector<Teacher> getTeachersAfter(const string& afterID, size_t limit, size_t& total);
     
     // ========== Course Operations ==========
     bool addCourse(const Course& course);
@@ -93,6 +169,16 @@ public:
     void updateConfig(const SystemConfig& config);
     bool isRegistrationOpen();
     
+    // ========== Snapshots (multi-process mode, see SharedSnapshot) ==========
+    // The records, one per line, of every section whose generation differs
+    // from seen[index], as (index, lines); taken under one lock so
+    // multi-store writes (enrollments) are never seen half done. seen is
+    // advanced to the exported generations
+    vector<pair<size_t, string>> exportSnapshot(array<uint64_t, SNAPSHOT_SECTIONS>& seen);
+    // Bring the given sections up to date under one lock: records whose
+    // line changed since previous are written, records gone are removed
+    void importSnapshot(const vector<SnapshotSection>& sections);
+    
 private:
     // Internal unlocked versions for use when lock is already held
     bool getStudentInternal(const string& studentID, Student& outStudent);
@@ -0,0 +1,135 @@
+#ifndef DURABILITY_H
+#define DURABILITY_H
+
+#include <string>
+#include <chrono>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// How hard a store works to get its writes onto stable storage
+enum class DurabilityMode {
+    NONE,    // Leave flushing to the OS page cache
+    BATCH,   // fsync once every N commits or every N milliseconds
+    STRICT   // fsync after every commit
+};
+
+/**
+ * DurabilityPolicy - Per-store fsync policy
+ *
+ * A "commit" is one completed write of the store's data file
+ * (add, update or remove). BATCH mode syncs when either threshold is
+ * reached; a pending batch is also synced on flush() and on shutdown.
+ */
+struct DurabilityPolicy {
+    DurabilityMode mode;
+    int batchIntervalMs;  // BATCH: sync if this much time passed since last sync
+    int batchCommits;     // BATCH: sync after this many unsynced commits
+
+    DurabilityPolicy(DurabilityMode m = DurabilityMode::NONE, int intervalMs = 100, int commits = 32)
+        : mode(m), batchIntervalMs(intervalMs), batchCommits(commits) {}
+
+    static DurabilityPolicy none() { return DurabilityPolicy(DurabilityMode::NONE); }
+    static DurabilityPolicy strict() { return DurabilityPolicy(DurabilityMode::STRICT); }
+    static DurabilityPolicy batch(int intervalMs, int commits) {
+        return DurabilityPolicy(DurabilityMode::BATCH, intervalMs, commits);
+    }
+};
+
+inline string durabilityModeToString(DurabilityMode mode) {
+    switch (mode) {
+        case DurabilityMode::NONE: return "none";
+        case DurabilityMode::BATCH: return "batch";
+        case DurabilityMode::STRICT: return "strict";
+        default: return "unknown";
+    }
+}
+
+inline DurabilityMode stringToDurabilityMode(const string& str) {
+    if (str == "strict") return DurabilityMode::STRICT;
+    if (str == "batch") return DurabilityMode::BATCH;
+    return DurabilityMode::NONE;  // Default
+}
+
+// Flush a closed file's contents to disk (fsync / _commit)
+inline bool syncFile(const string& path) {
+#ifdef _WIN32
+    int fd = _open(path.c_str(), _O_RDWR | _O_BINARY);
+    if (fd < 0) return false;
+    bool ok = (_commit(fd) == 0);
+    _close(fd);
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    bool ok = (fsync(fd) == 0);
+    close(fd);
+#endif
+    return ok;
+}
+
+/**
+ * FileSyncer - Applies a DurabilityPolicy to one data file
+ *
+ * Call onCommit() after each write to the file has been closed.
+ */
+class FileSyncer {
+private:
+    string path;
+    DurabilityPolicy policy;
+    int pendingCommits;
+    chrono::steady_clock::time_point lastSync;
+
+public:
+    FileSyncer(const string& filePath, const DurabilityPolicy& p = DurabilityPolicy())
+        : path(filePath), policy(p), pendingCommits(0), lastSync(chrono::steady_clock::now()) {}
+
+    void setPolicy(const DurabilityPolicy& p) {
+        flush();  // Don't carry unsynced commits across a policy change
+        policy = p;
+    }
+
+    const DurabilityPolicy& getPolicy() const { return policy; }
+
+    // Record a commit and fsync if the policy asks for it
+    void onCommit() {
+        switch (policy.mode) {
+            case DurabilityMode::NONE:
+                return;
+            case DurabilityMode::STRICT:
+                sync();
+                return;
+            case DurabilityMode::BATCH: {
+                pendingCommits++;
+                auto elapsed = chrono::duration_cast<chrono::milliseconds>(
+                    chrono::steady_clock::now() - lastSync).count();
+                if (pendingCommits >= policy.batchCommits || elapsed >= policy.batchIntervalMs) {
+                    sync();
+                }
+                return;
+            }
+        }
+    }
+
+    // Sync any commits still pending from a batch
+    void flush() {
+        if (pendingCommits > 0) {
+            sync();
+        }
+    }
+
+private:
+    void sync() {
+        syncFile(path);
+        pendingCommits = 0;
+        lastSync = chrono::steady_clock::now();
+    }
+};
+
+#endif // DURABILITY_H
@@ -0,0 +1,76 @@
+#ifndef ENTITY_CODEC_H
+#define ENTITY_CODEC_H
+
+#include "DataModels.h"
+#include "Serialization.h"
+#include <string>
+#include <type_traits>
+
+using namespace std;
+
+// Helper for static_assert (must be defined BEFORE use)
+template<typename> struct always_false : std::false_type {};
+
+/**
+ * EntityCodec - Per-entity ID and text record format shared by the
+ * storage backends (IndexedStorage, PagedStorage)
+ *
+ * One record per entity, in the Serializer text format (so it fits one
+ * line of a .dat file); the ID is the primary key both backends index.
+ */
+struct EntityCodec {
+    // Parenthesized members deduce to const string& (no copy)
+    template<typename T>
+    static decltype(auto) id(const T& entity) {
+        if constexpr (is_same_v<T, Student>) {
+            return (entity.studentID);
+        } else if constexpr (is_same_v<T, Course>) {
+            return (entity.courseID);
+        } else if constexpr (is_same_v<T, Teacher>) {
+            return (entity.teacherID);
+        } else if constexpr (is_same_v<T, User>) {
+            return (entity.email);  // Use email as unique identifier for login
+        } else if constexpr (is_same_v<T, Timetable>) {
+            return to_string(entity.semesterNumber);
+        } else {
+            static_assert(always_false<T>::value, "EntityCodec::id not implemented for this type");
+            return string();
+        }
+    }
+
+    template<typename T>
+    static string serialize(const T& entity) {
+        if constexpr (is_same_v<T, Student>) {
+            return Serializer::serializeStudent(entity);
+        } else if constexpr (is_same_v<T, Course>) {
+            return Serializer::serializeCourse(entity);
+        } else if constexpr (is_same_v<T, Teacher>) {
+            return Serializer::serializeTeacher(entity);
+        } else if constexpr (is_same_v<T, User>) {
+            return Serializer::serializeUser(entity);
+        } else if constexpr (is_same_v<T, Timetable>) {
+            return Serializer::serializeTimetable(entity);
+        } else {
+            return "";
+        }
+    }
+
+    template<typename T>
+    static T deserialize(const string& data) {
+        if constexpr (is_same_v<T, Student>) {
+            return Serializer::deserializeStudent(data);
+        } else if constexpr (is_same_v<T, Course>) {
+            return Serializer::deserializeCourse(data);
+        } else if constexpr (is_same_v<T, Teacher>) {
+            return Serializer::deserializeTeacher(data);
+        } else if constexpr (is_same_v<T, User>) {
+            return Serializer::deserializeUser(data);
+        } else if constexpr (is_same_v<T, Timetable>) {
+            return Serializer::deserializeTimetable(data);
+        } else {
+            return T();
+        }
+    }
+};
+
+#endif // ENTITY_CODEC_H
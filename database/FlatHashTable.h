@@ -0,0 +1,397 @@
+#ifndef FLAT_HASHTABLE_H
+#define FLAT_HASHTABLE_H
+
+#include <vector>
+#include <functional>
+#include <string>
+#include <memory>
+#include <new>
+#include <cstdint>
+#include <cstring>
+#include "KeyHash.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FLAT_HASHTABLE_SSE2 1
+#endif
+
+using namespace std;
+
+/**
+ * FlatHashTable - Open-addressing hash table with Swiss-table control bytes
+ *
+ * Drop-in alternative to HashTable<K, V> (same insert/get/contains/remove/
+ * update/getAllPairs/reserve interface) that keeps all entries in one flat
+ * slot array instead of a std::list per bucket.
+ *
+ * - Slots are grouped 16 at a time; each slot has a control byte that is
+ *   EMPTY, DELETED, or the low 7 bits of the key's hash (H2)
+ * - A lookup loads one 16-byte control group and compares all 16 H2 bytes at
+ *   once (SSE2, scalar fallback elsewhere); keys are compared only on a match
+ * - Probing visits whole groups in triangular order and stops at the first
+ *   group that has an EMPTY slot
+ *
+ * Unlike HashTable, growth rehashes in one step and moves entries, so a V*
+ * returned by get() is only valid until the next insert.
+ *
+ * Hash is the hash policy (see HashTable). Slot groups are always picked by
+ * mask, so an avalanching policy such as SeededHash<K> is the better match.
+ */
+template<typename K, typename V, typename Hash = KeyHash<K>>
+class FlatHashTable {
+private:
+    static const size_t GROUP_WIDTH = 16;
+    static const int8_t CTRL_EMPTY = -128;   // 0b10000000
+    static const int8_t CTRL_DELETED = -2;   // 0b11111110
+
+    typedef pair<K, V> Slot;
+
+    int8_t* ctrl;         // capacity control bytes
+    Slot* slots;          // capacity slots, constructed only where ctrl is full
+    size_t capacity;      // Power of two, multiple of GROUP_WIDTH (or 0)
+    size_t numElements;
+    size_t numDeleted;    // Tombstones still occupying probe chains
+    float maxLoad;
+    Hash hashFunction;
+
+    static bool isFull(int8_t c) { return c >= 0; }
+
+    static size_t h1(size_t hash) { return hash >> 7; }
+    static int8_t h2(size_t hash) { return static_cast<int8_t>(hash & 0x7F); }
+
+    size_t numGroups() const { return capacity / GROUP_WIDTH; }
+
+    // Bit i set if control byte i of the group equals value
+    static uint32_t matchByte(const int8_t* group, int8_t value);
+
+    // Index of the slot holding key, or capacity if absent
+    template<typename Q>
+    size_t findIndex(const Q& key, size_t hash) const;
+
+    // First EMPTY/DELETED slot on key's probe sequence
+    size_t findInsertSlot(size_t hash) const;
+
+    void setCtrl(size_t index, int8_t value) { ctrl[index] = value; }
+
+    void allocate(size_t newCapacity);
+    void destroyAll();
+    void rehash(size_t newCapacity);
+
+    // Smallest valid capacity that holds n elements under maxLoad
+    size_t capacityFor(size_t n) const;
+
+public:
+    FlatHashTable(size_t size = GROUP_WIDTH, const Hash& hasher = Hash());
+    ~FlatHashTable();
+
+    FlatHashTable(const FlatHashTable&) = delete;
+    FlatHashTable& operator=(const FlatHashTable&) = delete;
+
+    // Insert or update key-value pair
+    void insert(const K& key, const V& value);
+
+    // Get value by key (returns nullptr if not found)
+    // Q may be K or anything KeyHash<K> and == accept, e.g. string_view for string keys
+    template<typename Q>
+    V* get(const Q& key);
+
+    template<typename Q>
+    const V* get(const Q& key) const;
+
+    // Check if key exists
+    template<typename Q>
+    bool contains(const Q& key) const;
+
+    // Remove key-value pair
+    bool remove(const K& key);
+
+    // Update existing key's value
+    bool update(const K& key, const V& value);
+
+    // Get all key-value pairs
+    vector<pair<K, V>> getAllPairs() const;
+
+    // Get number of elements
+    size_t size() const { return numElements; }
+
+    // Check if empty
+    bool isEmpty() const { return numElements == 0; }
+
+    // Clear all data (keeps capacity)
+    void clear();
+
+    // ========== Capacity ==========
+
+    // Number of slots
+    size_t bucketCount() const { return capacity; }
+
+    float loadFactor() const { return capacity == 0 ? 0.0f : static_cast<float>(numElements) / capacity; }
+
+    // Fraction of slots (live + tombstones) that triggers growth (default 0.875)
+    float maxLoadFactor() const { return maxLoad; }
+    void setMaxLoadFactor(float lf);
+
+    // Size the table for n elements up front
+    void reserve(size_t n);
+};
+
+// ==================== FlatHashTable Implementation ====================
+
+template<typename K, typename V, typename Hash>
+FlatHashTable<K, V, Hash>::FlatHashTable(size_t size, const Hash& hasher)
+    : ctrl(nullptr), slots(nullptr), capacity(0), numElements(0), numDeleted(0), maxLoad(0.875f),
+      hashFunction(hasher) {
+    allocate(capacityFor(size));
+}
+
+template<typename K, typename V, typename Hash>
+FlatHashTable<K, V, Hash>::~FlatHashTable() {
+    destroyAll();
+    delete[] ctrl;
+    allocator<Slot>().deallocate(slots, capacity);
+}
+
+template<typename K, typename V, typename Hash>
+uint32_t FlatHashTable<K, V, Hash>::matchByte(const int8_t* group, int8_t value) {
+#ifdef FLAT_HASHTABLE_SSE2
+    __m128i ctrlBytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+    __m128i match = _mm_cmpeq_epi8(_mm_set1_epi8(value), ctrlBytes);
+    return static_cast<uint32_t>(_mm_movemask_epi8(match));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < GROUP_WIDTH; i++) {
+        if (group[i] == value) mask |= (1u << i);
+    }
+    return mask;
+#endif
+}
+
+// Index of lowest set bit (mask must be non-zero)
+inline int flatLowestBit(uint32_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(mask);
+#else
+    int i = 0;
+    while (!(mask & 1u)) { mask >>= 1; i++; }
+    return i;
+#endif
+}
+
+template<typename K, typename V, typename Hash>
+template<typename Q>
+size_t FlatHashTable<K, V, Hash>::findIndex(const Q& key, size_t hash) const {
+    size_t groupMask = numGroups() - 1;
+    size_t group = h1(hash) & groupMask;
+    int8_t tag = h2(hash);
+
+    for (size_t step = 1; step <= numGroups(); step++) {
+        const int8_t* g = ctrl + group * GROUP_WIDTH;
+
+        uint32_t candidates = matchByte(g, tag);
+        while (candidates != 0) {
+            size_t index = group * GROUP_WIDTH + flatLowestBit(candidates);
+            if (slots[index].first == key) {
+                return index;
+            }
+            candidates &= candidates - 1;
+        }
+
+        // An EMPTY slot ends the probe chain
+        if (matchByte(g, CTRL_EMPTY) != 0) {
+            return capacity;
+        }
+
+        group = (group + step) & groupMask;  // Triangular probing visits every group
+    }
+
+    return capacity;
+}
+
+template<typename K, typename V, typename Hash>
+size_t FlatHashTable<K, V, Hash>::findInsertSlot(size_t hash) const {
+    size_t groupMask = numGroups() - 1;
+    size_t group = h1(hash) & groupMask;
+
+    for (size_t step = 1; step <= numGroups(); step++) {
+        const int8_t* g = ctrl + group * GROUP_WIDTH;
+
+        uint32_t free = matchByte(g, CTRL_EMPTY) | matchByte(g, CTRL_DELETED);
+        if (free != 0) {
+            return group * GROUP_WIDTH + flatLowestBit(free);
+        }
+
+        group = (group + step) & groupMask;
+    }
+
+    return capacity;  // Unreachable: growth keeps free slots available
+}
+
+template<typename K, typename V, typename Hash>
+size_t FlatHashTable<K, V, Hash>::capacityFor(size_t n) const {
+    size_t cap = GROUP_WIDTH;
+    while (static_cast<float>(n) > cap * maxLoad) {
+        cap *= 2;
+    }
+    return cap;
+}
+
+template<typename K, typename V, typename Hash>
+void FlatHashTable<K, V, Hash>::allocate(size_t newCapacity) {
+    capacity = newCapacity;
+    ctrl = new int8_t[capacity];
+    memset(ctrl, CTRL_EMPTY, capacity);
+    slots = allocator<Slot>().allocate(capacity);
+    numElements = 0;
+    numDeleted = 0;
+}
+
+template<typename K, typename V, typename Hash>
+void FlatHashTable<K, V, Hash>::destroyAll() {
+    for (size_t i = 0; i < capacity; i++) {
+        if (isFull(ctrl[i])) {
+            slots[i].~Slot();
+        }
+    }
+}
+
+template<typename K, typename V, typename Hash>
+void FlatHashTable<K, V, Hash>::rehash(size_t newCapacity) {
+    int8_t* oldCtrl = ctrl;
+    Slot* oldSlots = slots;
+    size_t oldCapacity = capacity;
+
+    allocate(newCapacity);
+
+    for (size_t i = 0; i < oldCapacity; i++) {
+        if (isFull(oldCtrl[i])) {
+            size_t hash = hashFunction(oldSlots[i].first);
+            size_t index = findInsertSlot(hash);
+            new (&slots[index]) Slot(std::move(oldSlots[i]));
+            setCtrl(index, h2(hash));
+            numElements++;
+            oldSlots[i].~Slot();
+        }
+    }
+
+    delete[] oldCtrl;
+    allocator<Slot>().deallocate(oldSlots, oldCapacity);
+}
+
+template<typename K, typename V, typename Hash>
+void FlatHashTable<K, V, Hash>::insert(const K& key, const V& value) {
+    size_t hash = hashFunction(key);
+    size_t index = findIndex(key, hash);
+
+    if (index != capacity) {
+        slots[index].second = value;  // Update existing
+        return;
+    }
+
+    if (static_cast<float>(numElements + numDeleted + 1) > capacity * maxLoad) {
+        // Mostly tombstones: clean up in place; otherwise double
+        size_t newCapacity = capacityFor(numElements + 1);
+        rehash(newCapacity > capacity ? newCapacity : (numDeleted > numElements ? capacity : capacity * 2));
+    }
+
+    index = findInsertSlot(hash);
+    if (ctrl[index] == CTRL_DELETED) {
+        numDeleted--;
+    }
+    new (&slots[index]) Slot(key, value);
+    setCtrl(index, h2(hash));
+    numElements++;
+}
+
+template<typename K, typename V, typename Hash>
+template<typename Q>
+V* FlatHashTable<K, V, Hash>::get(const Q& key) {
+    size_t index = findIndex(key, hashFunction(key));
+    return index == capacity ? nullptr : &slots[index].second;
+}
+
+template<typename K, typename V, typename Hash>
+template<typename Q>
+const V* FlatHashTable<K, V, Hash>::get(const Q& key) const {
+    size_t index = findIndex(key, hashFunction(key));
+    return index == capacity ? nullptr : &slots[index].second;
+}
+
+template<typename K, typename V, typename Hash>
+template<typename Q>
+bool FlatHashTable<K, V, Hash>::contains(const Q& key) const {
+    return findIndex(key, hashFunction(key)) != capacity;
+}
+
+template<typename K, typename V, typename Hash>
+bool FlatHashTable<K, V, Hash>::remove(const K& key) {
+    size_t index = findIndex(key, hashFunction(key));
+    if (index == capacity) {
+        return false;
+    }
+
+    slots[index].~Slot();
+
+    // A group that still has an EMPTY slot was never full, so no probe chain
+    // passes through it and the slot can go straight back to EMPTY
+    const int8_t* group = ctrl + (index / GROUP_WIDTH) * GROUP_WIDTH;
+    if (matchByte(group, CTRL_EMPTY) != 0) {
+        setCtrl(index, CTRL_EMPTY);
+    } else {
+        setCtrl(index, CTRL_DELETED);
+        numDeleted++;
+    }
+
+    numElements--;
+    return true;
+}
+
+template<typename K, typename V, typename Hash>
+bool FlatHashTable<K, V, Hash>::update(const K& key, const V& value) {
+    V* found = get(key);
+    if (found != nullptr) {
+        *found = value;
+        return true;
+    }
+    return false;
+}
+
+template<typename K, typename V, typename Hash>
+vector<pair<K, V>> FlatHashTable<K, V, Hash>::getAllPairs() const {
+    vector<pair<K, V>> pairs;
+    pairs.reserve(numElements);
+
+    for (size_t i = 0; i < capacity; i++) {
+        if (isFull(ctrl[i])) {
+            pairs.push_back(slots[i]);
+        }
+    }
+
+    return pairs;
+}
+
+template<typename K, typename V, typename Hash>
+void FlatHashTable<K, V, Hash>::clear() {
+    destroyAll();
+    memset(ctrl, CTRL_EMPTY, capacity);
+    numElements = 0;
+    numDeleted = 0;
+}
+
+template<typename K, typename V, typename Hash>
+void FlatHashTable<K, V, Hash>::setMaxLoadFactor(float lf) {
+    if (lf <= 0.0f || lf >= 1.0f) return;  // Open addressing needs free slots
+    maxLoad = lf;
+    if (static_cast<float>(numElements + numDeleted) > capacity * maxLoad) {
+        rehash(capacityFor(numElements));
+    }
+}
+
+template<typename K, typename V, typename Hash>
+void FlatHashTable<K, V, Hash>::reserve(size_t n) {
+    size_t needed = capacityFor(n);
+    if (needed > capacity) {
+        rehash(needed);
+    }
+}
+
+#endif // FLAT_HASHTABLE_H
@@ -7,34 +7,99 @@
 #include <list>
 #include <functional>
 #include <string>
+#include "KeyHash.h"
 
 using namespace std;
 
-template<typename K, typename V>
+/**
+ * HashTable - Separate-chaining hash table with incremental growth
+ *
+ * Hash is the hash policy. The default KeyHash<K> (std::hash) is paired with
+ * a prime bucket count and `% tableSize`; a policy that declares
+ * is_avalanching (e.g. SeededHash<K>) gets power-of-two bucket counts and
+ * `& (tableSize - 1)` instead.
+ */
+template<typename K, typename V, typename Hash = KeyHash<K>>
 class HashTable {
 private:
     static const size_t DEFAULT_SIZE = 101;  // Prime number for better distribution
+    static constexpr bool USE_MASK = hash_is_avalanching<Hash>::value;
+    static const size_t REHASH_STEP = 4;     // Buckets migrated per operation while rehashing
     vector<list<pair<K, V>>> buckets;
     size_t tableSize;
     size_t numElements;
-    hash<K> hashFunction;
+    float maxLoad;
+    Hash hashFunction;
     
-    size_t getHash(const K& key) const {
-        return hashFunction(key) % tableSize;
+    // Incremental rehash state: while rehashing, entries live either in
+    // oldBuckets (at index >= rehashIndex) or in buckets, never in both
+    vector<list<pair<K, V>>> oldBuckets;
+    size_t oldTableSize;
+    size_t rehashIndex;
+    
+    static size_t reduce(size_t hash, size_t buckets) {
+        if constexpr (USE_MASK) {
+            return hash & (buckets - 1);
+        } else {
+            return hash % buckets;
+        }
+    }
+    
+    template<typename Q>
+    size_t getHash(const Q& key) const {
+        return reduce(hashFunction(key), tableSize);
+    }
+    
+    template<typename Q>
+    size_t getOldHash(const Q& key) const {
+        return reduce(hashFunction(key), oldTableSize);
     }
     
+    bool isRehashing() const { return !oldBuckets.empty(); }
+    
+    // Bucket currently holding key (in either table)
+    template<typename Q>
+    list<pair<K, V>>& bucketFor(const Q& key);
+    template<typename Q>
+    const list<pair<K, V>>& bucketFor(const Q& key) const;
+    
+    // Grow if the load factor is above maxLoad
+    void checkLoad();
+    
+    // Begin moving entries into a table of newSize buckets
+    void startRehash(size_t newSize);
+    
+    // Migrate up to `steps` old buckets into the new table
+    void rehashStep(size_t steps);
+    
+    // Finish any rehash in progress
+    void completeRehash();
+    
+    static size_t nextPrime(size_t n);
+    static size_t nextPowerOfTwo(size_t n);
+    
+    // Smallest valid bucket count >= n for this hash policy
+    static size_t nextSize(size_t n) { return USE_MASK ? nextPowerOfTwo(n) : nextPrime(n); }
+    
 public:
-    HashTable(size_t size = DEFAULT_SIZE);
+    HashTable(size_t size = DEFAULT_SIZE, const Hash& hasher = Hash());
     ~HashTable();
     
     // Insert or update key-value pair
     void insert(const K& key, const V& value);
     
     // Get value by key (returns nullptr if not found)
-    V* get(const K& key);
+    // Q may be K or anything KeyHash<K> and == accept, e.g. string_view for string keys
+    template<typename Q>
+    V* get(const Q& key);
+    
+    // Read-only lookup; never advances a rehash, so safe under a shared lock
+    template<typename Q>
+    const V* get(const Q& key) const;
     
     // Check if key exists
-    bool contains(const K& key) const;
+    template<typename Q>
+    bool contains(const Q& key) const;
     
     // Remove key-value pair
     bool remove(const K& key);
@@ -54,6 +119,21 @@ public:
     // Clear all data
     void clear();
     
+    // ========== Capacity ==========
+    
+    // Number of buckets (of the table new entries go to)
+    size_t bucketCount() const { return tableSize; }
+    
+    // Current elements per bucket
+    float loadFactor() const { return static_cast<float>(numElements) / tableSize; }
+    
+    // Load factor above which the table grows (default 1.0)
+    float maxLoadFactor() const { return maxLoad; }
+    void setMaxLoadFactor(float lf);
+    
+    // Size the table for n elements up front (rehashes immediately, not incrementally)
+    void reserve(size_t n);
+    
     // Save to file
     bool saveToFile(const string& filename);
     
@@ -63,38 +143,73 @@ public:
 
 // ==================== HashTable Implementation ====================
 
-template<typename K, typename V>
-HashTable<K, V>::HashTable(size_t size) : tableSize(size), numElements(0) {
+template<typename K, typename V, typename Hash>
+HashTable<K, V, Hash>::HashTable(size_t size, const Hash& hasher)
+    : tableSize(USE_MASK ? nextPowerOfTwo(size) : size), numElements(0), maxLoad(1.0f),
+      hashFunction(hasher), oldTableSize(0), rehashIndex(0) {
     buckets.resize(tableSize);
 }
 
-template<typename K, typename V>
-HashTable<K, V>::~HashTable() {
+template<typename K, typename V, typename Hash>
+HashTable<K, V, Hash>::~HashTable() {
     clear();
 }
 
-template<typename K, typename V>
-void HashTable<K, V>::insert(const K& key, const V& value) {
-    size_t index = getHash(key);
+template<typename K, typename V, typename Hash>
+template<typename Q>
+list<pair<K, V>>& HashTable<K, V, Hash>::bucketFor(const Q& key) {
+    if (isRehashing()) {
+        size_t oldIndex = getOldHash(key);
+        if (oldIndex >= rehashIndex) {
+            return oldBuckets[oldIndex];  // Not migrated yet
+        }
+    }
+    return buckets[getHash(key)];
+}
+
+template<typename K, typename V, typename Hash>
+template<typename Q>
+const list<pair<K, V>>& HashTable<K, V, Hash>::bucketFor(const Q& key) const {
+    if (isRehashing()) {
+        size_t oldIndex = getOldHash(key);
+        if (oldIndex >= rehashIndex) {
+            return oldBuckets[oldIndex];
+        }
+    }
+    return buckets[getHash(key)];
+}
+
+template<typename K, typename V, typename Hash>
+void HashTable<K, V, Hash>::insert(const K& key, const V& value) {
+    if (isRehashing()) {
+        rehashStep(REHASH_STEP);
+    }
+    
+    auto& bucket = bucketFor(key);
     
     // Check if key already exists
-    for (auto& pair : buckets[index]) {
+    for (auto& pair : bucket) {
         if (pair.first == key) {
             pair.second = value;  // Update existing
             return;
         }
     }
     
-    // Insert new pair
-    buckets[index].push_back({key, value});
+    // Insert new pair (an unmigrated old bucket gets it and moves it later)
+    bucket.push_back({key, value});
     numElements++;
+    
+    checkLoad();
 }
 
-template<typename K, typename V>
-V* HashTable<K, V>::get(const K& key) {
-    size_t index = getHash(key);
+template<typename K, typename V, typename Hash>
+template<typename Q>
+V* HashTable<K, V, Hash>::get(const Q& key) {
+    if (isRehashing()) {
+        rehashStep(REHASH_STEP);
+    }
     
-    for (auto& pair : buckets[index]) {
+    for (auto& pair : bucketFor(key)) {
         if (pair.first == key) {
             return &pair.second;
         }
@@ -103,11 +218,22 @@ V* HashTable<K, V>::get(const K& key) {
     return nullptr;
 }
 
-template<typename K, typename V>
-bool HashTable<K, V>::contains(const K& key) const {
-    size_t index = getHash(key);
+template<typename K, typename V, typename Hash>
+template<typename Q>
+const V* HashTable<K, V, Hash>::get(const Q& key) const {
+    for (const auto& pair : bucketFor(key)) {
+        if (pair.first == key) {
+            return &pair.second;
+        }
+    }
     
-    for (const auto& pair : buckets[index]) {
+    return nullptr;
+}
+
+template<typename K, typename V, typename Hash>
+template<typename Q>
+bool HashTable<K, V, Hash>::contains(const Q& key) const {
+    for (const auto& pair : bucketFor(key)) {
         if (pair.first == key) {
             return true;
         }
@@ -116,11 +242,13 @@ bool HashTable<K, V>::contains(const K& key) const {
     return false;
 }
 
-template<typename K, typename V>
-bool HashTable<K, V>::remove(const K& key) {
-    size_t index = getHash(key);
+template<typename K, typename V, typename Hash>
+bool HashTable<K, V, Hash>::remove(const K& key) {
+    if (isRehashing()) {
+        rehashStep(REHASH_STEP);
+    }
     
-    auto& bucket = buckets[index];
+    auto& bucket = bucketFor(key);
     for (auto it = bucket.begin(); it != bucket.end(); ++it) {
         if (it->first == key) {
             bucket.erase(it);
@@ -132,8 +260,8 @@ bool HashTable<K, V>::remove(const K& key) {
     return false;
 }
 
-template<typename K, typename V>
-bool HashTable<K, V>::update(const K& key, const V& value) {
+template<typename K, typename V, typename Hash>
+bool HashTable<K, V, Hash>::update(const K& key, const V& value) {
     V* found = get(key);
     if (found != nullptr) {
         *found = value;
@@ -142,9 +270,10 @@ bool HashTable<K, V>::update(const K& key, const V& value) {
     return false;
 }
 
-template<typename K, typename V>
-vector<pair<K, V>> HashTable<K, V>::getAllPairs() const {
+template<typename K, typename V, typename Hash>
+vector<pair<K, V>> HashTable<K, V, Hash>::getAllPairs() const {
     vector<pair<K, V>> pairs;
+    pairs.reserve(numElements);
     
     for (const auto& bucket : buckets) {
         for (const auto& pair : bucket) {
@@ -152,19 +281,121 @@ vector<pair<K, V>> HashTable<K, V>::getAllPairs() const {
         }
     }
     
+    for (size_t i = rehashIndex; i < oldBuckets.size(); i++) {
+        for (const auto& pair : oldBuckets[i]) {
+            pairs.push_back(pair);
+        }
+    }
+    
     return pairs;
 }
 
-template<typename K, typename V>
-void HashTable<K, V>::clear() {
+template<typename K, typename V, typename Hash>
+void HashTable<K, V, Hash>::clear() {
     for (auto& bucket : buckets) {
         bucket.clear();
     }
+    oldBuckets.clear();
+    oldTableSize = 0;
+    rehashIndex = 0;
     numElements = 0;
 }
 
-template<typename K, typename V>
-bool HashTable<K, V>::saveToFile(const string& filename) {
+template<typename K, typename V, typename Hash>
+void HashTable<K, V, Hash>::setMaxLoadFactor(float lf) {
+    if (lf <= 0.0f) return;
+    maxLoad = lf;
+    checkLoad();
+}
+
+template<typename K, typename V, typename Hash>
+void HashTable<K, V, Hash>::reserve(size_t n) {
+    completeRehash();
+    
+    size_t needed = static_cast<size_t>(n / maxLoad) + 1;
+    if (needed <= tableSize) return;
+    
+    startRehash(nextSize(needed));
+    completeRehash();
+}
+
+template<typename K, typename V, typename Hash>
+void HashTable<K, V, Hash>::checkLoad() {
+    if (loadFactor() <= maxLoad) return;
+    
+    // A new growth can't start until the previous one has drained
+    completeRehash();
+    if (loadFactor() > maxLoad) {
+        startRehash(nextSize(tableSize * 2));
+    }
+}
+
+template<typename K, typename V, typename Hash>
+void HashTable<K, V, Hash>::startRehash(size_t newSize) {
+    oldBuckets.swap(buckets);
+    oldTableSize = tableSize;
+    rehashIndex = 0;
+    
+    tableSize = newSize;
+    buckets.clear();
+    buckets.resize(tableSize);
+}
+
+template<typename K, typename V, typename Hash>
+void HashTable<K, V, Hash>::rehashStep(size_t steps) {
+    while (steps > 0 && rehashIndex < oldTableSize) {
+        auto& oldBucket = oldBuckets[rehashIndex];
+        // splice() relinks list nodes, so V* handed out by get() stay valid
+        while (!oldBucket.empty()) {
+            auto& target = buckets[getHash(oldBucket.front().first)];
+            target.splice(target.end(), oldBucket, oldBucket.begin());
+        }
+        rehashIndex++;
+        steps--;
+    }
+    
+    if (rehashIndex >= oldTableSize) {
+        oldBuckets.clear();
+        oldBuckets.shrink_to_fit();
+        oldTableSize = 0;
+        rehashIndex = 0;
+    }
+}
+
+template<typename K, typename V, typename Hash>
+void HashTable<K, V, Hash>::completeRehash() {
+    if (isRehashing()) {
+        rehashStep(oldTableSize);
+    }
+}
+
+template<typename K, typename V, typename Hash>
+size_t HashTable<K, V, Hash>::nextPrime(size_t n) {
+    if (n <= 2) return 2;
+    if (n % 2 == 0) n++;
+    for (;; n += 2) {
+        bool prime = true;
+        for (size_t d = 3; d * d <= n; d += 2) {
+            if (n % d == 0) {
+                prime = false;
+                break;
+            }
+        }
+        if (prime) return n;
+    }
+}
+
+template<typename K, typename V, typename Hash>
+size_t HashTable<K, V, Hash>::nextPowerOfTwo(size_t n) {
+    size_t size = 1;
+    while (size < n) {
+        size <<= 1;
+    }
+    return size;
+}
+
+template<typename K, typename V, typename Hash>
+bool HashTable<K, V, Hash>::saveToFile(const string& filename) {
     ofstream out(filename, ios::binary);
     if (!out.is_open()) return false;
     
@@ -173,19 +404,17 @@ bool HashTable<K, V>::saveToFile(const string& filename) {
     out.write(reinterpret_cast<const char*>(&numElements), sizeof(numElements));
     
     // Save all key-value pairs
-    for (const auto& bucket : buckets) {
-        for (const auto& pair : bucket) {
-            out.write(reinterpret_cast<const char*>(&pair.first), sizeof(K));
-            out.write(reinterpret_cast<const char*>(&pair.second), sizeof(V));
-        }
+    for (const auto& pair : getAllPairs()) {
+        out.write(reinterpret_cast<const char*>(&pair.first), sizeof(K));
+        out.write(reinterpret_cast<const char*>(&pair.second), sizeof(V));
     }
     
     out.close();
     return true;
 }
 
-template<typename K, typename V>
-bool HashTable<K, V>::loadFromFile(const string& filename) {
+template<typename K, typename V, typename Hash>
+bool HashTable<K, V, Hash>::loadFromFile(const string& filename) {
     ifstream in(filename, ios::binary);
     if (!in.is_open()) return false;
     
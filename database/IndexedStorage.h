@@ -1,35 +1,52 @@
 #ifndef INDEXED_STORAGE_H
 #define INDEXED_STORAGE_H
 
-#include "BTree.h"
+#include "BPlusTree.h"
 #include "HashTable.h"
+#include "FlatHashTable.h"
+#include "SeededHash.h"
 #include "DataModels.h"
+#include "Durability.h"
+#include "EntityCodec.h"
+#include "Logger.h"
 #include <fstream>
-#include <iostream>
 #include <type_traits>  // for is_same_v and if constexpr
+#include <string_view>
+#include <algorithm>
 
 using namespace std;
 
 /**
  * IndexedStorage - Combines B-Tree and Hash Table for optimal performance
  * 
- * - B-Tree: For sorted iteration and range queries
+ * - B+Tree: For sorted iteration and range queries
  * - HashTable: For O(1) get/exists lookups
  * - Data File: For actual entity storage
  * 
  * Template specializations for Student, Course, Teacher, User
+ *
+ * HashIndex selects the hash index implementation: the chained
+ * HashTable (default, incremental growth, stable value pointers) or the
+ * open-addressing FlatHashTable (fewer cache misses per lookup, one-shot
+ * growth). The default uses the seeded SeededHash policy so IDs can't be
+ * crafted to collide.
+ *
+ * TreeIndex selects the sorted index, normally a BPlusTree<string, size_t,
+ * ORDER> whose order suits the store (see benchmarks/bench_btree_order).
+ * getAll() and remove() walk it with a range-for over its leaf chain;
+ * getPage()/getPageAfter() use its per-subtree counts (select/upperBound)
+ * to start a page in O(log n) instead of skipping the earlier entries.
  */
-template<typename T>
+template<typename T, typename HashIndex = HashTable<string, size_t, SeededHash<string>>,
+         typename TreeIndex = BPlusTree<string, size_t>>
 class IndexedStorage {
 private:
-    BTree<string, size_t> btree;          // ID -> file offset
-    HashTable<string, size_t> hashTable;  // ID -> file offset
+    TreeIndex btree;                      // ID -> file offset
+    HashIndex hashTable;                  // ID -> file offset
     string dataFilename;
     string btreeFilename;
     string hashFilename;
-    
-    // Get entity ID (must specialize for each type)
-    string getID(const T& entity);
+    FileSyncer syncer;                    // fsync policy for dataFilename
     
     // Write entity to data file, return offset (line number)
     size_t writeEntity(const T& entity, size_t offset = (size_t)-1);
@@ -37,9 +54,9 @@ private:
     // Read entity from data file at offset (line number)
     bool readEntity(size_t offset, T& entity);
     
-    // Serialization helpers (use existing Serialization.h)
-    string serializeEntity(const T& entity);
-    T deserializeEntity(const string& data);
+    // Rebuild the B+Tree from (ID, offset) pairs with one bottom-up bulk
+    // load; sorts first if needed, a later duplicate ID wins
+    void rebuildTree(vector<pair<string, size_t>>& entries);
     
 public:
     IndexedStorage(const string& baseName);
@@ -47,82 +64,119 @@ public:
     
     // Core operations
     bool add(const T& entity);
-    bool get(const string& id, T& entity);
+    
+    // Add many entities with one data-file write (for migrations/imports).
+    // Entities whose ID is empty or already stored are skipped; returns
+    // the number added.
+    size_t addAll(const vector<T>& entities);
+    
+    bool get(string_view id, T& entity);
     bool update(const T& entity);
     bool remove(const string& id);
-    bool exists(const string& id);
+    bool exists(string_view id);
     
     // Get all entities (sorted by ID via B-Tree)
     vector<T> getAll();
     
+    // Pagination in ID order. getPage() returns entities [offset,
+    // offset + limit); getPageAfter() returns up to limit entities whose ID
+    // is greater than afterID ("" starts at the first ID).
+    vector<T> getPage(size_t offset, size_t limit);
+    vector<T> getPageAfter(string_view afterID, size_t limit);
+    
+    size_t size() const { return btree.size(); }
+    
+    // Position of id in ID order (number of smaller IDs)
+    size_t rankOf(string_view id) const { return btree.rank(id); }
+    
+    // Durability (fsync policy for the data file)
+    void setDurability(const DurabilityPolicy& policy) { syncer.setPolicy(policy); }
+    const DurabilityPolicy& getDurability() const { return syncer.getPolicy(); }
+    
     // Persistence
     void save();
     void load();
     void clear();
+    
+    // Every record, one serialized entity per line (for SharedSnapshot)
+    string exportLines();
 };
 
 // ==================== Implementation ====================
 
-template<typename T>
-IndexedStorage<T>::IndexedStorage(const string& baseName)
+template<typename T, typename HashIndex, typename TreeIndex>
+IndexedStorage<T, HashIndex, TreeIndex>::IndexedStorage(const string& baseName)
     : dataFilename(baseName + ".dat"),
       btreeFilename(baseName + ".btree"),
-      hashFilename(baseName + ".hash") {
+      hashFilename(baseName + ".hash"),
+      syncer(baseName + ".dat") {
 
-    cout << "[IndexedStorage] Loading from: " << dataFilename << endl;
+    LOG_INFO("IndexedStorage") << "Loading from: " << dataFilename;
     
     // REBUILD INDEXES: Read all entities from .dat and rebuild B-Tree/Hash Table
     ifstream dataFile(dataFilename);
     if (dataFile.is_open()) {
-        string line;
+        vector<string> lines;
+        string fileLine;
+        while (getline(dataFile, fileLine)) {
+            lines.push_back(fileLine);
+        }
+        dataFile.close();
+        
+        // Size the hash table once instead of growing it during the rebuild
+        hashTable.reserve(lines.size());
+        
         size_t lineNum = 0;
         size_t successCount = 0;
         size_t failCount = 0;
+        vector<pair<string, size_t>> entries;
+        entries.reserve(lines.size());
         
-        while (getline(dataFile, line)) {
+        for (const string& line : lines) {
             if (line.empty()) continue;
             
             try {
-                T entity = deserializeEntity(line);
-                string id = getID(entity);
+                T entity = EntityCodec::deserialize<T>(line);
+                const auto& id = EntityCodec::id(entity);
                 
                 if (id.empty()) {
-                    cout << "[IndexedStorage] WARNING: Empty ID at line " << lineNum << endl;
+                    LOG_WARN("IndexedStorage") << "Empty ID at line " << lineNum;
                     failCount++;
                     lineNum++;
                     continue;
                 }
                 
-                cout << "[IndexedStorage] Loaded entity: " << id << " at line " << lineNum << endl;
+                LOG_DEBUG("IndexedStorage") << "Loaded entity: " << id << " at line " << lineNum;
                 
                 // Add to both indexes with line number as offset
-                btree.insert(id, lineNum);
+                entries.emplace_back(id, lineNum);
                 hashTable.insert(id, lineNum);
                 successCount++;
                 
             } catch (const exception& e) {
-                cout << "[IndexedStorage] ERROR deserializing line " << lineNum << ": " << e.what() << endl;
+                LOG_ERROR("IndexedStorage") << "Error deserializing line " << lineNum << ": " << e.what();
                 failCount++;
             }
             
             lineNum++;
         }
-        dataFile.close();
         
-        cout << "[IndexedStorage] Total entities loaded: " << successCount << " (failed: " << failCount << ")" << endl;
+        rebuildTree(entries);
+        
+        LOG_INFO("IndexedStorage") << "Total entities loaded: " << successCount << " (failed: " << failCount << ")";
     } else {
-        cout << "[IndexedStorage] File not found: " << dataFilename << endl;
+        LOG_INFO("IndexedStorage") << "File not found: " << dataFilename;
     }
 }
 
-template<typename T>
-IndexedStorage<T>::~IndexedStorage() {
+template<typename T, typename HashIndex, typename TreeIndex>
+IndexedStorage<T, HashIndex, TreeIndex>::~IndexedStorage() {
     save();  // Auto-save on destruction
 }
 
-template<typename T>
-bool IndexedStorage<T>::add(const T& entity) {
-    string id = getID(entity);
+template<typename T, typename HashIndex, typename TreeIndex>
+bool IndexedStorage<T, HashIndex, TreeIndex>::add(const T& entity) {
+    const auto& id = EntityCodec::id(entity);
     
     // Check if already exists
     if (hashTable.contains(id)) {
@@ -139,8 +193,60 @@ bool IndexedStorage<T>::add(const T& entity) {
     return true;
 }
 
-template<typename T>
-bool IndexedStorage<T>::get(const string& id, T& entity) {
+template<typename T, typename HashIndex, typename TreeIndex>
+size_t IndexedStorage<T, HashIndex, TreeIndex>::addAll(const vector<T>& entities) {
+    // Count existing lines: new entities are appended after them
+    size_t lineCount = 0;
+    ifstream inFile(dataFilename);
+    if (inFile.is_open()) {
+        string line;
+        while (getline(inFile, line)) {
+            lineCount++;
+        }
+        inFile.close();
+    }
+    
+    ofstream outFile(dataFilename, ios::app);
+    if (!outFile.is_open()) {
+        LOG_ERROR("IndexedStorage") << "Failed to open data file for append: " << dataFilename;
+        return 0;
+    }
+    
+    hashTable.reserve(lineCount + entities.size());
+    vector<pair<string, size_t>> added;
+    added.reserve(entities.size());
+    
+    for (const T& entity : entities) {
+        const auto& id = EntityCodec::id(entity);
+        if (id.empty() || hashTable.contains(id)) {
+            continue;
+        }
+        
+        size_t offset = lineCount + added.size();
+        outFile << EntityCodec::serialize(entity) << "\n";
+        hashTable.insert(id, offset);
+        added.emplace_back(id, offset);
+    }
+    
+    outFile.close();
+    if (added.empty()) {
+        return 0;
+    }
+    syncer.onCommit();
+    
+    // An empty tree is built bottom-up; otherwise insert into the existing one
+    if (btree.isEmpty()) {
+        rebuildTree(added);
+    } else {
+        for (const auto& entry : added) {
+            btree.insert(entry.first, entry.second);
+        }
+    }
+    return added.size();
+}
+
+template<typename T, typename HashIndex, typename TreeIndex>
+bool IndexedStorage<T, HashIndex, TreeIndex>::get(string_view id, T& entity) {
     // Use hash table for O(1) lookup
     size_t* offsetPtr = hashTable.get(id);
     if (offsetPtr == nullptr) {
@@ -151,9 +257,9 @@ bool IndexedStorage<T>::get(const string& id, T& entity) {
     return readEntity(*offsetPtr, entity);
 }
 
-template<typename T>
-bool IndexedStorage<T>::update(const T& entity) {
-    string id = getID(entity);
+template<typename T, typename HashIndex, typename TreeIndex>
+bool IndexedStorage<T, HashIndex, TreeIndex>::update(const T& entity) {
+    const auto& id = EntityCodec::id(entity);
     
     // Get existing offset
     size_t* offsetPtr = hashTable.get(id);
@@ -167,8 +273,8 @@ bool IndexedStorage<T>::update(const T& entity) {
     return true;
 }
 
-template<typename T>
-bool IndexedStorage<T>::remove(const string& id) {
+template<typename T, typename HashIndex, typename TreeIndex>
+bool IndexedStorage<T, HashIndex, TreeIndex>::remove(const string& id) {
     // First check if entity exists
     size_t* offsetPtr = hashTable.get(id);
     if (offsetPtr == nullptr) {
@@ -177,59 +283,66 @@ bool IndexedStorage<T>::remove(const string& id) {
     
     // Read all entities from file (excluding the one to delete)
     vector<T> allEntities;
-    auto pairs = btree.getAllPairs();
+    allEntities.reserve(btree.size());
     
-    for (const auto& pair : pairs) {
-        if (pair.first != id) {  // Skip the one we're deleting
+    for (const auto& [entryID, offset] : btree) {
+        if (entryID != id) {  // Skip the one we're deleting
             T entity;
-            if (readEntity(pair.second, entity)) {
+            if (readEntity(offset, entity)) {
                 allEntities.push_back(entity);
             }
         }
     }
     
-    // Clear indexes
-    btree.clear();
-    hashTable.clear();
-    
-    // Rewrite data file with remaining entities
+    // Rewrite data file with remaining entities; the indexes are only
+    // touched once it opens, so a failure leaves them intact
     ofstream outFile(dataFilename);
     if (!outFile.is_open()) {
-        cerr << "[IndexedStorage] Failed to rewrite data file: " << dataFilename << endl;
+        LOG_ERROR("IndexedStorage") << "Failed to rewrite data file: " << dataFilename;
         return false;
     }
     
+    // Clear indexes
+    hashTable.clear();
+    hashTable.reserve(allEntities.size());
+    vector<pair<string, size_t>> entries;
+    entries.reserve(allEntities.size());
+    
     size_t newOffset = 0;
     for (const auto& entity : allEntities) {
-        string entityID = getID(entity);
-        string serialized = serializeEntity(entity);
+        const auto& entityID = EntityCodec::id(entity);
+        string serialized = EntityCodec::serialize(entity);
         outFile << serialized << "\n";
         
         // Rebuild indexes with new offsets
-        btree.insert(entityID, newOffset);
+        entries.emplace_back(entityID, newOffset);
         hashTable.insert(entityID, newOffset);
         newOffset++;
     }
     
+    // Entities were read in tree order, so entries are already sorted
+    btree.bulkLoad(entries.begin(), entries.end());
+    
     outFile.close();
+    syncer.onCommit();
     return true;
 }
 
-template<typename T>
-bool IndexedStorage<T>::exists(const string& id) {
+template<typename T, typename HashIndex, typename TreeIndex>
+bool IndexedStorage<T, HashIndex, TreeIndex>::exists(string_view id) {
     return hashTable.contains(id);
 }
 
-template<typename T>
-vector<T> IndexedStorage<T>::getAll() {
+template<typename T, typename HashIndex, typename TreeIndex>
+vector<T> IndexedStorage<T, HashIndex, TreeIndex>::getAll() {
     vector<T> results;
     
-    // Get all ID-offset pairs from B-Tree (sorted)
-    auto pairs = btree.getAllPairs();
+    results.reserve(btree.size());
     
-    for (const auto& pair : pairs) {
+    // Walk offsets along the B+Tree leaves (sorted); keys are not rebuilt
+    for (auto it = btree.begin(); it != btree.end(); ++it) {
         T entity;
-        if (readEntity(pair.second, entity)) {
+        if (readEntity(it.value(), entity)) {
             results.push_back(entity);
         }
     }
@@ -237,29 +350,98 @@ vector<T> IndexedStorage<T>::getAll() {
     return results;
 }
 
-template<typename T>
-void IndexedStorage<T>::save() {
+template<typename T, typename HashIndex, typename TreeIndex>
+vector<T> IndexedStorage<T, HashIndex, TreeIndex>::getPage(size_t offset, size_t limit) {
+    vector<T> results;
+    if (offset >= btree.size()) return results;
+    
+    results.reserve(min(limit, btree.size() - offset));
+    for (auto it = btree.select(offset); it != btree.end() && results.size() < limit; ++it) {
+        T entity;
+        if (readEntity(it.value(), entity)) {
+            results.push_back(entity);
+        }
+    }
+    
+    return results;
+}
+
+template<typename T, typename HashIndex, typename TreeIndex>
+vector<T> IndexedStorage<T, HashIndex, TreeIndex>::getPageAfter(string_view afterID, size_t limit) {
+    vector<T> results;
+    
+    auto it = afterID.empty() ? btree.begin() : btree.upperBound(afterID);
+    for (; it != btree.end() && results.size() < limit; ++it) {
+        T entity;
+        if (readEntity(it.value(), entity)) {
+            results.push_back(entity);
+        }
+    }
+    
+    return results;
+}
+
+template<typename T, typename HashIndex, typename TreeIndex>
+void IndexedStorage<T, HashIndex, TreeIndex>::save() {
     // Indexes are rebuilt from .dat file on startup, no need to save them
-    // Data file is written incrementally in writeEntity(), no need to save again
+    // Data file is written incrementally in writeEntity(), only pending batch fsyncs remain
+    syncer.flush();
 }
 
-template<typename T>
-void IndexedStorage<T>::load() {
+template<typename T, typename HashIndex, typename TreeIndex>
+void IndexedStorage<T, HashIndex, TreeIndex>::load() {
     // Indexes are rebuilt in constructor from .dat file, nothing to do here
 }
 
-template<typename T>
-void IndexedStorage<T>::clear() {
+template<typename T, typename HashIndex, typename TreeIndex>
+void IndexedStorage<T, HashIndex, TreeIndex>::clear() {
     btree.clear();
     hashTable.clear();
     // Optionally delete data file
     remove(dataFilename.c_str());
 }
 
+template<typename T, typename HashIndex, typename TreeIndex>
+string IndexedStorage<T, HashIndex, TreeIndex>::exportLines() {
+    // The data file holds exactly the live records: updates overwrite in
+    // place and removals rewrite it
+    ifstream dataFile(dataFilename, ios::binary);
+    if (!dataFile.is_open()) {
+        return string();
+    }
+    return string(istreambuf_iterator<char>(dataFile), istreambuf_iterator<char>());
+}
+
+template<typename T, typename HashIndex, typename TreeIndex>
+void IndexedStorage<T, HashIndex, TreeIndex>::rebuildTree(vector<pair<string, size_t>>& entries) {
+    auto byID = [](const pair<string, size_t>& a, const pair<string, size_t>& b) {
+        return a.first < b.first;
+    };
+    if (!is_sorted(entries.begin(), entries.end(), byID)) {
+        stable_sort(entries.begin(), entries.end(), byID);
+    }
+    
+    // Collapse duplicate IDs, keeping the last (same result as repeated insert)
+    size_t unique = 0;
+    for (size_t i = 0; i < entries.size(); i++) {
+        if (unique > 0 && entries[unique - 1].first == entries[i].first) {
+            entries[unique - 1].second = entries[i].second;
+        } else {
+            if (unique != i) {
+                entries[unique] = move(entries[i]);
+            }
+            unique++;
+        }
+    }
+    entries.resize(unique);
+    
+    btree.bulkLoad(entries.begin(), entries.end());
+}
+
 // ==================== File I/O Helpers (TEXT-BASED for portability) ====================
 
-template<typename T>
-size_t IndexedStorage<T>::writeEntity(const T& entity, size_t offset) {
+template<typename T, typename HashIndex, typename TreeIndex>
+size_t IndexedStorage<T, HashIndex, TreeIndex>::writeEntity(const T& entity, size_t offset) {
     // Use text-based line storage for portability
     // Each entity is one line in the file
     
@@ -275,7 +457,7 @@ size_t IndexedStorage<T>::writeEntity(const T& entity, size_t offset) {
     }
     
     // Serialize the entity to text
-    string serialized = serializeEntity(entity);
+    string serialized = EntityCodec::serialize(entity);
     
     if (offset == (size_t)-1) {
         // Append new entity
@@ -295,7 +477,7 @@ size_t IndexedStorage<T>::writeEntity(const T& entity, size_t offset) {
     // Write all lines back
     ofstream outFile(dataFilename);
     if (!outFile.is_open()) {
-        cerr << "Failed to open data file for writing: " << dataFilename << endl;
+        LOG_ERROR("IndexedStorage") << "Failed to open data file for writing: " << dataFilename;
         return 0;
     }
     
@@ -303,12 +485,13 @@ size_t IndexedStorage<T>::writeEntity(const T& entity, size_t offset) {
         outFile << line << "\n";
     }
     outFile.close();
+    syncer.onCommit();
     
     return offset;
 }
 
-template<typename T>
-bool IndexedStorage<T>::readEntity(size_t offset, T& entity) {
+template<typename T, typename HashIndex, typename TreeIndex>
+bool IndexedStorage<T, HashIndex, TreeIndex>::readEntity(size_t offset, T& entity) {
     ifstream file(dataFilename);
     if (!file.is_open()) {
         return false;
@@ -320,7 +503,7 @@ bool IndexedStorage<T>::readEntity(size_t offset, T& entity) {
     while (getline(file, line)) {
         if (currentLine == offset) {
             file.close();
-            entity = deserializeEntity(line);
+            entity = EntityCodec::deserialize<T>(line);
             return true;
         }
         currentLine++;
@@ -330,65 +513,4 @@ bool IndexedStorage<T>::readEntity(size_t offset, T& entity) {
     return false;
 }
 
-// ==================== Serialization Helpers (using existing Serialization.h) ====================
-
-#include "Serialization.h"
-
-template<typename T>
-string IndexedStorage<T>::serializeEntity(const T& entity) {
-    if constexpr (is_same_v<T, Student>) {
-        return Serializer::serializeStudent(entity);
-    } else if constexpr (is_same_v<T, Course>) {
-        return Serializer::serializeCourse(entity);
-    } else if constexpr (is_same_v<T, Teacher>) {
-        return Serializer::serializeTeacher(entity);
-    } else if constexpr (is_same_v<T, User>) {
-        return Serializer::serializeUser(entity);
-    } else if constexpr (is_same_v<T, Timetable>) {
-        return Serializer::serializeTimetable(entity);
-    } else {
-        return "";
-    }
-}
-
-template<typename T>
-T IndexedStorage<T>::deserializeEntity(const string& data) {
-    if constexpr (is_same_v<T, Student>) {
-        return Serializer::deserializeStudent(data);
-    } else if constexpr (is_same_v<T, Course>) {
-        return Serializer::deserializeCourse(data);
-    } else if constexpr (is_same_v<T, Teacher>) {
-        return Serializer::deserializeTeacher(data);
-    } else if constexpr (is_same_v<T, User>) {
-        return Serializer::deserializeUser(data);
-    } else if constexpr (is_same_v<T, Timetable>) {
-        return Serializer::deserializeTimetable(data);
-    } else {
-        return T();
-    }
-}
-
-// ==================== getID implementation using if constexpr ====================
-
-// Helper for static_assert (must be defined BEFORE use)
-template<typename> struct always_false : std::false_type {};
-
-template<typename T>
-string IndexedStorage<T>::getID(const T& entity) {
-    if constexpr (is_same_v<T, Student>) {
-        return entity.studentID;
-    } else if constexpr (is_same_v<T, Course>) {
-        return entity.courseID;
-    } else if constexpr (is_same_v<T, Teacher>) {
-        return entity.teacherID;
-    } else if constexpr (is_same_v<T, User>) {
-        return entity.email;  // Use email as unique identifier for login
-    } else if constexpr (is_same_v<T, Timetable>) {
-        return to_string(entity.semesterNumber);
-    } else {
-        static_assert(always_false<T>::value, "getID not implemented for this type");
-        return "";
-    }
-}
-
 #endif // INDEXED_STORAGE_H
@@ -0,0 +1,39 @@
+#ifndef KEY_HASH_H
+#define KEY_HASH_H
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+using namespace std;
+
+/**
+ * KeyHash - Hash functor used by HashTable and FlatHashTable
+ *
+ * Defaults to std::hash<K>. For string keys it hashes through string_view
+ * (std::hash<string> and std::hash<string_view> agree by definition), so a
+ * string_view or string literal can be looked up without building a
+ * temporary std::string.
+ */
+template<typename K>
+struct KeyHash : hash<K> {};
+
+template<>
+struct KeyHash<string> {
+    using is_transparent = void;
+    
+    size_t operator()(string_view key) const {
+        return hash<string_view>{}(key);
+    }
+};
+
+// True if Hash declares `is_avalanching`: its low bits are already well mixed,
+// so a table may pick buckets with a power-of-two mask instead of a prime modulus
+template<typename Hash, typename = void>
+struct hash_is_avalanching : false_type {};
+
+template<typename Hash>
+struct hash_is_avalanching<Hash, void_t<typename Hash::is_avalanching>> : true_type {};
+
+#endif // KEY_HASH_H
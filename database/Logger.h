@@ -0,0 +1,407 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <charconv>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+using namespace std;
+
+enum class LogLevel {
+    Debug = 0,
+    Info = 1,
+    Warn = 2,
+    Error = 3,
+    Off = 4
+};
+
+// Levels below this are compiled out entirely (-DUMS_LOG_MIN_LEVEL=1 drops
+// every LOG_DEBUG from the binary)
+#ifndef UMS_LOG_MIN_LEVEL
+#define UMS_LOG_MIN_LEVEL 0
+#endif
+
+/**
+ * LogRing - Single-producer/single-consumer ring of log records
+ *
+ * Each logging thread owns one ring; only the sink thread reads it. The
+ * producer publishes a record by advancing head (release), the sink frees
+ * slots by advancing tail (release), so neither side takes a lock. When
+ * the ring is full the record is dropped and counted rather than blocking
+ * the request thread.
+ */
+class LogRing {
+public:
+    static constexpr size_t CAPACITY = 512;       // Records per thread
+    static constexpr size_t MESSAGE_SIZE = 232;   // Longer messages are truncated
+
+    struct Record {
+        int64_t timeMicros;  // system_clock since epoch
+        const char* tag;     // String literal from the call site
+        LogLevel level;
+        uint16_t length;
+        char text[MESSAGE_SIZE];
+    };
+
+    explicit LogRing(int id) : threadId(id) {}
+
+    // Producer side: copy one message in; records now pending (0 if the
+    // ring was full and the message dropped)
+    size_t push(LogLevel level, const char* tag, int64_t timeMicros, const char* text, size_t length) {
+        size_t h = head.load(memory_order_relaxed);
+        size_t pending = h - tail.load(memory_order_acquire);
+        if (pending == CAPACITY) {
+            dropped.fetch_add(1, memory_order_relaxed);
+            return 0;
+        }
+        Record& record = slots[h % CAPACITY];
+        record.timeMicros = timeMicros;
+        record.tag = tag;
+        record.level = level;
+        record.length = static_cast<uint16_t>(length);
+        memcpy(record.text, text, length);
+        head.store(h + 1, memory_order_release);
+        return pending + 1;
+    }
+
+    // Consumer side: hand every published record to fn, then free the slots
+    template<typename Fn>
+    size_t drain(Fn fn) {
+        size_t t = tail.load(memory_order_relaxed);
+        size_t h = head.load(memory_order_acquire);
+        for (size_t i = t; i != h; i++) {
+            fn(slots[i % CAPACITY]);
+        }
+        tail.store(h, memory_order_release);
+        return h - t;
+    }
+
+    bool empty() const {
+        return head.load(memory_order_acquire) == tail.load(memory_order_acquire);
+    }
+
+    const int threadId;
+    atomic<size_t> dropped{0};
+    atomic<bool> orphaned{false};  // Owning thread has exited
+
+private:
+    Record slots[CAPACITY];
+    alignas(64) atomic<size_t> head{0};  // Next slot the producer writes
+    alignas(64) atomic<size_t> tail{0};  // Next slot the sink reads
+};
+
+/**
+ * AsyncLogger - Asynchronous leveled logging
+ *
+ * Call sites use the LOG_* macros, which test the level before evaluating
+ * any of the streamed arguments:
+ *
+ *     LOG_DEBUG("DB") << "getAllCourses() returning " << result.size() << " courses";
+ *
+ * A message is formatted into a stack buffer (no allocation, no iostream)
+ * and pushed onto the calling thread's LogRing. After start(), a sink
+ * thread drains all rings every FLUSH_INTERVAL (sooner once a ring is half
+ * full), formats timestamps, and
+ * writes each batch to the log file with one fwrite + fflush. Before
+ * start() (tools, tests) lines are written straight to stdout, as the old
+ * cout logging did.
+ */
+class AsyncLogger {
+public:
+    static constexpr chrono::milliseconds FLUSH_INTERVAL{20};
+
+    static AsyncLogger& instance() {
+        static AsyncLogger logger;
+        return logger;
+    }
+
+    static bool enabled(LogLevel level) {
+        return static_cast<int>(level) >= instance().minLevel.load(memory_order_relaxed);
+    }
+
+    void setLevel(LogLevel level) { minLevel.store(static_cast<int>(level), memory_order_relaxed); }
+    LogLevel level() const { return static_cast<LogLevel>(minLevel.load(memory_order_relaxed)); }
+
+    static int64_t nowMicros() {
+        return chrono::duration_cast<chrono::microseconds>(
+            chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    // Start the sink thread appending to path ("" or "-" for stdout);
+    // false if the file can't be opened
+    bool start(const string& path) {
+        lock_guard<mutex> lock(sinkMutex);
+        if (running) return true;
+        if (path.empty() || path == "-") {
+            out = stdout;
+        } else {
+            out = fopen(path.c_str(), "a");
+            if (out == nullptr) return false;
+        }
+        running = true;
+        stopping = false;
+        sink = thread(&AsyncLogger::sinkLoop, this);
+        return true;
+    }
+
+    // Drain everything logged so far and stop the sink thread
+    void stop() {
+        {
+            lock_guard<mutex> lock(sinkMutex);
+            if (!running) return;
+            stopping = true;
+        }
+        wake.notify_one();
+        sink.join();
+        lock_guard<mutex> lock(sinkMutex);
+        if (out != stdout) fclose(out);
+        out = nullptr;
+        running = false;
+    }
+
+    // Block until records logged before this call are written
+    void flush() {
+        if (!isRunning()) {
+            fflush(stdout);
+            return;
+        }
+        unique_lock<mutex> lock(sinkMutex);
+        size_t target = batches + 2;  // A batch already in progress may predate the call
+        wake.notify_one();
+        flushed.wait(lock, [&] { return batches >= target || !running; });
+    }
+
+    bool isRunning() const { return running.load(memory_order_acquire); }
+
+    // Records lost to full rings since startup
+    size_t droppedCount() const {
+        return totalDropped.load(memory_order_relaxed);
+    }
+
+    void write(LogLevel level, const char* tag, const char* text, size_t length) {
+        int64_t now = nowMicros();
+        if (!isRunning()) {
+            string line;
+            TimeCache cache;
+            formatLine(line, cache, now, level, tag, 0, string_view(text, length));
+            fwrite(line.data(), 1, line.size(), stdout);
+            return;
+        }
+        // Wake the sink early when a burst has filled half a ring, and give
+        // it the CPU, rather than dropping records until the next interval
+        if (localRing().push(level, tag, now, text, length) == LogRing::CAPACITY / 2) {
+            wake.notify_one();
+            this_thread::yield();
+        }
+    }
+
+    ~AsyncLogger() { stop(); }
+
+private:
+    // Wall-clock seconds already run through localtime/strftime
+    struct TimeCache {
+        int64_t second = -1;
+        char text[24];  // "2026-01-15 09:30:00"
+        size_t length = 0;
+    };
+
+    atomic<int> minLevel{static_cast<int>(LogLevel::Info)};
+    atomic<bool> running{false};
+    atomic<size_t> totalDropped{0};
+
+    mutex sinkMutex;                 // Guards start/stop, the flush counter and out
+    condition_variable wake;
+    condition_variable flushed;
+    thread sink;
+    bool stopping = false;
+    size_t batches = 0;
+    FILE* out = nullptr;
+
+    TimeCache timeCache;             // Sink thread only
+    mutex ringsMutex;                // Guards rings (registration only, not logging)
+    vector<shared_ptr<LogRing>> rings;
+    int nextThreadId = 1;
+
+    AsyncLogger() = default;
+
+    // The calling thread's ring, registered on its first message
+    LogRing& localRing() {
+        struct Owner {
+            shared_ptr<LogRing> ring;
+            ~Owner() { if (ring) ring->orphaned.store(true, memory_order_release); }
+        };
+        thread_local Owner owner;
+        if (!owner.ring) {
+            lock_guard<mutex> lock(ringsMutex);
+            owner.ring = make_shared<LogRing>(nextThreadId++);
+            rings.push_back(owner.ring);
+        }
+        return *owner.ring;
+    }
+
+    static const char* levelName(LogLevel level) {
+        switch (level) {
+            case LogLevel::Debug: return "DEBUG";
+            case LogLevel::Info:  return "INFO ";
+            case LogLevel::Warn:  return "WARN ";
+            case LogLevel::Error: return "ERROR";
+            default:              return "     ";
+        }
+    }
+
+    // "2026-01-15 09:30:00.123 INFO  [T3] [DB] message\n" (thread id 0 = unthreaded)
+    static void formatLine(string& line, TimeCache& cache, int64_t timeMicros, LogLevel level,
+                           const char* tag, int threadId, string_view text) {
+        int64_t second = timeMicros / 1000000;
+        if (second != cache.second) {
+            time_t seconds = static_cast<time_t>(second);
+            tm local;
+#ifdef _WIN32
+            localtime_s(&local, &seconds);
+#else
+            localtime_r(&seconds, &local);
+#endif
+            cache.length = strftime(cache.text, sizeof(cache.text), "%Y-%m-%d %H:%M:%S", &local);
+            cache.second = second;
+        }
+        int millis = static_cast<int>(timeMicros / 1000 % 1000);
+        char fraction[] = {'.', char('0' + millis / 100), char('0' + millis / 10 % 10),
+                           char('0' + millis % 10), ' '};
+        line.append(cache.text, cache.length);
+        line.append(fraction, sizeof(fraction));
+        line += levelName(level);
+        if (threadId > 0) {
+            char id[16];
+            auto result = to_chars(id, id + sizeof(id), threadId);
+            line += " [T";
+            line.append(id, result.ptr - id);
+            line += ']';
+        }
+        line += " [";
+        line += tag;
+        line += "] ";
+        line += text;
+        line += '\n';
+    }
+
+    // One pass over all rings into batch; retires rings of exited threads
+    void collect(string& batch) {
+        vector<shared_ptr<LogRing>> snapshot;
+        {
+            lock_guard<mutex> lock(ringsMutex);
+            snapshot = rings;
+        }
+        for (const auto& ring : snapshot) {
+            bool orphaned = ring->orphaned.load(memory_order_acquire);
+            ring->drain([&](const LogRing::Record& r) {
+                formatLine(batch, timeCache, r.timeMicros, r.level, r.tag, ring->threadId,
+                           string_view(r.text, r.length));
+            });
+            size_t dropped = ring->dropped.exchange(0, memory_order_relaxed);
+            if (dropped > 0) {
+                totalDropped.fetch_add(dropped, memory_order_relaxed);
+                string note = to_string(dropped) + " messages dropped (ring full)";
+                formatLine(batch, timeCache, nowMicros(), LogLevel::Warn, "Logger", ring->threadId, note);
+            }
+            if (orphaned && ring->empty()) {
+                lock_guard<mutex> lock(ringsMutex);
+                rings.erase(find(rings.begin(), rings.end(), ring));
+            }
+        }
+    }
+
+    void sinkLoop() {
+        string batch;
+        unique_lock<mutex> lock(sinkMutex);
+        while (true) {
+            bool last = stopping;
+            lock.unlock();
+
+            batch.clear();
+            collect(batch);
+            if (!batch.empty()) {
+                fwrite(batch.data(), 1, batch.size(), out);
+                fflush(out);
+            }
+
+            lock.lock();
+            batches++;
+            flushed.notify_all();
+            if (last) break;
+            wake.wait_for(lock, FLUSH_INTERVAL);
+        }
+    }
+};
+
+/**
+ * LogLine - One message being streamed at a LOG_* call site
+ *
+ * Formats into a fixed stack buffer and hands it to the AsyncLogger when the
+ * statement ends. Output beyond LogRing::MESSAGE_SIZE is cut off.
+ */
+class LogLine {
+public:
+    LogLine(LogLevel level, const char* tag) : level(level), tag(tag) {}
+    LogLine(const LogLine&) = delete;
+    LogLine& operator=(const LogLine&) = delete;
+
+    ~LogLine() {
+        AsyncLogger::instance().write(level, tag, buffer, length);
+    }
+
+    LogLine& operator<<(string_view text) {
+        size_t n = min(text.size(), sizeof(buffer) - length);
+        memcpy(buffer + length, text.data(), n);
+        length += n;
+        return *this;
+    }
+
+    LogLine& operator<<(const char* text) { return *this << string_view(text); }
+    LogLine& operator<<(const string& text) { return *this << string_view(text); }
+    LogLine& operator<<(char c) { return *this << string_view(&c, 1); }
+    LogLine& operator<<(bool b) { return *this << (b ? "true" : "false"); }
+
+    LogLine& operator<<(double d) {
+        char digits[32];
+        int n = snprintf(digits, sizeof(digits), "%g", d);
+        return *this << string_view(digits, n > 0 ? static_cast<size_t>(n) : 0);
+    }
+
+    template<typename T, typename = enable_if_t<is_integral_v<T>>>
+    LogLine& operator<<(T value) {
+        char digits[24];
+        auto result = to_chars(digits, digits + sizeof(digits), value);
+        return *this << string_view(digits, result.ptr - digits);
+    }
+
+private:
+    LogLevel level;
+    const char* tag;
+    size_t length = 0;
+    char buffer[LogRing::MESSAGE_SIZE];
+};
+
+// Streamed arguments are only evaluated when the level is enabled; levels
+// under UMS_LOG_MIN_LEVEL are removed at compile time
+#define UMS_LOG(level, tag) \
+    if (static_cast<int>(level) < UMS_LOG_MIN_LEVEL || !AsyncLogger::enabled(level)) {} \
+    else LogLine(level, tag)
+
+#define LOG_DEBUG(tag) UMS_LOG(LogLevel::Debug, tag)
+#define LOG_INFO(tag)  UMS_LOG(LogLevel::Info, tag)
+#define LOG_WARN(tag)  UMS_LOG(LogLevel::Warn, tag)
+#define LOG_ERROR(tag) UMS_LOG(LogLevel::Error, tag)
+
+#endif // LOGGER_H
@@ -0,0 +1,434 @@
+#ifndef NODE_KEYS_H
+#define NODE_KEYS_H
+
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+#include <vector>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define NODE_KEYS_AVX2 1
+#endif
+
+#if defined(_MSC_VER)
+#include <stdlib.h>  // _byteswap_uint64
+#endif
+
+using namespace std;
+
+/**
+ * NodeKeys - Sorted key slots of one B-Tree / B+Tree node with in-node search
+ *
+ * Reads go through operator[] (a const K&, or a rebuilt key: see KeyRef);
+ * writes must go through set(), moveFrom() or take() so any per-slot
+ * search data stays in sync.
+ *
+ * lowerBound()/upperBound() are binary searches, except for std::string
+ * keys (see below). std::string keys are prefix-compressed: the node
+ * stores the prefix all its keys share once (IDs in one node share
+ * "BSCS222", emails in one node "bscs2220"), and
+ * each slot keeps only its suffix, the first 16 bytes as two big-endian
+ * uint64_t (arrays next to each other) and any rest in a node-local tails
+ * buffer. A search compares the query with the prefix once, then runs over
+ * the suffix integers; a tail is only read when heads tie, so IDs and
+ * emails rarely touch one. A slot is 24 bytes instead of a 32-byte string
+ * plus a heap block for keys past the inline buffer. The head search
+ * halves the range only down to LINEAR_SCAN (32) slots and scans the rest
+ * linearly, so a node of up to 32 keys is a plain scan; with AVX2 (-mavx2 /
+ * -march=native) the whole node is scanned 4 heads at a time.
+ *
+ * The prefix only ever shrinks while keys are set; repack(n) re-picks it
+ * from the live keys after a split or bulk load.
+ */
+template<typename K, int N>
+class NodeKeys {
+private:
+    K keys[N];
+
+public:
+    using KeyRef = const K&;
+    static constexpr size_t SLOT_BYTES = sizeof(K);
+
+    const K& operator[](int i) const { return keys[i]; }
+
+    void set(int i, const K& key) { keys[i] = key; }
+    void set(int i, K&& key) { keys[i] = std::move(key); }
+    K&& take(int i) { return std::move(keys[i]); }  // Slot must be rewritten or dropped
+
+    // Move slot from into slot to (from may be in another node)
+    void moveFrom(int to, NodeKeys& other, int from) { keys[to] = std::move(other.keys[from]); }
+
+    // First slot in [0, n) whose key is >= key
+    template<typename Q>
+    int lowerBound(int n, const Q& key) const {
+        return static_cast<int>(std::lower_bound(keys, keys + n, key) - keys);
+    }
+
+    // First slot in [0, n) whose key is > key
+    template<typename Q>
+    int upperBound(int n, const Q& key) const {
+        return static_cast<int>(std::upper_bound(keys, keys + n, key) - keys);
+    }
+
+    // Does slot i hold key?
+    template<typename Q>
+    bool matches(int i, const Q& key) const { return keys[i] == key; }
+
+    void repack(int) {}  // Nothing shared between slots
+
+    // Bytes the first n keys hold outside the node (strings past their
+    // inline buffer)
+    size_t heapBytes(int n) const {
+        size_t bytes = 0;
+        if constexpr (is_convertible_v<const K&, const string&>) {
+            for (int i = 0; i < n; i++) {
+                const string& key = keys[i];
+                if (key.capacity() > string().capacity()) bytes += key.capacity() + 1;
+            }
+        }
+        return bytes;
+    }
+};
+
+template<int N>
+class NodeKeys<string, N> {
+private:
+    // Heads first: a search reads these, then at most a few suffixes
+    uint64_t suffixHi[N];   // Suffix bytes 0-7, big-endian so integer order = byte order
+    uint64_t suffixLo[N];   // Suffix bytes 8-15; short suffixes are zero-padded
+    uint32_t suffixLen[N];
+    uint32_t tailAt[N];     // Suffix bytes past 16 start at tails[tailAt]
+    string prefix;          // Shared by every key in the node
+    string tails;           // Appended to; stale bytes dropped by packTails()
+    size_t tailLimit;       // packTails() once tails grows past this
+
+    static constexpr int LINEAR_SCAN = 32;  // Runs this short are scanned, not halved
+    static constexpr size_t HEAD = 16;
+
+    struct Head {
+        uint64_t hi, lo;
+    };
+
+    // Big-endian loads: the first byte ends up most significant
+    static uint64_t load8(const char* p) {
+        uint64_t v;
+        memcpy(&v, p, 8);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        return v;
+#elif defined(__GNUC__) || defined(__clang__)
+        return __builtin_bswap64(v);
+#else
+        return _byteswap_uint64(v);
+#endif
+    }
+
+    static uint64_t load4(const char* p) {
+        uint32_t v;
+        memcpy(&v, p, 4);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        return v;
+#elif defined(__GNUC__) || defined(__clang__)
+        return __builtin_bswap32(v);
+#else
+        return _byteswap_ulong(v);
+#endif
+    }
+
+    // Up to 8 bytes, left-aligned and zero-padded. Short inputs use two
+    // overlapping loads instead of a variable-length copy.
+    static uint64_t loadPadded(const char* p, size_t len) {
+        if (len >= 8) return load8(p);
+        if (len >= 4) {
+            return (load4(p) << 32) | (load4(p + len - 4) << (8 * (8 - len)));
+        }
+        uint64_t v = 0;
+        for (size_t i = 0; i < len; i++) {
+            v |= static_cast<uint64_t>(static_cast<unsigned char>(p[i])) << (56 - 8 * i);
+        }
+        return v;
+    }
+
+    // Ordering of heads agrees with string ordering, except that equal
+    // heads (zero padding, shared first 16 bytes) need the full compare
+    static Head headOf(string_view key) {
+        size_t len = key.size();
+        Head p;
+        p.hi = loadPadded(key.data(), len);
+        p.lo = len > 8 ? loadPadded(key.data() + 8, len - 8) : 0;
+        return p;
+    }
+
+    bool headLess(int i, const Head& q) const {
+        return (suffixHi[i] < q.hi) | ((suffixHi[i] == q.hi) & (suffixLo[i] < q.lo));
+    }
+
+    bool headEqual(int i, const Head& q) const {
+        return (suffixHi[i] == q.hi) & (suffixLo[i] == q.lo);
+    }
+
+    // Number of slots in [0, n) whose head is below q (heads are sorted)
+    int countHeadLess(int n, const Head& q) const {
+#ifdef NODE_KEYS_AVX2
+        static const int BITS[16] = {0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+        // AVX2 compares signed 64-bit lanes; flipping the sign bit gives unsigned order
+        const __m256i bias = _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000ULL));
+        const __m256i qhi = _mm256_xor_si256(_mm256_set1_epi64x(static_cast<long long>(q.hi)), bias);
+        const __m256i qlo = _mm256_xor_si256(_mm256_set1_epi64x(static_cast<long long>(q.lo)), bias);
+        int count = 0;
+        int i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m256i hi = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(suffixHi + i)), bias);
+            __m256i lo = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(suffixLo + i)), bias);
+            __m256i less = _mm256_or_si256(_mm256_cmpgt_epi64(qhi, hi),
+                                           _mm256_and_si256(_mm256_cmpeq_epi64(qhi, hi), _mm256_cmpgt_epi64(qlo, lo)));
+            count += BITS[_mm256_movemask_pd(_mm256_castsi256_pd(less))];
+        }
+        for (; i < n; i++) {
+            count += headLess(i, q);
+        }
+        return count;
+#else
+        // Halve down to a short run, then scan it. Both steps branch on
+        // purpose: the predicted path lets the next node's load start before
+        // this search resolves, which beats cmov chains once nodes miss cache.
+        int lo = 0;
+        if constexpr (N > LINEAR_SCAN) {
+            while (n > LINEAR_SCAN) {
+                int half = n / 2;
+                if (headLess(lo + half - 1, q)) {
+                    lo += half;
+                    n -= half;
+                } else {
+                    n = half;
+                }
+            }
+        }
+        int end = lo + n;
+        while (lo < end && headLess(lo, q)) {
+            lo++;
+        }
+        return lo;
+#endif
+    }
+
+    void storeHead(int i, char* out) const {
+        for (int b = 0; b < 8; b++) {
+            out[b] = static_cast<char>(suffixHi[i] >> (56 - 8 * b));
+            out[8 + b] = static_cast<char>(suffixLo[i] >> (56 - 8 * b));
+        }
+    }
+
+    string_view tailOf(int i) const {
+        return suffixLen[i] > HEAD ? string_view(tails.data() + tailAt[i], suffixLen[i] - HEAD) : string_view();
+    }
+
+    void appendSuffix(int i, string& out) const {
+        char head[HEAD];
+        storeHead(i, head);
+        out.append(head, min<size_t>(suffixLen[i], HEAD));
+        string_view tail = tailOf(i);
+        out.append(tail.data(), tail.size());
+    }
+
+    void encode(int i, string_view suffix) {
+        Head h = headOf(suffix);
+        suffixHi[i] = h.hi;
+        suffixLo[i] = h.lo;
+        suffixLen[i] = static_cast<uint32_t>(suffix.size());
+        tailAt[i] = static_cast<uint32_t>(tails.size());
+        if (suffix.size() > HEAD) {
+            tails.append(suffix.data() + HEAD, suffix.size() - HEAD);
+        }
+    }
+
+    // Rewrite tails with only the bytes some slot still points at
+    void packTails() {
+        string packed;
+        for (int i = 0; i < N; i++) {
+            string_view tail = tailOf(i);
+            tailAt[i] = static_cast<uint32_t>(packed.size());
+            packed.append(tail.data(), tail.size());
+        }
+        tails.swap(packed);
+        tailLimit = 2 * tails.size() + 256;
+    }
+
+    // Shorten the shared prefix to keep bytes; every slot (live or stale)
+    // is re-encoded so it still decodes to the same key
+    void shrinkPrefix(size_t keep) {
+        vector<string> suffixes(N);
+        for (int i = 0; i < N; i++) {
+            suffixes[i].assign(prefix, keep, string::npos);
+            appendSuffix(i, suffixes[i]);
+        }
+        prefix.resize(keep);
+        tails.clear();
+        for (int i = 0; i < N; i++) {
+            encode(i, suffixes[i]);
+        }
+        tailLimit = 2 * tails.size() + 256;
+    }
+
+    // <0: query sorts before every key, >0: after every key, 0: it starts
+    // with the prefix (the suffix search decides)
+    int comparePrefix(string_view query) const {
+        if (query.size() >= prefix.size() && memcmp(query.data(), prefix.data(), prefix.size()) == 0) {
+            return 0;
+        }
+        return query.compare(0, prefix.size(), prefix) < 0 ? -1 : 1;
+    }
+
+    // Exact compare of slot i's suffix with suffix, for equal heads
+    int compareSuffix(int i, string_view suffix) const {
+        char head[HEAD];
+        storeHead(i, head);
+        int c = string_view(head, min<size_t>(suffixLen[i], HEAD)).compare(suffix.substr(0, HEAD));
+        if (c != 0 || suffix.size() <= HEAD) {
+            return c != 0 ? c : (suffixLen[i] > HEAD ? 1 : 0);
+        }
+        return tailOf(i).compare(suffix.substr(HEAD));
+    }
+
+    static size_t heapOf(const string& s) {
+        return s.capacity() > string().capacity() ? s.capacity() + 1 : 0;
+    }
+
+public:
+    using KeyRef = string;  // Keys are rebuilt from prefix + suffix
+    static constexpr size_t SLOT_BYTES = 2 * sizeof(uint64_t) + 2 * sizeof(uint32_t);
+
+    NodeKeys() : tailLimit(256) {
+        for (int i = 0; i < N; i++) {
+            suffixHi[i] = suffixLo[i] = 0;
+            suffixLen[i] = tailAt[i] = 0;
+        }
+    }
+
+    string operator[](int i) const {
+        string key;
+        key.reserve(prefix.size() + suffixLen[i]);
+        keyInto(i, key);
+        return key;
+    }
+
+    // Rebuild slot i's key into out, reusing its buffer
+    void keyInto(int i, string& out) const {
+        out.assign(prefix);
+        appendSuffix(i, out);
+    }
+
+    void set(int i, string_view key) {
+        size_t common = 0;
+        size_t limit = min(prefix.size(), key.size());
+        while (common < limit && prefix[common] == key[common]) {
+            common++;
+        }
+        if (common < prefix.size()) {
+            shrinkPrefix(common);
+        }
+        encode(i, key.substr(prefix.size()));
+        if (tails.size() > tailLimit) {
+            packTails();
+        }
+    }
+
+    string take(int i) { return (*this)[i]; }
+
+    // Move slot from into slot to (from may be in another node); within a
+    // node, or between nodes with the same prefix, the encoding is copied
+    void moveFrom(int to, NodeKeys& other, int from) {
+        if (&other != this && other.prefix != prefix) {
+            set(to, other[from]);
+            return;
+        }
+        suffixHi[to] = other.suffixHi[from];
+        suffixLo[to] = other.suffixLo[from];
+        suffixLen[to] = other.suffixLen[from];
+        if (&other == this) {
+            tailAt[to] = tailAt[from];
+            return;
+        }
+        string_view tail = other.tailOf(from);
+        tailAt[to] = static_cast<uint32_t>(tails.size());
+        tails.append(tail.data(), tail.size());
+        if (tails.size() > tailLimit) {
+            packTails();
+        }
+    }
+
+    // Re-pick the prefix as the longest one shared by the sorted keys in
+    // [0, n) and drop what slots past n held. Nodes call this once their
+    // key range has narrowed (after a split or bulk load).
+    void repack(int n) {
+        vector<string> live(n);
+        for (int i = 0; i < n; i++) {
+            live[i] = (*this)[i];
+        }
+        size_t common = 0;
+        if (n > 0) {
+            const string& first = live[0];
+            const string& last = live[n - 1];
+            size_t limit = min(first.size(), last.size());
+            while (common < limit && first[common] == last[common]) {
+                common++;
+            }
+            prefix.assign(first, 0, common);
+        } else {
+            prefix.clear();
+        }
+        tails.clear();
+        for (int i = 0; i < N; i++) {
+            encode(i, i < n ? string_view(live[i]).substr(common) : string_view());
+        }
+        tailLimit = 2 * tails.size() + 256;
+    }
+
+    template<typename Q>
+    int lowerBound(int n, const Q& key) const {
+        string_view query(key);
+        int side = comparePrefix(query);
+        if (side != 0) return side < 0 ? 0 : n;
+        string_view suffix = query.substr(prefix.size());
+        Head q = headOf(suffix);
+        int i = countHeadLess(n, q);
+        // Head ties: settle with exact compares
+        while (i < n && headEqual(i, q) && compareSuffix(i, suffix) < 0) {
+            i++;
+        }
+        return i;
+    }
+
+    template<typename Q>
+    int upperBound(int n, const Q& key) const {
+        string_view query(key);
+        int side = comparePrefix(query);
+        if (side != 0) return side < 0 ? 0 : n;
+        string_view suffix = query.substr(prefix.size());
+        Head q = headOf(suffix);
+        int i = countHeadLess(n, q);
+        while (i < n && headEqual(i, q) && compareSuffix(i, suffix) <= 0) {
+            i++;
+        }
+        return i;
+    }
+
+    // Does slot i hold key? (a head mismatch answers without the tail)
+    template<typename Q>
+    bool matches(int i, const Q& key) const {
+        string_view query(key);
+        if (comparePrefix(query) != 0) return false;
+        string_view suffix = query.substr(prefix.size());
+        return suffixLen[i] == suffix.size() && headEqual(i, headOf(suffix)) &&
+               tailOf(i) == suffix.substr(min(HEAD, suffix.size()));
+    }
+
+    // Bytes held outside the node (prefix and tails past the inline buffer)
+    size_t heapBytes(int) const { return heapOf(prefix) + heapOf(tails); }
+};
+
+#endif // NODE_KEYS_H
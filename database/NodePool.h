@@ -0,0 +1,90 @@
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+using namespace std;
+
+/**
+ * NodePool - Slab allocator for tree nodes
+ *
+ * Nodes are carved out of slabs of SLAB_NODES contiguous, pre-constructed
+ * objects, so a tree's nodes sit next to each other instead of wherever
+ * individual new calls put them. release() puts a node on a free list for
+ * the next allocate().
+ *
+ * reset() hands every node back in O(1): the slabs stay allocated and the
+ * nodes stay constructed, so a rebuilt tree reuses both the memory and any
+ * capacity its keys (e.g. std::string buffers) already had. Callers must
+ * reinitialize a node they get from allocate(). Everything is destroyed
+ * with the pool.
+ *
+ * The tree classes take the allocator as a template template parameter;
+ * HeapNodeAllocator is the plain new/delete alternative.
+ */
+template<typename T>
+class NodePool {
+private:
+    // About 64 KiB per slab, but never fewer than 8 nodes
+    static constexpr size_t SLAB_NODES = sizeof(T) * 8 > 65536 ? 8 : 65536 / sizeof(T);
+
+    vector<unique_ptr<T[]>> slabs;
+    vector<T*> freeList;  // Released nodes, reused first
+    size_t slabIndex;     // Next untouched node: slabs[slabIndex][slotIndex]
+    size_t slotIndex;
+
+public:
+    static constexpr bool BULK_RESET = true;  // reset() frees a whole tree
+
+    NodePool() : slabIndex(0), slotIndex(0) {}
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    // Get a node (recycled nodes keep their old contents)
+    T* allocate() {
+        if (!freeList.empty()) {
+            T* node = freeList.back();
+            freeList.pop_back();
+            return node;
+        }
+
+        if (slotIndex == SLAB_NODES) {
+            slabIndex++;
+            slotIndex = 0;
+        }
+        if (slabIndex == slabs.size()) {
+            slabs.emplace_back(new T[SLAB_NODES]);
+        }
+        return &slabs[slabIndex][slotIndex++];
+    }
+
+    // Return one node to the pool
+    void release(T* node) {
+        freeList.push_back(node);
+    }
+
+    // Return every node to the pool at once
+    void reset() {
+        freeList.clear();
+        slabIndex = 0;
+        slotIndex = 0;
+    }
+
+    // Nodes the pool can hand out without allocating
+    size_t capacity() const { return slabs.size() * SLAB_NODES; }
+};
+
+// One new/delete per node; the tree must release nodes individually
+template<typename T>
+struct HeapNodeAllocator {
+    static constexpr bool BULK_RESET = false;
+
+    T* allocate() { return new T(); }
+    void release(T* node) { delete node; }
+    void reset() {}
+};
+
+#endif // NODE_POOL_H
@@ -0,0 +1,635 @@
+#ifndef PAGED_BPLUS_TREE_H
+#define PAGED_BPLUS_TREE_H
+
+#include "BufferPool.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fstream>
+#include <stdexcept>
+#include <cstdint>
+#include <cstring>
+
+using namespace std;
+
+/**
+ * PagedBPlusTree - B+Tree of string keys and string records kept in a page
+ * file and cached through a BufferPool
+ *
+ * Page 0 is the file header (root, entry count, free list). Every other
+ * page is a slotted node: an 8-byte header, then a sorted array of u16 cell
+ * offsets growing forward while the cells themselves are packed backward
+ * from the end of the page.
+ *
+ *   Leaf cell:     [u16 keyLen][u8 flags][u32 valueLen][key][value]
+ *                  (a record too big for the page stores a u32 overflow
+ *                  page id in place of the value, with OVERFLOW_CELL set)
+ *   Internal cell: [u16 keyLen][u8 flags][u32 child][key]
+ *                  (the page header holds the leftmost child; cell i's child
+ *                  holds keys >= key i)
+ *
+ * Lookups binary-search the cell offsets directly in the pinned page.
+ * Writes decode the one node they change into cells, edit, and re-encode,
+ * which keeps every page compacted. Nodes split by bytes, not cell count,
+ * and a split at the right edge of the tree leaves the left page full so
+ * ascending loads (new IDs) pack pages densely.
+ *
+ * Removes never merge pages; emptied leaves stay in the leaf chain and are
+ * skipped by scans. Pages of freed overflow chains go on a free list and
+ * are reused before the file grows.
+ *
+ * Changes reach the file when the buffer pool evicts a page or on flush().
+ * There is no write-ahead log: a crash between flushes can leave a torn
+ * tree, so callers that need crash safety flush (and fsync) per commit.
+ */
+class PagedBPlusTree {
+public:
+    static const size_t DEFAULT_PAGE_SIZE = 4096;
+    static const size_t DEFAULT_CACHE_PAGES = 256;
+
+private:
+    enum PageType : uint8_t {
+        FREE_PAGE = 0,
+        LEAF_PAGE = 1,
+        INTERNAL_PAGE = 2,
+        OVERFLOW_PAGE = 3
+    };
+
+    // Node page header: type, cell count (overflow: bytes used), link
+    static const size_t TYPE_OFFSET = 0;
+    static const size_t COUNT_OFFSET = 2;
+    static const size_t LINK_OFFSET = 4;  // Leaf: next leaf, internal: leftmost child,
+                                          // overflow/free: next page in the chain
+    static const size_t PAGE_HEADER = 8;
+
+    static const size_t CELL_HEADER = 7;
+    static const uint8_t OVERFLOW_CELL = 1;
+    static const uint8_t CHILD_CELL = 2;
+
+    // File header (page 0)
+    static constexpr char MAGIC[8] = {'U', 'M', 'S', 'P', 'B', 'T', '0', '1'};
+    static const size_t HEADER_PAGE_SIZE = 8;
+    static const size_t HEADER_ROOT = 12;
+    static const size_t HEADER_COUNT = 16;
+    static const size_t HEADER_FREE_LIST = 24;
+
+    size_t pageSize;
+    PageFile file;
+    BufferPool pool;
+    PageID root;
+    uint64_t count;
+    PageID freeList;
+    bool created;  // The file was empty when opened
+
+    // ==================== Byte helpers (host byte order) ====================
+
+    static uint16_t load16(const char* p) { uint16_t v; memcpy(&v, p, 2); return v; }
+    static uint32_t load32(const char* p) { uint32_t v; memcpy(&v, p, 4); return v; }
+    static uint64_t load64(const char* p) { uint64_t v; memcpy(&v, p, 8); return v; }
+    static void store16(char* p, uint16_t v) { memcpy(p, &v, 2); }
+    static void store32(char* p, uint32_t v) { memcpy(p, &v, 4); }
+    static void store64(char* p, uint64_t v) { memcpy(p, &v, 8); }
+
+    static uint8_t pageType(const char* page) { return static_cast<uint8_t>(page[TYPE_OFFSET]); }
+    static uint16_t cellCount(const char* page) { return load16(page + COUNT_OFFSET); }
+    static PageID pageLink(const char* page) { return load32(page + LINK_OFFSET); }
+
+    static const char* cellAt(const char* page, size_t slot) {
+        return page + load16(page + PAGE_HEADER + 2 * slot);
+    }
+
+    static string_view cellKey(const char* cell) {
+        return string_view(cell + CELL_HEADER, load16(cell));
+    }
+
+    static size_t cellSize(const char* cell) {
+        uint8_t flags = static_cast<uint8_t>(cell[2]);
+        size_t payload = (flags & CHILD_CELL) ? 0 : (flags & OVERFLOW_CELL) ? 4 : load32(cell + 3);
+        return CELL_HEADER + load16(cell) + payload;
+    }
+
+    static PageID cellChild(const char* cell) { return load32(cell + 3); }
+
+    static string makeCell(string_view key, uint8_t flags, uint32_t number, string_view payload) {
+        string cell(CELL_HEADER + key.size() + payload.size(), '\0');
+        store16(&cell[0], static_cast<uint16_t>(key.size()));
+        cell[2] = static_cast<char>(flags);
+        store32(&cell[3], number);
+        memcpy(&cell[CELL_HEADER], key.data(), key.size());
+        if (!payload.empty()) {
+            memcpy(&cell[CELL_HEADER + key.size()], payload.data(), payload.size());
+        }
+        return cell;
+    }
+
+    // Largest cell allowed inline: four always fit, so a split of an
+    // overflowing page always yields two pages that fit
+    size_t maxCellSize() const { return (pageSize - PAGE_HEADER) / 4 - 2; }
+
+    // First slot whose key is >= key (or > key when UPPER)
+    template<bool UPPER>
+    static size_t searchPage(const char* page, string_view key) {
+        size_t lo = 0, hi = cellCount(page);
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            int cmp = cellKey(cellAt(page, mid)).compare(key);
+            if (UPPER ? cmp <= 0 : cmp < 0) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return lo;
+    }
+
+    static size_t searchCells(const vector<string>& cells, string_view key, bool upper) {
+        size_t lo = 0, hi = cells.size();
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            int cmp = cellKey(cells[mid].data()).compare(key);
+            if (upper ? cmp <= 0 : cmp < 0) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return lo;
+    }
+
+    // Child of an internal page that covers key
+    static PageID childFor(const char* page, string_view key, size_t& slot) {
+        slot = searchPage<true>(page, key);  // Cells before slot have keys <= key
+        return slot == 0 ? pageLink(page) : cellChild(cellAt(page, slot - 1));
+    }
+
+    // ==================== Header and page allocation ====================
+
+    static size_t storedPageSize(const string& path, size_t fallback) {
+        ifstream in(path, ios::binary);
+        char header[HEADER_ROOT];
+        if (in.read(header, sizeof(header)) && memcmp(header, MAGIC, sizeof(MAGIC)) == 0) {
+            return load32(header + HEADER_PAGE_SIZE);
+        }
+        return fallback;
+    }
+
+    void writeHeader() {
+        PageGuard header = pool.fetch(0);
+        char* p = header.data();
+        memcpy(p, MAGIC, sizeof(MAGIC));
+        store32(p + HEADER_PAGE_SIZE, static_cast<uint32_t>(pageSize));
+        store32(p + HEADER_ROOT, root);
+        store64(p + HEADER_COUNT, count);
+        store32(p + HEADER_FREE_LIST, freeList);
+        header.markDirty();
+    }
+
+    void format() {
+        root = 1;
+        count = 0;
+        freeList = INVALID_PAGE;
+        file.allocate();  // Page 0: header
+        file.allocate();  // Page 1: empty root leaf
+        writeNode(root, LEAF_PAGE, INVALID_PAGE, {});
+        writeHeader();
+        pool.flushAll();
+    }
+
+    PageID allocatePage() {
+        if (freeList == INVALID_PAGE) {
+            return file.allocate();
+        }
+        PageID id = freeList;
+        PageGuard page = pool.fetch(id);
+        freeList = pageLink(page.data());
+        return id;
+    }
+
+    void freePage(PageID id) {
+        PageGuard page = pool.fetch(id);
+        memset(page.data(), 0, pageSize);
+        page.data()[TYPE_OFFSET] = static_cast<char>(FREE_PAGE);
+        store32(page.data() + LINK_OFFSET, freeList);
+        page.markDirty();
+        freeList = id;
+    }
+
+    // ==================== Node encoding ====================
+
+    void readCells(const char* page, vector<string>& cells) {
+        size_t n = cellCount(page);
+        cells.clear();
+        cells.reserve(n + 1);
+        for (size_t i = 0; i < n; i++) {
+            const char* cell = cellAt(page, i);
+            cells.emplace_back(cell, cellSize(cell));
+        }
+    }
+
+    bool fits(const vector<string>& cells, size_t from, size_t to) const {
+        size_t used = PAGE_HEADER;
+        for (size_t i = from; i < to; i++) {
+            used += 2 + cells[i].size();
+        }
+        return used <= pageSize;
+    }
+
+    void writeNode(PageID id, PageType type, PageID link, const vector<string>& cells,
+                   size_t from = 0, size_t to = SIZE_MAX) {
+        to = min(to, cells.size());
+        PageGuard page = pool.fetch(id);
+        char* p = page.data();
+        memset(p, 0, pageSize);
+        p[TYPE_OFFSET] = static_cast<char>(type);
+        store16(p + COUNT_OFFSET, static_cast<uint16_t>(to - from));
+        store32(p + LINK_OFFSET, link);
+
+        size_t end = pageSize;
+        for (size_t i = from; i < to; i++) {
+            end -= cells[i].size();
+            memcpy(p + end, cells[i].data(), cells[i].size());
+            store16(p + PAGE_HEADER + 2 * (i - from), static_cast<uint16_t>(end));
+        }
+        page.markDirty();
+    }
+
+    // Split point that halves the bytes of cells
+    static size_t byteMiddle(const vector<string>& cells) {
+        size_t total = 0;
+        for (const auto& cell : cells) total += cell.size() + 2;
+        size_t half = 0, at = 0;
+        while (at < cells.size() - 1 && half + cells[at].size() + 2 <= total / 2) {
+            half += cells[at].size() + 2;
+            at++;
+        }
+        return max<size_t>(at, 1);
+    }
+
+    // ==================== Overflow records ====================
+
+    size_t overflowCapacity() const { return pageSize - PAGE_HEADER; }
+
+    PageID writeOverflow(string_view value) {
+        size_t chunks = (value.size() + overflowCapacity() - 1) / overflowCapacity();
+        vector<PageID> pages(chunks);
+        for (auto& id : pages) id = allocatePage();
+
+        for (size_t i = 0; i < chunks; i++) {
+            size_t offset = i * overflowCapacity();
+            size_t length = min(overflowCapacity(), value.size() - offset);
+            PageGuard page = pool.fetch(pages[i]);
+            char* p = page.data();
+            memset(p, 0, pageSize);
+            p[TYPE_OFFSET] = static_cast<char>(OVERFLOW_PAGE);
+            store16(p + COUNT_OFFSET, static_cast<uint16_t>(length));
+            store32(p + LINK_OFFSET, i + 1 < chunks ? pages[i + 1] : INVALID_PAGE);
+            memcpy(p + PAGE_HEADER, value.data() + offset, length);
+            page.markDirty();
+        }
+        return pages[0];
+    }
+
+    string readOverflow(PageID id, size_t length) {
+        string value;
+        value.reserve(length);
+        while (id != INVALID_PAGE && value.size() < length) {
+            PageGuard page = pool.fetch(id);
+            value.append(page.data() + PAGE_HEADER, cellCount(page.data()));
+            id = pageLink(page.data());
+        }
+        return value;
+    }
+
+    void freeOverflow(const char* cell) {
+        if (!(static_cast<uint8_t>(cell[2]) & OVERFLOW_CELL)) return;
+        PageID id = load32(cell + CELL_HEADER + load16(cell));
+        while (id != INVALID_PAGE) {
+            PageID next;
+            {
+                PageGuard page = pool.fetch(id);
+                next = pageLink(page.data());
+            }
+            freePage(id);
+            id = next;
+        }
+    }
+
+    string readValue(const char* cell) {
+        size_t length = load32(cell + 3);
+        const char* payload = cell + CELL_HEADER + load16(cell);
+        if (static_cast<uint8_t>(cell[2]) & OVERFLOW_CELL) {
+            return readOverflow(load32(payload), length);
+        }
+        return string(payload, length);
+    }
+
+    string makeLeafCell(string_view key, string_view value) {
+        if (CELL_HEADER + key.size() + value.size() <= maxCellSize()) {
+            return makeCell(key, 0, static_cast<uint32_t>(value.size()), value);
+        }
+        char first[4];
+        store32(first, writeOverflow(value));
+        return makeCell(key, OVERFLOW_CELL, static_cast<uint32_t>(value.size()), string_view(first, 4));
+    }
+
+    // ==================== Descent ====================
+
+    struct PathStep {
+        PageID page;
+        bool rightmost;  // On the right edge of the tree
+    };
+
+    // Root-to-leaf path for key (the leaf is last)
+    void descend(string_view key, vector<PathStep>& path) {
+        path.clear();
+        PageID id = root;
+        bool rightmost = true;
+        while (true) {
+            path.push_back({id, rightmost});
+            PageGuard page = pool.fetch(id);
+            if (pageType(page.data()) == LEAF_PAGE) return;
+            size_t slot;
+            id = childFor(page.data(), key, slot);
+            rightmost = rightmost && slot == cellCount(page.data());
+        }
+    }
+
+    PageID findLeaf(string_view key) {
+        PageID id = root;
+        while (true) {
+            PageGuard page = pool.fetch(id);
+            if (pageType(page.data()) == LEAF_PAGE) return id;
+            size_t slot;
+            id = childFor(page.data(), key, slot);
+        }
+    }
+
+    // Insert separator (key, child) into the internal node at path[level],
+    // splitting upward as far as needed
+    void insertSeparator(vector<PathStep>& path, size_t level, string key, PageID child) {
+        while (true) {
+            const PathStep& step = path[level];
+            vector<string> cells;
+            PageID leftmost;
+            {
+                PageGuard page = pool.fetch(step.page);
+                readCells(page.data(), cells);
+                leftmost = pageLink(page.data());
+            }
+            size_t pos = searchCells(cells, key, true);
+            cells.insert(cells.begin() + pos, makeCell(key, CHILD_CELL, child, string_view()));
+
+            if (fits(cells, 0, cells.size())) {
+                writeNode(step.page, INTERNAL_PAGE, leftmost, cells);
+                return;
+            }
+
+            // The middle cell moves up; its child becomes the right page's leftmost
+            size_t mid = (step.rightmost && pos == cells.size() - 1) ? cells.size() - 1 : byteMiddle(cells);
+            PageID right = allocatePage();
+            writeNode(right, INTERNAL_PAGE, cellChild(cells[mid].data()), cells, mid + 1);
+            writeNode(step.page, INTERNAL_PAGE, leftmost, cells, 0, mid);
+            key = string(cellKey(cells[mid].data()));
+            child = right;
+
+            if (level == 0) {
+                growRoot(key, child);
+                return;
+            }
+            level--;
+        }
+    }
+
+    void growRoot(const string& key, PageID right) {
+        PageID newRoot = allocatePage();
+        vector<string> cells{makeCell(key, CHILD_CELL, right, string_view())};
+        writeNode(newRoot, INTERNAL_PAGE, root, cells);
+        root = newRoot;
+    }
+
+public:
+    /**
+     * Cursor - Position in the leaf chain, in key order
+     *
+     * Pins the current leaf; it must not outlive the tree or be used
+     * across a write to it.
+     */
+    class Cursor {
+    private:
+        PagedBPlusTree* tree;
+        PageGuard leaf;
+        size_t slot;
+
+        friend class PagedBPlusTree;
+        Cursor(PagedBPlusTree* t, PageGuard page, size_t s) : tree(t), leaf(move(page)), slot(s) {
+            settle();
+        }
+
+        // Step over exhausted (or emptied) leaves
+        void settle() {
+            while (leaf.valid() && slot >= cellCount(leaf.data())) {
+                PageID next = pageLink(leaf.data());
+                slot = 0;
+                if (next == INVALID_PAGE) {
+                    leaf.release();
+                } else {
+                    leaf = tree->pool.fetch(next);
+                }
+            }
+        }
+
+    public:
+        bool valid() const { return leaf.valid(); }
+        string_view key() const { return cellKey(cellAt(leaf.data(), slot)); }
+        string value() const { return tree->readValue(cellAt(leaf.data(), slot)); }
+
+        void next() {
+            slot++;
+            settle();
+        }
+
+        // Move forward n entries without reading records; whole leaves are
+        // skipped by their cell count
+        void skip(size_t n) {
+            while (valid() && n > 0) {
+                size_t here = cellCount(leaf.data()) - slot;
+                if (n < here) {
+                    slot += n;
+                    return;
+                }
+                n -= here;
+                slot = cellCount(leaf.data());
+                settle();
+            }
+        }
+    };
+
+    PagedBPlusTree(const string& path, size_t requestedPageSize = DEFAULT_PAGE_SIZE,
+                   size_t cachePages = DEFAULT_CACHE_PAGES)
+        : pageSize(storedPageSize(path, requestedPageSize)),
+          file(path, pageSize),
+          pool(file, cachePages),
+          root(INVALID_PAGE), count(0), freeList(INVALID_PAGE), created(false) {
+        if (pageSize < 1024 || pageSize > 32768 || (pageSize & (pageSize - 1)) != 0) {
+            throw invalid_argument("PagedBPlusTree: page size must be a power of two in [1 KiB, 32 KiB]");
+        }
+        if (file.numPages() == 0) {
+            format();
+            created = true;
+            return;
+        }
+
+        PageGuard header = pool.fetch(0);
+        if (memcmp(header.data(), MAGIC, sizeof(MAGIC)) != 0) {
+            throw runtime_error("PagedBPlusTree: " + path + " is not a paged B+Tree file");
+        }
+        root = load32(header.data() + HEADER_ROOT);
+        count = load64(header.data() + HEADER_COUNT);
+        freeList = load32(header.data() + HEADER_FREE_LIST);
+    }
+
+    PagedBPlusTree(const PagedBPlusTree&) = delete;
+    PagedBPlusTree& operator=(const PagedBPlusTree&) = delete;
+
+    ~PagedBPlusTree() { flush(); }
+
+    // Longest key insert() accepts (an internal or overflow cell must fit)
+    size_t maxKeySize() const { return maxCellSize() - CELL_HEADER - 4; }
+
+    bool get(string_view key, string& value) {
+        PageGuard leaf = pool.fetch(findLeaf(key));
+        size_t slot = searchPage<false>(leaf.data(), key);
+        if (slot == cellCount(leaf.data()) || cellKey(cellAt(leaf.data(), slot)) != key) {
+            return false;
+        }
+        value = readValue(cellAt(leaf.data(), slot));
+        return true;
+    }
+
+    bool contains(string_view key) {
+        PageGuard leaf = pool.fetch(findLeaf(key));
+        size_t slot = searchPage<false>(leaf.data(), key);
+        return slot < cellCount(leaf.data()) && cellKey(cellAt(leaf.data(), slot)) == key;
+    }
+
+    // Insert or replace; false only if the key is too long
+    bool insert(string_view key, string_view value) {
+        if (key.size() > maxKeySize()) {
+            return false;
+        }
+
+        vector<PathStep> path;
+        descend(key, path);
+        const PathStep& leafStep = path.back();
+
+        vector<string> cells;
+        PageID next;
+        {
+            PageGuard leaf = pool.fetch(leafStep.page);
+            readCells(leaf.data(), cells);
+            next = pageLink(leaf.data());
+        }
+
+        size_t pos = searchCells(cells, key, false);
+        string cell = makeLeafCell(key, value);
+        if (pos < cells.size() && cellKey(cells[pos].data()) == key) {
+            freeOverflow(cells[pos].data());
+            cells[pos] = move(cell);
+        } else {
+            cells.insert(cells.begin() + pos, move(cell));
+            count++;
+        }
+
+        if (fits(cells, 0, cells.size())) {
+            writeNode(leafStep.page, LEAF_PAGE, next, cells);
+        } else {
+            // Appending at the right edge: keep the full page, start a new one
+            size_t split = (leafStep.rightmost && pos == cells.size() - 1) ? cells.size() - 1 : byteMiddle(cells);
+            PageID right = allocatePage();
+            writeNode(right, LEAF_PAGE, next, cells, split);
+            writeNode(leafStep.page, LEAF_PAGE, right, cells, 0, split);
+            string separator(cellKey(cells[split].data()));
+            if (path.size() == 1) {
+                growRoot(separator, right);
+            } else {
+                insertSeparator(path, path.size() - 2, separator, right);
+            }
+        }
+
+        writeHeader();
+        return true;
+    }
+
+    bool remove(string_view key) {
+        PageID leafId = findLeaf(key);
+        vector<string> cells;
+        PageID next;
+        {
+            PageGuard leaf = pool.fetch(leafId);
+            readCells(leaf.data(), cells);
+            next = pageLink(leaf.data());
+        }
+
+        size_t pos = searchCells(cells, key, false);
+        if (pos == cells.size() || cellKey(cells[pos].data()) != key) {
+            return false;
+        }
+        freeOverflow(cells[pos].data());
+        cells.erase(cells.begin() + pos);
+        writeNode(leafId, LEAF_PAGE, next, cells);
+        count--;
+        writeHeader();
+        return true;
+    }
+
+    Cursor begin() {
+        PageID id = root;
+        while (true) {
+            PageGuard page = pool.fetch(id);
+            if (pageType(page.data()) == LEAF_PAGE) {
+                return Cursor(this, move(page), 0);
+            }
+            id = pageLink(page.data());
+        }
+    }
+
+    // First entry with key >= key
+    Cursor lowerBound(string_view key) {
+        PageGuard leaf = pool.fetch(findLeaf(key));
+        size_t slot = searchPage<false>(leaf.data(), key);
+        return Cursor(this, move(leaf), slot);
+    }
+
+    // First entry with key > key
+    Cursor upperBound(string_view key) {
+        PageGuard leaf = pool.fetch(findLeaf(key));
+        size_t slot = searchPage<true>(leaf.data(), key);
+        return Cursor(this, move(leaf), slot);
+    }
+
+    size_t size() const { return count; }
+    bool isEmpty() const { return count == 0; }
+
+    // True if this open created the file
+    bool wasCreated() const { return created; }
+
+    // Drop every entry and shrink the file back to an empty tree
+    void clear() {
+        pool.discardAll();
+        file.truncate();
+        format();
+    }
+
+    // Write dirty pages back to the file
+    void flush() {
+        writeHeader();
+        pool.flushAll();
+    }
+
+    const string& getPath() const { return file.getPath(); }
+    size_t getPageSize() const { return pageSize; }
+    size_t getPageCount() const { return file.numPages(); }
+    const BufferPool& getBufferPool() const { return pool; }
+};
+
+#endif // PAGED_BPLUS_TREE_H
@@ -0,0 +1,291 @@
+#ifndef PAGED_STORAGE_H
+#define PAGED_STORAGE_H
+
+#include "PagedBPlusTree.h"
+#include "DataModels.h"
+#include "Durability.h"
+#include "EntityCodec.h"
+#include "Logger.h"
+#include <fstream>
+#include <string_view>
+
+using namespace std;
+
+/**
+ * PagedStorage - On-disk storage backend with the IndexedStorage interface
+ *
+ * Records live inline in the leaves of a PagedBPlusTree (baseName.db),
+ * keyed by ID, so there is no separate data file and no index to rebuild:
+ * opening a store reads one header page, and only the pages a request
+ * touches are cached (cachePages * pageSize bytes at most). Data sets
+ * larger than RAM work; a lookup costs one page read per tree level on a
+ * cold cache.
+ *
+ * An existing baseName.dat (IndexedStorage's text file) is imported once
+ * when baseName.db is first created.
+ *
+ * The tree keeps no subtree counts, so getPage(offset) walks the leaf
+ * chain to the offset (skipping whole leaves by cell count, without
+ * reading records); getPageAfter() starts with one descent and is the
+ * cursor to prefer for deep pages.
+ */
+template<typename T>
+class PagedStorage {
+private:
+    PagedBPlusTree tree;                  // ID -> serialized entity
+    string dbFilename;
+    FileSyncer syncer;                    // fsync policy for dbFilename
+
+    // Import baseName.dat into a freshly created tree
+    void importTextFile(const string& dataFilename);
+
+    // Apply the durability policy after a write: dirty pages reach the
+    // file, then the syncer decides whether to fsync
+    void commit();
+
+    static bool decode(const string& record, T& entity);
+
+public:
+    PagedStorage(const string& baseName,
+                 size_t pageSize = PagedBPlusTree::DEFAULT_PAGE_SIZE,
+                 size_t cachePages = PagedBPlusTree::DEFAULT_CACHE_PAGES);
+    ~PagedStorage();
+
+    // Core operations
+    bool add(const T& entity);
+
+    // Add many entities (for migrations/imports). Entities whose ID is
+    // empty or already stored are skipped; returns the number added.
+    size_t addAll(const vector<T>& entities);
+
+    bool get(string_view id, T& entity);
+    bool update(const T& entity);
+    bool remove(const string& id);
+    bool exists(string_view id);
+
+    // Get all entities (sorted by ID)
+    vector<T> getAll();
+
+    // One page of entities in ID order: by position, or after the last ID
+    // of the previous page
+    vector<T> getPage(size_t offset, size_t limit);
+    vector<T> getPageAfter(string_view afterID, size_t limit);
+
+    size_t size() const { return tree.size(); }
+
+    // Durability (fsync) policy for the page file
+    void setDurability(const DurabilityPolicy& policy) { syncer.setPolicy(policy); }
+    const DurabilityPolicy& getDurability() const { return syncer.getPolicy(); }
+
+    // Persistence
+    void save();
+    void load();
+    void clear();
+    
+    // Every record, one serialized entity per line (for SharedSnapshot)
+    string exportLines();
+};
+
+// ==================== Implementation ====================
+
+template<typename T>
+PagedStorage<T>::PagedStorage(const string& baseName, size_t pageSize, size_t cachePages)
+    : tree(baseName + ".db", pageSize, cachePages),
+      dbFilename(baseName + ".db"),
+      syncer(baseName + ".db") {
+
+    LOG_INFO("PagedStorage") << "Opened " << dbFilename << ": " << tree.size() << " entities, "
+                             << tree.getPageCount() << " pages of " << tree.getPageSize() << " bytes";
+
+    if (tree.wasCreated()) {
+        importTextFile(baseName + ".dat");
+    }
+}
+
+template<typename T>
+PagedStorage<T>::~PagedStorage() {
+    save();  // Auto-save on destruction
+}
+
+template<typename T>
+void PagedStorage<T>::importTextFile(const string& dataFilename) {
+    ifstream dataFile(dataFilename);
+    if (!dataFile.is_open()) {
+        return;
+    }
+
+    size_t lineNum = 0;
+    size_t successCount = 0;
+    size_t failCount = 0;
+    string line;
+    while (getline(dataFile, line)) {
+        if (!line.empty()) {
+            try {
+                T entity = EntityCodec::deserialize<T>(line);
+                const auto& id = EntityCodec::id(entity);
+                if (id.empty() || !tree.insert(id, line)) {
+                    failCount++;
+                } else {
+                    successCount++;
+                }
+            } catch (const exception& e) {
+                LOG_ERROR("PagedStorage") << "Error deserializing line " << lineNum << ": " << e.what();
+                failCount++;
+            }
+        }
+        lineNum++;
+    }
+
+    tree.flush();
+    syncFile(dbFilename);
+    LOG_INFO("PagedStorage") << "Imported " << successCount << " entities from " << dataFilename
+                             << " (failed: " << failCount << ")";
+}
+
+template<typename T>
+void PagedStorage<T>::commit() {
+    if (syncer.getPolicy().mode != DurabilityMode::NONE) {
+        tree.flush();
+        syncer.onCommit();
+    }
+}
+
+template<typename T>
+bool PagedStorage<T>::decode(const string& record, T& entity) {
+    try {
+        entity = EntityCodec::deserialize<T>(record);
+        return true;
+    } catch (const exception& e) {
+        LOG_ERROR("PagedStorage") << "Error deserializing record: " << e.what();
+        return false;
+    }
+}
+
+template<typename T>
+bool PagedStorage<T>::add(const T& entity) {
+    const auto& id = EntityCodec::id(entity);
+    if (!tree.insert(id, EntityCodec::serialize(entity))) {
+        LOG_ERROR("PagedStorage") << "ID too long for a page: " << id;
+        return false;
+    }
+    commit();
+    return true;
+}
+
+template<typename T>
+size_t PagedStorage<T>::addAll(const vector<T>& entities) {
+    size_t added = 0;
+    for (const T& entity : entities) {
+        const auto& id = EntityCodec::id(entity);
+        if (id.empty() || tree.contains(id)) {
+            continue;
+        }
+        if (tree.insert(id, EntityCodec::serialize(entity))) {
+            added++;
+        }
+    }
+    if (added > 0) {
+        commit();  // One commit for the whole batch
+    }
+    return added;
+}
+
+template<typename T>
+bool PagedStorage<T>::get(string_view id, T& entity) {
+    string record;
+    return tree.get(id, record) && decode(record, entity);
+}
+
+template<typename T>
+bool PagedStorage<T>::update(const T& entity) {
+    const auto& id = EntityCodec::id(entity);
+    if (!tree.contains(id)) {
+        return false;
+    }
+    tree.insert(id, EntityCodec::serialize(entity));
+    commit();
+    return true;
+}
+
+template<typename T>
+bool PagedStorage<T>::remove(const string& id) {
+    if (!tree.remove(id)) {
+        return false;
+    }
+    commit();
+    return true;
+}
+
+template<typename T>
+bool PagedStorage<T>::exists(string_view id) {
+    return tree.contains(id);
+}
+
+template<typename T>
+vector<T> PagedStorage<T>::getAll() {
+    vector<T> results;
+    results.reserve(tree.size());
+    for (auto cursor = tree.begin(); cursor.valid(); cursor.next()) {
+        T entity;
+        if (decode(cursor.value(), entity)) {
+            results.push_back(move(entity));
+        }
+    }
+    return results;
+}
+
+template<typename T>
+vector<T> PagedStorage<T>::getPage(size_t offset, size_t limit) {
+    vector<T> results;
+    auto cursor = tree.begin();
+    cursor.skip(offset);
+    for (; cursor.valid() && results.size() < limit; cursor.next()) {
+        T entity;
+        if (decode(cursor.value(), entity)) {
+            results.push_back(move(entity));
+        }
+    }
+    return results;
+}
+
+template<typename T>
+vector<T> PagedStorage<T>::getPageAfter(string_view afterID, size_t limit) {
+    vector<T> results;
+    auto cursor = afterID.empty() ? tree.begin() : tree.upperBound(afterID);
+    for (; cursor.valid() && results.size() < limit; cursor.next()) {
+        T entity;
+        if (decode(cursor.value(), entity)) {
+            results.push_back(move(entity));
+        }
+    }
+    return results;
+}
+
+template<typename T>
+void PagedStorage<T>::save() {
+    tree.flush();
+    syncer.flush();
+}
+
+template<typename T>
+void PagedStorage<T>::load() {
+    // Pages are read on demand through the buffer pool, nothing to do here
+}
+
+template<typename T>
+void PagedStorage<T>::clear() {
+    tree.clear();
+}
+
+template<typename T>
+string PagedStorage<T>::exportLines() {
+    // Records are stored serialized: no decode/encode round trip
+    string lines;
+    for (auto cursor = tree.begin(); cursor.valid(); cursor.next()) {
+        lines += cursor.value();
+        lines += '\n';
+    }
+    return lines;
+}
+
+#endif // PAGED_STORAGE_H
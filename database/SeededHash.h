@@ -0,0 +1,157 @@
+#ifndef SEEDED_HASH_H
+#define SEEDED_HASH_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <random>
+#include <type_traits>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+using namespace std;
+
+/**
+ * SeededHash - Fast seeded 64-bit hash policy for HashTable / FlatHashTable
+ *
+ * Strings are hashed with wyhash (final version 4, public domain, Wang Yi):
+ * 8/16-byte reads folded through 64x64->128 multiplies. Every output bit
+ * depends on every input bit, so tables using this policy index buckets
+ * with a power-of-two mask instead of a prime modulus.
+ *
+ * The default seed is drawn once per process from random_device, so bucket
+ * placement can't be predicted from outside (crafted colliding IDs). Pass an
+ * explicit seed for reproducible layouts in tests and benchmarks.
+ */
+
+namespace wyhash_detail {
+
+inline constexpr uint64_t SECRET[4] = {
+    0xa0761d6478bd642fULL, 0xe7037ed1a0b428dbULL,
+    0x8ebc6af09c88c6e3ULL, 0x589965cc75374cc3ULL
+};
+
+// 64x64 -> 128 multiply; A gets the low half, B the high half
+inline void mum(uint64_t* A, uint64_t* B) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = *A;
+    r *= *B;
+    *A = static_cast<uint64_t>(r);
+    *B = static_cast<uint64_t>(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    *A = _umul128(*A, *B, B);
+#else
+    uint64_t ha = *A >> 32, hb = *B >> 32, la = static_cast<uint32_t>(*A), lb = static_cast<uint32_t>(*B);
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32), c = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+    *A = lo;
+    *B = hi;
+#endif
+}
+
+inline uint64_t mix(uint64_t A, uint64_t B) {
+    mum(&A, &B);
+    return A ^ B;
+}
+
+// Little-endian reads (byte order only changes the hash values, not quality)
+inline uint64_t read8(const uint8_t* p) { uint64_t v; memcpy(&v, p, 8); return v; }
+inline uint64_t read4(const uint8_t* p) { uint32_t v; memcpy(&v, p, 4); return v; }
+inline uint64_t read3(const uint8_t* p, size_t k) {
+    return (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[k >> 1]) << 8) | p[k - 1];
+}
+
+inline uint64_t hash(const void* key, size_t len, uint64_t seed) {
+    const uint8_t* p = static_cast<const uint8_t*>(key);
+    seed ^= mix(seed ^ SECRET[0], SECRET[1]);
+    uint64_t a, b;
+
+    if (len <= 16) {
+        if (len >= 4) {
+            a = (read4(p) << 32) | read4(p + ((len >> 3) << 2));
+            b = (read4(p + len - 4) << 32) | read4(p + len - 4 - ((len >> 3) << 2));
+        } else if (len > 0) {
+            a = read3(p, len);
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t i = len;
+        if (i > 48) {
+            uint64_t see1 = seed, see2 = seed;
+            do {
+                seed = mix(read8(p) ^ SECRET[1], read8(p + 8) ^ seed);
+                see1 = mix(read8(p + 16) ^ SECRET[2], read8(p + 24) ^ see1);
+                see2 = mix(read8(p + 32) ^ SECRET[3], read8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = mix(read8(p) ^ SECRET[1], read8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = read8(p + i - 16);
+        b = read8(p + i - 8);
+    }
+
+    a ^= SECRET[1];
+    b ^= seed;
+    mum(&a, &b);
+    return mix(a ^ SECRET[0] ^ len, b ^ SECRET[1]);
+}
+
+} // namespace wyhash_detail
+
+// Per-process random seed shared by default-constructed SeededHash objects
+inline uint64_t defaultHashSeed() {
+    static const uint64_t seed = []() {
+        random_device rd;
+        return (static_cast<uint64_t>(rd()) << 32) ^ rd();
+    }();
+    return seed;
+}
+
+// Integral keys: one multiply-fold of key ^ seed
+template<typename K>
+struct SeededHash {
+    static_assert(is_integral_v<K>, "SeededHash supports integral and string keys");
+
+    using is_avalanching = void;  // Low bits are well mixed: mask, don't mod
+
+    uint64_t seed;
+
+    SeededHash() : seed(defaultHashSeed()) {}
+    explicit SeededHash(uint64_t s) : seed(s) {}
+
+    size_t operator()(K key) const {
+        return static_cast<size_t>(wyhash_detail::mix(static_cast<uint64_t>(key) ^ seed,
+                                                      wyhash_detail::SECRET[1]));
+    }
+};
+
+template<>
+struct SeededHash<string> {
+    using is_transparent = void;
+    using is_avalanching = void;
+
+    uint64_t seed;
+
+    SeededHash() : seed(defaultHashSeed()) {}
+    explicit SeededHash(uint64_t s) : seed(s) {}
+
+    size_t operator()(string_view key) const {
+        return static_cast<size_t>(wyhash_detail::hash(key.data(), key.size(), seed));
+    }
+};
+
+#endif // SEEDED_HASH_H
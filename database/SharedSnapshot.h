@@ -0,0 +1,289 @@
+#ifndef SHARED_SNAPSHOT_H
+#define SHARED_SNAPSHOT_H
+
+#ifdef __linux__
+
+#include "DatabaseManager.h"
+#include "Logger.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <array>
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * SharedSnapshot - Publishes one process's database to read replicas in others
+ *
+ * The writer process calls publish() after each write request. Sections
+ * (stores, and the config) whose DatabaseManager generation hasn't moved
+ * since the last call are skipped without being exported, so a request
+ * that wrote nothing costs a few atomic loads. Each changed section is
+ * written to its own file named by the new generation
+ * (<dataDir>/snapshot.<section>.<generation>, temp file + atomic rename);
+ * then a small manifest (<dataDir>/snapshot.bin) listing every section's
+ * current file, and last the generation in a control block that every
+ * process maps shared (<dataDir>/snapshot.ctl).
+ *
+ * Readers call refresh() before serving: normally one atomic load of the
+ * control block. When the generation has moved they read the manifest, map
+ * the files of the sections that differ from what their replica
+ * DatabaseManager holds, and hand them over together with the previous
+ * mapping of each, so the replica writes only the records that changed. A
+ * writer publishes before it answers, so a client that wrote through one
+ * process reads its write from any.
+ *
+ * Section files are never rewritten, only replaced by newer ones. The writer
+ * deletes a section's older file once a newer manifest is in place; a reader
+ * still holding the old manifest then fails to open it and simply tries
+ * again on its next refresh.
+ */
+class SharedSnapshot {
+public:
+    explicit SharedSnapshot(const string& dataDir)
+        : dataDir(dataDir),
+          snapshotPath(dataDir + "/snapshot.bin"),
+          tempPath(dataDir + "/snapshot.tmp." + to_string(getpid())) {
+        exportedAt.fill(NOT_EXPORTED);
+        fs::create_directories(dataDir);
+        string controlPath = dataDir + "/snapshot.ctl";
+        int fd = ::open(controlPath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd >= 0 && ftruncate(fd, sizeof(Control)) == 0) {
+            void* mapped = mmap(nullptr, sizeof(Control), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (mapped != MAP_FAILED) {
+                control = static_cast<Control*>(mapped);
+            }
+        }
+        if (fd >= 0) ::close(fd);
+        if (control == nullptr) {
+            LOG_ERROR("SharedSnapshot") << "Cannot map " << controlPath;
+        }
+    }
+
+    SharedSnapshot(const SharedSnapshot&) = delete;
+    SharedSnapshot& operator=(const SharedSnapshot&) = delete;
+
+    ~SharedSnapshot() {
+        for (Mapping& section : loaded) section.unmap();
+        if (control != nullptr) munmap(control, sizeof(Control));
+    }
+
+    bool isOpen() const { return control != nullptr; }
+
+    // Last published generation (0 = nothing published yet)
+    uint64_t generation() const {
+        return control != nullptr ? control->generation.load(memory_order_acquire) : 0;
+    }
+
+    // Forget earlier publications (a fresh start of the writer and readers)
+    void reset() {
+        if (control != nullptr) control->generation.store(0, memory_order_release);
+    }
+
+    // Writer: publish the sections that changed since the last call;
+    // returns the current generation (0 on failure)
+    uint64_t publish(DatabaseManager& db);
+
+    // Reader: bring the replica up to the published generation; returns
+    // the number of sections imported (0 when already current)
+    size_t refresh(DatabaseManager& replica);
+
+private:
+    struct Control {
+        atomic<uint64_t> generation;
+    };
+    static_assert(atomic<uint64_t>::is_always_lock_free, "Control is shared between processes");
+
+    static constexpr uint64_t MAGIC = 0x32534d5550414e53ull;  // "SNAPUMS2"
+    static constexpr uint64_t NOT_EXPORTED = ~0ull;
+
+    // The manifest: the file of section i is snapshot.<i>.<sectionGeneration[i]>
+    struct Header {
+        uint64_t magic;
+        uint64_t generation;
+        uint64_t sectionGeneration[SNAPSHOT_SECTIONS];
+        uint64_t sectionLength[SNAPSHOT_SECTIONS];
+    };
+
+    // A read-only mapping of one section file (none for an empty file)
+    struct Mapping {
+        void* data = nullptr;
+        size_t size = 0;
+
+        string_view view() const { return string_view(static_cast<const char*>(data), size); }
+
+        void unmap() {
+            if (data != nullptr) munmap(data, size);
+            data = nullptr;
+            size = 0;
+        }
+    };
+
+    string dataDir;
+    string snapshotPath;
+    string tempPath;
+    Control* control = nullptr;
+    mutex m;  // One publish/refresh at a time within this process
+
+    // Writer state: the last manifest, and the DatabaseManager generation
+    // each section had when it was exported
+    Header published{};
+    array<uint64_t, SNAPSHOT_SECTIONS> exportedAt;
+
+    // Reader state: generation and mapping of each section in the replica
+    atomic<uint64_t> loadedGeneration{0};
+    array<uint64_t, SNAPSHOT_SECTIONS> loadedAt{};
+    array<Mapping, SNAPSHOT_SECTIONS> loaded;
+
+    string sectionPath(size_t section, uint64_t generation) const {
+        return dataDir + "/snapshot." + to_string(section) + "." + to_string(generation);
+    }
+
+    bool writeFile(const string& path, const void* data, size_t size);
+
+    // Section files other than the ones header names (earlier writers')
+    void removeStaleSections(const Header& header);
+};
+
+// ==================== Implementation ====================
+
+inline uint64_t SharedSnapshot::publish(DatabaseManager& db) {
+    if (control == nullptr) return 0;
+    lock_guard<mutex> lock(m);
+
+    uint64_t current = control->generation.load(memory_order_acquire);
+    bool moved = false;
+    for (size_t i = 0; i < SNAPSHOT_SECTIONS; i++) {
+        moved = moved || db.sectionGeneration(i) != exportedAt[i];
+    }
+    if (!moved) return current;  // Read-only request or failed write
+
+    array<uint64_t, SNAPSHOT_SECTIONS> seen = exportedAt;
+    vector<pair<size_t, string>> sections = db.exportSnapshot(seen);
+    uint64_t next = current + 1;
+    Header header = published;
+    header.magic = MAGIC;
+    header.generation = next;
+    for (const auto& [index, lines] : sections) {
+        // On failure exportedAt is unchanged: these sections go out next time
+        if (!writeFile(sectionPath(index, next), lines.data(), lines.size())) return 0;
+        header.sectionGeneration[index] = next;
+        header.sectionLength[index] = lines.size();
+    }
+    if (!writeFile(snapshotPath, &header, sizeof(header))) return 0;
+    control->generation.store(next, memory_order_release);
+
+    if (published.magic != MAGIC) {
+        removeStaleSections(header);  // First publication of this writer
+    } else {
+        for (const auto& section : sections) {
+            ::unlink(sectionPath(section.first, published.sectionGeneration[section.first]).c_str());
+        }
+    }
+    published = header;
+    exportedAt = seen;
+    return next;
+}
+
+inline bool SharedSnapshot::writeFile(const string& path, const void* data, size_t size) {
+    FILE* out = fopen(tempPath.c_str(), "wb");
+    if (out == nullptr) {
+        LOG_ERROR("SharedSnapshot") << "Cannot write " << tempPath;
+        return false;
+    }
+    bool ok = size == 0 || fwrite(data, 1, size, out) == size;
+    ok = fclose(out) == 0 && ok;
+    // Readers open the new file or the old one, never a partial write
+    if (!ok || rename(tempPath.c_str(), path.c_str()) != 0) {
+        LOG_ERROR("SharedSnapshot") << "Failed to publish " << path;
+        remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+inline void SharedSnapshot::removeStaleSections(const Header& header) {
+    error_code ec;
+    for (const auto& entry : fs::directory_iterator(dataDir, ec)) {
+        string name = entry.path().filename().string();
+        size_t section = 0;
+        uint64_t generation = 0;
+        char end = 0;
+        if (sscanf(name.c_str(), "snapshot.%zu.%" SCNu64 "%c", &section, &generation, &end) == 2 &&
+            (section >= SNAPSHOT_SECTIONS || header.sectionGeneration[section] != generation)) {
+            fs::remove(entry.path(), ec);
+        }
+    }
+}
+
+inline size_t SharedSnapshot::refresh(DatabaseManager& replica) {
+    uint64_t current = generation();
+    if (current == 0 || current == loadedGeneration.load(memory_order_relaxed)) {
+        return 0;
+    }
+    lock_guard<mutex> lock(m);
+    if (generation() == loadedGeneration.load(memory_order_relaxed)) return 0;
+
+    Header header;
+    int fd = ::open(snapshotPath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return 0;
+    bool complete = ::read(fd, &header, sizeof(header)) == static_cast<ssize_t>(sizeof(header));
+    ::close(fd);
+    if (!complete || header.magic != MAGIC) {
+        LOG_ERROR("SharedSnapshot") << "Ignoring malformed " << snapshotPath;
+        return 0;
+    }
+
+    // Map every changed section before importing any, so the replica never
+    // mixes sections of two publications
+    vector<pair<size_t, Mapping>> mapped;
+    bool ok = true;
+    for (size_t i = 0; i < SNAPSHOT_SECTIONS && ok; i++) {
+        if (header.sectionGeneration[i] == loadedAt[i]) continue;
+        Mapping section;
+        fd = ::open(sectionPath(i, header.sectionGeneration[i]).c_str(), O_RDONLY | O_CLOEXEC);
+        struct stat st;
+        ok = fd >= 0 && fstat(fd, &st) == 0 && static_cast<uint64_t>(st.st_size) == header.sectionLength[i];
+        if (ok && st.st_size > 0) {
+            section.size = st.st_size;
+            section.data = mmap(nullptr, section.size, PROT_READ, MAP_PRIVATE, fd, 0);
+            ok = section.data != MAP_FAILED;
+            if (!ok) section.data = nullptr;
+        }
+        if (fd >= 0) ::close(fd);
+        if (ok) mapped.emplace_back(i, section);
+    }
+    if (!ok) {
+        // Replaced by a newer publication meanwhile: retry on the next refresh
+        for (auto& section : mapped) section.second.unmap();
+        return 0;
+    }
+
+    vector<SnapshotSection> changed;
+    for (const auto& [index, section] : mapped) {
+        optional<string_view> previous;
+        if (loadedAt[index] != 0) previous = loaded[index].view();
+        changed.push_back(SnapshotSection{index, section.view(), previous});
+    }
+    replica.importSnapshot(changed);  // Views into the mappings
+    for (auto& [index, section] : mapped) {
+        loaded[index].unmap();
+        loaded[index] = section;
+        loadedAt[index] = header.sectionGeneration[index];
+    }
+    loadedGeneration.store(header.generation, memory_order_relaxed);
+    return changed.size();
+}
+
+#endif // __linux__
+
+#endif // SHARED_SNAPSHOT_H
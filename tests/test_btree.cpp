@@ -0,0 +1,487 @@
+#undef NDEBUG  // Checks must run in Release builds too
+#include <iostream>
+#include <cassert>
+#include <map>
+#include <random>
+#include <string>
+#include <string_view>
+#include <algorithm>
+#include "../database/BTree.h"
+#include "../database/BPlusTree.h"
+
+using namespace std;
+
+// Ordered-index checks for BTree and BPlusTree: randomized operations
+// against std::map at several orders, bulk loading, plus B+Tree iteration,
+// ranges and order statistics.
+
+string studentID(int i) {
+    string roll = to_string(i % 1000);
+    return "BSCS" + to_string(18 + i / 1000) + string(3 - roll.size(), '0') + roll;
+}
+
+// Users-store keys: mostly student emails sharing long prefixes, some
+// staff emails, and some past 16 bytes of suffix under any node prefix
+string emailKey(int i) {
+    if (i % 7 == 0) return "staff" + to_string(i) + "@itu.edu.pk";
+    if (i % 11 == 0) return "student.with.a.long.name." + to_string(i) + "@alumni.itu.edu.pk";
+    string id = studentID(i);
+    transform(id.begin(), id.end(), id.begin(), ::tolower);
+    return id + "@itu.edu.pk";
+}
+
+template<typename Tree>
+void checkAgainstMap(Tree& tree, map<string, size_t>& expected) {
+    auto pairs = tree.getAllPairs();
+    assert(pairs.size() == expected.size());
+    size_t i = 0;
+    for (const auto& entry : expected) {
+        assert(pairs[i].first == entry.first);
+        assert(pairs[i].second == entry.second);
+        i++;
+    }
+}
+
+// Random inserts, updates and removes over a small key space so every
+// split, borrow and merge path runs many times
+template<typename Tree>
+void randomOperations(const string& name, string (*keyOf)(int) = studentID) {
+    Tree tree;
+    map<string, size_t> expected;
+    mt19937 rng(42);
+
+    for (int step = 0; step < 20000; step++) {
+        string key = keyOf(rng() % 3000);
+        size_t value = rng();
+        if (rng() % 3 == 0) {
+            tree.remove(key);
+            expected.erase(key);
+        } else {
+            tree.insert(key, value);
+            expected[key] = value;
+        }
+
+        if (step % 997 == 0) {
+            checkAgainstMap(tree, expected);
+        }
+    }
+    checkAgainstMap(tree, expected);
+
+    for (int i = 0; i < 3000; i++) {
+        string key = keyOf(i);
+        size_t* found = tree.search(key);
+        auto it = expected.find(key);
+        assert((found != nullptr) == (it != expected.end()));
+        if (found != nullptr) {
+            assert(*found == it->second);
+        }
+    }
+
+    // Drain completely
+    for (const auto& entry : map<string, size_t>(expected)) {
+        tree.remove(entry.first);
+    }
+    assert(tree.isEmpty());
+    assert(tree.getAllPairs().empty());
+    cout << "[PASS] " << name << " matches std::map" << endl;
+}
+
+void testBTreeOrders() {
+    cout << "\n=== Testing BTree Orders ===" << endl;
+
+    randomOperations<BTree<string, size_t, 4>>("BTree order 4");
+    randomOperations<BTree<string, size_t, 5>>("BTree order 5");
+    randomOperations<BTree<string, size_t, 16>>("BTree order 16");
+    randomOperations<BTree<string, size_t>>("BTree default order");
+    randomOperations<BTree<string, size_t, 5, HeapNodeAllocator>>("BTree order 5 (heap nodes)");
+}
+
+void testBPlusTreeOrders() {
+    cout << "\n=== Testing BPlusTree Orders ===" << endl;
+
+    randomOperations<BPlusTree<string, size_t, 4>>("BPlusTree order 4");
+    randomOperations<BPlusTree<string, size_t, 5>>("BPlusTree order 5");
+    randomOperations<BPlusTree<string, size_t, 16>>("BPlusTree order 16");
+    randomOperations<BPlusTree<string, size_t>>("BPlusTree default order");
+    randomOperations<BPlusTree<string, size_t, 5, HeapNodeAllocator>>("BPlusTree order 5 (heap nodes)");
+}
+
+// Email keys: node prefixes shrink as unrelated keys arrive, and long
+// suffixes keep bytes in each node's tails buffer
+void testPrefixCompressedTrees() {
+    cout << "\n=== Testing Prefix-Compressed Keys ===" << endl;
+
+    randomOperations<BTree<string, size_t, 4>>("BTree order 4, email keys", emailKey);
+    randomOperations<BTree<string, size_t>>("BTree default order, email keys", emailKey);
+    randomOperations<BPlusTree<string, size_t, 4>>("BPlusTree order 4, email keys", emailKey);
+    randomOperations<BPlusTree<string, size_t, 16>>("BPlusTree order 16, email keys", emailKey);
+    randomOperations<BPlusTree<string, size_t>>("BPlusTree default order, email keys", emailKey);
+
+    // Iteration and bounds rebuild whole keys
+    BPlusTree<string, size_t, 8> tree;
+    map<string, size_t> expected;
+    for (int i = 0; i < 3000; i++) {
+        tree.insert(emailKey(i), static_cast<size_t>(i));
+        expected[emailKey(i)] = static_cast<size_t>(i);
+    }
+    auto it = tree.begin();
+    const string* buffer = &it.key();
+    for (const auto& entry : expected) {
+        assert(it.key() == entry.first && it.value() == entry.second);
+        assert(&it.key() == buffer);  // Rebuilt in place, not copied out per entry
+        ++it;
+    }
+    assert(it == tree.end());
+    auto expectedEntry = expected.begin();
+    for (const auto& [key, value] : tree) {
+        assert(key == expectedEntry->first && value == expectedEntry->second);
+        ++expectedEntry;
+    }
+    assert(tree.lowerBound("bscs20").key() == expected.lower_bound("bscs20")->first);
+    assert(tree.upperBound(emailKey(5)).key() == expected.upper_bound(emailKey(5))->first);
+    assert(tree.memoryUsage() > 0);
+    cout << "[PASS] Iteration rebuilds every key in order" << endl;
+
+    // Node order is sized from the compressed slots, not sizeof(string)
+    static_assert(BTreeCacheOrder<string, size_t>::KEY_SLOT < sizeof(string), "string keys are compressed");
+    static_assert(BTreeCacheOrder<string, size_t>::value > (16 * BTREE_CACHE_LINE + sizeof(string) + sizeof(size_t)) /
+                                                           (sizeof(string) + sizeof(size_t) + sizeof(void*)),
+                  "compressed keys raise the fan-out");
+    static_assert(BTreeCacheOrder<int, size_t>::KEYS_FIXED == 0, "plain keys have no per-node overhead");
+    cout << "[PASS] Node order sized from compressed key slots" << endl;
+}
+
+void testBPlusTreeIteration() {
+    cout << "\n=== Testing BPlusTree Iteration ===" << endl;
+
+    BPlusTree<string, size_t, 5> tree;
+    assert(tree.begin() == tree.end());
+
+    for (int i = 2999; i >= 0; i--) {
+        tree.insert(studentID(i), static_cast<size_t>(i));
+    }
+    assert(tree.size() == 3000);
+
+    size_t expected = 0;
+    for (auto [id, offset] : tree) {
+        assert(id == studentID(static_cast<int>(expected)));
+        assert(offset == expected);
+        expected++;
+    }
+    assert(expected == 3000);
+    cout << "[PASS] Range-for walks the leaf chain in key order" << endl;
+
+    for (auto it = tree.begin(); it != tree.end(); ++it) {
+        it.value() += 1;
+    }
+    assert(*tree.search("BSCS18000") == 1);
+    cout << "[PASS] Values are writable through the iterator" << endl;
+
+    // One intake year: BSCS19000 .. BSCS19999
+    size_t inRange = 0;
+    for (auto it = tree.lowerBound("BSCS19000"); it != tree.upperBound("BSCS19999"); ++it) {
+        assert(it.key().compare(0, 6, "BSCS19") == 0);
+        inRange++;
+    }
+    assert(inRange == 1000);
+    cout << "[PASS] lowerBound/upperBound bound a range scan" << endl;
+
+    // Bounds between and beyond stored keys
+    assert(tree.lowerBound("BSCS18000a").key() == "BSCS18001");
+    assert(tree.upperBound("BSCS18000").key() == "BSCS18001");
+    assert(tree.lowerBound("A").key() == "BSCS18000");
+    assert(tree.lowerBound("Z") == tree.end());
+    assert(tree.upperBound(string_view("BSCS20999")) == tree.end());
+    cout << "[PASS] Bounds between and past stored keys" << endl;
+
+    const auto& constTree = tree;
+    size_t constCount = 0;
+    for (auto it = constTree.begin(); it != constTree.end(); ++it) {
+        constCount++;
+    }
+    assert(constCount == 3000);
+    cout << "[PASS] const iteration" << endl;
+}
+
+// rank/select/countRange against positions in std::map, while inserts,
+// removes and bulk loads reshape the tree
+template<typename Tree>
+void checkOrderStatistics(const Tree& tree, const map<string, size_t>& expected) {
+    assert(tree.select(expected.size()) == tree.end());
+    size_t k = 0;
+    for (const auto& entry : expected) {
+        auto it = tree.select(k);
+        assert(it != tree.end() && it.key() == entry.first && it.value() == entry.second);
+        assert(tree.rank(entry.first) == k);
+        assert(tree.rank(entry.first + "a") == k + 1);
+        k++;
+    }
+    assert(tree.rank("A") == 0);
+    assert(tree.rank("Z") == expected.size());
+
+    // Ranges with bounds on, between and outside stored keys
+    for (int lo = 0; lo < 3000; lo += 397) {
+        for (int hi = lo - 500; hi < 3000; hi += 613) {
+            string a = studentID(lo), b = hi < 0 ? string("A") : studentID(hi);
+            size_t inRange = 0;
+            for (auto it = expected.lower_bound(a); it != expected.end() && it->first <= b; ++it) {
+                inRange++;
+            }
+            assert(tree.countRange(a, b) == inRange);
+        }
+    }
+}
+
+template<typename Tree>
+void orderStatistics(const string& name) {
+    Tree tree;
+    map<string, size_t> expected;
+    mt19937 rng(7);
+
+    assert(tree.rank("BSCS18000") == 0);
+    assert(tree.select(0) == tree.end());
+    assert(tree.countRange("A", "Z") == 0);
+
+    for (int step = 0; step < 12000; step++) {
+        string key = studentID(rng() % 3000);
+        if (rng() % 3 == 0) {
+            tree.remove(key);
+            expected.erase(key);
+        } else {
+            tree.insert(key, step);  // Sometimes an update: counts must not change
+            expected[key] = step;
+        }
+        if (step % 1999 == 0) {
+            checkOrderStatistics(tree, expected);
+        }
+    }
+    checkOrderStatistics(tree, expected);
+
+    vector<pair<string, size_t>> sorted(expected.begin(), expected.end());
+    tree.bulkLoad(sorted, 0.7);
+    checkOrderStatistics(tree, expected);
+
+    // Drain through merges down to an empty root
+    for (int i = 0; i < 3000; i += 2) {
+        tree.remove(studentID(i));
+        expected.erase(studentID(i));
+    }
+    checkOrderStatistics(tree, expected);
+    cout << "[PASS] " << name << " rank/select/countRange match std::map" << endl;
+}
+
+void testOrderStatistics() {
+    cout << "\n=== Testing BPlusTree Order Statistics ===" << endl;
+
+    orderStatistics<BPlusTree<string, size_t, 4>>("BPlusTree order 4");
+    orderStatistics<BPlusTree<string, size_t, 5>>("BPlusTree order 5");
+    orderStatistics<BPlusTree<string, size_t>>("BPlusTree default order");
+    orderStatistics<BPlusTree<string, size_t, 5, HeapNodeAllocator>>("BPlusTree order 5 (heap nodes)");
+}
+
+void testNodeKeys() {
+    cout << "\n=== Testing NodeKeys In-Node Search ===" << endl;
+
+    // Prefix ties: zero padding, embedded NULs, shared first 16 bytes,
+    // bytes above 0x7f
+    vector<string> sorted = {
+        "", string("\0", 1), "A", "AB", string("AB\0", 3), string("AB\0\0", 4), "ABC",
+        "BSCS22201", "BSCS22202", "bscs22001@itu.edu.pk", "bscs22001@itu.edu.pl",
+        "bscs22001@itu.edua", "bscs22001@itu.ed", "zzzzzzzzzzzzzzzzzzz", "\xff", "\xff\xff"
+    };
+    sort(sorted.begin(), sorted.end());
+
+    NodeKeys<string, 16> keys;
+    for (size_t i = 0; i < sorted.size(); i++) {
+        keys.set(static_cast<int>(i), sorted[i]);
+    }
+
+    vector<string> probes = sorted;
+    for (const auto& key : sorted) {
+        probes.push_back(key + "a");
+        probes.push_back(key + string("\0", 1));
+        if (!key.empty()) probes.push_back(key.substr(0, key.size() - 1));
+    }
+
+    for (int n = 0; n <= static_cast<int>(sorted.size()); n++) {
+        for (const auto& probe : probes) {
+            int lower = static_cast<int>(lower_bound(sorted.begin(), sorted.begin() + n, probe) - sorted.begin());
+            int upper = static_cast<int>(upper_bound(sorted.begin(), sorted.begin() + n, probe) - sorted.begin());
+            assert(keys.lowerBound(n, probe) == lower);
+            assert(keys.upperBound(n, string_view(probe)) == upper);
+            if (lower < n) {
+                assert(keys.matches(lower, probe) == (sorted[lower] == probe));
+            }
+        }
+    }
+    cout << "[PASS] Prefix search agrees with std::lower_bound/upper_bound" << endl;
+
+    // repack() narrows to the live keys' shared prefix; a later set()
+    // outside it shrinks the prefix again
+    NodeKeys<string, 8> emails;
+    vector<string> users = {"bscs22001@itu.edu.pk", "bscs22002@itu.edu.pk",
+                            "bscs22003@itu.edu.pk", "bscs22004@itu.edu.pk"};
+    for (int i = 0; i < 4; i++) {
+        emails.set(i, users[i]);
+    }
+    emails.repack(4);
+    for (int i = 0; i < 4; i++) {
+        assert(emails[i] == users[i]);
+        assert(emails.matches(i, users[i]));
+        assert(emails.lowerBound(4, users[i]) == i);
+        assert(emails.upperBound(4, users[i]) == i + 1);
+    }
+    assert(emails.lowerBound(4, "bscs21") == 0 && emails.lowerBound(4, "bscs23") == 4);
+    assert(emails.lowerBound(4, "bscs22") == 0 && emails.upperBound(4, "bscs22003") == 2);
+    assert(!emails.matches(0, "bscs22001@itu.edu"));
+
+    users.push_back("student.with.a.long.name@alumni.itu.edu.pk");
+    emails.set(4, users[4]);
+    users.insert(users.begin(), "admin@itu.edu.pk");
+    for (int i = 5; i > 0; i--) {
+        emails.moveFrom(i, emails, i - 1);
+    }
+    emails.set(0, users[0]);
+    for (int i = 0; i < 6; i++) {
+        assert(emails[i] == users[i]);
+        assert(emails.lowerBound(6, users[i]) == i);
+    }
+    emails.repack(6);
+    assert(emails.take(5) == users[5]);
+    cout << "[PASS] Prefixes repack and shrink without changing keys" << endl;
+
+    // Wide nodes halve before scanning
+    NodeKeys<string, 100> wide;
+    for (int i = 0; i < 100; i++) {
+        wide.set(i, studentID(i * 2));
+    }
+    for (int n : {33, 64, 100}) {
+        for (int i = -1; i <= 200; i++) {
+            string probe = i < 0 ? "A" : studentID(i);
+            assert(wide.lowerBound(n, probe) == min(n, (max(i, 0) + 1) / 2));
+            assert(wide.upperBound(n, probe) == min(n, max(i + 2, 0) / 2));
+        }
+    }
+    cout << "[PASS] Wide nodes search correctly" << endl;
+
+    NodeKeys<int, 7> ints;
+    for (int i = 0; i < 7; i++) {
+        ints.set(i, i * 10);
+    }
+    assert(ints.lowerBound(7, 30) == 3);
+    assert(ints.upperBound(7, 30) == 4);
+    assert(ints.lowerBound(7, 31) == 4);
+    assert(ints.lowerBound(7, 99) == 7);
+    cout << "[PASS] Non-string keys use plain binary search" << endl;
+}
+
+// Bulk load sorted IDs, then keep mutating: the built tree must behave
+// exactly like one grown by insert()
+template<typename Tree>
+void bulkLoadThenMutate(const string& name) {
+    for (double fill : {0.5, 0.9, 1.0}) {
+        for (int n : {0, 1, 2, 7, 100, 3000}) {
+            vector<pair<string, size_t>> sorted;
+            for (int i = 0; i < n; i++) {
+                sorted.emplace_back(studentID(i), static_cast<size_t>(i));
+            }
+
+            Tree tree;
+            tree.insert("stale", 1);  // bulkLoad replaces existing contents
+            tree.bulkLoad(sorted, fill);
+            map<string, size_t> expected(sorted.begin(), sorted.end());
+            checkAgainstMap(tree, expected);
+
+            mt19937 rng(n);
+            for (int step = 0; step < 2000; step++) {
+                string key = studentID(rng() % 4000);
+                if (rng() % 2 == 0) {
+                    tree.remove(key);
+                    expected.erase(key);
+                } else {
+                    tree.insert(key, step);
+                    expected[key] = step;
+                }
+            }
+            checkAgainstMap(tree, expected);
+        }
+    }
+
+    // Unsorted input still loads correctly (through insert)
+    Tree tree;
+    vector<pair<string, size_t>> unsorted = {{"CS301", 3}, {"CS101", 1}, {"CS201", 2}};
+    tree.bulkLoad(unsorted.begin(), unsorted.end());
+    map<string, size_t> expected(unsorted.begin(), unsorted.end());
+    checkAgainstMap(tree, expected);
+
+    cout << "[PASS] " << name << " bulkLoad matches std::map" << endl;
+}
+
+void testBulkLoad() {
+    cout << "\n=== Testing Bulk Load ===" << endl;
+
+    bulkLoadThenMutate<BTree<string, size_t, 4>>("BTree order 4");
+    bulkLoadThenMutate<BTree<string, size_t>>("BTree default order");
+    bulkLoadThenMutate<BPlusTree<string, size_t, 4>>("BPlusTree order 4");
+    bulkLoadThenMutate<BPlusTree<string, size_t, 7>>("BPlusTree order 7");
+    bulkLoadThenMutate<BPlusTree<string, size_t>>("BPlusTree default order");
+}
+
+void testNodePool() {
+    cout << "\n=== Testing NodePool ===" << endl;
+
+    NodePool<BTreeNode<string, size_t, 8>> pool;
+    auto* a = pool.allocate();
+    auto* b = pool.allocate();
+    assert(b == a + 1);
+    cout << "[PASS] Nodes are handed out contiguously" << endl;
+
+    pool.release(a);
+    assert(pool.allocate() == a);
+    cout << "[PASS] Released nodes are reused first" << endl;
+
+    size_t capacity = pool.capacity();
+    pool.reset();
+    assert(pool.allocate() == a);
+    assert(pool.capacity() == capacity);
+    cout << "[PASS] reset() returns every node without freeing slabs" << endl;
+
+    // clear() + rebuild (IndexedStorage::remove) reuses the same nodes
+    BPlusTree<string, size_t, 8> tree;
+    for (int round = 0; round < 3; round++) {
+        tree.clear();
+        for (int i = 0; i < 5000; i++) {
+            tree.insert(studentID(i), static_cast<size_t>(i + round));
+        }
+        assert(tree.size() == 5000);
+        assert(*tree.search(studentID(4999)) == static_cast<size_t>(4999 + round));
+    }
+    size_t expected = 0;
+    for (auto [id, offset] : tree) {
+        assert(offset == expected + 2);
+        expected++;
+    }
+    assert(expected == 5000);
+    cout << "[PASS] Trees rebuild correctly on recycled nodes" << endl;
+}
+
+int main() {
+    cout << "========================================" << endl;
+    cout << "  B-Tree Test" << endl;
+    cout << "========================================" << endl;
+
+    testNodeKeys();
+    testBTreeOrders();
+    testBPlusTreeOrders();
+    testPrefixCompressedTrees();
+    testBPlusTreeIteration();
+    testOrderStatistics();
+    testBulkLoad();
+    testNodePool();
+
+    cout << "\n========================================" << endl;
+    cout << "All tests passed!" << endl;
+    cout << "========================================" << endl;
+
+    return 0;
+}
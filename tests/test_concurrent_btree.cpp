@@ -0,0 +1,223 @@
+#undef NDEBUG  // Checks must run in Release builds too
+#include <iostream>
+#include <cassert>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include "../database/ConcurrentBTree.h"
+
+using namespace std;
+
+// ConcurrentBTree checks: single-threaded behaviour against std::map at
+// several orders, then readers, range scans and writers running together.
+
+using ID = FixedKey<16>;
+
+string studentID(int i) {
+    string roll = to_string(i % 1000);
+    return "BSCS" + to_string(18 + i / 1000) + string(3 - roll.size(), '0') + roll;
+}
+
+void testFixedKey() {
+    cout << "\n=== Testing FixedKey ===" << endl;
+
+    assert(ID("BSCS22001") < ID("BSCS22002"));
+    assert(ID("AB") < ID("ABC"));
+    assert(!(ID("ABC") < ID("AB")));
+    assert(ID(string("CS701")) == ID(string_view("CS701")));
+    assert(ID("CS701").str() == "CS701");
+    assert(ID("0123456789abcdef").str() == "0123456789abcdef");
+    assert(ID::fits("0123456789abcdef"));
+    assert(!ID::fits("0123456789abcdefg"));
+    assert(!ID::fits(string("A\0B", 3)));
+    cout << "[PASS] Zero-padded keys order like strings" << endl;
+}
+
+template<typename Tree>
+void randomOperations(const string& name) {
+    Tree tree;
+    map<string, size_t> expected;
+    mt19937 rng(42);
+
+    for (int step = 0; step < 20000; step++) {
+        string key = studentID(rng() % 3000);
+        size_t value = rng();
+        int op = rng() % 4;
+        if (op == 0) {
+            assert(tree.remove(key) == (expected.erase(key) == 1));
+        } else if (op == 1) {
+            bool exists = expected.count(key) > 0;
+            assert(tree.update(key, value) == exists);
+            if (exists) expected[key] = value;
+        } else {
+            tree.insert(key, value);
+            expected[key] = value;
+        }
+    }
+    assert(tree.size() == expected.size());
+
+    for (int i = 0; i < 3000; i++) {
+        size_t value = 0;
+        auto it = expected.find(studentID(i));
+        assert(tree.get(studentID(i), value) == (it != expected.end()));
+        if (it != expected.end()) {
+            assert(value == it->second);
+        }
+    }
+
+    auto pairs = tree.getAllPairs();
+    assert(pairs.size() == expected.size());
+    size_t i = 0;
+    for (const auto& entry : expected) {
+        assert(pairs[i].first.str() == entry.first);
+        assert(pairs[i].second == entry.second);
+        i++;
+    }
+
+    // One intake year, a capped page, and an empty range
+    vector<pair<ID, size_t>> range;
+    tree.scan("BSCS19000", "BSCS19999", range);
+    size_t inRange = 0;
+    for (auto it = expected.lower_bound("BSCS19000"); it != expected.upper_bound("BSCS19999"); ++it) {
+        assert(range[inRange].first.str() == it->first);
+        inRange++;
+    }
+    assert(range.size() == inRange);
+    range.clear();
+    assert(tree.scan("A", "Z", range, 10) == 10);
+    assert(range[0].first.str() == expected.begin()->first);
+    assert(tree.scan("Z", "A", range) == 0);
+
+    tree.clear();
+    assert(tree.isEmpty() && tree.getAllPairs().empty());
+    assert(!tree.contains("BSCS18000"));
+    cout << "[PASS] " << name << " matches std::map" << endl;
+}
+
+// Writers insert disjoint key sets while readers look up preloaded keys
+// and scan ranges; no reader may miss a preloaded key or see disorder
+void testConcurrentReadersAndWriters() {
+    cout << "\n=== Testing Concurrent Readers and Writers ===" << endl;
+
+    ConcurrentBTree<ID, size_t, 8> tree;  // Small nodes: many splits under load
+    const int PRELOADED = 2000;
+    for (int i = 0; i < PRELOADED; i++) {
+        tree.insert(studentID(i * 2), i * 2);  // Even IDs
+    }
+
+    const int WRITERS = 4;
+    const int PER_WRITER = 2500;
+    atomic<bool> writing(true);
+    atomic<size_t> readerChecks(0);
+    vector<thread> threads;
+
+    for (int w = 0; w < WRITERS; w++) {
+        threads.emplace_back([&, w]() {
+            // Odd IDs, interleaved between the preloaded ones and past them
+            for (int i = w; i < PER_WRITER * WRITERS; i += WRITERS) {
+                tree.insert(studentID(i * 2 + 1), i * 2 + 1);
+            }
+        });
+    }
+
+    for (int r = 0; r < 3; r++) {
+        threads.emplace_back([&, r]() {
+            mt19937 rng(r);
+            size_t checks = 0;
+            while (writing.load() || checks < 1000) {
+                int i = rng() % PRELOADED;
+                size_t value = 0;
+                assert(tree.get(studentID(i * 2), value));
+                assert(value == static_cast<size_t>(i * 2));
+                checks++;
+            }
+            readerChecks += checks;
+        });
+    }
+
+    threads.emplace_back([&]() {
+        size_t scans = 0;
+        while (writing.load() || scans < 50) {
+            vector<pair<ID, size_t>> range;
+            tree.scan(studentID(1000), studentID(1999), range);
+            int evens = 0;
+            for (size_t i = 0; i < range.size(); i++) {
+                assert(i == 0 || range[i - 1].first < range[i].first);
+                assert(range[i].first.str() == studentID(static_cast<int>(range[i].second)));
+                if (range[i].second % 2 == 0) evens++;
+            }
+            assert(evens == 500);  // Every preloaded key in range, exactly once
+            scans++;
+        }
+    });
+
+    for (int w = 0; w < WRITERS; w++) {
+        threads[w].join();
+    }
+    writing = false;
+    for (size_t t = WRITERS; t < threads.size(); t++) {
+        threads[t].join();
+    }
+
+    size_t total = PRELOADED + PER_WRITER * WRITERS;
+    assert(tree.size() == total);
+    auto pairs = tree.getAllPairs();
+    assert(pairs.size() == total);
+    for (size_t i = 1; i < pairs.size(); i++) {
+        assert(pairs[i - 1].first < pairs[i].first);
+    }
+    for (int i = 0; i < PER_WRITER * WRITERS; i++) {
+        assert(tree.contains(studentID(i * 2 + 1)));
+    }
+    cout << "[PASS] " << readerChecks.load() << " lookups during " << PER_WRITER * WRITERS
+         << " concurrent inserts never missed a key" << endl;
+
+    // Concurrent removes and updates on disjoint keys
+    threads.clear();
+    for (int w = 0; w < WRITERS; w++) {
+        threads.emplace_back([&, w]() {
+            for (int i = w; i < PER_WRITER * WRITERS; i += WRITERS) {
+                assert(tree.remove(studentID(i * 2 + 1)));
+                if (i < PRELOADED) {
+                    assert(tree.update(studentID(i * 2), 7));
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    assert(tree.size() == static_cast<size_t>(PRELOADED));
+    for (int i = 0; i < PRELOADED; i++) {
+        size_t value = 0;
+        assert(tree.get(studentID(i * 2), value) && value == 7);
+    }
+    cout << "[PASS] Concurrent removes and updates leave the expected keys" << endl;
+}
+
+void testTreeOrders() {
+    cout << "\n=== Testing ConcurrentBTree Orders ===" << endl;
+
+    randomOperations<ConcurrentBTree<ID, size_t, 4>>("ConcurrentBTree order 4");
+    randomOperations<ConcurrentBTree<ID, size_t, 5>>("ConcurrentBTree order 5");
+    randomOperations<ConcurrentBTree<ID, size_t>>("ConcurrentBTree default order");
+}
+
+int main() {
+    cout << "========================================" << endl;
+    cout << "  Concurrent B-Tree Test" << endl;
+    cout << "========================================" << endl;
+
+    testFixedKey();
+    testTreeOrders();
+    testConcurrentReadersAndWriters();
+
+    cout << "\n========================================" << endl;
+    cout << "All tests passed!" << endl;
+    cout << "========================================" << endl;
+
+    return 0;
+}
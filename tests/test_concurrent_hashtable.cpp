@@ -0,0 +1,166 @@
+#undef NDEBUG  // Checks must run in Release builds too
+#include <iostream>
+#include <cassert>
+#include <atomic>
+#include <map>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "../database/ConcurrentHashTable.h"
+
+using namespace std;
+
+// ConcurrentHashTable checks: single-threaded behaviour against std::map,
+// then threads inserting, reading and removing on their own keys while
+// readers look up a preloaded set that nobody writes.
+
+using Contents = map<string, int>;
+
+string studentID(int i) {
+    string roll = to_string(i % 1000);
+    return "BSCS" + to_string(18 + i / 1000) + string(3 - roll.size(), '0') + roll;
+}
+
+void testMatchesMap() {
+    cout << "\n=== Testing Against std::map ===" << endl;
+
+    ConcurrentHashTable<string, int, 4> table;
+    Contents expected;
+    mt19937 rng(7);
+
+    for (int step = 0; step < 20000; step++) {
+        string key = studentID(rng() % 3000);
+        int value = static_cast<int>(rng() % 100000);
+        int op = rng() % 4;
+        if (op == 0) {
+            assert(table.remove(key) == (expected.erase(key) == 1));
+        } else if (op == 1) {
+            bool exists = expected.count(key) > 0;
+            assert(table.update(key, value) == exists);
+            if (exists) expected[key] = value;
+        } else {
+            table.insert(key, value);
+            expected[key] = value;
+        }
+    }
+    assert(table.size() == expected.size());
+
+    for (int i = 0; i < 3000; i++) {
+        int value = -1;
+        auto it = expected.find(studentID(i));
+        assert(table.get(studentID(i), value) == (it != expected.end()));
+        assert(table.contains(string_view(studentID(i))) == (it != expected.end()));
+        if (it != expected.end()) {
+            assert(value == it->second);
+        }
+    }
+
+    auto pairs = table.getAllPairs();
+    assert(Contents(pairs.begin(), pairs.end()) == expected);
+    assert(pairs.size() == expected.size());  // No key in two places
+
+    table.clear();
+    assert(table.isEmpty() && table.getAllPairs().empty());
+    assert(!table.contains(studentID(0)));
+    cout << "[PASS] Random operations match std::map" << endl;
+}
+
+// Writers each own a stride of keys: insert them all, check them, remove
+// every other one, update the rest. Readers meanwhile look up preloaded keys
+// (spread over every shard, so they share locks with the writers) and must
+// never miss one or see a wrong value.
+void testConcurrentWriters() {
+    cout << "\n=== Testing Concurrent Insert/Find/Remove ===" << endl;
+
+    ConcurrentHashTable<string, int> table;
+    const int PRELOADED = 2000;
+    for (int i = 0; i < PRELOADED; i++) {
+        table.insert("P" + to_string(i), i);
+    }
+
+    const int WRITERS = 4;
+    const int PER_WRITER = 5000;
+    atomic<int> writersLeft(WRITERS);
+    atomic<size_t> readerChecks(0);
+    vector<thread> threads;
+
+    for (int w = 0; w < WRITERS; w++) {
+        threads.emplace_back([&, w]() {
+            // Growth happens while readers hold shared locks on other keys
+            for (int i = w; i < PER_WRITER * WRITERS; i += WRITERS) {
+                table.insert(studentID(i), i);
+            }
+            for (int i = w; i < PER_WRITER * WRITERS; i += WRITERS) {
+                int value = -1;
+                assert(table.get(studentID(i), value) && value == i);
+            }
+            for (int i = w; i < PER_WRITER * WRITERS; i += WRITERS) {
+                if (i % 2 == 0) {
+                    assert(table.remove(studentID(i)));
+                    assert(!table.remove(studentID(i)));
+                    assert(!table.update(studentID(i), 0));
+                } else {
+                    assert(table.update(studentID(i), -i));
+                }
+            }
+            writersLeft--;
+        });
+    }
+
+    for (int r = 0; r < 3; r++) {
+        threads.emplace_back([&, r]() {
+            mt19937 rng(r);
+            size_t checks = 0;
+            while (writersLeft.load() > 0 || checks < 1000) {
+                int i = rng() % PRELOADED;
+                int value = -1;
+                assert(table.get("P" + to_string(i), value));
+                assert(value == i);
+                checks++;
+            }
+            readerChecks += checks;
+        });
+    }
+
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    // Preloaded keys plus each writer's odd keys, with their updated values
+    size_t total = PRELOADED + PER_WRITER * WRITERS / 2;
+    assert(table.size() == total);
+    auto pairs = table.getAllPairs();
+    assert(pairs.size() == total);
+    Contents contents(pairs.begin(), pairs.end());
+    assert(contents.size() == total);  // No key in two places
+    for (int i = 0; i < PRELOADED; i++) {
+        assert(contents.at("P" + to_string(i)) == i);
+    }
+    for (int i = 0; i < PER_WRITER * WRITERS; i++) {
+        auto it = contents.find(studentID(i));
+        if (i % 2 == 0) {
+            assert(it == contents.end());
+        } else {
+            assert(it != contents.end() && it->second == -i);
+        }
+    }
+    cout << "[PASS] " << readerChecks.load() << " lookups during " << PER_WRITER * WRITERS
+         << " concurrent inserts and removes never missed a key" << endl;
+}
+
+int main() {
+    cout << "========================================" << endl;
+    cout << "  Concurrent Hash Table Test" << endl;
+    cout << "========================================" << endl;
+
+    testMatchesMap();
+    testConcurrentWriters();
+
+    cout << "\n========================================" << endl;
+    cout << "All tests passed!" << endl;
+    cout << "========================================" << endl;
+
+    return 0;
+}
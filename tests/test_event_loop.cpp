@@ -0,0 +1,236 @@
+#undef NDEBUG  // Checks must run in Release builds too
+#include <iostream>
+#include <cassert>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../backend/HTTPServer.h"
+
+using namespace std;
+
+// HttpRequestParser on split, pipelined, chunked and malformed input, then
+// a live HTTPServer on the event loop transport: keep-alive, pipelining
+// (also HEAD followed by GET) over a raw socket, many idle connections, the
+// idle timeout and errors.
+
+void testParser() {
+    cout << "\n=== Testing HttpRequestParser ===" << endl;
+
+    // Fed one byte at a time, the request only completes on the last byte
+    string raw = "POST /api/a%20b?x=1&y=two HTTP/1.1\r\nHost: h\r\nContent-Length: 5\r\n\r\nhello";
+    HttpRequestParser parser;
+    Request req;
+    for (size_t i = 1; i < raw.size(); i++) {
+        assert(parser.parse(string_view(raw).substr(0, i), req) == HttpRequestParser::Status::NeedMore);
+    }
+    assert(parser.parse(raw, req) == HttpRequestParser::Status::Complete);
+    assert(parser.consumed() == raw.size());
+    assert(req.method == "POST" && req.path == "/api/a b" && req.body == "hello");
+    assert(req.get_param_value("x") == "1" && req.get_param_value("y") == "two");
+    assert(req.get_header_value("host") == "h");
+    assert(parser.keepAlive());
+    cout << "[PASS] Incremental head and body" << endl;
+
+    // Pipelined: two requests in one buffer
+    string two = "\r\nGET /one HTTP/1.1\r\n\r\nGET /two HTTP/1.0\r\n\r\n";
+    parser.reset();
+    Request first, second;
+    assert(parser.parse(two, first) == HttpRequestParser::Status::Complete && first.path == "/one");
+    string rest = two.substr(parser.consumed());
+    parser.reset();
+    assert(parser.parse(rest, second) == HttpRequestParser::Status::Complete && second.path == "/two");
+    assert(!parser.keepAlive());  // HTTP/1.0 without Connection: keep-alive
+    cout << "[PASS] Pipelined requests" << endl;
+
+    // Chunked body, split mid-chunk
+    string chunked = "POST /c HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n"
+                     "4;ext=1\r\nWiki\r\n5\r\npedia\r\n0\r\nTrailer: x\r\n\r\nNEXT";
+    parser.reset();
+    Request chunkReq;
+    size_t cut = chunked.find("pedia") + 2;
+    assert(parser.parse(string_view(chunked).substr(0, cut), chunkReq) == HttpRequestParser::Status::NeedMore);
+    assert(parser.parse(chunked, chunkReq) == HttpRequestParser::Status::Complete);
+    assert(chunkReq.body == "Wikipedia");
+    assert(chunked.substr(parser.consumed()) == "NEXT");
+    cout << "[PASS] Chunked body" << endl;
+
+    auto errorFor = [](const string& input, size_t maxBody = 1024) {
+        HttpRequestParser p(maxBody);
+        Request r;
+        return p.parse(input, r) == HttpRequestParser::Status::Error ? p.errorStatus() : 0;
+    };
+    assert(errorFor("GARBAGE\r\n\r\n") == 400);
+    assert(errorFor("GET nopath HTTP/1.1\r\n\r\n") == 400);
+    assert(errorFor("GET / HTTP/1.1\r\nNoColon\r\n\r\n") == 400);
+    assert(errorFor("GET / HTTP/2.0\r\n\r\n") == 505);
+    assert(errorFor("POST / HTTP/1.1\r\nContent-Length: 2000\r\n\r\n") == 413);
+    assert(errorFor("POST / HTTP/1.1\r\nTransfer-Encoding: gzip\r\n\r\n") == 501);
+    assert(errorFor("POST / HTTP/1.1\r\nContent-Length: 1\r\nTransfer-Encoding: chunked\r\n\r\n") == 400);
+    assert(errorFor("POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\nzz\r\n") == 400);
+    assert(errorFor("GET / HTTP/1.1\r\nX: " + string(HttpRequestParser::MAX_HEAD_BYTES, 'a')) == 431);
+    cout << "[PASS] Malformed and oversized requests rejected" << endl;
+}
+
+// Blocking client socket with a receive timeout
+int connectTo(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    timeval timeout{5, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    return fd;
+}
+
+// Read until `count` responses' worth of "HTTP/1.1 " lines and bodies arrived, or EOF
+string readResponses(int fd, size_t count, const string& lastBody) {
+    string data;
+    char buffer[4096];
+    while (true) {
+        size_t seen = 0;
+        for (size_t pos = data.find("HTTP/1.1 "); pos != string::npos; pos = data.find("HTTP/1.1 ", pos + 1)) {
+            seen++;
+        }
+        if (seen >= count && data.size() >= lastBody.size() &&
+            data.compare(data.size() - lastBody.size(), lastBody.size(), lastBody) == 0) {
+            return data;
+        }
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) return data;
+        data.append(buffer, static_cast<size_t>(n));
+    }
+}
+
+bool peerClosed(int fd) {
+    char c;
+    return recv(fd, &c, 1, 0) == 0;
+}
+
+void testServer() {
+    cout << "\n=== Testing Event Loop Transport ===" << endl;
+
+    string dir = (filesystem::temp_directory_path() / "ums_test_event_loop").string();
+    filesystem::remove_all(dir);
+    AsyncLogger::instance().setLevel(LogLevel::Warn);
+    DatabaseManager db(dir);
+
+    ServerOptions options;
+    options.transport = ServerOptions::Transport::EventLoop;
+    options.workerThreads = 2;
+    options.eventLoopIdleTimeoutSec = 2;
+    const int port = 18947;
+    HTTPServer server(port, db, options);
+    server.get("/echo", [](const HTTPRequest& req, DatabaseManager&) {
+        return HTTPResponse(200, "{\"v\":\"" + string(req.param("v")) + "\"}");
+    });
+    server.post("/len", [](const HTTPRequest& req, DatabaseManager&) {
+        return HTTPResponse(200, "{\"len\":\"" + to_string(req.body.size()) + "\"}");
+    });
+
+    thread listener([&server]() { server.start(); });
+    Client probe("127.0.0.1", port);
+    while (!probe.Options("/")) this_thread::sleep_for(chrono::milliseconds(5));
+
+    // Handlers registered through get/post; keep-alive client reuses one socket
+    Client client("127.0.0.1", port);
+    client.set_keep_alive(true);
+    for (int i = 0; i < 20; i++) {
+        auto res = client.Get("/echo?v=" + to_string(i));
+        assert(res && res->status == 200 && res->body == "{\"v\":\"" + to_string(i) + "\"}");
+        assert(res->get_header_value("Access-Control-Allow-Origin") == "*");
+        assert(res->get_header_value("Connection") == "keep-alive");
+    }
+    auto posted = client.Post("/len", string(100000, 'x'), "text/plain");
+    assert(posted && posted->body == "{\"len\":\"100000\"}");
+    auto missing = client.Get("/nope");
+    assert(missing && missing->status == 404);
+    auto tagged = client.Get("/echo?v=etag");
+    auto unchanged = client.Get("/echo?v=etag", {{"If-None-Match", tagged->get_header_value("ETag")}});
+    assert(unchanged && unchanged->status == 304 && unchanged->body.empty());
+    assert(!unchanged->has_header("Content-Length"));  // Would claim the full body's length
+    assert(client.Get("/echo?v=0")->body == "{\"v\":\"0\"}");  // Framing intact after the 304
+    client.stop();
+    cout << "[PASS] Keep-alive requests, POST body, 404, 304" << endl;
+
+    // Pipelining: three requests in one write, answered in order
+    int fd = connectTo(port);
+    string pipelined = "GET /echo?v=a HTTP/1.1\r\n\r\nGET /echo?v=b HTTP/1.1\r\n\r\n"
+                       "GET /echo?v=c HTTP/1.1\r\nConnection: close\r\n\r\n";
+    send(fd, pipelined.data(), pipelined.size(), 0);
+    string replies = readResponses(fd, 3, "{\"v\":\"c\"}");
+    size_t a = replies.find("{\"v\":\"a\"}"), b = replies.find("{\"v\":\"b\"}"), c = replies.find("{\"v\":\"c\"}");
+    assert(a != string::npos && a < b && b < c && c != string::npos);
+    assert(peerClosed(fd));  // Connection: close honoured
+    close(fd);
+    cout << "[PASS] Pipelined requests answered in order" << endl;
+
+    // HEAD: the GET route's headers and Content-Length, no body, so the
+    // next response on the connection starts right after the headers
+    fd = connectTo(port);
+    string headThenGet = "HEAD /echo?v=h HTTP/1.1\r\n\r\n"
+                         "GET /echo?v=g HTTP/1.1\r\nConnection: close\r\n\r\n";
+    send(fd, headThenGet.data(), headThenGet.size(), 0);
+    replies = readResponses(fd, 2, "{\"v\":\"g\"}");
+    size_t headEnd = replies.find("\r\n\r\n");
+    assert(replies.rfind("HTTP/1.1 200 OK\r\n", 0) == 0 && headEnd != string::npos);
+    assert(replies.substr(0, headEnd).find("Content-Length: 9\r\n") != string::npos);
+    assert(replies.substr(0, headEnd).find("Connection: keep-alive") != string::npos);
+    assert(replies.compare(headEnd + 4, 17, "HTTP/1.1 200 OK\r\n") == 0);
+    assert(replies.find("{\"v\":\"h\"}") == string::npos);
+    assert(peerClosed(fd));
+    close(fd);
+    cout << "[PASS] HEAD answered without a body on a kept-alive connection" << endl;
+
+    // Malformed request: error response, then the connection is closed
+    fd = connectTo(port);
+    string bad = "BROKEN\r\n\r\n";
+    send(fd, bad.data(), bad.size(), 0);
+    string badReply = readResponses(fd, 1, "}");
+    assert(badReply.rfind("HTTP/1.1 400 Bad Request\r\n", 0) == 0);
+    assert(peerClosed(fd));
+    close(fd);
+    cout << "[PASS] Malformed request gets 400 and close" << endl;
+
+    // Many idle connections cost no worker: requests still go through
+    vector<int> idle;
+    for (int i = 0; i < 500; i++) {
+        int s = connectTo(port);
+        assert(s >= 0);
+        idle.push_back(s);
+    }
+    Client busy("127.0.0.1", port);
+    auto during = busy.Get("/echo?v=busy");
+    assert(during && during->status == 200);
+    cout << "[PASS] 500 idle connections held alongside traffic" << endl;
+
+    // ...until the idle timeout closes them
+    this_thread::sleep_for(chrono::milliseconds(3500));
+    assert(peerClosed(idle.front()) && peerClosed(idle.back()));
+    for (int s : idle) close(s);
+    cout << "[PASS] Idle connections closed after the timeout" << endl;
+
+    server.stop();
+    listener.join();
+    filesystem::remove_all(dir);
+}
+
+int main() {
+    cout << "========================================" << endl;
+    cout << "  Event Loop Test" << endl;
+    cout << "========================================" << endl;
+
+    testParser();
+    testServer();
+
+    cout << "\n========================================" << endl;
+    cout << "All tests passed!" << endl;
+    cout << "========================================" << endl;
+
+    return 0;
+}
@@ -0,0 +1,188 @@
+#undef NDEBUG  // Checks must run in Release builds too
+#include <iostream>
+#include <cassert>
+#include <functional>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include "../database/FlatHashTable.h"
+
+using namespace std;
+
+// FlatHashTable checks: random operations against std::map, then removes
+// from full groups (tombstones) - lookups probing past them, inserts reusing
+// them, growth and in-place rehash dropping them - and clear().
+
+using Contents = map<string, int>;
+
+string studentID(int i) {
+    string roll = to_string(i % 1000);
+    return "BSCS" + to_string(18 + i / 1000) + string(3 - roll.size(), '0') + roll;
+}
+
+// Only the low 7 bits (the control byte tag) vary, so every key starts
+// probing at group 0 and groups fill up one after another
+struct CollidingHash {
+    size_t operator()(const string& key) const { return hash<string>()(key) & 0x7F; }
+};
+
+void testMatchesMap() {
+    cout << "\n=== Testing Against std::map ===" << endl;
+
+    FlatHashTable<string, int> table;
+    Contents expected;
+    mt19937 rng(5);
+
+    for (int step = 0; step < 50000; step++) {
+        string key = studentID(rng() % 3000);
+        int value = static_cast<int>(rng() % 100000);
+        int op = rng() % 3;  // Removes as often as inserts: many tombstones
+        if (op == 0) {
+            assert(table.remove(key) == (expected.erase(key) == 1));
+        } else if (op == 1) {
+            bool exists = expected.count(key) > 0;
+            assert(table.update(key, value) == exists);
+            if (exists) expected[key] = value;
+        } else {
+            table.insert(key, value);
+            expected[key] = value;
+        }
+    }
+    assert(table.size() == expected.size());
+    for (int i = 0; i < 3000; i++) {
+        auto it = expected.find(studentID(i));
+        const int* value = table.get(studentID(i));
+        assert((value != nullptr) == (it != expected.end()));
+        if (value != nullptr) {
+            assert(*value == it->second);
+        }
+    }
+    auto pairs = table.getAllPairs();
+    assert(Contents(pairs.begin(), pairs.end()) == expected);
+    assert(pairs.size() == expected.size());
+    cout << "[PASS] Random inserts, updates and removes match std::map" << endl;
+}
+
+void testTombstones() {
+    cout << "\n=== Testing Tombstones ===" << endl;
+
+    // 64 slots, grows past 56 (live + tombstones)
+    FlatHashTable<string, int, CollidingHash> table(48);
+    assert(table.bucketCount() == 64);
+    for (int i = 0; i < 48; i++) {
+        table.insert(studentID(i), i);
+    }
+
+    // The first 16 keys filled group 0; removing them leaves tombstones
+    // that the probe for every later key must walk past
+    for (int i = 0; i < 16; i++) {
+        assert(table.remove(studentID(i)));
+        assert(!table.remove(studentID(i)));
+        assert(table.get(studentID(i)) == nullptr);
+    }
+    for (int i = 16; i < 48; i++) {
+        assert(table.get(studentID(i)) != nullptr && *table.get(studentID(i)) == i);
+    }
+    assert(table.size() == 32);
+    cout << "[PASS] Lookups probe past removed slots" << endl;
+
+    // 16 new keys take the tombstones: had they used EMPTY slots, live plus
+    // tombstones would pass the load limit and the table would grow
+    for (int i = 100; i < 116; i++) {
+        table.insert(studentID(i), i);
+    }
+    assert(table.bucketCount() == 64 && table.size() == 48);
+    table.insert(studentID(16), -16);  // Existing key: updated in place
+    assert(table.size() == 48 && *table.get(studentID(16)) == -16);
+    cout << "[PASS] Inserts reuse tombstones" << endl;
+
+    // Growth rehashes live entries only
+    for (int i = 0; i < 16; i++) {
+        assert(table.remove(studentID(100 + i)));
+    }
+    for (int i = 200; table.bucketCount() == 64; i++) {
+        table.insert(studentID(i), i);
+    }
+    assert(table.bucketCount() == 128);
+    for (int i = 0; i < 16; i++) {
+        assert(!table.contains(studentID(i)) && !table.contains(studentID(100 + i)));
+    }
+    for (int i = 17; i < 48; i++) {
+        assert(*table.get(studentID(i)) == i);
+    }
+    assert(table.getAllPairs().size() == table.size());
+    cout << "[PASS] Growth drops tombstones" << endl;
+}
+
+void testChurn() {
+    cout << "\n=== Testing Remove/Insert Churn ===" << endl;
+
+    // A steady 40% live load with a stream of new keys: the slots freed by
+    // removes are reclaimed by rehashing in place, never by doubling
+    FlatHashTable<string, int> table(1024);
+    size_t capacity = table.bucketCount();
+    const int LIVE = static_cast<int>(capacity * 2 / 5);
+    for (int i = 0; i < LIVE; i++) {
+        table.insert(studentID(i), i);
+    }
+    const int TOTAL = 40 * static_cast<int>(capacity);
+    for (int i = LIVE; i < TOTAL; i++) {
+        table.insert(studentID(i), i);
+        assert(table.remove(studentID(i - LIVE)));
+    }
+    assert(table.bucketCount() == capacity);
+    assert(table.size() == static_cast<size_t>(LIVE));
+    for (int i = TOTAL - LIVE; i < TOTAL; i++) {
+        assert(*table.get(studentID(i)) == i);
+    }
+    for (int i = 0; i < TOTAL - LIVE; i += 97) {
+        assert(!table.contains(studentID(i)));
+    }
+    cout << "[PASS] " << TOTAL - LIVE << " removes at " << capacity << " slots never grew the table" << endl;
+}
+
+void testClear() {
+    cout << "\n=== Testing Clear ===" << endl;
+
+    FlatHashTable<string, int, CollidingHash> table(48);
+    for (int i = 0; i < 48; i++) {
+        table.insert(studentID(i), i);
+    }
+    for (int i = 0; i < 16; i++) {
+        table.remove(studentID(i));  // Tombstones in group 0
+    }
+    table.clear();
+    assert(table.isEmpty() && table.getAllPairs().empty());
+    assert(table.bucketCount() == 64);  // Keeps capacity
+    for (int i = 0; i < 48; i++) {
+        assert(!table.contains(studentID(i)));
+    }
+
+    // Tombstones are gone too: 56 entries fit without growing
+    for (int i = 0; i < 56; i++) {
+        table.insert(studentID(i), -i);
+    }
+    assert(table.bucketCount() == 64 && table.size() == 56);
+    for (int i = 0; i < 56; i++) {
+        assert(*table.get(studentID(i)) == -i);
+    }
+    cout << "[PASS] Clear empties every slot and keeps capacity" << endl;
+}
+
+int main() {
+    cout << "========================================" << endl;
+    cout << "  Flat Hash Table Test" << endl;
+    cout << "========================================" << endl;
+
+    testMatchesMap();
+    testTombstones();
+    testChurn();
+    testClear();
+
+    cout << "\n========================================" << endl;
+    cout << "All tests passed!" << endl;
+    cout << "========================================" << endl;
+
+    return 0;
+}
@@ -0,0 +1,206 @@
+#undef NDEBUG  // Checks must run in Release builds too
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+#include <set>
+#include <string>
+#include "../database/SeededHash.h"
+#include "../database/HashTable.h"
+#include "../database/FlatHashTable.h"
+
+using namespace std;
+
+// Hash-quality checks for SeededHash on the ID shapes the system stores:
+// student IDs (BSCS22201), course IDs (CS701) and emails.
+
+// BSCS + two-digit intake year + three-digit roll number (BSCS22201)
+vector<string> studentIDs(int count) {
+    vector<string> ids;
+    for (int i = 0; i < count; i++) {
+        string roll = to_string(i % 1000);
+        ids.push_back("BSCS" + to_string(18 + i / 1000) + string(3 - roll.size(), '0') + roll);
+    }
+    return ids;
+}
+
+vector<string> courseIDs() {
+    vector<string> ids;
+    const string prefixes[] = {"CS", "MATH", "MGT", "ENG", "PHY", "ELEC"};
+    for (const auto& prefix : prefixes) {
+        for (int sem = 1; sem <= 8; sem++) {
+            for (int n = 1; n <= 9; n++) {
+                ids.push_back(prefix + to_string(sem * 100 + n));
+            }
+        }
+    }
+    return ids;
+}
+
+vector<string> emails(int count) {
+    vector<string> ids;
+    for (int i = 0; i < count; i++) {
+        ids.push_back("bscs" + to_string(22000 + i) + "@itu.edu.pk");
+    }
+    return ids;
+}
+
+int popcount64(uint64_t x) {
+    int count = 0;
+    while (x) {
+        x &= x - 1;
+        count++;
+    }
+    return count;
+}
+
+// Chi-square of bucket counts over a power-of-two mask, normalized so that
+// a uniform hash gives ~1.0
+double normalizedChiSquare(const vector<string>& keys, const SeededHash<string>& hasher, size_t buckets) {
+    vector<size_t> counts(buckets, 0);
+    for (const auto& key : keys) {
+        counts[hasher(key) & (buckets - 1)]++;
+    }
+    double expected = static_cast<double>(keys.size()) / buckets;
+    double chi = 0;
+    for (size_t c : counts) {
+        chi += (c - expected) * (c - expected) / expected;
+    }
+    return chi / (buckets - 1);
+}
+
+void testDeterminismAndSeeds() {
+    cout << "\n=== Testing Determinism and Seeds ===" << endl;
+
+    SeededHash<string> a(12345), b(12345), c(54321);
+    assert(a("BSCS22201") == b("BSCS22201"));
+    assert(a("BSCS22201") != c("BSCS22201"));
+    cout << "[PASS] Same seed same hash, different seed different hash" << endl;
+
+    SeededHash<string> d1, d2;
+    assert(d1.seed == d2.seed);
+    assert(d1.seed == defaultHashSeed());
+    cout << "[PASS] Default seed is per-process" << endl;
+
+    string id = "CS701";
+    assert(a(id) == a(string_view(id)));
+    assert(a(id) == a("CS701"));
+    cout << "[PASS] string, string_view and literal agree" << endl;
+
+    // Every length class of the short-input path
+    set<size_t> lengths;
+    string s;
+    for (int len = 0; len <= 64; len++) {
+        lengths.insert(a(s));
+        s += static_cast<char>('a' + len % 26);
+    }
+    assert(lengths.size() == 65);
+    cout << "[PASS] Lengths 0..64 hash distinctly" << endl;
+}
+
+void testCollisions() {
+    cout << "\n=== Testing Full-Width Collisions ===" << endl;
+
+    SeededHash<string> hasher(1);
+    vector<string> keys = studentIDs(10000);
+    vector<string> more = emails(10000);
+    keys.insert(keys.end(), more.begin(), more.end());
+    vector<string> courses = courseIDs();
+    keys.insert(keys.end(), courses.begin(), courses.end());
+
+    set<string> unique(keys.begin(), keys.end());
+    set<size_t> hashes;
+    for (const auto& key : unique) {
+        hashes.insert(hasher(key));
+    }
+    assert(hashes.size() == unique.size());
+    cout << "[PASS] No 64-bit collisions across " << unique.size() << " IDs" << endl;
+}
+
+void testAvalanche() {
+    cout << "\n=== Testing Avalanche ===" << endl;
+
+    SeededHash<string> hasher(7);
+    vector<string> keys = studentIDs(500);
+    vector<string> courses = courseIDs();
+    keys.insert(keys.end(), courses.begin(), courses.end());
+
+    // Flip each input bit; on average half the output bits should change
+    double totalFlipped = 0;
+    size_t trials = 0;
+    for (const auto& key : keys) {
+        uint64_t base = hasher(key);
+        for (size_t byte = 0; byte < key.size(); byte++) {
+            for (int bit = 0; bit < 8; bit++) {
+                string flipped = key;
+                flipped[byte] ^= static_cast<char>(1 << bit);
+                totalFlipped += popcount64(base ^ hasher(flipped));
+                trials++;
+            }
+        }
+    }
+    double avg = totalFlipped / trials;
+    cout << "Average output bits flipped: " << avg << " / 64" << endl;
+    assert(avg > 30.0 && avg < 34.0);
+    cout << "[PASS] Single-bit input changes flip ~32 output bits" << endl;
+}
+
+void testBucketDistribution() {
+    cout << "\n=== Testing Bucket Distribution (power-of-two mask) ===" << endl;
+
+    SeededHash<string> hasher(99);
+
+    struct Case { string name; vector<string> keys; size_t buckets; };
+    vector<Case> cases = {
+        {"student IDs", studentIDs(10000), 1024},
+        {"emails", emails(10000), 1024},
+        {"course IDs", courseIDs(), 64},
+    };
+
+    for (const auto& c : cases) {
+        double chi = normalizedChiSquare(c.keys, hasher, c.buckets);
+        cout << c.name << ": normalized chi-square = " << chi << endl;
+        assert(chi > 0.7 && chi < 1.3);
+        cout << "[PASS] " << c.name << " spread uniformly over " << c.buckets << " buckets" << endl;
+    }
+}
+
+void testTablesWithPolicy() {
+    cout << "\n=== Testing Tables with SeededHash ===" << endl;
+
+    HashTable<string, int, SeededHash<string>> chained(100, SeededHash<string>(3));
+    assert(chained.bucketCount() == 128);  // Rounded to a power of two
+    FlatHashTable<string, int, SeededHash<string>> flat;
+
+    vector<string> keys = studentIDs(5000);
+    for (size_t i = 0; i < keys.size(); i++) {
+        chained.insert(keys[i], static_cast<int>(i));
+        flat.insert(keys[i], static_cast<int>(i));
+    }
+    assert((chained.bucketCount() & (chained.bucketCount() - 1)) == 0);
+    for (size_t i = 0; i < keys.size(); i++) {
+        assert(*chained.get(keys[i]) == static_cast<int>(i));
+        assert(*flat.get(string_view(keys[i])) == static_cast<int>(i));
+    }
+    assert(!chained.contains("BSCS99999"));
+    assert(!flat.contains("BSCS99999"));
+    cout << "[PASS] HashTable and FlatHashTable work with the seeded policy" << endl;
+}
+
+int main() {
+    cout << "========================================" << endl;
+    cout << "  Hash Quality Test" << endl;
+    cout << "========================================" << endl;
+
+    testDeterminismAndSeeds();
+    testCollisions();
+    testAvalanche();
+    testBucketDistribution();
+    testTablesWithPolicy();
+
+    cout << "\n========================================" << endl;
+    cout << "All tests passed!" << endl;
+    cout << "========================================" << endl;
+
+    return 0;
+}
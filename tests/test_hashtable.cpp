@@ -0,0 +1,173 @@
+#undef NDEBUG  // Checks must run in Release builds too
+#include <iostream>
+#include <cassert>
+#include <random>
+#include <string>
+#include <vector>
+#include "../database/HashTable.h"
+#include "../database/SeededHash.h"
+
+using namespace std;
+
+// HashTable checks for incremental growth, under both bucket policies
+// (prime modulus and power-of-two mask): lookups, updates and removes while
+// old buckets are still migrating, value pointers that survive every
+// migration, reserve(), and clear() in the middle of a rehash.
+
+string studentID(int i) {
+    string roll = to_string(i % 1000);
+    return "BSCS" + to_string(18 + i / 1000) + string(3 - roll.size(), '0') + roll;
+}
+
+template<typename Hash>
+void testIncrementalRehash(const string& name) {
+    HashTable<string, int, Hash> table(7);
+    const auto& view = table;  // Const lookups never advance the migration
+    const int COUNT = 20000;
+    vector<int*> saved;
+    mt19937 rng(1);
+    int growths = 0;
+
+    for (int i = 0; i < COUNT; i++) {
+        size_t buckets = table.bucketCount();
+        table.insert(studentID(i), i);
+        saved.push_back(table.get(studentID(i)));
+        assert(saved.back() != nullptr && *saved.back() == i);
+
+        if (table.bucketCount() != buckets) {
+            // Growth just started: every key is still found, in whichever
+            // table holds it, and listed exactly once
+            growths++;
+            for (int j = 0; j <= i; j++) {
+                assert(view.get(studentID(j)) == saved[j]);
+            }
+            assert(table.getAllPairs().size() == static_cast<size_t>(i + 1));
+        }
+
+        // Reads between inserts move old buckets; the entry must not move
+        int j = rng() % (i + 1);
+        assert(table.get(studentID(j)) == saved[j]);
+    }
+    assert(growths >= 8);
+    assert(table.size() == static_cast<size_t>(COUNT));
+    assert(table.loadFactor() <= table.maxLoadFactor());
+
+    for (int i = 0; i < COUNT; i++) {
+        assert(table.get(studentID(i)) == saved[i] && *saved[i] == i);
+    }
+    *saved[42] = -42;  // Writes through a saved pointer land in the table
+    assert(*table.get(studentID(42)) == -42);
+    cout << "[PASS] " << name << ": " << growths << " incremental growths kept every key and pointer" << endl;
+}
+
+template<typename Hash>
+void testWritesDuringRehash(const string& name) {
+    HashTable<string, int, Hash> table(7);
+    const int COUNT = 5000;
+    int i = 0;
+    // Fill until a large growth starts, so its migration spans many operations
+    for (;;) {
+        size_t buckets = table.bucketCount();
+        table.insert(studentID(i), i);
+        i++;
+        if (i >= COUNT && table.bucketCount() != buckets) break;
+    }
+    int filled = i;
+
+    // Remove odd keys and update even ones while the old buckets drain
+    for (int k = 1; k < filled; k += 2) {
+        assert(table.remove(studentID(k)));
+        assert(!table.remove(studentID(k)));
+    }
+    for (int k = 0; k < filled; k += 2) {
+        assert(table.update(studentID(k), -k));
+    }
+    assert(!table.update(studentID(filled), 0));
+    assert(table.size() == static_cast<size_t>((filled + 1) / 2));
+    auto pairs = table.getAllPairs();
+    assert(pairs.size() == table.size());
+    for (const auto& p : pairs) {
+        assert(p.second <= 0 && p.first == studentID(-p.second));
+    }
+    for (int k = 0; k < filled; k++) {
+        assert(table.contains(studentID(k)) == (k % 2 == 0));
+    }
+    cout << "[PASS] " << name << ": removes and updates during a rehash" << endl;
+
+    // clear() drops both tables, even mid-migration
+    size_t buckets = table.bucketCount();
+    for (int k = filled; table.bucketCount() == buckets; k++) {
+        table.insert(studentID(k), k);
+    }
+    table.clear();
+    assert(table.isEmpty() && table.getAllPairs().empty());
+    assert(!table.contains(studentID(0)));
+    table.insert(studentID(0), 0);
+    assert(table.size() == 1 && *table.get(studentID(0)) == 0);
+    cout << "[PASS] " << name << ": clear during a rehash" << endl;
+}
+
+template<typename Hash>
+void testReserve(const string& name) {
+    HashTable<string, int, Hash> table(7);
+    const int COUNT = 10000;
+    table.reserve(COUNT);
+    size_t buckets = table.bucketCount();
+    assert(buckets >= static_cast<size_t>(COUNT));
+    for (int i = 0; i < COUNT; i++) {
+        table.insert(studentID(i), i);
+    }
+    assert(table.bucketCount() == buckets);  // Never had to grow
+    table.reserve(COUNT / 2);                 // Shrinking is a no-op
+    assert(table.bucketCount() == buckets);
+
+    // Reserving mid-migration finishes it first and keeps every pointer
+    HashTable<string, int, Hash> growing(7);
+    vector<int*> saved;
+    int i = 0;
+    for (;;) {
+        size_t start = growing.bucketCount();
+        growing.insert(studentID(i), i);
+        saved.push_back(growing.get(studentID(i)));
+        i++;
+        if (i >= 1000 && growing.bucketCount() != start) break;
+    }
+    growing.reserve(4 * i);
+    assert(growing.bucketCount() >= static_cast<size_t>(4 * i));
+    assert(growing.getAllPairs().size() == static_cast<size_t>(i));
+    for (int k = 0; k < i; k++) {
+        assert(growing.get(studentID(k)) == saved[k] && *saved[k] == k);
+    }
+
+    // A lower maximum load factor grows the table right away
+    table.setMaxLoadFactor(0.5f);
+    assert(table.bucketCount() > buckets && table.loadFactor() <= 0.5f);
+    for (int k = 0; k < COUNT; k++) {
+        assert(*table.get(studentID(k)) == k);
+    }
+    cout << "[PASS] " << name << ": reserve and setMaxLoadFactor" << endl;
+}
+
+template<typename Hash>
+void testPolicy(const string& name) {
+    cout << "\n=== Testing " << name << " ===" << endl;
+
+    testIncrementalRehash<Hash>(name);
+    testWritesDuringRehash<Hash>(name);
+    testReserve<Hash>(name);
+}
+
+int main() {
+    cout << "========================================" << endl;
+    cout << "  Hash Table Test" << endl;
+    cout << "========================================" << endl;
+
+    testPolicy<KeyHash<string>>("Prime buckets");
+    testPolicy<SeededHash<string>>("Power-of-two buckets");
+
+    cout << "\n========================================" << endl;
+    cout << "All tests passed!" << endl;
+    cout << "========================================" << endl;
+
+    return 0;
+}
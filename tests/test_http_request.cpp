@@ -0,0 +1,134 @@
+#undef NDEBUG  // Checks must run in Release builds too
+#include <iostream>
+#include <cassert>
+#include <fstream>
+#include <filesystem>
+#include <string>
+#include "../backend/HTTPServer.h"
+
+using namespace std;
+
+// HTTPRequest checks: views into the httplib Request (no copies), query
+// and path parameter lookup, case-insensitive headers and the debug-level
+// request dump, and handler exceptions turned into valid JSON errors.
+
+Request makeRequest() {
+    Request req;
+    req.method = "GET";
+    req.path = "/api/student/viewCourses";
+    req.target = "/api/student/viewCourses?semester=3&studentID=BSCS22001&name=Ali%20Khan";
+    req.params.emplace("semester", "3");
+    req.params.emplace("studentID", "BSCS22001");
+    req.params.emplace("name", "Ali Khan");       // httplib decodes the query
+    req.params.emplace("empty", "");
+    req.headers.emplace("Content-Type", "application/json");
+    req.headers.emplace("If-None-Match", "\"abc\"");
+    req.body = R"({"courseID":"CS101"})";
+    return req;
+}
+
+void testViews() {
+    cout << "\n=== Testing Views ===" << endl;
+
+    Request raw = makeRequest();
+    HTTPRequest req(raw);
+    assert(req.method == "GET" && req.method.data() == raw.method.data());
+    assert(req.path == "/api/student/viewCourses" && req.path.data() == raw.path.data());
+    assert(req.body.data() == raw.body.data() && req.body.size() == raw.body.size());
+
+    assert(req.hasParam("semester") && req.param("semester") == "3");
+    assert(req.param("name") == "Ali Khan");
+    assert(req.param("studentID").data() == raw.params.find("studentID")->second.data());
+    assert(req.hasParam("empty") && req.param("empty", "x") == "");
+    assert(!req.hasParam("page") && req.param("page", "1") == "1");
+    assert(!req.hasParam("Semester"));  // Parameter names are case-sensitive
+    cout << "[PASS] Fields and query parameters view the Request" << endl;
+}
+
+void testPathParamsAndHeaders() {
+    cout << "\n=== Testing Path Params and Headers ===" << endl;
+
+    Request raw = makeRequest();
+    string path = "/api/student/BSCS22999/timetable";
+    HTTPRequest::PathParams pathParams = {{"studentID", string_view(path).substr(13, 9)}};
+    HTTPRequest req(raw, pathParams);
+    assert(req.param("studentID") == "BSCS22999");  // Path segment wins over the query
+    assert(req.param("semester") == "3");
+
+    assert(req.header("content-type") == "application/json");
+    assert(req.header("IF-NONE-MATCH") == "\"abc\"");
+    assert(req.header("Authorization", "none") == "none");
+    assert(req.header("Content-Typ").empty());
+    cout << "[PASS] Path parameters and case-insensitive headers" << endl;
+}
+
+void testLog() {
+    cout << "\n=== Testing Debug Dump ===" << endl;
+
+    string path = (filesystem::temp_directory_path() / "ums_test_http_request.log").string();
+    filesystem::remove(path);
+    AsyncLogger& logger = AsyncLogger::instance();
+    assert(logger.start(path));
+
+    Request raw = makeRequest();
+    HTTPRequest req(raw, {{"courseID", "CS101"}});
+    logger.setLevel(LogLevel::Info);
+    req.log();                             // Below the level: nothing written
+    logger.setLevel(LogLevel::Debug);
+    req.log();
+    logger.stop();
+
+    ifstream in(path);
+    string dump((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    assert(dump.find("[HTTPRequest] GET " + raw.target) != string::npos);
+    assert(dump.find("path  [courseID] = [CS101]") != string::npos);
+    assert(dump.find("query [name] = [Ali Khan]") != string::npos);
+    assert(dump.find("header If-None-Match: \"abc\"") != string::npos);
+    assert(dump.find("[HTTPRequest] GET") == dump.rfind("[HTTPRequest] GET"));  // Logged once
+    filesystem::remove(path);
+    cout << "[PASS] Request line, parameters and headers logged at debug level" << endl;
+}
+
+void testHandlerException() {
+    cout << "\n=== Testing Handler Exceptions ===" << endl;
+
+    string dir = (filesystem::temp_directory_path() / "ums_test_http_request_db").string();
+    filesystem::remove_all(dir);
+    {
+        AsyncLogger::instance().setLevel(LogLevel::Off);  // The failure is logged as an error
+        DatabaseManager db(dir);
+        HTTPServer server(0, db);
+        server.get("/throws", [](const HTTPRequest&, DatabaseManager&) -> HTTPResponse {
+            throw runtime_error("bad \"quote\" and \\ backslash");
+        });
+        Request req;
+        req.method = "GET";
+        req.path = "/throws";
+        Response res;
+        server.handle(req, res);
+        AsyncLogger::instance().setLevel(LogLevel::Info);
+
+        JSONDocument body;
+        assert(res.status == 500 && body.parse(res.body));
+        assert(body.getString("error") == "bad \"quote\" and \\ backslash");
+    }
+    filesystem::remove_all(dir);
+    cout << "[PASS] Exception messages escaped in the 500 body" << endl;
+}
+
+int main() {
+    cout << "========================================" << endl;
+    cout << "  HTTP Request Test" << endl;
+    cout << "========================================" << endl;
+
+    testViews();
+    testPathParamsAndHeaders();
+    testLog();
+    testHandlerException();
+
+    cout << "\n========================================" << endl;
+    cout << "All tests passed!" << endl;
+    cout << "========================================" << endl;
+
+    return 0;
+}
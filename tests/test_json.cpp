@@ -0,0 +1,228 @@
+#undef NDEBUG  // Checks must run in Release builds too
+#include <iostream>
+#include <cassert>
+#include <string>
+#include "../backend/utils/JSONDocument.h"
+#include "../backend/utils/JSONParser.h"
+#include "../backend/utils/JsonWriter.h"
+
+using namespace std;
+
+// JSONDocument checks: request bodies the frontends send, nesting that
+// the old comma-splitting parser broke on, escapes, typed accessors and
+// malformed input; plus JSONParser::parse on top of it. JsonWriter output
+// is checked as text and by parsing it back.
+
+void testRequestBodies() {
+    cout << "\n=== Testing Request Bodies ===" << endl;
+
+    JSONDocument doc;
+    string body = R"({"studentID":"BSCS22001","name":"Ali Khan","email":"bscs22001@itu.edu.pk",)"
+                  R"("password":"2001","semester":3})";
+    assert(doc.parse(body));
+    assert(doc.root().isObject() && doc.root().size() == 5);
+    assert(doc.getString("studentID") == "BSCS22001");
+    assert(doc.getString("name") == "Ali Khan");
+    assert(doc.getInt("semester", 1) == 3);
+    assert(doc.getString("contact") == "");
+    assert(doc.getString("password", "student123") == "2001");
+    assert(doc.getString("missing", "student123") == "student123");
+
+    // Unescaped strings are views into the body
+    string_view id = doc["studentID"].asString();
+    assert(id.data() >= body.data() && id.data() < body.data() + body.size());
+
+    string window = "{ \"startTime\" : 1735689600,\n \"endTime\": 4102444800, \"isOpen\": true }";
+    assert(doc.parse(window));
+    assert(doc.getInt64("startTime") == 1735689600);
+    assert(doc.getInt64("endTime") == 4102444800LL);
+    assert(doc.getInt("endTime", -1) == -1);  // Does not fit an int
+    assert(doc.getBool("isOpen", false));
+
+    // Values typed loosely by older clients
+    assert(doc.parse(R"({"semester":"4","isOpen":"1","count":2.9,"flag":0})"));
+    assert(doc.getInt("semester") == 4);
+    assert(doc.getBool("isOpen"));
+    assert(doc.getInt("count") == 2);
+    assert(!doc.getBool("flag", true));
+    assert(doc.getString("count") == "2.9");
+    cout << "[PASS] Frontend bodies and typed accessors" << endl;
+}
+
+void testNesting() {
+    cout << "\n=== Testing Nesting ===" << endl;
+
+    JSONDocument doc;
+    string body = R"({"course":{"id":"CS101","slots":[{"day":1},{"day":3}]},)"
+                  R"("courses":["CS101","MATH201",7,"PHY101"],"empty":[],"obj":{},"after":"x, y"})";
+    assert(doc.parse(body));
+    assert(doc.root().size() == 5);
+    assert(doc["course"]["id"].asString() == "CS101");
+    assert(doc["course"]["slots"].size() == 2);
+    assert(doc["course"]["slots"].at(1)["day"].asInt() == 3);
+    assert(!doc["course"]["slots"].at(2).exists());
+    assert(doc["course"].text() == R"({"id":"CS101","slots":[{"day":1},{"day":3}]})");
+    assert(doc["empty"].isArray() && doc["empty"].size() == 0);
+    assert(doc["empty"].begin() == doc["empty"].end());
+    assert(doc["obj"].isObject() && doc["obj"].size() == 0);
+    assert(doc.getString("after") == "x, y");
+
+    vector<string> courses = doc.getStringArray("courses");
+    assert((courses == vector<string>{"CS101", "MATH201", "PHY101"}));
+    assert(doc.getStringArray("after").empty());
+
+    // Member iteration in document order
+    string keys;
+    for (auto it = doc.root().begin(); it != doc.root().end(); ++it) {
+        keys += string(it.key()) + ";";
+    }
+    assert(keys == "course;courses;empty;obj;after;");
+
+    // Wrong-type lookups give defaults instead of throwing
+    assert(!doc["courses"]["id"].exists());
+    assert(!doc["after"].at(0).exists());
+    assert(doc["course"].asInt(-1) == -1);
+    assert(doc["missing"]["deeper"].asString("d") == "d");
+    cout << "[PASS] Nested objects and arrays" << endl;
+}
+
+void testStrings() {
+    cout << "\n=== Testing Strings ===" << endl;
+
+    JSONDocument doc;
+    assert(doc.parse(R"({"q":"say \"hi\"\\now","path":"a\/b","ws":"tab\there\nline",)"
+                     R"("u":"caf\u00e9 \u20ac \ud83d\ude00"})"));
+    assert(doc.getString("q") == "say \"hi\"\\now");
+    assert(doc.getString("path") == "a/b");
+    assert(doc.getString("ws") == "tab\there\nline");
+    assert(doc.getString("u") == "caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80");
+
+    // Escaped keys match their decoded name
+    assert(doc.parse(R"({"na\u006de":"x"})"));
+    assert(doc.getString("name") == "x");
+
+    // Many escaped strings: arena views stay valid
+    string body = "[";
+    for (int i = 0; i < 500; i++) {
+        body += string(i ? "," : "") + "\"v\\n" + to_string(i) + "\"";
+    }
+    body += "]";
+    assert(doc.parse(body));
+    assert(doc.root().size() == 500);
+    int i = 0;
+    for (auto value : doc.root()) {
+        assert(value.asString() == "v\n" + to_string(i++));
+    }
+    cout << "[PASS] Escapes, unicode and arena stability" << endl;
+}
+
+void testMalformed() {
+    cout << "\n=== Testing Malformed Input ===" << endl;
+
+    const char* bad[] = {
+        "", "   ", "{", "}", "{\"a\"}", "{\"a\":}", "{\"a\":1,}", "{a:1}", "[1,2", "[1 2]",
+        "{\"a\":1}x", "{\"a\":01}", "{\"a\":-}", "{\"a\":1.}", "{\"a\":tru}", "\"open",
+        "{\"a\":\"\\x\"}", "{\"a\":\"\\u12\"}", "{\"a\":\"\\ud800\"}", "{'a':1}"
+    };
+    JSONDocument doc;
+    for (const char* json : bad) {
+        assert(!doc.parse(json));
+        assert(!doc.error().empty());
+        assert(!doc.root().exists());
+        assert(doc.getString("a", "default") == "default");
+    }
+
+    string deep(100, '[');
+    assert(!doc.parse(deep + string(100, ']')));
+    string ok(60, '[');
+    assert(doc.parse(ok + string(60, ']')));
+
+    assert(doc.parse(" 42 ") && doc.root().asInt() == 42);
+    assert(doc.parse("null") && doc.root().isNull());
+    cout << "[PASS] Malformed documents rejected" << endl;
+}
+
+void testJSONParserMap() {
+    cout << "\n=== Testing JSONParser::parse ===" << endl;
+
+    auto data = JSONParser::parse(R"({"success":"true","token":"ab,cd","list":["a","b"],"n":5})");
+    assert(data.size() == 4);
+    assert(JSONParser::getString(data, "success") == "true");
+    assert(JSONParser::getString(data, "token") == "ab,cd");
+    assert(data["list"] == R"(["a","b"])");
+    assert(JSONParser::getInt(data, "n") == 5);
+    assert(JSONParser::parse("not json").empty());
+    cout << "[PASS] Map view of the top-level members" << endl;
+}
+
+void testWriter() {
+    cout << "\n=== Testing JsonWriter ===" << endl;
+
+    string buffer;
+    JsonWriter json(buffer);
+    json.beginObject()
+        .member("success", "true")
+        .key("total").quoted(size_t(1200))
+        .member("open", false)
+        .key("students").beginArray();
+    for (int i = 0; i < 2; i++) {
+        json.beginObject()
+            .member("studentID", "BSCS2200" + to_string(i))
+            .member("semester", i + 1)
+            .key("courses").beginArray().value("CS101").value(string("MATH201")).endArray()
+            .endObject();
+    }
+    json.endArray()
+        .key("empty").beginObject().endObject()
+        .key("none").null()
+        .key("raw").raw("[1,2]")
+        .member("min", INT64_MIN)
+        .endObject();
+    assert(buffer == R"({"success":"true","total":"1200","open":false,"students":[)"
+                     R"({"studentID":"BSCS22000","semester":1,"courses":["CS101","MATH201"]},)"
+                     R"({"studentID":"BSCS22001","semester":2,"courses":["CS101","MATH201"]}],)"
+                     R"("empty":{},"none":null,"raw":[1,2],"min":-9223372036854775808})");
+    cout << "[PASS] Nesting, commas and integer formatting" << endl;
+
+    // Names and strings are escaped; the parser reads back the originals
+    string tricky = "Ali \"The Ace\" Khan\\\n\t\x01 caf\xc3\xa9";
+    JsonWriter escaped(buffer);
+    escaped.beginObject().member("na\"me", tricky).endObject();
+    assert(buffer == "{\"na\\\"me\":\"Ali \\\"The Ace\\\" Khan\\\\\\n\\t\\u0001 caf\xc3\xa9\"}");
+    JSONDocument doc;
+    assert(doc.parse(buffer));
+    assert(doc.getString("na\"me") == tricky);
+
+    // The thread's buffer is reused, not reallocated, by the next writer
+    const char* data;
+    {
+        JsonWriter first;
+        first.beginArray();
+        for (int i = 0; i < 1000; i++) first.value(i);
+        first.endArray();
+        data = first.str().data();
+    }
+    JsonWriter second;
+    second.beginArray().value(7).endArray();
+    assert(second.str() == "[7]" && second.str().data() == data);
+    cout << "[PASS] Escaping round trip and buffer reuse" << endl;
+}
+
+int main() {
+    cout << "========================================" << endl;
+    cout << "  JSON Parser Test" << endl;
+    cout << "========================================" << endl;
+
+    testRequestBodies();
+    testNesting();
+    testStrings();
+    testMalformed();
+    testJSONParserMap();
+    testWriter();
+
+    cout << "\n========================================" << endl;
+    cout << "All tests passed!" << endl;
+    cout << "========================================" << endl;
+
+    return 0;
+}
@@ -0,0 +1,189 @@
+#undef NDEBUG  // Checks must run in Release builds too
+#include <iostream>
+#include <cassert>
+#include <fstream>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../database/Logger.h"
+
+using namespace std;
+
+// AsyncLogger checks: LogRing wrap-around and overflow, disabled levels skipping
+// argument evaluation, value formatting and truncation, and many threads
+// logging through the sink into one file without losing or reordering
+// their own lines.
+
+string logPath() {
+    return (filesystem::temp_directory_path() / "ums_test_logger.log").string();
+}
+
+vector<string> readLines(const string& path) {
+    vector<string> lines;
+    ifstream in(path);
+    string line;
+    while (getline(in, line)) lines.push_back(line);
+    return lines;
+}
+
+void testRing() {
+    cout << "\n=== Testing LogRing ===" << endl;
+
+    auto ring = make_unique<LogRing>(1);
+    size_t pushed = 0;
+    while (ring->push(LogLevel::Info, "Ring", 0, "x", 1) > 0) pushed++;
+    assert(pushed == LogRing::CAPACITY);
+    assert(ring->dropped == 1);
+
+    // Wrap around several times, draining in between
+    size_t drained = ring->drain([](const LogRing::Record&) {});
+    assert(drained == LogRing::CAPACITY && ring->empty());
+    for (int round = 0; round < 5; round++) {
+        for (int i = 0; i < 300; i++) {
+            string text = to_string(round * 300 + i);
+            assert(ring->push(LogLevel::Debug, "Ring", i, text.data(), text.size()) == size_t(i + 1));
+        }
+        int expected = round * 300;
+        ring->drain([&](const LogRing::Record& r) {
+            assert(string(r.text, r.length) == to_string(expected++));
+        });
+        assert(expected == (round + 1) * 300);
+    }
+    cout << "[PASS] Capacity, overflow count and wrap-around" << endl;
+}
+
+void testLevels() {
+    cout << "\n=== Testing Levels ===" << endl;
+
+    AsyncLogger& logger = AsyncLogger::instance();
+    logger.setLevel(LogLevel::Error);
+    int evaluated = 0;
+    auto touch = [&evaluated]() { return ++evaluated; };
+    LOG_DEBUG("Test") << touch();
+    LOG_INFO("Test") << touch();
+    LOG_WARN("Test") << touch();
+    assert(evaluated == 0);  // Disabled: arguments never evaluated
+
+    logger.setLevel(LogLevel::Off);
+    LOG_ERROR("Test") << touch();
+    assert(evaluated == 0);
+
+    // Dangling else: the macro must not capture it
+    bool tookElse = false;
+    if (evaluated > 0)
+        LOG_ERROR("Test") << "unreachable";
+    else
+        tookElse = true;
+    assert(tookElse);
+    cout << "[PASS] Disabled levels cost a load and a compare" << endl;
+}
+
+void testFileSink() {
+    cout << "\n=== Testing File Sink ===" << endl;
+
+    AsyncLogger& logger = AsyncLogger::instance();
+    string path = logPath();
+    filesystem::remove(path);
+    assert(logger.start(path));
+    logger.setLevel(LogLevel::Debug);
+
+    string name = "CS101";
+    LOG_DEBUG("Test") << "course " << name << " seats " << -42 << " open " << true
+                      << " load " << 2.5 << " id " << 18446744073709551615ULL << ' ' << 'x';
+    LOG_WARN("Test") << string(1000, 'a');
+    auto nested = []() {
+        LOG_INFO("Inner") << "while formatting";
+        return 7;
+    };
+    LOG_INFO("Outer") << "value " << nested();
+    logger.flush();
+
+    vector<string> lines = readLines(path);
+    assert(lines.size() == 4);
+    assert(lines[0].size() > 24 && lines[0][4] == '-' && lines[0][19] == '.');  // Timestamp
+    assert(lines[0].find("DEBUG [T") != string::npos);
+    assert(lines[0].find("[Test] course CS101 seats -42 open true load 2.5 id 18446744073709551615 x")
+           != string::npos);
+    assert(lines[1].find("WARN ") != string::npos);
+    assert(lines[1].substr(lines[1].find("] a") + 2) == string(LogRing::MESSAGE_SIZE, 'a'));
+    assert(lines[2].find("[Inner] while formatting") != string::npos);
+    assert(lines[3].find("[Outer] value 7") != string::npos);
+
+    logger.stop();
+    LOG_INFO("Test") << "after stop goes to stdout";
+    assert(readLines(path).size() == 4);
+    cout << "[PASS] Formatting, truncation and batched file output" << endl;
+}
+
+void testThreads() {
+    cout << "\n=== Testing Threads ===" << endl;
+
+    AsyncLogger& logger = AsyncLogger::instance();
+    string path = logPath();
+    filesystem::remove(path);
+    assert(logger.start(path));
+    logger.setLevel(LogLevel::Info);
+
+    // Fewer lines per thread than a ring holds: nothing may be dropped
+    const int THREADS = 4, LINES = 400;
+    vector<thread> threads;
+    for (int t = 0; t < THREADS; t++) {
+        threads.emplace_back([t]() {
+            for (int i = 0; i < LINES; i++) {
+                LOG_INFO("Worker") << "w" << t << " line " << i;
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    // A burst far past the ring: every line is either written or counted
+    size_t droppedBefore = logger.droppedCount();
+    const int BURST = 20000;
+    thread burst([]() {
+        for (int i = 0; i < BURST; i++) LOG_INFO("Burst") << i;
+    });
+    burst.join();
+    logger.flush();
+    logger.stop();
+
+    vector<int> next(THREADS, 0);
+    size_t burstLines = 0;
+    int lastBurst = -1;
+    for (const string& line : readLines(path)) {
+        size_t tagPos = line.find("[Worker] w");
+        if (tagPos != string::npos) {
+            int t = line[tagPos + 10] - '0';
+            int i = stoi(line.substr(line.rfind(' ') + 1));
+            assert(i == next[t]++);  // Per-thread order preserved
+        } else if ((tagPos = line.find("[Burst] ")) != string::npos) {
+            int i = stoi(line.substr(tagPos + 8));
+            assert(i > lastBurst);
+            lastBurst = i;
+            burstLines++;
+        }
+    }
+    for (int t = 0; t < THREADS; t++) assert(next[t] == LINES);
+    assert(burstLines + (logger.droppedCount() - droppedBefore) == static_cast<size_t>(BURST));
+    cout << "[PASS] " << THREADS * LINES << " lines from " << THREADS << " threads, burst wrote "
+         << burstLines << "/" << BURST << " (rest counted as dropped)" << endl;
+
+    filesystem::remove(path);
+}
+
+int main() {
+    cout << "========================================" << endl;
+    cout << "  AsyncLogger Test" << endl;
+    cout << "========================================" << endl;
+
+    testRing();
+    testLevels();
+    testFileSink();
+    testThreads();
+
+    cout << "\n========================================" << endl;
+    cout << "All tests passed!" << endl;
+    cout << "========================================" << endl;
+
+    return 0;
+}
@@ -0,0 +1,276 @@
+#undef NDEBUG  // Checks must run in Release builds too
+#include <iostream>
+#include <cassert>
+#include <map>
+#include <random>
+#include <string>
+#include <fstream>
+#include <filesystem>
+#include "../database/PagedBPlusTree.h"
+#include "../database/PagedStorage.h"
+
+using namespace std;
+namespace fs = std::filesystem;
+
+// PagedBPlusTree and PagedStorage checks: random operations against
+// std::map through a buffer pool far smaller than the file, reopening
+// without a rebuild, overflow records, and the storage interface.
+
+string testDir;
+
+string studentID(int i) {
+    string roll = to_string(i % 1000);
+    return "BSCS" + to_string(18 + i / 1000) + string(3 - roll.size(), '0') + roll;
+}
+
+// Record of a size picked by the step: mostly small, some larger than a page
+string record(mt19937& rng) {
+    size_t length = (rng() % 10 == 0) ? 1000 + rng() % 5000 : rng() % 200;
+    string value(length, '\0');
+    for (auto& c : value) c = static_cast<char>('a' + rng() % 26);
+    return value;
+}
+
+void checkMatches(PagedBPlusTree& tree, const map<string, string>& expected) {
+    assert(tree.size() == expected.size());
+    auto cursor = tree.begin();
+    for (const auto& entry : expected) {
+        assert(cursor.valid());
+        assert(cursor.key() == entry.first);
+        assert(cursor.value() == entry.second);
+        cursor.next();
+    }
+    assert(!cursor.valid());
+}
+
+void testRandomOperations() {
+    cout << "\n=== Testing Random Operations ===" << endl;
+
+    string path = testDir + "/random.db";
+    map<string, string> expected;
+    mt19937 rng(42);
+    {
+        PagedBPlusTree tree(path, 1024, 8);  // 8 KiB of cache for a file many times that
+        for (int step = 0; step < 20000; step++) {
+            string key = studentID(rng() % 3000);
+            int op = rng() % 4;
+            if (op == 0) {
+                assert(tree.remove(key) == (expected.erase(key) == 1));
+            } else {
+                string value = record(rng);
+                assert(tree.insert(key, value));
+                expected[key] = value;
+            }
+        }
+        checkMatches(tree, expected);
+
+        for (int i = 0; i < 3000; i++) {
+            string value;
+            auto it = expected.find(studentID(i));
+            assert(tree.get(studentID(i), value) == (it != expected.end()));
+            assert(tree.contains(studentID(i)) == (it != expected.end()));
+            if (it != expected.end()) {
+                assert(value == it->second);
+            }
+        }
+        assert(tree.getPageCount() * tree.getPageSize() > 50 * 8 * 1024);
+        assert(tree.getBufferPool().missCount() > 0);
+    }
+    cout << "[PASS] Matches std::map with the file 50x the buffer pool" << endl;
+
+    // Reopen: the header alone locates the data
+    {
+        PagedBPlusTree tree(path, 1024, 8);
+        assert(!tree.wasCreated());
+        checkMatches(tree, expected);
+    }
+    cout << "[PASS] Reopened tree holds the same entries" << endl;
+}
+
+void testCursors() {
+    cout << "\n=== Testing Cursors ===" << endl;
+
+    PagedBPlusTree tree(testDir + "/cursor.db", 1024, 16);
+    for (int i = 0; i < 2000; i += 2) {
+        tree.insert(studentID(i), to_string(i));
+    }
+
+    auto cursor = tree.lowerBound(studentID(501));
+    assert(cursor.valid() && cursor.key() == studentID(502));
+    cursor = tree.lowerBound(studentID(502));
+    assert(cursor.key() == studentID(502));
+    cursor = tree.upperBound(studentID(502));
+    assert(cursor.key() == studentID(504));
+    assert(!tree.upperBound(studentID(1998)).valid());
+    assert(tree.lowerBound("A").key() == studentID(0));
+
+    // skip() crosses leaves by cell count
+    cursor = tree.begin();
+    cursor.skip(700);
+    assert(cursor.valid() && cursor.value() == "1400");
+    cursor.skip(300);
+    assert(!cursor.valid());
+
+    // Emptied leaves stay in the chain and are stepped over
+    for (int i = 200; i < 1800; i += 2) {
+        assert(tree.remove(studentID(i)));
+    }
+    cursor = tree.lowerBound(studentID(199));
+    assert(cursor.valid() && cursor.key() == studentID(1800));
+    cursor = tree.begin();
+    cursor.skip(100);
+    assert(cursor.key() == studentID(1800));
+    cout << "[PASS] lowerBound/upperBound/skip across leaves" << endl;
+}
+
+void testPageReuse() {
+    cout << "\n=== Testing Page Reuse ===" << endl;
+
+    PagedBPlusTree tree(testDir + "/reuse.db", 4096, 8);
+    string big(100000, 'x');
+    for (int i = 0; i < 10; i++) {
+        tree.insert(studentID(i), big);
+    }
+    size_t pages = tree.getPageCount();
+
+    // Freed overflow chains are reused before the file grows
+    for (int round = 0; round < 5; round++) {
+        for (int i = 0; i < 10; i++) {
+            assert(tree.remove(studentID(i)));
+        }
+        for (int i = 0; i < 10; i++) {
+            tree.insert(studentID(i), big);
+        }
+        for (int i = 0; i < 10; i++) {
+            tree.insert(studentID(i), big);  // Replace: frees the old chain
+        }
+    }
+    assert(tree.getPageCount() <= pages + 30);
+    string value;
+    assert(tree.get(studentID(3), value) && value == big);
+    cout << "[PASS] " << pages << " pages after the first load, " << tree.getPageCount()
+         << " after 5 rewrite rounds" << endl;
+
+    // Ascending keys pack leaves densely
+    PagedBPlusTree dense(testDir + "/dense.db", 4096, 8);
+    for (int i = 0; i < 20000; i++) {
+        dense.insert(studentID(i), string(100, 'v'));
+    }
+    size_t cellBytes = 20000 * (7 + 9 + 100 + 2);
+    size_t minimumPages = cellBytes / (4096 - 8);
+    assert(dense.getPageCount() < minimumPages * 115 / 100);
+    cout << "[PASS] Sequential load: " << dense.getPageCount() << " pages (minimum "
+         << minimumPages << ")" << endl;
+
+    assert(!dense.insert(string(dense.maxKeySize() + 1, 'k'), "v"));
+    assert(dense.insert(string(dense.maxKeySize(), 'k'), "v"));
+    cout << "[PASS] Keys longer than maxKeySize() are rejected" << endl;
+}
+
+void testPageSizes() {
+    cout << "\n=== Testing Page Sizes ===" << endl;
+
+    string path = testDir + "/large_pages.db";
+    {
+        PagedBPlusTree tree(path, 16384, 8);
+        for (int i = 0; i < 5000; i++) {
+            tree.insert(studentID(i), to_string(i));
+        }
+    }
+    {
+        PagedBPlusTree tree(path, 4096, 8);  // The file's page size wins
+        assert(tree.getPageSize() == 16384);
+        assert(tree.size() == 5000);
+        string value;
+        assert(tree.get(studentID(4321), value) && value == "4321");
+        tree.clear();
+        assert(tree.isEmpty() && !tree.begin().valid());
+    }
+    cout << "[PASS] 16 KiB pages, reopened with the stored page size" << endl;
+}
+
+Student makeStudent(int i) {
+    Student s;
+    s.studentID = studentID(i);
+    s.email = s.studentID + "@itu.edu.pk";
+    s.name = "Student " + to_string(i);
+    s.currentSemester = 1 + i % 8;
+    return s;
+}
+
+void testPagedStorage() {
+    cout << "\n=== Testing PagedStorage ===" << endl;
+
+    string base = testDir + "/students";
+    {
+        // A text data file from the in-memory backend is imported once
+        ofstream dat(base + ".dat");
+        for (int i = 0; i < 100; i++) {
+            dat << EntityCodec::serialize(makeStudent(i)) << "\n";
+        }
+    }
+    {
+        PagedStorage<Student> storage(base, 4096, 16);
+        assert(storage.size() == 100);
+
+        Student s;
+        assert(storage.get(studentID(42), s) && s.name == "Student 42");
+        assert(storage.exists(studentID(7)) && !storage.exists(studentID(500)));
+
+        s.name = "Renamed";
+        assert(storage.update(s));
+        assert(!storage.update(makeStudent(500)));
+        assert(storage.remove(studentID(0)) && !storage.remove(studentID(0)));
+
+        vector<Student> batch;
+        for (int i = 100; i < 1100; i++) batch.push_back(makeStudent(i));
+        batch.push_back(makeStudent(5));  // Already stored: skipped
+        assert(storage.addAll(batch) == 1000);
+        storage.setDurability(DurabilityPolicy::strict());
+        assert(storage.add(makeStudent(2000)));
+        assert(storage.size() == 1100);
+
+        auto page = storage.getPage(10, 20);
+        assert(page.size() == 20 && page[0].studentID == studentID(11));
+        auto after = storage.getPageAfter(page.back().studentID, 20);
+        assert(after.size() == 20 && after[0].studentID == studentID(31));
+        assert(storage.getPageAfter("", 1)[0].studentID == studentID(1));
+        assert(storage.getAll().size() == 1100);
+    }
+
+    // Reopen: nothing re-imported, changes kept
+    fs::remove(base + ".dat");
+    {
+        PagedStorage<Student> storage(base, 4096, 16);
+        assert(storage.size() == 1100);
+        Student s;
+        assert(storage.get(studentID(42), s) && s.name == "Renamed");
+        assert(!storage.exists(studentID(0)));
+        assert(storage.exists(studentID(2000)));
+    }
+    cout << "[PASS] Import, CRUD, paging and reopen" << endl;
+}
+
+int main() {
+    cout << "========================================" << endl;
+    cout << "  Paged Storage Test" << endl;
+    cout << "========================================" << endl;
+
+    testDir = (fs::temp_directory_path() / "ums_test_paged_storage").string();
+    fs::remove_all(testDir);
+    fs::create_directories(testDir);
+
+    testRandomOperations();
+    testCursors();
+    testPageReuse();
+    testPageSizes();
+    testPagedStorage();
+
+    fs::remove_all(testDir);
+
+    cout << "\n========================================" << endl;
+    cout << "All tests passed!" << endl;
+    cout << "========================================" << endl;
+
+    return 0;
+}
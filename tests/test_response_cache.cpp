@@ -0,0 +1,243 @@
+#undef NDEBUG  // Checks must run in Release builds too
+#include <iostream>
+#include <cassert>
+#include <filesystem>
+#include <string>
+#include "../backend/HTTPServer.h"
+#include "../backend/Routes.h"
+
+using namespace std;
+
+// ResponseCache keys, staleness and the byte cap; DatabaseManager write
+// generations; then HTTPServer serving a cached route until a write to a
+// store it reads from, and answering If-None-Match with 304; last, the real
+// route table rebuilding a cached response when any store it reads changes.
+
+ResponseCache::Entry makeEntry(const string& body) {
+    ResponseCache::Entry entry;
+    entry.body = make_shared<const string>(body);
+    return entry;
+}
+
+void testCache() {
+    cout << "\n=== Testing ResponseCache ===" << endl;
+
+    // Parameter order doesn't matter; names, values and repeats do
+    multimap<string, string> ab{{"a", "1"}, {"b", "2"}};
+    vector<pair<string, string>> ba{{"b", "2"}, {"a", "1"}};
+    assert(ResponseCache::key("/p", ab) == ResponseCache::key("/p", ba));
+    assert(ResponseCache::key("/p", ab) != ResponseCache::key("/q", ab));
+    multimap<string, string> joined{{"a", "1&b=2"}};
+    assert(ResponseCache::key("/p", ab) != ResponseCache::key("/p", joined));
+    cout << "[PASS] Keys normalize parameter order" << endl;
+
+    ResponseCache cache(4096);
+    ResponseCache::Entry out;
+    assert(!cache.lookup("k", {1, 2}, out));
+    cache.store("k", {1, 2}, makeEntry("body"));
+    assert(cache.lookup("k", {1, 2}, out) && *out.body == "body");
+    assert(!cache.lookup("k", {1, 3}, out));  // A store was written
+    assert(!cache.lookup("k", {1, 2}, out));  // ...and the stale entry is gone
+    ResponseCache::Stats stats = cache.stats();
+    assert(stats.hits == 1 && stats.misses == 3 && stats.stale == 1 && stats.entries == 0 && stats.bytes == 0);
+    cout << "[PASS] Entries go stale when a generation moves" << endl;
+
+    // Least recently used entries make room; oversized ones are not kept
+    string big(1000, 'x');
+    for (int i = 0; i < 3; i++) cache.store("k" + to_string(i), {0}, makeEntry(big));
+    assert(cache.lookup("k0", {0}, out));  // k1 is now the oldest
+    cache.store("k3", {0}, makeEntry(big));
+    assert(!cache.lookup("k1", {0}, out));
+    assert(cache.lookup("k0", {0}, out) && cache.lookup("k2", {0}, out) && cache.lookup("k3", {0}, out));
+    stats = cache.stats();
+    assert(stats.evictions == 1 && stats.entries == 3 && stats.bytes <= 4096);
+    cache.store("huge", {0}, makeEntry(string(5000, 'x')));
+    assert(!cache.lookup("huge", {0}, out) && cache.stats().entries == 3);
+    cout << "[PASS] LRU eviction within the byte cap" << endl;
+}
+
+void testGenerations(DatabaseManager& db) {
+    cout << "\n=== Testing Write Generations ===" << endl;
+
+    uint64_t students = db.generation(Store::STUDENTS);
+    uint64_t courses = db.generation(Store::COURSES);
+    uint64_t users = db.generation(Store::USERS);
+    Student s;
+    s.studentID = "S1";
+    s.email = "s1@uni.edu";
+    s.currentSemester = 1;
+    assert(db.addStudent(s));
+    assert(db.generation(Store::STUDENTS) == students + 1);
+    Student missing;
+    missing.studentID = "NOPE";
+    assert(!db.updateStudent(missing));  // Failed writes change nothing
+    assert(db.generation(Store::STUDENTS) == students + 1);
+    assert(db.generation(Store::COURSES) == courses && db.generation(Store::USERS) == users);
+
+    User u;
+    u.userID = "S1";
+    u.email = s.email;
+    db.createUser(u);
+    assert(db.deleteStudent("S1"));  // Also removes the account
+    assert(db.generation(Store::STUDENTS) == students + 2);
+    assert(db.generation(Store::USERS) == users + 2);
+    cout << "[PASS] Writes bump the stores they change" << endl;
+}
+
+void testServer(DatabaseManager& db) {
+    cout << "\n=== Testing Cached Routes ===" << endl;
+
+    ServerOptions options;
+    options.responseCacheBytes = 1024 * 1024;
+    HTTPServer server(0, db, options);  // Never listens: requests go through handle()
+    int calls = 0;
+    server.get("/count", [&calls](const HTTPRequest& req, DatabaseManager& db) {
+        calls++;
+        if (req.param("fail") == "1") return HTTPServer::jsonError("no");
+        return HTTPResponse(200, to_string(db.getAllStudents().size()));
+    }, {Store::STUDENTS});
+    server.get("/uncached", [&calls](const HTTPRequest&, DatabaseManager&) {
+        calls++;
+        return HTTPResponse(200, "x");
+    });
+
+    auto get = [&server](const string& path, const Params& params = {}, const string& ifNoneMatch = "",
+                         const string& method = "GET") {
+        Request req;
+        req.method = method;
+        req.path = path;
+        req.params = params;
+        if (!ifNoneMatch.empty()) req.set_header("If-None-Match", ifNoneMatch);
+        Response res;
+        server.handle(req, res);
+        return res;
+    };
+
+    assert(get("/count").body == "0" && calls == 1);
+    Response hit = get("/count");
+    assert(hit.body == "0" && hit.status == 200 && calls == 1);
+    assert(hit.get_header_value("Access-Control-Allow-Origin") == "*");
+    get("/count", {{"a", "1"}, {"b", "2"}});
+    get("/count", {{"b", "2"}, {"a", "1"}});
+    assert(calls == 2);
+    cout << "[PASS] Repeated reads served from the cache" << endl;
+
+    // HEAD goes to the GET route (the transport drops the body)
+    Response head = get("/count", {}, "", "HEAD");
+    assert(head.status == 200 && head.get_header_value("ETag") == hit.get_header_value("ETag"));
+    assert(get("/nope", {}, "", "HEAD").status == 404);
+    assert(calls == 2);
+    cout << "[PASS] HEAD answered by the GET route" << endl;
+
+    // Writes to other stores keep the entry; a student write drops it
+    Teacher t;
+    t.teacherID = "T1";
+    db.addTeacher(t);
+    assert(get("/count").body == "0" && calls == 2);
+    Student s;
+    s.studentID = "S2";
+    db.addStudent(s);
+    assert(get("/count").body == "1" && calls == 3);
+    assert(get("/count").body == "1" && calls == 3);
+    cout << "[PASS] Invalidated exactly by writes to the route's stores" << endl;
+
+    // Errors and routes without stores always run the handler
+    assert(get("/count", {{"fail", "1"}}).status == 400 && calls == 4);
+    assert(get("/count", {{"fail", "1"}}).status == 400 && calls == 5);
+    get("/uncached");
+    get("/uncached");
+    assert(calls == 7);
+    ResponseCache::Stats stats = server.cacheStats();
+    assert(stats.hits == 5 && stats.stale == 1 && stats.entries == 2);
+    cout << "[PASS] Errors and uncached routes not stored" << endl;
+
+    // Conditional GETs: the tag is a hash of the body, the same whether the
+    // response was cached or not
+    string tag = get("/count").get_header_value("ETag");
+    assert(tag.size() == 18 && tag.front() == '"' && tag.back() == '"');
+    Response same = get("/count", {}, tag);
+    assert(same.status == 304 && same.body.empty() && same.get_header_value("ETag") == tag);
+    assert(get("/count", {}, "\"other\", W/" + tag).status == 304);  // Lists, weak form
+    assert(get("/count", {}, "*").status == 304);
+    assert(get("/count", {}, "\"other\"").status == 200);
+    s.studentID = "S3";
+    db.addStudent(s);
+    Response changed = get("/count", {}, tag);
+    assert(changed.status == 200 && changed.body == "2" && changed.get_header_value("ETag") != tag);
+    string uncachedTag = get("/uncached").get_header_value("ETag");
+    assert(!uncachedTag.empty() && get("/uncached", {}, uncachedTag).status == 304);
+    assert(get("/count", {{"fail", "1"}}).get_header_value("ETag").empty());  // Errors carry none
+    cout << "[PASS] If-None-Match answered with 304 until the data changes" << endl;
+}
+
+void testRoutes(DatabaseManager& db) {
+    cout << "\n=== Testing Registered Routes ===" << endl;
+
+    ServerOptions options;
+    options.responseCacheBytes = 1024 * 1024;
+    HTTPServer server(0, db, options);
+    registerRoutes(server);
+    auto get = [&server](const string& path, const Params& params) {
+        Request req;
+        req.method = "GET";
+        req.path = path;
+        req.params = params;
+        Response res;
+        server.handle(req, res);
+        return res;
+    };
+
+    Course course;
+    course.courseID = "CS101";
+    course.courseName = "Programming";
+    course.semester = 1;
+    assert(db.addCourse(course));
+    Timetable timetable;
+    timetable.semesterNumber = 1;
+    ScheduledCourse scheduled;
+    scheduled.courseID = course.courseID;
+    scheduled.courseName = course.courseName;
+    timetable.schedule.push_back(scheduled);
+    assert(db.saveTimetable(timetable));
+
+    // The admin timetable counts enrollments from the course records, so an
+    // enrollment must rebuild it even though the timetable itself is unchanged
+    Params semester{{"semester", "1"}};
+    Response before = get("/api/admin/viewTimetable", semester);
+    assert(before.status == 200 && before.body.find("\"studentCount\":0") != string::npos);
+    assert(get("/api/admin/viewTimetable", semester).body == before.body);
+    course.enrolledStudents.push_back("S2");
+    assert(db.updateCourse(course));
+    Response after = get("/api/admin/viewTimetable", semester);
+    assert(after.status == 200 && after.body.find("\"studentCount\":1") != string::npos);
+    assert(server.cacheStats().stale == 1);
+    cout << "[PASS] Course writes rebuild the cached admin timetable" << endl;
+}
+
+int main() {
+    cout << "========================================" << endl;
+    cout << "  Response Cache Test" << endl;
+    cout << "========================================" << endl;
+
+    AsyncLogger::instance().setLevel(LogLevel::Warn);
+#ifdef UMS_PAGED_STORAGE
+    string dir = (filesystem::temp_directory_path() / "ums_test_response_cache_paged").string();
+#else
+    string dir = (filesystem::temp_directory_path() / "ums_test_response_cache").string();
+#endif
+    filesystem::remove_all(dir);
+    {
+        DatabaseManager db(dir);
+        testCache();
+        testGenerations(db);
+        testServer(db);
+        testRoutes(db);
+    }
+    filesystem::remove_all(dir);
+
+    cout << "\n========================================" << endl;
+    cout << "All tests passed!" << endl;
+    cout << "========================================" << endl;
+
+    return 0;
+}
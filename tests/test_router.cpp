@@ -0,0 +1,154 @@
+#undef NDEBUG  // Checks must run in Release builds too
+#include <iostream>
+#include <cassert>
+#include <string>
+#include "../backend/utils/Router.h"
+
+using namespace std;
+
+// Router checks: the server's literal routes, parameterized patterns that
+// share prefixes (edge splits in the trie), literal-before-parameter
+// precedence with backtracking, per-method tables and rejected patterns.
+
+const char* SERVER_ROUTES[][2] = {
+    {"POST", "/api/login"},
+    {"POST", "/api/admin/addStudent"},
+    {"POST", "/api/admin/removeStudent"},
+    {"POST", "/api/admin/addTeacher"},
+    {"POST", "/api/admin/removeTeacher"},
+    {"POST", "/api/admin/addCourse"},
+    {"POST", "/api/admin/setRegistrationWindow"},
+    {"GET", "/api/admin/getRegistrationWindow"},
+    {"GET", "/api/admin/viewAllStudents"},
+    {"GET", "/api/admin/viewAllTeachers"},
+    {"GET", "/api/admin/viewTimetable"},
+    {"POST", "/api/admin/generateTimetable"},
+    {"POST", "/api/student/enrollCourse"},
+    {"POST", "/api/student/dropCourse"},
+    {"GET", "/api/student/viewCourses"},
+    {"GET", "/api/student/viewTimetable"},
+    {"GET", "/api/student/mydata"},
+    {"GET", "/api/teacher/viewStudents"},
+    {"GET", "/api/teacher/viewTimetable"},
+};
+
+// Route index of the match, or -1 (params view into path: pass literals)
+int route(const Router<int>& router, string_view method, string_view path,
+          Router<int>::Params& params) {
+    params.clear();
+    const int* handler = router.find(method, path, params);
+    return handler != nullptr ? *handler : -1;
+}
+
+void testLiteralRoutes() {
+    cout << "\n=== Testing Literal Routes ===" << endl;
+
+    Router<int> router;
+    int i = 0;
+    for (const auto& r : SERVER_ROUTES) {
+        router.add(r[0], r[1], i++);
+    }
+    assert(router.size() == 19);
+
+    Router<int>::Params params;
+    i = 0;
+    for (const auto& r : SERVER_ROUTES) {
+        assert(route(router, r[0], r[1], params) == i++);
+        assert(params.empty());
+    }
+    assert(route(router, "GET", "/api/login", params) == -1);      // POST only
+    assert(route(router, "DELETE", "/api/login", params) == -1);   // No DELETE table
+    assert(route(router, "GET", "/api/student/mydata/", params) == -1);
+    assert(route(router, "GET", "/api/student/mydat", params) == -1);
+    assert(route(router, "GET", "/", params) == -1);
+    cout << "[PASS] " << router.size() << " server routes, exact matches only" << endl;
+}
+
+void testParameterizedRoutes() {
+    cout << "\n=== Testing Parameterized Routes ===" << endl;
+
+    Router<int> router;
+    router.add("GET", "/api/student/:studentID/timetable", 1);
+    router.add("GET", "/api/student/:studentID/courses", 2);
+    router.add("GET", "/api/student/:studentID", 3);
+    router.add("GET", "/api/student/me/timetable", 4);     // Literal: exact table
+    router.add("GET", "/api/student/me/:courseID", 9);     // Literal edge beside the parameter
+    router.add("GET", "/api/student/:studentID/courses/:courseID", 10);
+    router.add("GET", "/api/students/:studentID/courses/:courseID", 5);
+    router.add("GET", "/api/teacher/:teacherID/students", 6);
+    router.add("GET", "/api/teacher/:teacherID/studentCount", 7);  // Splits "students"
+    router.add("GET", "/files/v:version", 8);              // Parameter inside a segment
+
+    Router<int>::Params params;
+    assert(route(router, "GET", "/api/student/BSCS22001/timetable", params) == 1);
+    assert(params.size() == 1 && params[0].first == "studentID" && params[0].second == "BSCS22001");
+    assert(route(router, "GET", "/api/student/BSCS22001/courses", params) == 2);
+    assert(route(router, "GET", "/api/student/BSCS22001", params) == 3);
+    assert(params[0].second == "BSCS22001");
+
+    // "me/" takes the literal edge, and falls back to the parameter when the
+    // literal branch has no match
+    assert(route(router, "GET", "/api/student/me/timetable", params) == 4 && params.empty());
+    assert(route(router, "GET", "/api/student/me/courses", params) == 9);
+    assert(params.size() == 1 && params[0].first == "courseID" && params[0].second == "courses");
+    assert(route(router, "GET", "/api/student/me/courses/CS301", params) == 10);
+    assert(params.size() == 2 && params[0].second == "me" && params[1].second == "CS301");
+    assert(route(router, "GET", "/api/student/me", params) == 3 && params[0].second == "me");
+    assert(route(router, "GET", "/api/student/mez/timetable", params) == 1);
+
+    assert(route(router, "GET", "/api/students/BSCS22001/courses/CS301", params) == 5);
+    assert(params.size() == 2 && params[1].first == "courseID" && params[1].second == "CS301");
+    assert(route(router, "GET", "/api/teacher/T1100/students", params) == 6);
+    assert(route(router, "GET", "/api/teacher/T1100/studentCount", params) == 7);
+    assert(route(router, "GET", "/files/v2", params) == 8 && params[0].second == "2");
+
+    // Segments must be non-empty and whole
+    assert(route(router, "GET", "/api/student//timetable", params) == -1);
+    assert(route(router, "GET", "/api/student/", params) == -1);
+    assert(route(router, "GET", "/api/student/BSCS22001/timetable/extra", params) == -1);
+    assert(route(router, "GET", "/api/teacher/T1100/student", params) == -1);
+    assert(route(router, "POST", "/api/student/BSCS22001", params) == -1);
+    cout << "[PASS] Parameters, shared prefixes and literal precedence" << endl;
+}
+
+void testInvalidPatterns() {
+    cout << "\n=== Testing Invalid Patterns ===" << endl;
+
+    Router<int> router;
+    router.add("GET", "/api/login", 1);
+    router.add("GET", "/api/user/:id", 2);
+
+    auto rejects = [&router](const char* pattern) {
+        try {
+            router.add("GET", pattern, 0);
+        } catch (const invalid_argument&) {
+            return true;
+        }
+        return false;
+    };
+    assert(rejects("/api/login"));         // Duplicate literal
+    assert(rejects("/api/user/:id"));      // Duplicate pattern
+    assert(rejects("/api/user/:name"));    // Conflicting parameter name
+    assert(rejects("api/login"));
+    assert(rejects(""));
+    assert(rejects("/api/:/x"));
+    router.add("POST", "/api/login", 3);   // Same path, other method
+    assert(router.size() == 3);
+    cout << "[PASS] Malformed and conflicting patterns rejected" << endl;
+}
+
+int main() {
+    cout << "========================================" << endl;
+    cout << "  Router Test" << endl;
+    cout << "========================================" << endl;
+
+    testLiteralRoutes();
+    testParameterizedRoutes();
+    testInvalidPatterns();
+
+    cout << "\n========================================" << endl;
+    cout << "All tests passed!" << endl;
+    cout << "========================================" << endl;
+
+    return 0;
+}
@@ -0,0 +1,233 @@
+#undef NDEBUG  // Checks must run in Release builds too
+#include <iostream>
+#include <cassert>
+#include <filesystem>
+#include <set>
+#include <string>
+#include <thread>
+#include "../backend/ServerCluster.h"
+
+using namespace std;
+
+// SharedSnapshot checks first: only changed sections are published, and the
+// replica applies them as record-level changes. Then a forked ServerCluster:
+// reads from every worker see writes forwarded to the writer, and a killed
+// worker or writer is replaced without taking the others down.
+
+Student makeStudent(const string& id) {
+    Student s;
+    s.studentID = id;
+    s.name = "Student " + id;
+    s.email = id + "@uni.edu";
+    s.currentSemester = 1;
+    return s;
+}
+
+void testSnapshot() {
+    cout << "\n=== Testing SharedSnapshot ===" << endl;
+
+    string dir = (filesystem::temp_directory_path() / "ums_test_snapshot").string();
+    filesystem::remove_all(dir);
+    {
+        DatabaseManager primary(dir + "/primary");
+        DatabaseManager replica(dir + "/replica");
+        SharedSnapshot writer(dir);
+        SharedSnapshot reader(dir);
+        writer.reset();
+        assert(writer.isOpen() && reader.generation() == 0);
+        assert(reader.refresh(replica) == 0);  // Nothing published yet
+
+        primary.addStudent(makeStudent("S1"));
+        assert(writer.publish(primary) == 1);
+        assert(reader.generation() == 1);
+        assert(reader.refresh(replica) == SNAPSHOT_SECTIONS);  // First load: everything
+        Student s;
+        assert(replica.getStudent("S1", s) && s.name == "Student S1");
+
+        // Nothing changed (a read, a failed write): same generation, nothing to import
+        assert(writer.publish(primary) == 1);
+        assert(!primary.updateStudent(makeStudent("NOPE")));
+        assert(writer.publish(primary) == 1);
+        assert(reader.refresh(replica) == 0);
+
+        // One store changed: only its section is imported
+        Teacher t;
+        t.teacherID = "T1";
+        t.name = "Teacher";
+        primary.addTeacher(t);
+        assert(writer.publish(primary) == 2);
+        assert(reader.refresh(replica) == 1);
+        assert(replica.getTeacher("T1", t));
+        // ...and only its file was written; the teachers' older one is gone
+        set<string> files;
+        for (const auto& entry : filesystem::directory_iterator(dir)) {
+            string name = entry.path().filename().string();
+            if (name.rfind("snapshot.", 0) == 0) files.insert(name);
+        }
+        string students = "snapshot." + to_string(static_cast<size_t>(Store::STUDENTS));
+        string teachers = "snapshot." + to_string(static_cast<size_t>(Store::TEACHERS));
+        assert(files.count(students + ".1") && files.count(teachers + ".2") && !files.count(teachers + ".1"));
+        assert(files.size() == SNAPSHOT_SECTIONS + 2);  // Plus the manifest and control block
+
+        // Removals and the config travel too
+        primary.deleteStudent("S1");
+        SystemConfig config = primary.getConfig();
+        config.isRegistrationOpen = true;
+        primary.updateConfig(config);
+        assert(writer.publish(primary) == 3);
+        assert(reader.refresh(replica) == 2);
+        assert(!replica.getStudent("S1", s));
+        assert(replica.getConfig().isRegistrationOpen);
+
+        // A changed record is written into the replica on its own: a record
+        // that only the replica has (never the case in a cluster) survives
+        for (int i = 0; i < 10; i++) {
+            primary.addStudent(makeStudent("S" + to_string(10 + i)));
+        }
+        writer.publish(primary);
+        assert(reader.refresh(replica) == 1);
+        replica.addStudent(makeStudent("LOCAL"));
+        Student changed = makeStudent("S12");
+        changed.name = "Renamed";
+        primary.updateStudent(changed);
+        primary.deleteStudent("S15");
+        writer.publish(primary);
+        assert(reader.refresh(replica) == 1);
+        assert(replica.getStudent("S12", s) && s.name == "Renamed");
+        assert(!replica.getStudent("S15", s) && replica.getStudent("S14", s));
+        assert(replica.getStudent("LOCAL", s));
+
+        // Many removals reload the section instead
+        primary.deleteStudent("S10");
+        primary.deleteStudent("S11");
+        writer.publish(primary);
+        assert(reader.refresh(replica) == 1);
+        assert(!replica.getStudent("LOCAL", s) && !replica.getStudent("S10", s));
+        assert(replica.getAllStudents().size() == 7);
+    }
+    filesystem::remove_all(dir);
+    cout << "[PASS] Changed sections published and imported" << endl;
+}
+
+// GET with a fresh connection each time; SO_REUSEPORT picks the worker
+shared_ptr<Response> getFrom(int port, const string& path) {
+    Client client("127.0.0.1", port);
+    client.set_read_timeout(5, 0);
+    auto res = client.Get(path);
+    return res ? make_shared<Response>(*res) : nullptr;
+}
+
+shared_ptr<Response> postTo(int port, const string& path) {
+    Client client("127.0.0.1", port);
+    client.set_read_timeout(5, 0);
+    auto res = client.Post(path, "", "text/plain");
+    return res ? make_shared<Response>(*res) : nullptr;
+}
+
+template<typename Check>
+bool eventually(Check check, int seconds = 10) {
+    auto deadline = chrono::steady_clock::now() + chrono::seconds(seconds);
+    while (chrono::steady_clock::now() < deadline) {
+        if (check()) return true;
+        this_thread::sleep_for(chrono::milliseconds(20));
+    }
+    return false;
+}
+
+void testCluster() {
+    cout << "\n=== Testing ServerCluster ===" << endl;
+
+    string dir = (filesystem::temp_directory_path() / "ums_test_cluster").string();
+    filesystem::remove_all(dir);
+    const int port = 18948;
+
+    // Forked while this process has no threads, as main() does
+    pid_t supervisor = fork();
+    if (supervisor == 0) {
+        prctl(PR_SET_PDEATHSIG, SIGTERM);  // Don't outlive a failed test
+        AsyncLogger::instance().setLevel(LogLevel::Error);
+        ServerOptions options;
+        options.workerThreads = 2;
+        ServerCluster cluster(port, dir, 2, options, "-");
+        _exit(cluster.run([](HTTPServer& server) {
+            server.get("/count", [](const HTTPRequest&, DatabaseManager& db) {
+                return HTTPResponse(200, to_string(db.getAllStudents().size()));
+            });
+            server.get("/pid", [](const HTTPRequest&, DatabaseManager&) {
+                return HTTPResponse(200, to_string(getpid()));
+            });
+            server.post("/add", [](const HTTPRequest& req, DatabaseManager& db) {
+                db.addStudent(makeStudent(string(req.param("id"))));
+                return HTTPResponse(200, to_string(getpid()));
+            });
+        }));
+    }
+    assert(supervisor > 0);
+    assert(eventually([port]() { return getFrom(port, "/count") != nullptr; }));
+
+    // A write through any worker is visible from every worker
+    auto added = postTo(port, "/add?id=S1");
+    assert(added && added->status == 200);
+    pid_t writerPid = stoi(added->body);
+    set<string> workerPids;
+    for (int i = 0; i < 40; i++) {
+        auto count = getFrom(port, "/count");
+        assert(count && count->status == 200 && count->body == "1");
+        workerPids.insert(getFrom(port, "/pid")->body);
+    }
+    assert(workerPids.size() == 2);
+    assert(workerPids.count(to_string(writerPid)) == 0);
+    Client client("127.0.0.1", port);
+    auto head = client.Head("/count");  // A read too: answered by the worker, not forwarded
+    assert(head && head->status == 200 && head->body.empty());
+    cout << "[PASS] Reads spread over both workers see the forwarded write" << endl;
+
+    // A crashed worker: the other keeps serving, a replacement joins
+    pid_t victim = stoi(*workerPids.begin());
+    kill(victim, SIGKILL);
+    for (int i = 0; i < 20; i++) {
+        auto count = getFrom(port, "/count");
+        if (!count) count = getFrom(port, "/count");  // A connect that raced the crash
+        assert(count && count->body == "1");
+    }
+    assert(eventually([&]() {
+        auto pid = getFrom(port, "/pid");
+        return pid && workerPids.count(pid->body) == 0;
+    }));
+    cout << "[PASS] Killed worker replaced, service uninterrupted" << endl;
+
+    // A crashed writer: writes come back once it is restarted, data intact
+    kill(writerPid, SIGKILL);
+    assert(eventually([port, writerPid]() {
+        auto res = postTo(port, "/add?id=S2");
+        return res && res->status == 200 && res->body != to_string(writerPid);
+    }));
+    assert(eventually([port]() {
+        auto count = getFrom(port, "/count");
+        return count && count->body == "2";
+    }));
+    cout << "[PASS] Killed writer replaced, writes resume" << endl;
+
+    kill(supervisor, SIGTERM);
+    int status = 0;
+    assert(waitpid(supervisor, &status, 0) == supervisor);
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    assert(!getFrom(port, "/count"));
+    filesystem::remove_all(dir);
+    cout << "[PASS] SIGTERM stops every process" << endl;
+}
+
+int main() {
+    cout << "========================================" << endl;
+    cout << "  Server Cluster Test" << endl;
+    cout << "========================================" << endl;
+
+    testSnapshot();
+    testCluster();
+
+    cout << "\n========================================" << endl;
+    cout << "All tests passed!" << endl;
+    cout << "========================================" << endl;
+
+    return 0;
+}
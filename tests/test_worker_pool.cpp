@@ -0,0 +1,164 @@
+#undef NDEBUG  // Checks must run in Release builds too
+#include <iostream>
+#include <cassert>
+#include <filesystem>
+#include <future>
+#include <string>
+#include <thread>
+#include "../backend/HTTPServer.h"
+
+using namespace std;
+
+// WorkerPool and ServerOptions checks: the bounded backlog, the shed lane
+// and refusal once both are full, then a live HTTPServer with one worker
+// answering the overflow with 503 + Retry-After while the queued request
+// still succeeds.
+
+// Blocks tasks until opened
+struct Gate {
+    mutex m;
+    condition_variable cv;
+    bool open = false;
+    atomic<int> waiting{0};
+
+    void wait() {
+        waiting++;
+        unique_lock<mutex> lock(m);
+        cv.wait(lock, [this] { return open; });
+    }
+    void release() {
+        { lock_guard<mutex> lock(m); open = true; }
+        cv.notify_all();
+    }
+    void awaitWaiting(int n) {
+        while (waiting.load() < n) this_thread::sleep_for(chrono::milliseconds(1));
+    }
+};
+
+void testPool() {
+    cout << "\n=== Testing WorkerPool ===" << endl;
+
+    Gate gate;
+    atomic<int> mainRan{0}, shedRan{0};
+    auto job = [&]() {
+        gate.wait();
+        (WorkerPool::shedding() ? shedRan : mainRan)++;
+    };
+
+    {
+        WorkerPool pool(1, 1);
+        assert(pool.enqueue(job));    // Running on the worker
+        gate.awaitWaiting(1);
+        assert(pool.enqueue(job));    // Backlog
+        assert(pool.queued() == 1);
+        assert(pool.enqueue(job));    // Shed lane: running on the shed thread
+        gate.awaitWaiting(2);
+        for (int i = 0; i < 16; i++) {
+            assert(pool.enqueue(job));  // Shed backlog (at least 16 deep)
+        }
+        assert(!pool.enqueue(job));   // Everything full: httplib closes the socket
+        assert(pool.shedConnections() == 17);
+        assert(pool.refusedConnections() == 1);
+
+        gate.release();
+        pool.shutdown();              // Drains both lanes
+        pool.shutdown();              // Idempotent (the destructor calls it again)
+    }
+    assert(mainRan == 2 && shedRan == 17);
+
+    // Unbounded backlog: no shed lane, nothing refused
+    Gate open;
+    open.release();
+    atomic<int> ran{0};
+    {
+        WorkerPool pool(2, 0);
+        for (int i = 0; i < 1000; i++) {
+            assert(pool.enqueue([&]() { assert(!WorkerPool::shedding()); ran++; }));
+        }
+    }
+    assert(ran == 1000);
+    cout << "[PASS] Backlog limit, shed lane and refusal" << endl;
+}
+
+void testServerSheds() {
+    cout << "\n=== Testing Server Load Shedding ===" << endl;
+
+    string dir = (filesystem::temp_directory_path() / "ums_test_worker_pool").string();
+    filesystem::remove_all(dir);
+    AsyncLogger::instance().setLevel(LogLevel::Warn);
+    DatabaseManager db(dir);
+
+    ServerOptions options;
+    options.workerThreads = 1;
+    options.maxQueuedConnections = 1;
+    options.retryAfterSeconds = 3;
+    const int port = 18946;
+    HTTPServer server(port, db, options);
+
+    Gate gate;
+    atomic<int> dbTouches{0};
+    server.get("/slow", [&gate](const HTTPRequest&, DatabaseManager&) {
+        gate.wait();
+        return HTTPResponse(200, "{\"slow\":\"done\"}");
+    });
+    server.get("/fast", [&dbTouches](const HTTPRequest&, DatabaseManager&) {
+        dbTouches++;
+        return HTTPResponse(200, "{\"fast\":\"done\"}");
+    });
+
+    thread listener([&server]() { server.start(); });
+    Client probe("127.0.0.1", port);
+    while (!probe.Options("/")) this_thread::sleep_for(chrono::milliseconds(5));
+
+    auto get = [port](const char* path) {
+        Client client("127.0.0.1", port);
+        client.set_read_timeout(10, 0);
+        return client.Get(path);
+    };
+
+    auto slow = async(launch::async, get, "/slow");     // Holds the only worker
+    gate.awaitWaiting(1);
+    auto queued = async(launch::async, get, "/fast");   // Waits in the backlog
+    this_thread::sleep_for(chrono::milliseconds(200));
+
+    auto shed = get("/fast");                           // Backlog full: shed
+    assert(shed && shed->status == 503);
+    assert(shed->get_header_value("Retry-After") == "3");
+    assert(shed->body.find("Server busy") != string::npos);
+    assert(dbTouches == 0);
+
+    gate.release();
+    auto slowRes = slow.get();
+    auto queuedRes = queued.get();
+    assert(slowRes && slowRes->status == 200);
+    assert(queuedRes && queuedRes->status == 200 && queuedRes->body == "{\"fast\":\"done\"}");
+    assert(dbTouches == 1);
+
+    // Keep-alive limits are advertised on persistent connections
+    Client keepAlive("127.0.0.1", port);
+    keepAlive.set_keep_alive(true);
+    auto fast = keepAlive.Get("/fast");
+    assert(fast && fast->status == 200);
+    assert(fast->get_header_value("Keep-Alive") == "timeout=2, max=100");
+    keepAlive.stop();
+
+    server.stop();
+    listener.join();
+    filesystem::remove_all(dir);
+    cout << "[PASS] Overflow answered with 503 and Retry-After, backlog served" << endl;
+}
+
+int main() {
+    cout << "========================================" << endl;
+    cout << "  Worker Pool Test" << endl;
+    cout << "========================================" << endl;
+
+    testPool();
+    testServerSheds();
+
+    cout << "\n========================================" << endl;
+    cout << "All tests passed!" << endl;
+    cout << "========================================" << endl;
+
+    return 0;
+}
@@ -3,6 +3,7 @@
 #include <iostream>
 #include <sstream>
 #include <vector>
+#include <set>
 #include <string>
 #include <fstream>
 
@@ -50,6 +51,14 @@ int main() {
     int successCount = 0;
     int failCount = 0;
     
+    // Collect records first and import them in one batch per store: one
+    // data-file write each, and the indexes are bulk-loaded instead of
+    // rewriting the file and inserting once per student
+    vector<User> newUsers;
+    vector<Student> newStudents;
+    set<string> seenIDs;
+    set<string> seenEmails;
+    
     cout << "\nAdding " << studentData.size() << " students..." << endl;
     cout << "----------------------------------------" << endl;
     
@@ -82,11 +91,17 @@ int main() {
         
         // Check if student already exists
         Student existingStudent;
-        if (db.getStudent(studentID, existingStudent)) {
+        if (db.getStudent(studentID, existingStudent) || seenIDs.count(studentID)) {
             cout << "[SKIP] " << studentID << " - Already exists" << endl;
             continue;
         }
         
+        if (db.getUserByEmail(email) != nullptr || seenEmails.count(email)) {
+            cerr << "[FAIL] " << studentID << " - Failed to create user account" << endl;
+            failCount++;
+            continue;
+        }
+        
         // Create User account for student
         User user;
         user.userID = studentID;
@@ -97,13 +112,6 @@ int main() {
         user.role = UserRole::STUDENT;
         user.name = name;
         
-        // Add user account
-        if (!db.createUser(user)) {
-            cerr << "[FAIL] " << studentID << " - Failed to create user account" << endl;
-            failCount++;
-            continue;
-        }
-        
         // Create Student record
         Student student;
         student.studentID = studentID;
@@ -114,13 +122,32 @@ int main() {
         student.contactInfo = phone;
         student.dateOfAdmission = admission;
         
-        // Add student
-        if (db.addStudent(student)) {
-            cout << "[OK] " << studentID << " - " << name 
-                 << " (Semester " << semester << ", " << courses.size() << " courses)" << endl;
+        newUsers.push_back(user);
+        newStudents.push_back(student);
+        seenIDs.insert(studentID);
+        seenEmails.insert(email);
+    }
+    
+    // Report each record only once the batch is written
+    size_t usersAdded = db.createUsers(newUsers);
+    size_t studentsAdded = db.addStudents(newStudents);
+    bool batchWritten = usersAdded == newUsers.size() && studentsAdded == newStudents.size();
+    if (!batchWritten) {
+        cerr << "[FAIL] Batch import wrote " << usersAdded << "/" << newUsers.size() << " users and "
+             << studentsAdded << "/" << newStudents.size() << " students" << endl;
+    }
+    for (const auto& student : newStudents) {
+        // On a partial write, look up which records made it
+        Student stored;
+        bool added = batchWritten || (db.getStudent(student.studentID, stored) &&
+                                      db.getUserByEmail(student.email) != nullptr);
+        if (added) {
+            cout << "[OK] " << student.studentID << " - " << student.name
+                 << " (Semester " << student.currentSemester << ", "
+                 << student.enrolledCourses.size() << " courses)" << endl;
             successCount++;
         } else {
-            cerr << "[FAIL] " << studentID << " - Failed to add student record" << endl;
+            cerr << "[FAIL] " << student.studentID << " - Failed to write student record" << endl;
             failCount++;
         }
     }
@@ -527,10 +527,10 @@ async function displayAllTimetables() {
         // Fetch all 8 semesters
         for (let semester = 1; semester <= 8; semester++) {
             try {
-                const url = `${API_URL}/admin/viewTimetable?semester=${semester}&_t=${Date.now()}`;
+                const url = `${API_URL}/admin/viewTimetable?semester=${semester}`;
                 console.log(`[Timetable] Fetching semester ${semester} from:`, url);
 
-                const response = await fetch(url, {
+                const response = await api.revalidatingFetch(url, {
                     headers: { 'Authorization': `Bearer ${localStorage.getItem('token')}` }
                 });
 
@@ -6,6 +6,43 @@ class APIClient {
     constructor(baseURL) {
         this.baseURL = baseURL;
         this.token = localStorage.getItem('token');
+        // GET bodies with their ETag, most recently used last
+        this.etagCache = new Map();
+        this.etagCacheLimit = 100;
+    }
+
+    // fetch() for GETs that are polled: the last body of each URL is kept
+    // with its ETag and revalidated with If-None-Match. Unchanged data
+    // comes back from the server as an empty 304, turned here into the
+    // kept 200 response.
+    async revalidatingFetch(url, options = {}) {
+        const cached = this.etagCache.get(url);
+        const headers = { ...options.headers };
+        if (cached) {
+            headers['If-None-Match'] = cached.etag;
+        }
+
+        const response = await fetch(url, { ...options, headers });
+
+        if (response.status === 304 && cached) {
+            this.etagCache.delete(url);
+            this.etagCache.set(url, cached);
+            return new Response(cached.body, {
+                status: 200,
+                headers: { 'Content-Type': 'application/json', 'ETag': cached.etag }
+            });
+        }
+
+        const etag = response.headers.get('ETag');
+        if (response.ok && etag) {
+            const body = await response.clone().text();
+            this.etagCache.delete(url);
+            this.etagCache.set(url, { etag, body });
+            if (this.etagCache.size > this.etagCacheLimit) {
+                this.etagCache.delete(this.etagCache.keys().next().value);
+            }
+        }
+        return response;
     }
 
     async request(endpoint, options = {}) {
@@ -20,10 +57,9 @@ class APIClient {
         }
 
         try {
-            const response = await fetch(url, {
-                ...options,
-                headers
-            });
+            const isGet = (options.method || 'GET').toUpperCase() === 'GET';
+            const response = await (isGet ? this.revalidatingFetch(url, { ...options, headers })
+                                          : fetch(url, { ...options, headers }));
 
             const data = await response.json();
 
@@ -56,6 +92,7 @@ class APIClient {
 
     logout() {
         this.token = null;
+        this.etagCache.clear();
         localStorage.removeItem('token');
         localStorage.removeItem('userRole');
         localStorage.removeItem('userName');
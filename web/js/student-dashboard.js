@@ -45,7 +45,7 @@ async function loadStudentData() {
         }
 
         // CRITICAL FIX: Use correct query parameter format
-        const response = await fetch(`${API_URL}/student/mydata?studentID=${encodeURIComponent(studentID)}&_t=${Date.now()}`, {
+        const response = await api.revalidatingFetch(`${API_URL}/student/mydata?studentID=${encodeURIComponent(studentID)}`, {
             headers: { 'Authorization': `Bearer ${localStorage.getItem('token')}` }
         });
 
@@ -137,7 +137,7 @@ let isRegistrationOpen = false;
 
 async function loadRegistrationWindow() {
     try {
-        const response = await fetch(`${API_URL}/admin/getRegistrationWindow?_t=${Date.now()}`, {
+        const response = await api.revalidatingFetch(`${API_URL}/admin/getRegistrationWindow`, {
             headers: { 'Authorization': `Bearer ${localStorage.getItem('token')}` }
         });
 
@@ -192,7 +192,7 @@ async function loadCourses() {
     try {
         document.getElementById('courses-semester').textContent = currentSemester;
 
-        const response = await fetch(`${API_URL}/student/viewCourses?semester=${currentSemester}&_t=${Date.now()}`, {
+        const response = await api.revalidatingFetch(`${API_URL}/student/viewCourses?semester=${currentSemester}`, {
             headers: { 'Authorization': `Bearer ${localStorage.getItem('token')}` }
         });
 
@@ -355,10 +355,10 @@ async function loadTimetable() {
         console.log('[Timetable] Fetching for student:', studentID);
 
         // CRITICAL FIX: Use correct URL format with proper encoding
-        const url = `${API_URL}/student/viewTimetable?studentID=${encodeURIComponent(studentID)}&_t=${Date.now()}`;
+        const url = `${API_URL}/student/viewTimetable?studentID=${encodeURIComponent(studentID)}`;
         console.log('[Timetable] Fetching from:', url);
 
-        const response = await fetch(url, {
+        const response = await api.revalidatingFetch(url, {
             headers: {
                 'Authorization': `Bearer ${localStorage.getItem('token')}`
             }